@@ -0,0 +1,227 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "chrono/collision/ChCBroadphaseGrid.h"
+#include "chrono/parallel/ChOpenMP.h"
+
+namespace chrono {
+namespace collision {
+
+// Boxes spanning more cells than this are tested against all the other boxes.
+static const int max_cells_per_box = 64;
+
+// Number of bits of each cell coordinate in the cell keys.
+static const int cell_bits = 21;
+static const int64_t max_cell_index = (int64_t(1) << cell_bits) - 1;
+
+static inline ChVector<> ComponentMin(const ChVector<>& a, const ChVector<>& b) {
+    return ChVector<>(std::min(a.x(), b.x()), std::min(a.y(), b.y()), std::min(a.z(), b.z()));
+}
+
+static inline ChVector<> ComponentMax(const ChVector<>& a, const ChVector<>& b) {
+    return ChVector<>(std::max(a.x(), b.x()), std::max(a.y(), b.y()), std::max(a.z(), b.z()));
+}
+
+static inline bool BoxesOverlap(const ChBroadphaseGrid::Box& A, const ChBroadphaseGrid::Box& B) {
+    return A.min.x() <= B.max.x() && B.min.x() <= A.max.x() &&  //
+           A.min.y() <= B.max.y() && B.min.y() <= A.max.y() &&  //
+           A.min.z() <= B.max.z() && B.min.z() <= A.max.z() &&  //
+           (A.group & B.mask) != 0 && (B.group & A.mask) != 0;
+}
+
+ChBroadphaseGrid::ChBroadphaseGrid() : m_num_threads(1), m_cell_size(0) {}
+
+uint64_t ChBroadphaseGrid::CellKey(const ChVector<>& p) const {
+    uint64_t key = 0;
+    for (int k = 0; k < 3; k++) {
+        int64_t i = (int64_t)std::floor((p[k] - m_origin[k]) / m_cell_size);
+        i = std::min(std::max(i, int64_t(0)), max_cell_index);
+        key |= uint64_t(i) << (k * cell_bits);
+    }
+    return key;
+}
+
+void ChBroadphaseGrid::FindPairs(const std::vector<Box>& boxes, std::vector<std::pair<int, int>>& pairs) {
+    int n = (int)boxes.size();
+    int nthreads = std::max(m_num_threads, 1);
+
+    pairs.clear();
+    m_large.clear();
+
+    // Grid origin (lower corner of all boxes) and cell size (average box size).
+    double inf = std::numeric_limits<double>::max();
+    ChVector<> lo(inf, inf, inf);
+    ChVector<> hi(-inf, -inf, -inf);
+    double size_sum = 0;
+    int num_active = 0;
+    for (int i = 0; i < n; i++) {
+        const Box& b = boxes[i];
+        if (!b.active)
+            continue;
+        lo = ComponentMin(lo, b.min);
+        hi = ComponentMax(hi, b.max);
+        ChVector<> size = b.max - b.min;
+        size_sum += std::max(size.x(), std::max(size.y(), size.z()));
+        num_active++;
+    }
+    if (num_active < 2)
+        return;
+
+    m_origin = lo;
+    m_cell_size = size_sum / num_active;
+    ChVector<> range = hi - lo;
+    double max_range = std::max(range.x(), std::max(range.y(), range.z()));
+    m_cell_size = std::max(m_cell_size, max_range / max_cell_index);
+    if (!(m_cell_size > 0))
+        m_cell_size = 1;
+
+    // Number of cells spanned by each box.
+    m_box_cells.resize(n);
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < n; i++) {
+        const Box& b = boxes[i];
+        if (!b.active) {
+            m_box_cells[i] = 0;
+            continue;
+        }
+        uint64_t k0 = CellKey(b.min);
+        uint64_t k1 = CellKey(b.max);
+        int64_t cells = 1;
+        for (int k = 0; k < 3; k++) {
+            int64_t i0 = (k0 >> (k * cell_bits)) & max_cell_index;
+            int64_t i1 = (k1 >> (k * cell_bits)) & max_cell_index;
+            cells *= i1 - i0 + 1;
+        }
+        m_box_cells[i] = (cells > max_cells_per_box) ? -1 : (int)cells;
+    }
+
+    m_entry_start.resize(n + 1);
+    m_entry_start[0] = 0;
+    for (int i = 0; i < n; i++) {
+        if (m_box_cells[i] < 0)
+            m_large.push_back(i);
+        m_entry_start[i + 1] = m_entry_start[i] + std::max(m_box_cells[i], 0);
+    }
+    int num_entries = m_entry_start[n];
+
+    // Cell entries of the boxes.
+    m_entries.resize(num_entries);
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < n; i++) {
+        if (m_box_cells[i] <= 0)
+            continue;
+        uint64_t k0 = CellKey(boxes[i].min);
+        uint64_t k1 = CellKey(boxes[i].max);
+        int64_t ix0 = k0 & max_cell_index, ix1 = k1 & max_cell_index;
+        int64_t iy0 = (k0 >> cell_bits) & max_cell_index, iy1 = (k1 >> cell_bits) & max_cell_index;
+        int64_t iz0 = (k0 >> (2 * cell_bits)) & max_cell_index, iz1 = (k1 >> (2 * cell_bits)) & max_cell_index;
+        int e = m_entry_start[i];
+        for (int64_t iz = iz0; iz <= iz1; iz++)
+            for (int64_t iy = iy0; iy <= iy1; iy++)
+                for (int64_t ix = ix0; ix <= ix1; ix++) {
+                    m_entries[e].cell = uint64_t(ix) | (uint64_t(iy) << cell_bits) | (uint64_t(iz) << (2 * cell_bits));
+                    m_entries[e].box = i;
+                    e++;
+                }
+    }
+
+    // Counting sort of the entries in hash buckets (entries of a cell are all in the same bucket).
+    int num_buckets = 1;
+    int bucket_bits = 0;
+    while (num_buckets < num_entries) {
+        num_buckets <<= 1;
+        bucket_bits++;
+    }
+    auto bucket = [bucket_bits](uint64_t cell) {
+        return bucket_bits ? (int)((cell * 0x9E3779B97F4A7C15ull) >> (64 - bucket_bits)) : 0;
+    };
+    m_bucket_start.assign(num_buckets + 1, 0);
+    for (int e = 0; e < num_entries; e++)
+        m_bucket_start[bucket(m_entries[e].cell) + 1]++;
+    for (int b = 0; b < num_buckets; b++)
+        m_bucket_start[b + 1] += m_bucket_start[b];
+    m_sorted.resize(num_entries);
+    m_pair_start.assign(m_bucket_start.begin(), m_bucket_start.end() - 1);  // used as insertion cursors
+    for (int e = 0; e < num_entries; e++)
+        m_sorted[m_pair_start[bucket(m_entries[e].cell)]++] = m_entries[e];
+
+    // Pair search, with thread-local output.
+    m_thread_pairs.resize(nthreads);
+#pragma omp parallel num_threads(nthreads) if (nthreads > 1)
+    {
+        std::vector<std::pair<int, int>>& local = m_thread_pairs[CHOMPfunctions::GetThreadNum()];
+        local.clear();
+
+        // Pairs of boxes in the same cell, tested only in the cell of the lower corner of their intersection.
+#pragma omp for schedule(dynamic, 64)
+        for (int b = 0; b < num_buckets; b++) {
+            CellEntry* first = m_sorted.data() + m_bucket_start[b];
+            CellEntry* last = m_sorted.data() + m_bucket_start[b + 1];
+            if (last - first < 2)
+                continue;
+            std::sort(first, last, [](const CellEntry& e1, const CellEntry& e2) {
+                return e1.cell < e2.cell || (e1.cell == e2.cell && e1.box < e2.box);
+            });
+            for (CellEntry* e1 = first; e1 < last; e1++) {
+                const Box& A = boxes[e1->box];
+                for (CellEntry* e2 = e1 + 1; e2 < last && e2->cell == e1->cell; e2++) {
+                    const Box& B = boxes[e2->box];
+                    if (BoxesOverlap(A, B) && CellKey(ComponentMax(A.min, B.min)) == e1->cell)
+                        local.push_back(std::make_pair(e1->box, e2->box));
+                }
+            }
+        }
+
+        // Large boxes, tested against all the others.
+        int num_large = (int)m_large.size();
+        if (num_large > 0) {
+#pragma omp for schedule(dynamic, 256)
+            for (int j = 0; j < n; j++) {
+                if (!boxes[j].active)
+                    continue;
+                for (int l = 0; l < num_large; l++) {
+                    int i = m_large[l];
+                    if (i == j || (m_box_cells[j] < 0 && j > i))
+                        continue;
+                    if (BoxesOverlap(boxes[i], boxes[j]))
+                        local.push_back(std::make_pair(std::min(i, j), std::max(i, j)));
+                }
+            }
+        }
+    }
+
+    // Merge the thread-local pairs, sorted by first box (counting sort), then by second box.
+    m_pair_start.assign(n + 1, 0);
+    for (int t = 0; t < nthreads; t++)
+        for (const auto& p : m_thread_pairs[t])
+            m_pair_start[p.first + 1]++;
+    for (int i = 0; i < n; i++)
+        m_pair_start[i + 1] += m_pair_start[i];
+    pairs.resize(m_pair_start[n]);
+    m_entry_start.assign(m_pair_start.begin(), m_pair_start.end() - 1);  // used as insertion cursors
+    for (int t = 0; t < nthreads; t++)
+        for (const auto& p : m_thread_pairs[t])
+            pairs[m_entry_start[p.first]++] = p;
+
+#pragma omp parallel for schedule(dynamic, 256) num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < n; i++) {
+        if (m_pair_start[i + 1] - m_pair_start[i] > 1)
+            std::sort(pairs.begin() + m_pair_start[i], pairs.begin() + m_pair_start[i + 1]);
+    }
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -0,0 +1,87 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHC_BROADPHASEGRID_H
+#define CHC_BROADPHASEGRID_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChVector.h"
+
+namespace chrono {
+namespace collision {
+
+/// Multithreaded uniform grid broadphase.
+/// Given the axis-aligned bounding boxes of a set of objects, it finds all the pairs of objects with overlapping
+/// boxes. The boxes are binned in a uniform grid (with cell size set from the average box size) using a parallel
+/// counting sort; each pair is tested in the cell that contains the lower corner of the intersection of the two
+/// boxes, so that it is found only once. Boxes that span too many cells are instead tested against all the others.
+/// The output does not depend on the number of threads: pairs are sorted by first object, then second object.
+/// This is used by ChCollisionSystemBullet for its multithreaded collision detection.
+class ChApi ChBroadphaseGrid {
+  public:
+    /// Bounding box of an object, with its collision filter.
+    /// Two objects are paired only if (group_A & mask_B) != 0 and (group_B & mask_A) != 0.
+    struct Box {
+        ChVector<> min;  ///< lower corner
+        ChVector<> max;  ///< upper corner
+        short group;     ///< collision filter group
+        short mask;      ///< collision filter mask
+        bool active;     ///< if false, the object is ignored
+    };
+
+    ChBroadphaseGrid();
+
+    /// Set the number of threads used in the pair search.
+    void SetNumThreads(int nthreads) { m_num_threads = nthreads; }
+
+    /// Find all the pairs (i, j) of active boxes that overlap and pass the collision filter, with i < j.
+    /// On output, the pairs are sorted by i, then by j.
+    void FindPairs(const std::vector<Box>& boxes, std::vector<std::pair<int, int>>& pairs);
+
+    /// Return the cell size used in the last call to FindPairs.
+    double GetCellSize() const { return m_cell_size; }
+
+    /// Return the number of boxes tested against all the others in the last call to FindPairs.
+    int GetNumLargeBoxes() const { return (int)m_large.size(); }
+
+  private:
+    // Entry of a box in a cell of the grid.
+    struct CellEntry {
+        uint64_t cell;  // cell key
+        int box;        // box index
+    };
+
+    uint64_t CellKey(const ChVector<>& p) const;
+
+    int m_num_threads;
+    double m_cell_size;
+    ChVector<> m_origin;
+
+    // Work arrays, kept between calls to avoid reallocations.
+    std::vector<int> m_box_cells;         // number of cells of each box (-1 for large boxes)
+    std::vector<int> m_entry_start;       // start of the entries of each box
+    std::vector<CellEntry> m_entries;     // cell entries, by box
+    std::vector<int> m_bucket_start;      // start of each hash bucket in m_sorted
+    std::vector<CellEntry> m_sorted;      // cell entries, by hash bucket
+    std::vector<int> m_large;             // indices of the large boxes
+    std::vector<int> m_pair_start;        // start of the pairs of each box in the output
+    std::vector<std::vector<std::pair<int, int>>> m_thread_pairs;  // pairs found by each thread
+};
+
+}  // end namespace collision
+}  // end namespace chrono
+
+#endif
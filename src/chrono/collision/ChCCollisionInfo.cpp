@@ -10,6 +10,8 @@
 //
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/collision/ChCCollisionInfo.h"
 
 namespace chrono {
@@ -25,7 +27,9 @@ ChCollisionInfo::ChCollisionInfo()
       vN(ChVector<>(1, 0, 0)),
       distance(0),
       eff_radius(default_eff_radius),
-      reaction_cache(nullptr) {}
+      reaction_cache(nullptr),
+      shapeA(-1),
+      shapeB(-1) {}
 
 ChCollisionInfo::ChCollisionInfo(const ChCollisionInfo& other, const bool swap) {
     if (!swap) {
@@ -34,6 +38,8 @@ ChCollisionInfo::ChCollisionInfo(const ChCollisionInfo& other, const bool swap)
         vpA = other.vpA;
         vpB = other.vpB;
         vN = other.vN;
+        shapeA = other.shapeA;
+        shapeB = other.shapeB;
     } else {
         // copy by swapping models
         modelA = other.modelB;
@@ -41,6 +47,8 @@ ChCollisionInfo::ChCollisionInfo(const ChCollisionInfo& other, const bool swap)
         vpA = other.vpB;
         vpB = other.vpA;
         vN = -other.vN;
+        shapeA = other.shapeB;
+        shapeB = other.shapeA;
     }
     distance = other.distance;
     eff_radius = other.eff_radius;
@@ -57,6 +65,7 @@ void ChCollisionInfo::SwapModels() {
     vpA = vpB;
     vpB = vtemp;
     vN = Vmul(vN, -1.0);
+    std::swap(shapeA, shapeB);
 }
 
 void ChCollisionInfo::SetDefaultEffectiveCurvatureRadius(double radius) {
@@ -34,6 +34,8 @@ class ChApi ChCollisionInfo {
     double distance;           ///< distance (negative for penetration)
     double eff_radius;         ///< effective radius of curvature at contact (SMC only)
     float* reaction_cache;     ///< pointer to some persistent user cache of reactions
+    int shapeA;                ///< index of the shape (or shape feature) of model A, -1 if not available
+    int shapeB;                ///< index of the shape (or shape feature) of model B, -1 if not available
 
     /// Basic default constructor.
     ChCollisionInfo();
@@ -15,6 +15,8 @@
 #ifndef CHC_COLLISIONSYSTEM_H
 #define CHC_COLLISIONSYSTEM_H
 
+#include <vector>
+
 #include "chrono/collision/ChCCollisionInfo.h"
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChFrame.h"
@@ -63,6 +65,10 @@ class ChApi ChCollisionSystem {
     /// Children classes _must_ implement this.
     virtual void Run() = 0;
 
+    /// Set the number of threads that the collision detection can use, if multithreaded.
+    /// ChSystem calls this with its number of parallel threads. The default implementation does nothing.
+    virtual void SetNumThreads(int nthreads) {}
+
     /// After the Run() has completed, you can call this function to
     /// fill a 'contact container', that is an object inherited from class
     /// ChContactContainer. For instance ChSystem, after each Run()
@@ -145,6 +151,27 @@ class ChApi ChCollisionSystem {
                         ChCollisionModel* model,
                         ChRayhitResult& mresult) const = 0;
 
+    /// Perform ray-hit tests of a set of rays (from[i], to[i]) with all collision models.
+    /// On output, results[i] is the result of the i-th ray. The default implementation calls RayHit() for each ray.
+    virtual void RayHits(const std::vector<ChVector<>>& from,
+                         const std::vector<ChVector<>>& to,
+                         std::vector<ChRayhitResult>& results) const {
+        results.resize(from.size());
+        for (size_t i = 0; i < from.size(); i++)
+            RayHit(from[i], to[i], results[i]);
+    }
+
+    /// Perform ray-hit tests of a set of rays (from[i], to[i]) with the specified collision model.
+    /// On output, results[i] is the result of the i-th ray. The default implementation calls RayHit() for each ray.
+    virtual void RayHits(const std::vector<ChVector<>>& from,
+                         const std::vector<ChVector<>>& to,
+                         ChCollisionModel* model,
+                         std::vector<ChRayhitResult>& results) const {
+        results.resize(from.size());
+        for (size_t i = 0; i < from.size(); i++)
+            RayHit(from[i], to[i], model, results[i]);
+    }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive) {
         // version number
@@ -12,6 +12,8 @@
 // Authors: Alessandro Tasora
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/collision/ChCCollisionSystemBullet.h"
 #include "chrono/collision/ChCModelBullet.h"
 #include "chrono/collision/gimpact/GIMPACT/Bullet/btGImpactCollisionAlgorithm.h"
@@ -19,6 +21,8 @@
 #include "chrono/physics/ChBody.h"
 #include "chrono/physics/ChContactContainer.h"
 #include "chrono/physics/ChProximityContainer.h"
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/utils/ChProfiler.h"
 #include "chrono/collision/bullet/LinearMath/btPoolAllocator.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionShapes/btSphereShape.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionShapes/btCylinderShape.h"
@@ -1166,12 +1170,86 @@ private:
 ////////////////////////////////////
 ////////////////////////////////////
 
+// Collision dispatcher that can be used by the multithreaded narrow phase: when locking is enabled, the creation
+// and deletion of contact manifolds and collision algorithms (which use shared pools) are serialized.
+class btCollisionDispatcherMT : public btCollisionDispatcher {
+  public:
+    btCollisionDispatcherMT(btCollisionConfiguration* collisionConfiguration)
+        : btCollisionDispatcher(collisionConfiguration), m_locking(false) {}
+
+    void setLocking(bool locking) { m_locking = locking; }
+
+    virtual btPersistentManifold* getNewManifold(void* b0, void* b1) {
+        if (!m_locking)
+            return btCollisionDispatcher::getNewManifold(b0, b1);
+        CHOMPscopedLock lock(m_mutex);
+        return btCollisionDispatcher::getNewManifold(b0, b1);
+    }
+
+    virtual void releaseManifold(btPersistentManifold* manifold) {
+        if (!m_locking) {
+            btCollisionDispatcher::releaseManifold(manifold);
+            return;
+        }
+        CHOMPscopedLock lock(m_mutex);
+        btCollisionDispatcher::releaseManifold(manifold);
+    }
+
+    virtual void* allocateCollisionAlgorithm(int size) {
+        if (!m_locking)
+            return btCollisionDispatcher::allocateCollisionAlgorithm(size);
+        CHOMPscopedLock lock(m_mutex);
+        return btCollisionDispatcher::allocateCollisionAlgorithm(size);
+    }
+
+    virtual void freeCollisionAlgorithm(void* ptr) {
+        if (!m_locking) {
+            btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+            return;
+        }
+        CHOMPscopedLock lock(m_mutex);
+        btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+    }
 
-ChCollisionSystemBullet::ChCollisionSystemBullet(unsigned int max_objects, double scene_size) {
+  private:
+    bool m_locking;
+    CHOMPmutex m_mutex;
+};
+
+// How the multithreaded narrow phase can process the pairs of a collision object.
+enum NarrowphaseMode {
+    NARROWPHASE_SHARED = 0,     // pairs can be processed concurrently (the object is not modified)
+    NARROWPHASE_EXCLUSIVE = 1,  // pairs must be processed one at a time (compound and concave shapes)
+    NARROWPHASE_SERIAL = 2      // pairs must be processed after all the others (GIMPACT meshes)
+};
+
+static char GetNarrowphaseMode(const btCollisionShape* shape) {
+    int type = shape->getShapeType();
+    if (type == GIMPACT_SHAPE_PROXYTYPE)
+        return NARROWPHASE_SERIAL;
+    if (shape->isCompound()) {
+        // the compound algorithm temporarily replaces the shape and transform of the compound object
+        const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+        char mode = NARROWPHASE_EXCLUSIVE;
+        for (int i = 0; i < compound->getNumChildShapes(); i++)
+            mode = std::max(mode, GetNarrowphaseMode(compound->getChildShape(i)));
+        return mode;
+    }
+    if (shape->isConcave() && type != STATIC_PLANE_PROXYTYPE)
+        return NARROWPHASE_EXCLUSIVE;
+    return NARROWPHASE_SHARED;
+}
+
+////////////////////////////////////
+////////////////////////////////////
+
+
+ChCollisionSystemBullet::ChCollisionSystemBullet(unsigned int max_objects, double scene_size)
+    : use_parallel(false), num_threads(1) {
     // btDefaultCollisionConstructionInfo conf_info(...); ***TODO***
     bt_collision_configuration = new btDefaultCollisionConfiguration();
 
-    bt_dispatcher = new btCollisionDispatcher(bt_collision_configuration);
+    bt_dispatcher = new btCollisionDispatcherMT(bt_collision_configuration);
     //((btDefaultCollisionConfiguration*)bt_collision_configuration)->setConvexConvexMultipointIterations(4,4);
 
     //***OLD***
@@ -1257,84 +1335,293 @@ void ChCollisionSystemBullet::Add(ChCollisionModel* model) {
 void ChCollisionSystemBullet::Remove(ChCollisionModel* model) {
     if (((ChModelBullet*)model)->GetBulletModel()->getCollisionShape()) {
         bt_collision_world->removeCollisionObject(((ChModelBullet*)model)->GetBulletModel());
+        manifolds.clear();
     }
 }
 
+void ChCollisionSystemBullet::SetNumThreads(int nthreads) {
+    num_threads = std::max(nthreads, 1);
+}
+
+void ChCollisionSystemBullet::SetUseParallelCollision(bool val) {
+    use_parallel = val;
+    manifolds.clear();
+
+    // The Bullet broadphase is still updated, for ray queries, but its pairs are then managed in RunParallel().
+    ((btDbvtBroadphase*)bt_broadphase)->m_deferedcollide = val;
+}
+
 void ChCollisionSystemBullet::Run() {
     if (bt_collision_world) {
-        bt_collision_world->performDiscreteCollisionDetection();
+        if (use_parallel)
+            RunParallel();
+        else
+            bt_collision_world->performDiscreteCollisionDetection();
     }
 }
 
-void ChCollisionSystemBullet::ReportContacts(ChContactContainer* mcontactcontainer) {
-    // This should remove all old contacts (or at least rewind the index)
-    mcontactcontainer->BeginAddContact();
+void ChCollisionSystemBullet::RunParallel() {
+    btCollisionDispatcherMT* dispatcher = static_cast<btCollisionDispatcherMT*>(bt_dispatcher);
+    btOverlappingPairCache* pair_cache = bt_broadphase->getOverlappingPairCache();
+    btCollisionObjectArray& objects = bt_collision_world->getCollisionObjectArray();
+    int nobjects = objects.size();
+    int nthreads = num_threads;
+
+    {
+        CH_PROFILE("Broad-phase");
+
+        // Bounding boxes of the collision objects (as in btCollisionWorld::updateAabbs, objects with huge
+        // bounding boxes are excluded). The companion id of each object is set to its index.
+        boxes.resize(nobjects);
+        object_mode.resize(nobjects);
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+        for (int i = 0; i < nobjects; i++) {
+            btCollisionObject* obj = objects[i];
+            btBroadphaseProxy* proxy = obj->getBroadphaseHandle();
+            obj->setCompanionId(i);
+
+            btVector3 bmin, bmax;
+            obj->getCollisionShape()->getAabb(obj->getWorldTransform(), bmin, bmax);
+            ChBroadphaseGrid::Box& box = boxes[i];
+            box.min.Set(bmin.x(), bmin.y(), bmin.z());
+            box.max.Set(bmax.x(), bmax.y(), bmax.z());
+            box.group = proxy ? proxy->m_collisionFilterGroup : 0;
+            box.mask = proxy ? proxy->m_collisionFilterMask : 0;
+            box.active = proxy && (obj->isStaticObject() || (bmax - bmin).length2() < btScalar(1e12));
+            object_mode[i] = GetNarrowphaseMode(obj->getCollisionShape());
+        }
 
-    // NOTE: Bullet does not provide information on radius of curvature at a contact point.
-    // As such, for all Bullet-identified contacts, the default value will be used (SMC only). 
-    ChCollisionInfo icontact;
+        // Update of the Bullet broadphase tree, used by the ray queries.
+        for (int i = 0; i < nobjects; i++) {
+            if (boxes[i].active) {
+                const ChBroadphaseGrid::Box& box = boxes[i];
+                bt_broadphase->setAabb(objects[i]->getBroadphaseHandle(),
+                                       btVector3((btScalar)box.min.x(), (btScalar)box.min.y(), (btScalar)box.min.z()),
+                                       btVector3((btScalar)box.max.x(), (btScalar)box.max.y(), (btScalar)box.max.z()),
+                                       dispatcher);
+            } else if (!objects[i]->isStaticObject()) {
+                objects[i]->setActivationState(DISABLE_SIMULATION);
+            }
+        }
 
-    int numManifolds = bt_collision_world->getDispatcher()->getNumManifolds();
-    for (int i = 0; i < numManifolds; i++) {
-        btPersistentManifold* contactManifold = bt_collision_world->getDispatcher()->getManifoldByIndexInternal(i);
-        btCollisionObject* obA = static_cast<btCollisionObject*>(contactManifold->getBody0());
-        btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
-        contactManifold->refreshContactPoints(obA->getWorldTransform(), obB->getWorldTransform());
+        // Overlapping pairs, sorted by object indices.
+        grid.SetNumThreads(nthreads);
+        grid.FindPairs(boxes, pairs);
+        int npairs = (int)pairs.size();
+
+        // Find the pairs of the Bullet pair cache that are still overlapping (these keep their persistent
+        // collision algorithms and contact manifolds).
+        btBroadphasePairArray& cached = pair_cache->getOverlappingPairArray();
+        int ncached = cached.size();
+        pair_cached.assign(npairs, 0);
+        cached_pair_kept.resize(ncached);
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+        for (int k = 0; k < ncached; k++) {
+            int i0 = static_cast<btCollisionObject*>(cached[k].m_pProxy0->m_clientObject)->getCompanionId();
+            int i1 = static_cast<btCollisionObject*>(cached[k].m_pProxy1->m_clientObject)->getCompanionId();
+            std::pair<int, int> key(std::min(i0, i1), std::max(i0, i1));
+            auto it = std::lower_bound(pairs.begin(), pairs.end(), key);
+            bool kept = (it != pairs.end() && *it == key);
+            cached_pair_kept[k] = kept;
+            if (kept)
+                pair_cached[it - pairs.begin()] = 1;
+        }
 
-        icontact.modelA = (ChCollisionModel*)obA->getUserPointer();
-        icontact.modelB = (ChCollisionModel*)obB->getUserPointer();
+        // Remove the pairs that are no longer overlapping (this deletes their collision algorithms), then add
+        // the new pairs.
+        narrow_pairs.clear();
+        for (int k = 0; k < ncached; k++) {
+            if (!cached_pair_kept[k])
+                narrow_pairs.push_back(&cached[k]);
+        }
+        for (int k = (int)narrow_pairs.size() - 1; k >= 0; k--) {
+            // removal swaps the last pair into the removed slot, so proceed from the end of the array
+            btBroadphasePair* pair = narrow_pairs[k];
+            pair_cache->removeOverlappingPair(pair->m_pProxy0, pair->m_pProxy1, dispatcher);
+        }
+        for (int k = 0; k < npairs; k++) {
+            if (!pair_cached[k])
+                pair_cache->addOverlappingPair(objects[pairs[k].first]->getBroadphaseHandle(),
+                                               objects[pairs[k].second]->getBroadphaseHandle());
+        }
+    }
+
+    {
+        CH_PROFILE("Narrow-phase");
+
+        // Group the pairs in tasks: pairs with an exclusive object are processed in a single task per object,
+        // the other pairs in a task each.
+        btBroadphasePairArray& cached = pair_cache->getOverlappingPairArray();
+        int ncached = cached.size();
+        std::vector<std::pair<int, int>> exclusive_pairs;
+        std::vector<btBroadphasePair*> serial_pairs;
+        narrow_pairs.clear();
+        narrow_tasks.clear();
+        for (int k = 0; k < ncached; k++) {
+            int i0 = static_cast<btCollisionObject*>(cached[k].m_pProxy0->m_clientObject)->getCompanionId();
+            int i1 = static_cast<btCollisionObject*>(cached[k].m_pProxy1->m_clientObject)->getCompanionId();
+            char mode0 = object_mode[i0];
+            char mode1 = object_mode[i1];
+            if (mode0 == NARROWPHASE_SERIAL || mode1 == NARROWPHASE_SERIAL ||
+                (mode0 == NARROWPHASE_EXCLUSIVE && mode1 == NARROWPHASE_EXCLUSIVE))
+                serial_pairs.push_back(&cached[k]);
+            else if (mode0 == NARROWPHASE_EXCLUSIVE)
+                exclusive_pairs.push_back(std::make_pair(i0, k));
+            else if (mode1 == NARROWPHASE_EXCLUSIVE)
+                exclusive_pairs.push_back(std::make_pair(i1, k));
+        }
+        std::sort(exclusive_pairs.begin(), exclusive_pairs.end());
+        for (size_t j = 0; j < exclusive_pairs.size(); j++) {
+            if (j == 0 || exclusive_pairs[j].first != exclusive_pairs[j - 1].first)
+                narrow_tasks.push_back((int)narrow_pairs.size());
+            narrow_pairs.push_back(&cached[exclusive_pairs[j].second]);
+        }
+        for (int k = 0; k < ncached; k++) {
+            int i0 = static_cast<btCollisionObject*>(cached[k].m_pProxy0->m_clientObject)->getCompanionId();
+            int i1 = static_cast<btCollisionObject*>(cached[k].m_pProxy1->m_clientObject)->getCompanionId();
+            if (object_mode[i0] == NARROWPHASE_SHARED && object_mode[i1] == NARROWPHASE_SHARED) {
+                narrow_tasks.push_back((int)narrow_pairs.size());
+                narrow_pairs.push_back(&cached[k]);
+            }
+        }
+        int ntasks = (int)narrow_tasks.size();
+        narrow_tasks.push_back((int)narrow_pairs.size());
+
+        btNearCallback near_callback = dispatcher->getNearCallback();
+        btDispatcherInfo& dispatch_info = bt_collision_world->getDispatchInfo();
+
+        dispatcher->setLocking(nthreads > 1);
+#pragma omp parallel for schedule(dynamic, 16) num_threads(nthreads) if (nthreads > 1)
+        for (int t = 0; t < ntasks; t++) {
+            for (int k = narrow_tasks[t]; k < narrow_tasks[t + 1]; k++)
+                near_callback(*narrow_pairs[k], *dispatcher, dispatch_info);
+        }
+        dispatcher->setLocking(false);
+
+        for (size_t k = 0; k < serial_pairs.size(); k++)
+            near_callback(*serial_pairs[k], *dispatcher, dispatch_info);
+
+        // Contact manifolds in the order of the pair cache, which does not depend on the number of threads
+        // (unlike the order of the manifolds in the dispatcher). If some collision algorithm does not expose
+        // its manifolds, fall back to the dispatcher order.
+        manifolds.resize(0);
+        for (int k = 0; k < ncached; k++) {
+            if (cached[k].m_algorithm)
+                cached[k].m_algorithm->getAllContactManifolds(manifolds);
+        }
+        if (manifolds.size() != dispatcher->getNumManifolds()) {
+            manifolds.resize(0);
+            for (int i = 0; i < dispatcher->getNumManifolds(); i++)
+                manifolds.push_back(dispatcher->getManifoldByIndexInternal(i));
+        }
+    }
+}
+
+void ChCollisionSystemBullet::ReportContacts(ChContactContainer* mcontactcontainer) {
+    // Contact manifolds: in the order set by RunParallel(), if available, otherwise in the dispatcher order.
+    btDispatcher* dispatcher = bt_collision_world->getDispatcher();
+    int numManifolds = dispatcher->getNumManifolds();
+    if (!use_parallel || manifolds.size() != numManifolds) {
+        manifolds.resize(0);
+        for (int i = 0; i < numManifolds; i++)
+            manifolds.push_back(dispatcher->getManifoldByIndexInternal(i));
+    }
 
-        double envelopeA = icontact.modelA->GetEnvelope();
-        double envelopeB = icontact.modelB->GetEnvelope();
+    // Collect the contacts in a contiguous batch. This is done in parallel if the multithreaded collision
+    // detection is enabled and there are no user callbacks (which are not assumed to be thread-safe).
+    int nthreads = (use_parallel && !broad_callback && !narrow_callback) ? num_threads : 1;
+    manifold_contacts.resize(numManifolds + 1);
+    manifold_contacts[0] = 0;
 
-        double marginA = icontact.modelA->GetSafeMargin();
-        double marginB = icontact.modelB->GetSafeMargin();
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < numManifolds; i++)
+        manifold_contacts[i + 1] = CountManifoldContacts(manifolds[i]);
 
-        // Execute custom broadphase callback, if any
-        bool do_narrow_contactgeneration = true;
-        if (this->broad_callback)
-            do_narrow_contactgeneration = this->broad_callback->OnBroadphase(icontact.modelA, icontact.modelB);
+    for (int i = 0; i < numManifolds; i++)
+        manifold_contacts[i + 1] += manifold_contacts[i];
+    contact_batch.resize(manifold_contacts[numManifolds]);
 
-        if (do_narrow_contactgeneration) {
-            int numContacts = contactManifold->getNumContacts();
-            //GetLog() << "numContacts=" << numContacts << "\n";
-            for (int j = 0; j < numContacts; j++) {
-                btManifoldPoint& pt = contactManifold->getContactPoint(j);
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < numManifolds; i++)
+        FillManifoldContacts(manifolds[i], contact_batch.data() + manifold_contacts[i],
+                             manifold_contacts[i + 1] - manifold_contacts[i]);
 
-                // Discard "too far" constraints (the Bullet engine also has its threshold)
-                if (pt.getDistance() < marginA + marginB) {
-                    btVector3 ptA = pt.getPositionWorldOnA();
-                    btVector3 ptB = pt.getPositionWorldOnB();
+    // Pass all the contacts to the container at once.
+    mcontactcontainer->BeginAddContact();
+    mcontactcontainer->AddContacts(contact_batch);
+    mcontactcontainer->EndAddContact();
+}
 
-                    icontact.vpA.Set(ptA.getX(), ptA.getY(), ptA.getZ());
-                    icontact.vpB.Set(ptB.getX(), ptB.getY(), ptB.getZ());
+int ChCollisionSystemBullet::CountManifoldContacts(btPersistentManifold* contactManifold) {
+    // The narrow phase refreshes the contact points of the manifolds it processes, i.e. those of the pairs that
+    // need collision. Refresh the others (e.g. pairs of inactive objects), as the dispatcher skipped them.
+    btCollisionObject* obA = static_cast<btCollisionObject*>(contactManifold->getBody0());
+    btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
+    if (!bt_dispatcher->needsCollision(obA, obB))
+        contactManifold->refreshContactPoints(obA->getWorldTransform(), obB->getWorldTransform());
 
-                    icontact.vN.Set(-pt.m_normalWorldOnB.getX(), -pt.m_normalWorldOnB.getY(),
-                                    -pt.m_normalWorldOnB.getZ());
-                    icontact.vN.Normalize();
+    ChCollisionModel* modelA = (ChCollisionModel*)obA->getUserPointer();
+    ChCollisionModel* modelB = (ChCollisionModel*)obB->getUserPointer();
 
-                    double ptdist = pt.getDistance();
+    // Execute custom broadphase callback, if any
+    if (this->broad_callback && !this->broad_callback->OnBroadphase(modelA, modelB))
+        return 0;
 
-                    icontact.vpA = icontact.vpA - icontact.vN * envelopeA;
-                    icontact.vpB = icontact.vpB + icontact.vN * envelopeB;
-                    icontact.distance = ptdist + envelopeA + envelopeB;
+    // Discard "too far" constraints (the Bullet engine also has its threshold)
+    double max_distance = modelA->GetSafeMargin() + modelB->GetSafeMargin();
+    int count = 0;
+    for (int j = 0; j < contactManifold->getNumContacts(); j++) {
+        if (contactManifold->getContactPoint(j).getDistance() < max_distance)
+            count++;
+    }
+    return count;
+}
 
-                    icontact.reaction_cache = pt.reactions_cache;
+void ChCollisionSystemBullet::FillManifoldContacts(btPersistentManifold* contactManifold,
+                                                   ChCollisionInfo* contacts,
+                                                   int num_contacts) {
+    if (num_contacts == 0)
+        return;
 
-                    // Execute some user custom callback, if any
-                    if (this->narrow_callback)
-                        this->narrow_callback->OnNarrowphase(icontact);
+    ChCollisionModel* modelA = (ChCollisionModel*)static_cast<btCollisionObject*>(contactManifold->getBody0())->getUserPointer();
+    ChCollisionModel* modelB = (ChCollisionModel*)static_cast<btCollisionObject*>(contactManifold->getBody1())->getUserPointer();
 
-                    // Add to contact container
-                    mcontactcontainer->AddContact(icontact);
-                }
-            }
-        }
+    double envelopeA = modelA->GetEnvelope();
+    double envelopeB = modelB->GetEnvelope();
+    double max_distance = modelA->GetSafeMargin() + modelB->GetSafeMargin();
 
-        // you can un-comment out this line, and then all points are removed
-        // contactManifold->clearManifold();
+    // NOTE: Bullet does not provide information on radius of curvature at a contact point.
+    // As such, for all Bullet-identified contacts, the default value will be used (SMC only).
+    double eff_radius = ChCollisionInfo::GetDefaultEffectiveCurvatureRadius();
+
+    int numContacts = contactManifold->getNumContacts();
+    for (int j = 0; j < numContacts; j++) {
+        btManifoldPoint& pt = contactManifold->getContactPoint(j);
+        if (!(pt.getDistance() < max_distance))
+            continue;
+
+        ChCollisionInfo& icontact = *contacts++;
+        icontact.modelA = modelA;
+        icontact.modelB = modelB;
+
+        const btVector3& ptA = pt.getPositionWorldOnA();
+        const btVector3& ptB = pt.getPositionWorldOnB();
+        icontact.vN.Set(-pt.m_normalWorldOnB.getX(), -pt.m_normalWorldOnB.getY(), -pt.m_normalWorldOnB.getZ());
+        icontact.vN.Normalize();
+        icontact.vpA.Set(ptA.getX(), ptA.getY(), ptA.getZ());
+        icontact.vpB.Set(ptB.getX(), ptB.getY(), ptB.getZ());
+        icontact.vpA -= icontact.vN * envelopeA;
+        icontact.vpB += icontact.vN * envelopeB;
+        icontact.distance = pt.getDistance() + envelopeA + envelopeB;
+        icontact.eff_radius = eff_radius;
+        icontact.reaction_cache = pt.reactions_cache;
+        icontact.shapeA = pt.m_index0;
+        icontact.shapeB = pt.m_index1;
+
+        // Execute some user custom callback, if any
+        if (this->narrow_callback)
+            this->narrow_callback->OnNarrowphase(icontact);
     }
-    mcontactcontainer->EndAddContact();
 }
 
 void ChCollisionSystemBullet::ReportProximities(ChProximityContainer* mproximitycontainer) {
@@ -1397,46 +1684,214 @@ bool ChCollisionSystemBullet::RayHit(const ChVector<>& from, const ChVector<>& t
     return false;
 }
 
-bool ChCollisionSystemBullet::RayHit(const ChVector<>& from,
-                                     const ChVector<>& to,
-                                     ChCollisionModel* model,
-                                     ChRayhitResult& mresult) const {
-    btVector3 btfrom((btScalar)from.x(), (btScalar)from.y(), (btScalar)from.z());
-    btVector3 btto((btScalar)to.x(), (btScalar)to.y(), (btScalar)to.z());
+// Ray test against a shape of a collision object. Unlike btCollisionWorld::rayTestSingle, the children of compound
+// shapes are tested without temporarily replacing the shape of the object, so that concurrent ray tests on the same
+// object are possible (the result callback does not need the child shape). GIMPACT meshes lock their parts during
+// the ray test, hence they are tested under the given mutex, if any.
+static void RayTestShape(const btTransform& rayFromTrans,
+                         const btTransform& rayToTrans,
+                         btCollisionObject* object,
+                         const btCollisionShape* shape,
+                         const btTransform& shapeTrans,
+                         btCollisionWorld::RayResultCallback& rayCallback,
+                         CHOMPmutex* gimpact_mutex) {
+    if (!shape->isCompound()) {
+        if (gimpact_mutex && shape->getShapeType() == GIMPACT_SHAPE_PROXYTYPE) {
+            gimpact_mutex->Lock();
+            btCollisionWorld::rayTestSingle(rayFromTrans, rayToTrans, object, shape, shapeTrans, rayCallback);
+            gimpact_mutex->Unlock();
+        } else {
+            btCollisionWorld::rayTestSingle(rayFromTrans, rayToTrans, object, shape, shapeTrans, rayCallback);
+        }
+        return;
+    }
 
-    btCollisionWorld::AllHitsRayResultCallback rayCallback(btfrom, btto);
+    struct ChildRayTester : btDbvt::ICollide {
+        const btTransform& rayFromTrans;
+        const btTransform& rayToTrans;
+        btCollisionObject* object;
+        const btCompoundShape* compound;
+        const btTransform& compoundTrans;
+        btCollisionWorld::RayResultCallback& rayCallback;
+        CHOMPmutex* gimpact_mutex;
+
+        ChildRayTester(const btTransform& from,
+                       const btTransform& to,
+                       btCollisionObject* obj,
+                       const btCompoundShape* comp,
+                       const btTransform& trans,
+                       btCollisionWorld::RayResultCallback& callback,
+                       CHOMPmutex* mutex)
+            : rayFromTrans(from),
+              rayToTrans(to),
+              object(obj),
+              compound(comp),
+              compoundTrans(trans),
+              rayCallback(callback),
+              gimpact_mutex(mutex) {}
+
+        void Process(int i) {
+            RayTestShape(rayFromTrans, rayToTrans, object, compound->getChildShape(i),
+                         compoundTrans * compound->getChildTransform(i), rayCallback, gimpact_mutex);
+        }
+        void Process(const btDbvtNode* leaf) override { Process(leaf->dataAsInt); }
+    };
 
-    this->bt_collision_world->rayTest(btfrom, btto, rayCallback);
+    const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+    ChildRayTester tester(rayFromTrans, rayToTrans, object, compound, shapeTrans, rayCallback, gimpact_mutex);
+    const btDbvt* dbvt = compound->getDynamicAabbTree();
+    if (dbvt) {
+        btVector3 localFrom = shapeTrans.invXform(rayFromTrans.getOrigin());
+        btVector3 localTo = shapeTrans.invXform(rayToTrans.getOrigin());
+        btDbvt::rayTest(dbvt->m_root, localFrom, localTo, tester);
+    } else {
+        for (int i = 0; i < compound->getNumChildShapes(); i++)
+            tester.Process(i);
+    }
+}
 
-    // Find the closest hit result on the specified model (if any)
-    int hit = -1;
-    btScalar fraction = 1;
-    for (int i = 0; i < rayCallback.m_collisionObjects.size(); ++i) {
-        if (rayCallback.m_collisionObjects[i]->getUserPointer() == model && rayCallback.m_hitFractions[i] < fraction) {
-            hit = i;
-            fraction = rayCallback.m_hitFractions[i];
+// Broadphase callback for ray tests with the whole collision world (as in btCollisionWorld::rayTest), with the
+// objects tested by RayTestShape.
+struct RayTestBroadphaseCallback : public btBroadphaseRayCallback {
+    btTransform rayFromTrans;
+    btTransform rayToTrans;
+    btCollisionWorld::RayResultCallback& rayCallback;
+    CHOMPmutex* gimpact_mutex;
+
+    RayTestBroadphaseCallback(const btVector3& rayFrom,
+                              const btVector3& rayTo,
+                              btCollisionWorld::RayResultCallback& callback,
+                              CHOMPmutex* mutex)
+        : rayCallback(callback), gimpact_mutex(mutex) {
+        rayFromTrans.setIdentity();
+        rayFromTrans.setOrigin(rayFrom);
+        rayToTrans.setIdentity();
+        rayToTrans.setOrigin(rayTo);
+
+        btVector3 rayDir = (rayTo - rayFrom).normalized();
+        for (int k = 0; k < 3; k++) {
+            m_rayDirectionInverse[k] = rayDir[k] == btScalar(0.0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1.0) / rayDir[k];
+            m_signs[k] = m_rayDirectionInverse[k] < 0.0;
         }
+        m_lambda_max = rayDir.dot(rayTo - rayFrom);
     }
 
+    virtual bool process(const btBroadphaseProxy* proxy) override {
+        // terminate further ray tests, once the closest hit fraction reached zero
+        if (rayCallback.m_closestHitFraction == btScalar(0.f))
+            return false;
+
+        btCollisionObject* object = (btCollisionObject*)proxy->m_clientObject;
+        if (rayCallback.needsCollision(object->getBroadphaseHandle()))
+            RayTestShape(rayFromTrans, rayToTrans, object, object->getCollisionShape(), object->getWorldTransform(),
+                         rayCallback, gimpact_mutex);
+        return true;
+    }
+};
+
+// Ray test against a single collision object, using the same filter as btCollisionWorld::rayTest.
+static bool RayHitObject(const ChVector<>& from,
+                         const ChVector<>& to,
+                         btCollisionObject* object,
+                         ChCollisionSystem::ChRayhitResult& mresult,
+                         CHOMPmutex* gimpact_mutex) {
+    mresult.hit = false;
+
+    // The object must be in the collision world (as in a ray test against the whole world)
+    if (!object || !object->getBroadphaseHandle() || !object->getCollisionShape())
+        return false;
+
+    btVector3 btfrom((btScalar)from.x(), (btScalar)from.y(), (btScalar)from.z());
+    btVector3 btto((btScalar)to.x(), (btScalar)to.y(), (btScalar)to.z());
+
+    btCollisionWorld::ClosestRayResultCallback rayCallback(btfrom, btto);
+    if (!rayCallback.needsCollision(object->getBroadphaseHandle()))
+        return false;
+
+    btTransform rayFromTrans;
+    btTransform rayToTrans;
+    rayFromTrans.setIdentity();
+    rayFromTrans.setOrigin(btfrom);
+    rayToTrans.setIdentity();
+    rayToTrans.setOrigin(btto);
+    RayTestShape(rayFromTrans, rayToTrans, object, object->getCollisionShape(), object->getWorldTransform(),
+                 rayCallback, gimpact_mutex);
+
     // Ray does not hit specified model
-    if (hit == -1) {
-        mresult.hit = false;
+    if (!rayCallback.hasHit())
         return false;
-    }
 
-    // Return the closest hit on the specified model
     mresult.hit = true;
-    mresult.hitModel = static_cast<ChCollisionModel*>(rayCallback.m_collisionObjects[hit]->getUserPointer());
-    mresult.abs_hitPoint.Set(rayCallback.m_hitPointWorld[hit].x(), rayCallback.m_hitPointWorld[hit].y(),
-                             rayCallback.m_hitPointWorld[hit].z());
-    mresult.abs_hitNormal.Set(rayCallback.m_hitNormalWorld[hit].x(), rayCallback.m_hitNormalWorld[hit].y(),
-                              rayCallback.m_hitNormalWorld[hit].z());
+    mresult.hitModel = static_cast<ChCollisionModel*>(object->getUserPointer());
+    mresult.abs_hitPoint.Set(rayCallback.m_hitPointWorld.x(), rayCallback.m_hitPointWorld.y(),
+                             rayCallback.m_hitPointWorld.z());
+    mresult.abs_hitNormal.Set(rayCallback.m_hitNormalWorld.x(), rayCallback.m_hitNormalWorld.y(),
+                              rayCallback.m_hitNormalWorld.z());
     mresult.abs_hitNormal.Normalize();
-    mresult.dist_factor = fraction;
+    mresult.dist_factor = rayCallback.m_closestHitFraction;
     mresult.abs_hitPoint = mresult.abs_hitPoint - mresult.abs_hitNormal * mresult.hitModel->GetEnvelope();
     return true;
 }
 
+void ChCollisionSystemBullet::RayHits(const std::vector<ChVector<>>& from,
+                                      const std::vector<ChVector<>>& to,
+                                      std::vector<ChRayhitResult>& results) const {
+    int nrays = (int)from.size();
+    results.resize(nrays);
+
+    int nthreads = use_parallel ? num_threads : 1;
+    CHOMPmutex gimpact_mutex;
+
+#pragma omp parallel for schedule(dynamic, 64) num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < nrays; i++) {
+        ChRayhitResult& mresult = results[i];
+        btVector3 btfrom((btScalar)from[i].x(), (btScalar)from[i].y(), (btScalar)from[i].z());
+        btVector3 btto((btScalar)to[i].x(), (btScalar)to[i].y(), (btScalar)to[i].z());
+
+        btCollisionWorld::ClosestRayResultCallback rayCallback(btfrom, btto);
+        RayTestBroadphaseCallback broadphaseCallback(btfrom, btto, rayCallback, &gimpact_mutex);
+        bt_broadphase->rayTest(btfrom, btto, broadphaseCallback);
+
+        mresult.hit = false;
+        if (!rayCallback.hasHit())
+            continue;
+        mresult.hitModel = (ChCollisionModel*)(rayCallback.m_collisionObject->getUserPointer());
+        if (!mresult.hitModel)
+            continue;
+        mresult.hit = true;
+        mresult.abs_hitPoint.Set(rayCallback.m_hitPointWorld.x(), rayCallback.m_hitPointWorld.y(),
+                                 rayCallback.m_hitPointWorld.z());
+        mresult.abs_hitNormal.Set(rayCallback.m_hitNormalWorld.x(), rayCallback.m_hitNormalWorld.y(),
+                                  rayCallback.m_hitNormalWorld.z());
+        mresult.abs_hitNormal.Normalize();
+        mresult.dist_factor = rayCallback.m_closestHitFraction;
+        mresult.abs_hitPoint = mresult.abs_hitPoint - mresult.abs_hitNormal * mresult.hitModel->GetEnvelope();
+    }
+}
+
+bool ChCollisionSystemBullet::RayHit(const ChVector<>& from,
+                                     const ChVector<>& to,
+                                     ChCollisionModel* model,
+                                     ChRayhitResult& mresult) const {
+    return RayHitObject(from, to, static_cast<ChModelBullet*>(model)->GetBulletModel(), mresult, nullptr);
+}
+
+void ChCollisionSystemBullet::RayHits(const std::vector<ChVector<>>& from,
+                                      const std::vector<ChVector<>>& to,
+                                      ChCollisionModel* model,
+                                      std::vector<ChRayhitResult>& results) const {
+    btCollisionObject* object = static_cast<ChModelBullet*>(model)->GetBulletModel();
+    int nrays = (int)from.size();
+    results.resize(nrays);
+
+    int nthreads = use_parallel ? num_threads : 1;
+    CHOMPmutex gimpact_mutex;
+
+#pragma omp parallel for schedule(dynamic, 64) num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < nrays; i++)
+        RayHitObject(from[i], to[i], object, results[i], &gimpact_mutex);
+}
+
 void ChCollisionSystemBullet::SetContactBreakingThreshold(double threshold) {
     gContactBreakingThreshold = (btScalar)threshold;
 }
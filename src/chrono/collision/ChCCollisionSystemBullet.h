@@ -15,6 +15,10 @@
 #ifndef CHC_COLLISIONSYSTEMBULLET_H
 #define CHC_COLLISIONSYSTEMBULLET_H
 
+#include <utility>
+#include <vector>
+
+#include "chrono/collision/ChCBroadphaseGrid.h"
 #include "chrono/collision/ChCCollisionSystem.h"
 #include "chrono/collision/bullet/btBulletCollisionCommon.h"
 #include "chrono/core/ChApiCE.h"
@@ -53,13 +57,31 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     /// (Contacts will be managed by the Bullet persistent contact cache).
     virtual void Run() override;
 
+    /// Set the number of threads used by the multithreaded collision detection (see SetUseParallelCollision).
+    /// ChSystem sets this to its number of parallel threads.
+    virtual void SetNumThreads(int nthreads) override;
+
+    /// Enable/disable the multithreaded collision detection (default: false).
+    /// If enabled, Run() computes the bounding boxes of the models in parallel, finds the overlapping pairs with a
+    /// multithreaded uniform grid broadphase (ChBroadphaseGrid) and runs the narrow phase on the pairs in parallel;
+    /// pairs that involve models with compound or concave (mesh) shapes are processed one model at a time, since
+    /// the Bullet algorithms temporarily modify such models, and pairs with GIMPACT meshes are processed
+    /// sequentially. Contacts are reported in an order that does not depend on the number of threads.
+    /// Call this before starting the simulation.
+    void SetUseParallelCollision(bool val);
+
+    /// Return true if the multithreaded collision detection is enabled.
+    bool GetUseParallelCollision() const { return use_parallel; }
+
     /// After the Run() has completed, you can call this function to
     /// fill a 'contact container', that is an object inherited from class
     /// ChContactContainer. For instance ChSystem, after each Run()
     /// collision detection, calls this method multiple times for all contact containers in the system,
     /// The basic behavior of the implementation is the following: collision system
-    /// will call in sequence the functions BeginAddContact(), AddContact() (x n times),
-    /// EndAddContact() of the contact container.
+    /// will call in sequence the functions BeginAddContact(), AddContacts() (with all the
+    /// contacts in a single batch), EndAddContact() of the contact container.
+    /// The contact points are those computed by the last Run(): only the manifolds skipped by the narrow phase
+    /// (pairs that do not need collision) are refreshed.
     virtual void ReportContacts(ChContactContainer* mcontactcontainer) override;
 
     /// After the Run() has completed, you can call this function to
@@ -75,11 +97,27 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     virtual bool RayHit(const ChVector<>& from, const ChVector<>& to, ChRayhitResult& mresult) const override;
 
     /// Perform a ray-hit test with the specified collision model.
+    /// Only the shapes of that model are tested (through their bounding volume hierarchy, for meshes and
+    /// compound shapes), regardless of the other models in the collision world.
     virtual bool RayHit(const ChVector<>& from,
                         const ChVector<>& to,
                         ChCollisionModel* model,
                         ChRayhitResult& mresult) const override;
 
+    /// Perform ray-hit tests of a set of rays (from[i], to[i]) with all collision models.
+    /// Each ray traverses the broadphase tree; if the multithreaded collision detection is enabled, the rays are
+    /// processed in parallel (ray tests with GIMPACT meshes, which are not reentrant, are serialized).
+    virtual void RayHits(const std::vector<ChVector<>>& from,
+                         const std::vector<ChVector<>>& to,
+                         std::vector<ChRayhitResult>& results) const override;
+
+    /// Perform ray-hit tests of a set of rays (from[i], to[i]) with the specified collision model.
+    /// If the multithreaded collision detection is enabled, the rays are processed in parallel.
+    virtual void RayHits(const std::vector<ChVector<>>& from,
+                         const std::vector<ChVector<>>& to,
+                         ChCollisionModel* model,
+                         std::vector<ChRayhitResult>& results) const override;
+
     // For Bullet related stuff
     btCollisionWorld* GetBulletCollisionWorld() { return bt_collision_world; }
 
@@ -89,10 +127,37 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     static void SetContactBreakingThreshold(double threshold);
 
   private:
+    /// Multithreaded collision detection.
+    void RunParallel();
+
+    /// Return the number of contacts of a contact manifold that are reported (refreshing its contact points first
+    /// if the narrow phase skipped it).
+    int CountManifoldContacts(btPersistentManifold* manifold);
+
+    /// Write the reported contacts of a contact manifold (as counted by CountManifoldContacts) in the given array.
+    void FillManifoldContacts(btPersistentManifold* manifold, ChCollisionInfo* contacts, int num_contacts);
+
     btCollisionConfiguration* bt_collision_configuration;
     btCollisionDispatcher* bt_dispatcher;
     btBroadphaseInterface* bt_broadphase;
     btCollisionWorld* bt_collision_world;
+
+    bool use_parallel;  ///< multithreaded collision detection
+    int num_threads;    ///< number of threads of the multithreaded collision detection
+
+    // Data of the multithreaded collision detection, kept between calls to avoid reallocations.
+    ChBroadphaseGrid grid;                        ///< broadphase
+    std::vector<ChBroadphaseGrid::Box> boxes;     ///< bounding boxes of the collision objects
+    std::vector<char> object_mode;                ///< how the narrow phase can process the pairs of each object
+    std::vector<std::pair<int, int>> pairs;       ///< overlapping pairs (object indices)
+    std::vector<char> pair_cached;                ///< pairs already in the Bullet pair cache
+    std::vector<char> cached_pair_kept;           ///< pairs of the Bullet pair cache that are still overlapping
+    std::vector<int> narrow_tasks;                ///< narrow phase tasks (start of the pairs of each task)
+    std::vector<btBroadphasePair*> narrow_pairs;  ///< pairs of the Bullet pair cache, by narrow phase task
+    btManifoldArray manifolds;                    ///< contact manifolds, in the order of the pairs
+
+    std::vector<int> manifold_contacts;         ///< start of the contacts of each manifold in the batch
+    std::vector<ChCollisionInfo> contact_batch;  ///< contacts passed to the contact container
 };
 
 }  // end namespace collision
@@ -47,12 +47,11 @@ btManifoldResult::btManifoldResult(btCollisionObject* body0,btCollisionObject* b
 		:m_manifoldPtr(0),
 		m_body0(body0),
 		m_body1(body1)
-#ifdef DEBUG_PART_INDEX
+		//***ALEX*** always initialize the shape identifiers, they are reported to ChCollisionInfo
 		,m_partId0(-1),
 	m_partId1(-1),
 	m_index0(-1),
 	m_index1(-1)
-#endif //DEBUG_PART_INDEX
 {
 	m_rootTransA = body0->getWorldTransform();
 	m_rootTransB = body1->getWorldTransform();
@@ -53,13 +53,11 @@ protected:
 public:
 
 	btManifoldResult()
-#ifdef DEBUG_PART_INDEX
-		:
+		: //***ALEX*** always initialize the shape identifiers, they are reported to ChCollisionInfo
 	m_partId0(-1),
 	m_partId1(-1),
 	m_index0(-1),
 	m_index1(-1)
-#endif //DEBUG_PART_INDEX
 	{
 	}
 
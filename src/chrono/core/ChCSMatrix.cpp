@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include <algorithm>
+#include <atomic>
 
 #include "chrono/core/ChCSMatrix.h"
 #include "chrono/core/ChMapMatrix.h"
@@ -33,6 +34,21 @@ void ChCSMatrix::SetElement(int row_sel, int col_sel, double insval, bool overwr
     auto lead_sel = row_major_format ? row_sel : col_sel;
     auto trail_sel = row_major_format ? col_sel : row_sel;
 
+    // replay the scatter map: the element is expected in the recorded slot
+    if (m_scatter_mode == ScatterMapMode::REPLAY) {
+        if (m_scatter_cursor < static_cast<int>(m_scatter_map.size())) {
+            int trail_i = m_scatter_map[m_scatter_cursor];
+            if (trail_i >= leadIndex[lead_sel] && trail_i < leadIndex[lead_sel + 1] &&
+                trailIndex[trail_i] == trail_sel) {
+                ++m_scatter_cursor;
+                (overwrite) ? values[trail_i] = insval : values[trail_i] += insval;
+                return;
+            }
+        }
+        // the sequence of calls differs from the recorded one
+        invalidate_scatter_map();
+    }
+
     if (insval == 0 && !m_lock)
         return;
 
@@ -45,6 +61,8 @@ void ChCSMatrix::SetElement(int row_sel, int col_sel, double insval, bool overwr
             initialized_element[trail_i] = true;
             trailIndex[trail_i] = trail_sel;
             values[trail_i] = insval;
+            if (m_scatter_mode == ScatterMapMode::RECORD)
+                invalidate_scatter_map();
             return;
         }
 
@@ -59,6 +77,8 @@ void ChCSMatrix::SetElement(int row_sel, int col_sel, double insval, bool overwr
         // the requested element already exists
         if (trailIndex[trail_i] == trail_sel) {
             (overwrite) ? values[trail_i] = insval : values[trail_i] += insval;
+            if (m_scatter_mode == ScatterMapMode::RECORD)
+                m_scatter_map.push_back(trail_i);
             return;
         }
     }
@@ -84,6 +104,18 @@ double ChCSMatrix::GetElement(int row_sel, int col_sel) const {
     return 0.0;
 }
 
+int ChCSMatrix::GetElementSlot(int row_sel, int col_sel) const {
+    auto lead_sel = row_major_format ? row_sel : col_sel;
+    auto trail_sel = row_major_format ? col_sel : row_sel;
+
+    for (auto trail_i = leadIndex[lead_sel]; trail_i < leadIndex[lead_sel + 1]; ++trail_i) {
+        if (trailIndex[trail_i] == trail_sel && initialized_element[trail_i])
+            return trail_i;
+    }
+
+    return -1;
+}
+
 double& ChCSMatrix::Element(int row_sel, int col_sel) {
     auto lead_sel = row_major_format ? row_sel : col_sel;
     auto trail_sel = row_major_format ? col_sel : row_sel;
@@ -129,6 +161,10 @@ void ChCSMatrix::Reset(int nrows, int ncols, int nonzeros_hint) {
     if (nonzeros_hint == 0 && lead_dim_new == *leading_dimension && trail_dim_new == *trailing_dimension && m_lock &&
         lead_dim_new != 0 && trail_dim_new != 0) {
         std::fill(values.begin(), values.begin() + leadIndex[*leading_dimension] - 1, 0);
+        // rewind the scatter map
+        m_scatter_cursor = 0;
+        if (m_scatter_mode == ScatterMapMode::RECORD)
+            m_scatter_map.clear();
     } else {
         if (nonzeros_hint == 0)
             nonzeros_hint = GetTrailingIndexLength();
@@ -161,6 +197,7 @@ bool ChCSMatrix::Compress() {
     if (isCompressed)
         return false;
 
+    new_layout_stamp();
     int trail_i_dest = 0;
     int trail_i = 0;
     for (auto lead_i = 0; lead_i < *leading_dimension; ++lead_i) {
@@ -188,6 +225,7 @@ int ChCSMatrix::Inflate(int storage_augm, int lead_sel, int trail_sel) {
     assert(trail_sel >= 0 && trail_sel <= leadIndex[*leading_dimension] &&
            "Cannot inflate the values and trail-dimension index array in the given position");
 
+    new_layout_stamp();
     auto new_size = trailIndex.size() + storage_augm;
     if (new_size >= trailIndex.capacity())  // the space required does NOT fit into the current array capacity
     {
@@ -233,6 +271,8 @@ void ChCSMatrix::Trim() {
 }
 
 void ChCSMatrix::Prune(double pruning_threshold) {
+    invalidate_scatter_map();
+    new_layout_stamp();
     int trail_i_dest = 0;
     for (auto lead_i = 0; lead_i < *leading_dimension; ++lead_i) {
         for (auto trail_i = leadIndex[lead_i]; trail_i < leadIndex[lead_i + 1]; ++trail_i) {
@@ -249,6 +289,42 @@ void ChCSMatrix::Prune(double pruning_threshold) {
     isCompressed = true;
 }
 
+void ChCSMatrix::BeginScatterMap() {
+    m_scatter_cursor = 0;
+
+    // the positions of the elements are stable only if the matrix is compressed and cannot lose its pattern
+    if (!m_lock || !isCompressed) {
+        invalidate_scatter_map();
+        return;
+    }
+
+    if (m_scatter_valid) {
+        m_scatter_mode = ScatterMapMode::REPLAY;
+    } else {
+        m_scatter_map.clear();
+        m_scatter_map.reserve(GetTrailingIndexLength());
+        m_scatter_mode = ScatterMapMode::RECORD;
+    }
+}
+
+bool ChCSMatrix::EndScatterMap() {
+    bool success = false;
+    switch (m_scatter_mode) {
+        case ScatterMapMode::REPLAY:
+            success = (m_scatter_cursor == static_cast<int>(m_scatter_map.size()));
+            m_scatter_valid = success;
+            break;
+        case ScatterMapMode::RECORD:
+            success = true;
+            m_scatter_valid = true;
+            break;
+        default:
+            break;
+    }
+    m_scatter_mode = ScatterMapMode::OFF;
+    return success;
+}
+
 int ChCSMatrix::VerifyMatrix() const {
     bool uninitialized_elements_found = false;
     for (int lead_sel = 0; lead_sel < *leading_dimension; lead_sel++) {
@@ -375,6 +451,14 @@ void ChCSMatrix::LoadSparsityPattern(ChSparsityPatternLearner& sparsity_learner)
     initialized_element.assign(nnz, true);
     m_lock_broken = false;
     isCompressed = true;
+    invalidate_scatter_map();
+    new_layout_stamp();
+}
+
+void ChCSMatrix::new_layout_stamp() {
+    // stamps are unique across all matrices, so that a stamp also identifies the matrix it belongs to
+    static std::atomic<unsigned int> last_stamp(0);
+    m_layout_stamp = ++last_stamp;
 }
 
 void ChCSMatrix::distribute_integer_range_on_vector(index_vector_t& vector, int initial_number, int final_number) {
@@ -387,6 +471,8 @@ void ChCSMatrix::distribute_integer_range_on_vector(index_vector_t& vector, int
 void ChCSMatrix::reset_arrays(int lead_dim, int trail_dim, int nonzeros) {
     // break sparsity lock
     m_lock_broken = true;
+    invalidate_scatter_map();
+    new_layout_stamp();
 
     // update dimensions (redundant if called from constructor)
     *leading_dimension = lead_dim;
@@ -413,6 +499,8 @@ void ChCSMatrix::reset_arrays(int lead_dim, int trail_dim, int nonzeros) {
 void ChCSMatrix::insert(int& trail_i_sel, const int& lead_sel) {
     isCompressed = false;
     m_lock_broken = true;
+    invalidate_scatter_map();
+    new_layout_stamp();
 
     bool OK_also_out_of_row = true;  // look for viable positions also in other rows respect to the one selected
     bool OK_also_onelement_rows = false;
@@ -606,6 +694,8 @@ ChCSMatrix& ChCSMatrix::operator=(const ChCSMatrix& mat_source) {
 
     isCompressed = mat_source.IsCompressed();
     m_lock_broken = mat_source.m_lock_broken;
+    invalidate_scatter_map();
+    new_layout_stamp();
 
     return *this;
 }
@@ -142,6 +142,16 @@ class ChApi ChCSMatrix : public ChSparseMatrix {
 
     bool m_lock_broken = false;  ///< true if a modification was made that overrules m_lock
 
+    /// Status of the scatter map during an assembly pass (see BeginScatterMap()).
+    enum class ScatterMapMode { OFF, RECORD, REPLAY };
+
+    std::vector<int> m_scatter_map;                    ///< position in #values of each SetElement() call, in order
+    int m_scatter_cursor = 0;                          ///< next entry of #m_scatter_map to be replayed
+    bool m_scatter_valid = false;                      ///< if \c true #m_scatter_map matches the current arrays
+    ScatterMapMode m_scatter_mode = ScatterMapMode::OFF;  ///< status of the current assembly pass
+
+    unsigned int m_layout_stamp = 0;  ///< incremented each time the elements may have moved in the arrays
+
   protected:
     /// (internal) The \a vector elements will contain equally spaced indexes, going from \a initial_number to \a
     /// final_number.
@@ -152,6 +162,15 @@ class ChApi ChCSMatrix : public ChSparseMatrix {
     void reset_arrays(int lead_dim, int trail_dim, int nonzeros);
 
     ChCSMatrix& apply_operator(const ChCSMatrix& mat_source, std::function<void(double&, const double&)> f);
+    /// (internal) Discard the scatter map, because the position of the elements in the arrays changed.
+    void invalidate_scatter_map() {
+        m_scatter_valid = false;
+        m_scatter_mode = ScatterMapMode::OFF;
+    }
+
+    /// (internal) Assign a new layout stamp, because the elements may have moved in the arrays.
+    void new_layout_stamp();
+
     /// (internal) Insert a non existing element in the position \a trai_i, given the row(CSR) or column(CSC) \a
     /// lead_sel
     void insert(int& trail_i, const int& lead_sel);
@@ -255,6 +274,32 @@ class ChApi ChCSMatrix : public ChSparseMatrix {
     /// in order to accommodate the sparsity pattern
     void LoadSparsityPattern(ChSparsityPatternLearner& sparsity_learner) override;
 
+    /// Start an assembly pass that exploits the \e scatter map of the matrix.\n
+    /// If the matrix is compressed and its sparsity pattern is locked, the position in the internal arrays of the
+    /// elements set by each call to SetElement() (and to the Paste functions) is recorded in the scatter map.
+    /// The following assembly passes that perform the same sequence of calls (e.g. ChSystemDescriptor::ConvertToMatrixForm()
+    /// on an unchanged system) replay the map, so that each value is stored directly in its slot, without any search.
+    /// Each call is checked against the map: at the first mismatch the replay is abandoned and the pass goes on
+    /// with the usual insertion algorithm. A partial #Reset() rewinds the map to its beginning.
+    void BeginScatterMap();
+
+    /// End an assembly pass started with BeginScatterMap().
+    /// Return \c true if the pass matched the stored sparsity pattern, i.e. no element was added to the matrix
+    /// (either because the scatter map was successfully replayed or recorded).
+    bool EndScatterMap();
+
+    /// Check if the matrix holds a scatter map that matches its current arrays.
+    bool HasScatterMap() const { return m_scatter_valid; }
+
+    /// Return the position in the value array (see GetCS_ValueArray()) of the element with index (\a row_sel,
+    /// \a col_sel), or -1 if the element is not stored.
+    int GetElementSlot(int row_sel, int col_sel) const;
+
+    /// Return a stamp of the layout of the internal arrays: it changes each time the stored elements may have changed
+    /// position (e.g. on insertion, compression or full reset), and it is never shared by two matrices.
+    /// Positions obtained with GetElementSlot() stay valid as long as the stamp does not change.
+    unsigned int GetLayoutStamp() const { return m_layout_stamp; }
+
     /// Verify if the matrix respects the Compressed Sparse Row|Column standard.\n
     ///  3 - warning message: the row (CSR) | column (CSC) is empty\n
     ///  1 - warning message: the matrix is not compressed\n
@@ -0,0 +1,74 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHDISJOINTSETS_H
+#define CHDISJOINTSETS_H
+
+#include <vector>
+
+namespace chrono {
+
+/// Disjoint-set forest (union-find) over the integers 0..n-1, with union by size and path halving.
+/// Used to compute the connected components of graphs, e.g. the simulation islands of a system
+/// (bodies connected by links and contacts) or of a system descriptor (variables coupled by constraints).
+class ChDisjointSets {
+  public:
+    ChDisjointSets(int n = 0) { Reset(n); }
+
+    /// Reset to \a n singleton sets.
+    void Reset(int n) {
+        parent.resize(n);
+        size.assign(n, 1);
+        for (int i = 0; i < n; i++)
+            parent[i] = i;
+    }
+
+    /// Return the number of elements.
+    int GetNumElements() const { return (int)parent.size(); }
+
+    /// Return the representative of the set containing element \a i.
+    int Find(int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+
+    /// Merge the sets containing elements \a i and \a j.
+    /// Return the representative of the merged set.
+    int Union(int i, int j) {
+        i = Find(i);
+        j = Find(j);
+        if (i == j)
+            return i;
+        if (size[i] < size[j]) {
+            int tmp = i;
+            i = j;
+            j = tmp;
+        }
+        parent[j] = i;
+        size[i] += size[j];
+        return i;
+    }
+
+    /// Return the number of elements in the set containing element \a i.
+    int GetSetSize(int i) { return size[Find(i)]; }
+
+  private:
+    std::vector<int> parent;
+    std::vector<int> size;
+};
+
+}  // end namespace chrono
+
+#endif
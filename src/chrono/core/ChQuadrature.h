@@ -345,6 +345,68 @@ class ChApi ChQuadrature {
     static ChQuadratureTablesTetrahedron* GetStaticTablesTetrahedron();
 };
 
+/// Points and weights of the Gauss-Legendre quadrature of given order over the 3D interval [xA, xB][yA, yB][zA, zB],
+/// with the number of points known at compile time.
+/// Points are listed in the same sequence as evaluated by ChQuadrature::Integrate3D() (x in the outer loop, z in the
+/// inner loop), and weights already include the scaling of the interval.
+/// This is meant for elements that evaluate the data depending on the reference configuration once, at the
+/// quadrature points, and then integrate with plain loops over the points, without the virtual calls and the
+/// temporaries of a ChIntegrable3D integrand.
+template <int order>
+class ChQuadraturePoints3D {
+  public:
+    static const int num_points = order * order * order;
+
+    ChQuadraturePoints3D(double Xa = -1, double Xb = 1, double Ya = -1, double Yb = 1, double Za = -1, double Zb = 1) {
+        static_assert(order >= 1 && order <= 10, "Gauss-Legendre tables are available up to the 10th order");
+        const std::vector<double>& lroots = ChQuadrature::GetStaticTables()->Lroots[order - 1];
+        const std::vector<double>& weight = ChQuadrature::GetStaticTables()->Weight[order - 1];
+        double Xc1 = (Xb - Xa) / 2;
+        double Xc2 = (Xb + Xa) / 2;
+        double Yc1 = (Yb - Ya) / 2;
+        double Yc2 = (Yb + Ya) / 2;
+        double Zc1 = (Zb - Za) / 2;
+        double Zc2 = (Zb + Za) / 2;
+        int ip = 0;
+        for (int ix = 0; ix < order; ix++)
+            for (int iy = 0; iy < order; iy++)
+                for (int iz = 0; iz < order; iz++) {
+                    x[ip] = Xc1 * lroots[ix] + Xc2;
+                    y[ip] = Yc1 * lroots[iy] + Yc2;
+                    z[ip] = Zc1 * lroots[iz] + Zc2;
+                    w[ip] = weight[ix] * weight[iy] * weight[iz] * (Xc1 * Yc1 * Zc1);
+                    ip++;
+                }
+    }
+
+    double x[num_points];  ///< x coordinates of the points
+    double y[num_points];  ///< y coordinates of the points
+    double z[num_points];  ///< z coordinates of the points
+    double w[num_points];  ///< weights, including the scaling of the interval
+};
+
+/// As ChQuadraturePoints3D, but for the Gauss-Legendre quadrature over the 1D interval [xA, xB].
+template <int order>
+class ChQuadraturePoints1D {
+  public:
+    static const int num_points = order;
+
+    ChQuadraturePoints1D(double Xa = -1, double Xb = 1) {
+        static_assert(order >= 1 && order <= 10, "Gauss-Legendre tables are available up to the 10th order");
+        const std::vector<double>& lroots = ChQuadrature::GetStaticTables()->Lroots[order - 1];
+        const std::vector<double>& weight = ChQuadrature::GetStaticTables()->Weight[order - 1];
+        double Xc1 = (Xb - Xa) / 2;
+        double Xc2 = (Xb + Xa) / 2;
+        for (int ix = 0; ix < order; ix++) {
+            x[ix] = Xc1 * lroots[ix] + Xc2;
+            w[ix] = weight[ix] * Xc1;
+        }
+    }
+
+    double x[num_points];  ///< coordinates of the points
+    double w[num_points];  ///< weights, including the scaling of the interval
+};
+
 }  // end namespace chrono
 
 #endif
@@ -21,6 +21,7 @@
 #include "chrono/physics/ChBodyAuxRef.h"
 #include "chrono/physics/ChGlobal.h"
 #include "chrono/physics/ChSystem.h"
+#include "chrono/parallel/ChOpenMP.h"
 
 namespace chrono {
 
@@ -44,7 +45,10 @@ ChAssembly::ChAssembly()
       nsysvars(0),
       nsysvars_w(0),
       nbodies_sleep(0),
-      nbodies_fixed(0) {}
+      nbodies_fixed(0),
+      nstructure_changes(0),
+      use_parallel_integrable(false),
+      parallel_integrable_min_items(1000) {}
 
 ChAssembly::ChAssembly(const ChAssembly& other) : ChPhysicsItem(other) {
     nbodies = other.nbodies;
@@ -61,6 +65,9 @@ ChAssembly::ChAssembly(const ChAssembly& other) : ChPhysicsItem(other) {
     nsysvars_w = other.nsysvars_w;
     nbodies_sleep = other.nbodies_sleep;
     nbodies_fixed = other.nbodies_fixed;
+    nstructure_changes = other.nstructure_changes;
+    use_parallel_integrable = other.use_parallel_integrable;
+    parallel_integrable_min_items = other.parallel_integrable_min_items;
 
     //// RADU
     //// TODO:  deep copy of the object lists (bodylist, linklist, otherphysicslist)
@@ -101,7 +108,10 @@ void ChAssembly::AddBody(std::shared_ptr<ChBody> newbody) {
 
     // set system and also add collision models to system
     newbody->SetSystem(this->GetSystem());
+    // a sleeping island tag is only meaningful in the system that issued it
+    newbody->SetSleepIsland(-1);
     bodylist.push_back(newbody);
+    nstructure_changes++;
 }
 
 void ChAssembly::RemoveBody(std::shared_ptr<ChBody> mbody) {
@@ -113,6 +123,7 @@ void ChAssembly::RemoveBody(std::shared_ptr<ChBody> mbody) {
 
     // nullify backward link to system and also remove from collision system
     mbody->SetSystem(0);
+    nstructure_changes++;
 }
 
 void ChAssembly::AddLink(std::shared_ptr<ChLink> newlink) {
@@ -121,6 +132,7 @@ void ChAssembly::AddLink(std::shared_ptr<ChLink> newlink) {
 
     newlink->SetSystem(this->GetSystem());
     linklist.push_back(newlink);
+    nstructure_changes++;
 }
 
 void ChAssembly::RemoveLink(std::shared_ptr<ChLink> mlink) {
@@ -132,6 +144,7 @@ void ChAssembly::RemoveLink(std::shared_ptr<ChLink> mlink) {
 
     // nullify backward link to system
     mlink->SetSystem(0);
+    nstructure_changes++;
 }
 
 void ChAssembly::AddOtherPhysicsItem(std::shared_ptr<ChPhysicsItem> newitem) {
@@ -142,6 +155,7 @@ void ChAssembly::AddOtherPhysicsItem(std::shared_ptr<ChPhysicsItem> newitem) {
     // set system and also add collision models to system
     newitem->SetSystem(this->GetSystem());
     otherphysicslist.push_back(newitem);
+    nstructure_changes++;
 }
 
 void ChAssembly::RemoveOtherPhysicsItem(std::shared_ptr<ChPhysicsItem> mitem) {
@@ -154,6 +168,7 @@ void ChAssembly::RemoveOtherPhysicsItem(std::shared_ptr<ChPhysicsItem> mitem) {
 
     // nullify backward link to system and also remove from collision system
     mitem->SetSystem(0);
+    nstructure_changes++;
 }
 
 void ChAssembly::Add(std::shared_ptr<ChPhysicsItem> newitem) {
@@ -201,6 +216,7 @@ void ChAssembly::RemoveAllBodies() {
         bodylist[ip]->SetSystem(0);
     }
     bodylist.clear();
+    nstructure_changes++;
 }
 
 void ChAssembly::RemoveAllLinks() {
@@ -209,6 +225,7 @@ void ChAssembly::RemoveAllLinks() {
         linklist[ip]->SetSystem(0);
     }
     linklist.clear();
+    nstructure_changes++;
 }
 
 void ChAssembly::RemoveAllOtherPhysicsItems() {
@@ -217,6 +234,7 @@ void ChAssembly::RemoveAllOtherPhysicsItems() {
         otherphysicslist[ip]->SetSystem(0);
     }
     otherphysicslist.clear();
+    nstructure_changes++;
 }
 
 std::shared_ptr<ChBody> ChAssembly::SearchBody(const char* m_name) {
@@ -436,6 +454,12 @@ void ChAssembly::Update(bool update_assets) {
     }
 }
 
+int ChAssembly::GetIntegrableThreads(size_t nitems) const {
+    if (!use_parallel_integrable || !system || nitems < (size_t)parallel_integrable_min_items)
+        return 1;
+    return system->GetParallelThreadNumber();
+}
+
 void ChAssembly::SetNoSpeedNoAcceleration() {
     for (int ip = 0; ip < bodylist.size(); ++ip) {
         bodylist[ip]->SetNoSpeedNoAcceleration();
@@ -456,15 +480,25 @@ void ChAssembly::IntStateGather(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+    // Each item writes only its own slice of x and v. The time returned by the single items is not
+    // needed (it is overwritten below), so each iteration uses a private copy to avoid a race on T.
+    int nthreads = GetIntegrableThreads(bodylist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        ChBody* Bpointer = bodylist[ip].get();
+        double T_item;
         if (Bpointer->IsActive())
-            Bpointer->IntStateGather(displ_x + Bpointer->GetOffset_x(), x, displ_v + Bpointer->GetOffset_w(), v, T);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        std::shared_ptr<ChLink> Lpointer = linklist[ip];
+            Bpointer->IntStateGather(displ_x + Bpointer->GetOffset_x(), x, displ_v + Bpointer->GetOffset_w(), v,
+                                     T_item);
+    }
+    nthreads = GetIntegrableThreads(linklist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        ChLink* Lpointer = linklist[ip].get();
+        double T_item;
         if (Lpointer->IsActive())
-            Lpointer->IntStateGather(displ_x + Lpointer->GetOffset_x(), x, displ_v + Lpointer->GetOffset_w(), v, T);
+            Lpointer->IntStateGather(displ_x + Lpointer->GetOffset_x(), x, displ_v + Lpointer->GetOffset_w(), v,
+                                     T_item);
     }
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
@@ -481,6 +515,8 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
+    // This is always sequential: each item calls Update(), which also updates assets (often shared between
+    // bodies), markers and forces (whose functions, e.g. ChFunction_Recorder, may keep mutable state).
     for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
         if (Bpointer->IsActive())
@@ -617,8 +653,12 @@ void ChAssembly::IntLoadResidual_F(const unsigned int off,  ///< offset in R res
 {
     unsigned int displ_v = off - this->offset_w;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+    // Bodies load forces only in their own slice of R. Links are processed sequentially
+    // because they add their forces in the slices of the connected bodies.
+    int nthreads = GetIntegrableThreads(bodylist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        ChBody* Bpointer = bodylist[ip].get();
         if (Bpointer->IsActive())
             Bpointer->IntLoadResidual_F(displ_v + Bpointer->GetOffset_w(), R, c);
     }
@@ -640,13 +680,17 @@ void ChAssembly::IntLoadResidual_Mv(const unsigned int off,      ///< offset in
 ) {
     unsigned int displ_v = off - this->offset_w;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+    int nthreads = GetIntegrableThreads(bodylist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        ChBody* Bpointer = bodylist[ip].get();
         if (Bpointer->IsActive())
             Bpointer->IntLoadResidual_Mv(displ_v + Bpointer->GetOffset_w(), R, w, c);
     }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        std::shared_ptr<ChLink> Lpointer = linklist[ip];
+    nthreads = GetIntegrableThreads(linklist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        ChLink* Lpointer = linklist[ip].get();
         if (Lpointer->IsActive())
             Lpointer->IntLoadResidual_Mv(displ_v + Lpointer->GetOffset_w(), R, w, c);
     }
@@ -663,8 +707,11 @@ void ChAssembly::IntLoadResidual_CqL(const unsigned int off_L,    ///< offset in
 ) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+    // Links are processed sequentially because Cq'*L is added in the slices of the connected bodies.
+    int nthreads = GetIntegrableThreads(bodylist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        ChBody* Bpointer = bodylist[ip].get();
         if (Bpointer->IsActive())
             Bpointer->IntLoadResidual_CqL(displ_L + Bpointer->GetOffset_L(), R, L, c);
     }
@@ -687,13 +734,18 @@ void ChAssembly::IntLoadConstraint_C(const unsigned int off_L,  ///< offset in Q
 ) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+    // Each body and link writes only its own slice of Qc.
+    int nthreads = GetIntegrableThreads(bodylist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        ChBody* Bpointer = bodylist[ip].get();
         if (Bpointer->IsActive())
             Bpointer->IntLoadConstraint_C(displ_L + Bpointer->GetOffset_L(), Qc, c, do_clamp, recovery_clamp);
     }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        std::shared_ptr<ChLink> Lpointer = linklist[ip];
+    nthreads = GetIntegrableThreads(linklist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        ChLink* Lpointer = linklist[ip].get();
         if (Lpointer->IsActive())
             Lpointer->IntLoadConstraint_C(displ_L + Lpointer->GetOffset_L(), Qc, c, do_clamp, recovery_clamp);
     }
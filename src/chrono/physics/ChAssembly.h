@@ -115,6 +115,26 @@ class ChApi ChAssembly : public ChPhysicsItem {
     /// Search a marker by its unique ID.
     std::shared_ptr<ChMarker> SearchMarker(int markID);
 
+    //
+    // PARALLEL EXECUTION
+    //
+
+    /// Enable or disable the multithreaded execution of the state gather and of the residual and
+    /// constraint loading functions (IntStateGather, IntLoadResidual_F, IntLoadResidual_Mv,
+    /// IntLoadResidual_CqL, IntLoadConstraint_C) over the lists of bodies and links. Default: disabled.
+    /// Only the loops where each item writes exclusively in its own range of the global vectors (as set
+    /// in Setup() via offset_x, offset_w, offset_L) are parallelized, so results are identical to the
+    /// sequential execution. The number of threads is the one set in ChSystem::SetParallelThreadNumber().
+    /// IntStateScatter stays sequential, since it updates the markers, forces and assets of the items.
+    void SetUseParallelIntegrable(bool mpar) { use_parallel_integrable = mpar; }
+    /// Tell if the multithreaded execution of state gather and residual loading is enabled.
+    bool GetUseParallelIntegrable() const { return use_parallel_integrable; }
+
+    /// Set the minimum number of items in a list for its loop to be executed in parallel. Default: 1000.
+    void SetParallelIntegrableMinItems(int mitems) { parallel_integrable_min_items = mitems; }
+    /// Get the minimum number of items in a list for its loop to be executed in parallel.
+    int GetParallelIntegrableMinItems() const { return parallel_integrable_min_items; }
+
     //
     // STATISTICS
     //
@@ -294,6 +314,15 @@ class ChApi ChAssembly : public ChPhysicsItem {
     int ndoc_w_D;       ///< number of scalar constraints D, when using 3 rot. dof. per body (only unilaterals)
     int nbodies_sleep;  ///< number of bodies that are sleeping
     int nbodies_fixed;  ///< number of bodies that are fixed
+
+    int nstructure_changes;  ///< number of additions/removals of items to the lists (for change detection)
+
+    bool use_parallel_integrable;       ///< use multithreaded loops in state gather and residual loading
+    int parallel_integrable_min_items;  ///< min. list size for a loop to be run in parallel
+
+    /// Number of threads to be used in a loop over a list with the given number of items
+    /// (1 if parallel execution is disabled or if the list is too short).
+    int GetIntegrableThreads(size_t nitems) const;
 };
 
 
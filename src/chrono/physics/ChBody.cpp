@@ -70,6 +70,7 @@ ChBody::ChBody(ChMaterialSurface::ContactMethod contact_method) {
     sleep_starttime = 0;
     sleep_minspeed = 0.1f;
     sleep_minwvel = 0.04f;
+    sleep_island = -1;
     SetUseSleeping(true);
 
     variables.SetUserData((void*)this);
@@ -114,6 +115,7 @@ ChBody::ChBody(std::shared_ptr<collision::ChCollisionModel> new_collision_model,
     sleep_starttime = 0;
     sleep_minspeed = 0.1f;
     sleep_minwvel = 0.04f;
+    sleep_island = -1;
     SetUseSleeping(true);
 
     variables.SetUserData((void*)this);
@@ -153,6 +155,7 @@ ChBody::ChBody(const ChBody& other) : ChPhysicsItem(other), ChBodyFrame(other) {
     sleep_starttime = other.sleep_starttime;
     sleep_minspeed = other.sleep_minspeed;
     sleep_minwvel = other.sleep_minwvel;
+    sleep_island = -1;
 }
 
 ChBody::~ChBody() {
@@ -771,6 +774,11 @@ bool ChBody::GetUseSleeping() const {
 }
 
 void ChBody::SetSleeping(bool state) {
+    // when woken up, the body must stay at rest for the whole sleep time before falling asleep again
+    if (!state && BFlagGet(BodyFlag::SLEEPING))
+        sleep_starttime = float(GetChTime());
+    if (!state)
+        sleep_island = -1;
     BFlagSet(BodyFlag::SLEEPING, state);
 }
 
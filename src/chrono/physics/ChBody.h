@@ -82,6 +82,7 @@ class ChApi ChBody : public ChPhysicsItem, public ChBodyFrame, public ChContacta
     float sleep_minspeed;
     float sleep_minwvel;
     float sleep_starttime;
+    int sleep_island;  ///< tag of the sleeping island of the body (-1 if not sleeping)
 
   public:
     /// Build a rigid body.
@@ -196,6 +197,13 @@ class ChApi ChBody : public ChPhysicsItem, public ChBodyFrame, public ChContacta
     /// Get the global body index (internal use only)
     unsigned int GetGid() const { return body_gid; }
 
+    /// Set the tag of the sleeping island of the body (internal use only).
+    /// All the bodies of an island that fell asleep share the same tag, so that they are woken up together.
+    void SetSleepIsland(int tag) { sleep_island = tag; }
+
+    /// Get the tag of the sleeping island of the body, or -1 if not sleeping (internal use only).
+    int GetSleepIsland() const { return sleep_island; }
+
     //
     // FUNCTIONS
     //
@@ -17,6 +17,7 @@
 
 #include <list>
 #include <unordered_map>
+#include <vector>
 
 #include "chrono/collision/ChCCollisionInfo.h"
 #include "chrono/physics/ChBody.h"
@@ -57,6 +58,15 @@ class ChApi ChContactContainer : public ChPhysicsItem {
     /// specialized add-functions are found.
     virtual void AddContact(const collision::ChCollisionInfo& mcontact) = 0;
 
+    /// Add a batch of contacts, stored contiguously, with the same effect as calling AddContact() for each
+    /// of them in order (which is what this default implementation does).
+    /// Collision systems that can collect all their contacts before passing them to the container
+    /// (ex. ChCollisionSystemBullet) use this, so that derived classes can ingest the whole batch at once.
+    virtual void AddContacts(const std::vector<collision::ChCollisionInfo>& contacts) {
+        for (const auto& contact : contacts)
+            AddContact(contact);
+    }
+
     /// The collision system will call EndAddContact() after adding
     /// all contacts (for example with AddContact() or similar). By default
     /// it does nothing.
@@ -145,48 +155,53 @@ class ChApi ChContactContainer : public ChPhysicsItem {
     void SumAllContactForces(std::list<Tcont*>& contactlist,
                              std::unordered_map<ChContactable*, ForceTorque>& contactforces) {
         for (auto contact = contactlist.begin(); contact != contactlist.end(); ++contact) {
-            // Extract information for current contact (expressed in global frame)
-            ChMatrix33<> A = (*contact)->GetContactPlane();
-            ChVector<> force_loc = (*contact)->GetContactForce();
-            ChVector<> force = A.Matr_x_Vect(force_loc);
-            ChVector<> p1 = (*contact)->GetContactP1();
-            ChVector<> p2 = (*contact)->GetContactP2();
-
-            // Calculate contact torque for first object (expressed in global frame).
-            // Recall that -force is applied to the first object.
-            ChVector<> torque1(0);
-            if (ChBody* body = dynamic_cast<ChBody*>((*contact)->GetObjA())) {
-                torque1 = Vcross(p1 - body->GetPos(), -force);
-            }
-
-            // If there is already an entry for the first object, accumulate.
-            // Otherwise, insert a new entry.
-            auto entry1 = contactforces.find((*contact)->GetObjA());
-            if (entry1 != contactforces.end()) {
-                entry1->second.force -= force;
-                entry1->second.torque += torque1;
-            } else {
-                ForceTorque ft{-force, torque1};
-                contactforces.insert(std::make_pair((*contact)->GetObjA(), ft));
-            }
-
-            // Calculate contact torque for second object (expressed in global frame).
-            // Recall that +force is applied to the second object.
-            ChVector<> torque2(0);
-            if (ChBody* body = dynamic_cast<ChBody*>((*contact)->GetObjB())) {
-                torque2 = Vcross(p2 - body->GetPos(), force);
-            }
-
-            // If there is already an entry for the first object, accumulate.
-            // Otherwise, insert a new entry.
-            auto entry2 = contactforces.find((*contact)->GetObjB());
-            if (entry2 != contactforces.end()) {
-                entry2->second.force += force;
-                entry2->second.torque += torque2;
-            } else {
-                ForceTorque ft{force, torque2};
-                contactforces.insert(std::make_pair((*contact)->GetObjB(), ft));
-            }
+            SumContactForce(**contact, contactforces);
+        }
+    }
+
+    template <class Tcont>
+    void SumContactForce(Tcont& contact, std::unordered_map<ChContactable*, ForceTorque>& contactforces) {
+        // Extract information for current contact (expressed in global frame)
+        ChMatrix33<> A = contact.GetContactPlane();
+        ChVector<> force_loc = contact.GetContactForce();
+        ChVector<> force = A.Matr_x_Vect(force_loc);
+        ChVector<> p1 = contact.GetContactP1();
+        ChVector<> p2 = contact.GetContactP2();
+
+        // Calculate contact torque for first object (expressed in global frame).
+        // Recall that -force is applied to the first object.
+        ChVector<> torque1(0);
+        if (ChBody* body = dynamic_cast<ChBody*>(contact.GetObjA())) {
+            torque1 = Vcross(p1 - body->GetPos(), -force);
+        }
+
+        // If there is already an entry for the first object, accumulate.
+        // Otherwise, insert a new entry.
+        auto entry1 = contactforces.find(contact.GetObjA());
+        if (entry1 != contactforces.end()) {
+            entry1->second.force -= force;
+            entry1->second.torque += torque1;
+        } else {
+            ForceTorque ft{-force, torque1};
+            contactforces.insert(std::make_pair(contact.GetObjA(), ft));
+        }
+
+        // Calculate contact torque for second object (expressed in global frame).
+        // Recall that +force is applied to the second object.
+        ChVector<> torque2(0);
+        if (ChBody* body = dynamic_cast<ChBody*>(contact.GetObjB())) {
+            torque2 = Vcross(p2 - body->GetPos(), force);
+        }
+
+        // If there is already an entry for the first object, accumulate.
+        // Otherwise, insert a new entry.
+        auto entry2 = contactforces.find(contact.GetObjB());
+        if (entry2 != contactforces.end()) {
+            entry2->second.force += force;
+            entry2->second.torque += torque2;
+        } else {
+            ForceTorque ft{force, torque2};
+            contactforces.insert(std::make_pair(contact.GetObjB(), ft));
         }
     }
 };
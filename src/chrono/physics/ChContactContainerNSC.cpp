@@ -12,6 +12,9 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
+#include <tuple>
+
 #include "chrono/physics/ChContactContainerNSC.h"
 #include "chrono/physics/ChSystem.h"
 #include "chrono/solver/ChConstraintTwoTuplesContactN.h"
@@ -35,7 +38,11 @@ ChContactContainerNSC::ChContactContainerNSC()
       n_added_666_6(0),
       n_added_666_333(0),
       n_added_666_666(0),
-      n_added_6_6_rolling(0) {}
+      n_added_6_6_rolling(0),
+      use_reaction_cache(false),
+      use_persistent(false),
+      persistent_active(false),
+      n_persistent(0) {}
 
 ChContactContainerNSC::ChContactContainerNSC(const ChContactContainerNSC& other) : ChContactContainer(other) {
     n_added_6_6 = 0;
@@ -49,6 +56,10 @@ ChContactContainerNSC::ChContactContainerNSC(const ChContactContainerNSC& other)
     n_added_666_333 = 0;
     n_added_666_666 = 0;
     n_added_6_6_rolling = 0;
+    use_reaction_cache = false;
+    use_persistent = other.use_persistent;
+    persistent_active = false;
+    n_persistent = 0;
 }
 
 ChContactContainerNSC::~ChContactContainerNSC() {
@@ -85,9 +96,71 @@ void ChContactContainerNSC::RemoveAllContacts() {
     _RemoveAllContacts(contactlist_666_333, lastcontact_666_333, n_added_666_333);
     _RemoveAllContacts(contactlist_666_666, lastcontact_666_666, n_added_666_666);
     _RemoveAllContacts(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling);
+
+    // the persistent contacts were all in the lists, the free contact objects were not
+    for (auto& free_list : persistent_free) {
+        for (auto& pc : free_list.second)
+            pc.destroy(pc.contact);
+    }
+    persistent_free.clear();
+    persistent_contacts.clear();
+    persistent_added.clear();
+    n_persistent = 0;
+}
+
+template <class Tcont>
+void _StoreReactions(ChContactReactionCache& cache, std::list<Tcont*>& contactlist) {
+    ChVector<> force;
+    ChVector<> torque;
+    for (auto contact : contactlist) {
+        contact->GetAbsReactions(force, torque);
+        cache.Store(contact->GetObjA(), contact->GetObjB(), contact->GetShapeA(), contact->GetShapeB(), force,
+                    torque);
+    }
+}
+
+template <class Tcont>
+void _MatchReactions(ChContactReactionCache& cache, std::list<Tcont*>& contactlist) {
+    ChVector<> force;
+    ChVector<> torque;
+    for (auto contact : contactlist) {
+        if (cache.Match(contact->GetObjA(), contact->GetObjB(), contact->GetShapeA(), contact->GetShapeB(),
+                        contact->GetContactP1(), force, torque))
+            contact->SetAbsReactions(force, torque);
+    }
 }
 
 void ChContactContainerNSC::BeginAddContact() {
+    // Before the contact objects are reused, store the reactions of the last step in the persistent cache.
+    // Lists must be traversed in the same order as in EndAddContact().
+    if (use_reaction_cache) {
+        reaction_cache.BeginStore();
+        _StoreReactions(reaction_cache, contactlist_6_6);
+        _StoreReactions(reaction_cache, contactlist_6_3);
+        _StoreReactions(reaction_cache, contactlist_3_3);
+        _StoreReactions(reaction_cache, contactlist_333_3);
+        _StoreReactions(reaction_cache, contactlist_333_6);
+        _StoreReactions(reaction_cache, contactlist_333_333);
+        _StoreReactions(reaction_cache, contactlist_666_3);
+        _StoreReactions(reaction_cache, contactlist_666_6);
+        _StoreReactions(reaction_cache, contactlist_666_333);
+        _StoreReactions(reaction_cache, contactlist_666_666);
+        _StoreReactions(reaction_cache, contactlist_6_6_rolling);
+        reaction_cache.EndStore();
+    }
+
+    use_reaction_cache = GetSystem() && GetSystem()->GetSolverWarmStarting();
+    if (!use_reaction_cache)
+        reaction_cache.Clear();
+
+    // Contacts created in the other mode cannot be reused.
+    if (use_persistent != persistent_active) {
+        RemoveAllContacts();
+        persistent_active = use_persistent;
+    }
+    persistent_added.clear();
+    n_persistent = 0;
+
     lastcontact_6_6 = contactlist_6_6.begin();
     n_added_6_6 = 0;
 
@@ -122,52 +195,66 @@ void ChContactContainerNSC::BeginAddContact() {
     n_added_6_6_rolling = 0;
 }
 
+template <class Tcont>
+void _DeleteContact(void* contact) {
+    delete static_cast<Tcont*>(contact);
+}
+
+template <class T>
+bool _PersistentLess(const T& a, const T& b) {
+    return std::tie(a.list, a.objA, a.objB, a.shapeA, a.shapeB) < std::tie(b.list, b.objA, b.objB, b.shapeA, b.shapeB);
+}
+
+template <class Tcont, class Titer>
+void _PurgeContacts(std::list<Tcont*>& contactlist, Titer& lastcontact, bool owned) {
+    while (lastcontact != contactlist.end()) {
+        if (owned)
+            delete (*lastcontact);
+        lastcontact = contactlist.erase(lastcontact);
+    }
+}
+
 void ChContactContainerNSC::EndAddContact() {
     // remove contacts that are beyond last contact
-    while (lastcontact_6_6 != contactlist_6_6.end()) {
-        delete (*lastcontact_6_6);
-        lastcontact_6_6 = contactlist_6_6.erase(lastcontact_6_6);
-    }
-    while (lastcontact_6_3 != contactlist_6_3.end()) {
-        delete (*lastcontact_6_3);
-        lastcontact_6_3 = contactlist_6_3.erase(lastcontact_6_3);
-    }
-    while (lastcontact_3_3 != contactlist_3_3.end()) {
-        delete (*lastcontact_3_3);
-        lastcontact_3_3 = contactlist_3_3.erase(lastcontact_3_3);
-    }
-    while (lastcontact_333_3 != contactlist_333_3.end()) {
-        delete (*lastcontact_333_3);
-        lastcontact_333_3 = contactlist_333_3.erase(lastcontact_333_3);
-    }
-    while (lastcontact_333_6 != contactlist_333_6.end()) {
-        delete (*lastcontact_333_6);
-        lastcontact_333_6 = contactlist_333_6.erase(lastcontact_333_6);
-    }
-    while (lastcontact_333_333 != contactlist_333_333.end()) {
-        delete (*lastcontact_333_333);
-        lastcontact_333_333 = contactlist_333_333.erase(lastcontact_333_333);
-    }
-    while (lastcontact_666_3 != contactlist_666_3.end()) {
-        delete (*lastcontact_666_3);
-        lastcontact_666_3 = contactlist_666_3.erase(lastcontact_666_3);
-    }
-    while (lastcontact_666_6 != contactlist_666_6.end()) {
-        delete (*lastcontact_666_6);
-        lastcontact_666_6 = contactlist_666_6.erase(lastcontact_666_6);
-    }
-    while (lastcontact_666_333 != contactlist_666_333.end()) {
-        delete (*lastcontact_666_333);
-        lastcontact_666_333 = contactlist_666_333.erase(lastcontact_666_333);
-    }
-    while (lastcontact_666_666 != contactlist_666_666.end()) {
-        delete (*lastcontact_666_666);
-        lastcontact_666_666 = contactlist_666_666.erase(lastcontact_666_666);
+    // (with persistent contacts, these are recycled below, only if they were not reused)
+    bool owned = !persistent_active;
+    _PurgeContacts(contactlist_6_6, lastcontact_6_6, owned);
+    _PurgeContacts(contactlist_6_3, lastcontact_6_3, owned);
+    _PurgeContacts(contactlist_3_3, lastcontact_3_3, owned);
+    _PurgeContacts(contactlist_333_3, lastcontact_333_3, owned);
+    _PurgeContacts(contactlist_333_6, lastcontact_333_6, owned);
+    _PurgeContacts(contactlist_333_333, lastcontact_333_333, owned);
+    _PurgeContacts(contactlist_666_3, lastcontact_666_3, owned);
+    _PurgeContacts(contactlist_666_6, lastcontact_666_6, owned);
+    _PurgeContacts(contactlist_666_333, lastcontact_666_333, owned);
+    _PurgeContacts(contactlist_666_666, lastcontact_666_666, owned);
+    _PurgeContacts(contactlist_6_6_rolling, lastcontact_6_6_rolling, owned);
+
+    if (persistent_active) {
+        // Keep the contact objects that were not reused, for the new contacts of the next steps.
+        for (auto& pc : persistent_contacts) {
+            if (!pc.matched)
+                persistent_free[pc.list].push_back(pc);
+        }
+        persistent_contacts.swap(persistent_added);
+        std::stable_sort(persistent_contacts.begin(), persistent_contacts.end(), _PersistentLess<PersistentContact>);
+        persistent_added.clear();
     }
 
-    while (lastcontact_6_6_rolling != contactlist_6_6_rolling.end()) {
-        delete (*lastcontact_6_6_rolling);
-        lastcontact_6_6_rolling = contactlist_6_6_rolling.erase(lastcontact_6_6_rolling);
+    // Initialize the reactions of the new contacts with those of the same contacts in the previous step,
+    // whatever the order in which the collision system reported them.
+    if (use_reaction_cache) {
+        _MatchReactions(reaction_cache, contactlist_6_6);
+        _MatchReactions(reaction_cache, contactlist_6_3);
+        _MatchReactions(reaction_cache, contactlist_3_3);
+        _MatchReactions(reaction_cache, contactlist_333_3);
+        _MatchReactions(reaction_cache, contactlist_333_6);
+        _MatchReactions(reaction_cache, contactlist_333_333);
+        _MatchReactions(reaction_cache, contactlist_666_3);
+        _MatchReactions(reaction_cache, contactlist_666_6);
+        _MatchReactions(reaction_cache, contactlist_666_333);
+        _MatchReactions(reaction_cache, contactlist_666_666);
+        _MatchReactions(reaction_cache, contactlist_6_6_rolling);
     }
 }
 
@@ -194,6 +281,66 @@ void _OptimalContactInsert(std::list<Tcont*>& contactlist,          ///< contact
     n_added++;
 }
 
+template <class Tcont, class Titer, class Ta, class Tb>
+void ChContactContainerNSC::InsertContact(std::list<Tcont*>& contactlist,
+                                          Titer& lastcontact,
+                                          int& n_added,
+                                          Ta* objA,
+                                          Tb* objB,
+                                          const collision::ChCollisionInfo& cinfo) {
+    if (!persistent_active) {
+        _OptimalContactInsert(contactlist, lastcontact, n_added, this, objA, objB, cinfo);
+        return;
+    }
+
+    PersistentContact key = {&contactlist, objA, objB, cinfo.shapeA, cinfo.shapeB, nullptr, &_DeleteContact<Tcont>,
+                             false};
+
+    // Look for the first contact of the previous step with the same key, not yet reused.
+    Tcont* mc = nullptr;
+    auto it = std::lower_bound(persistent_contacts.begin(), persistent_contacts.end(), key,
+                               _PersistentLess<PersistentContact>);
+    for (; it != persistent_contacts.end() && !_PersistentLess(key, *it); ++it) {
+        if (!it->matched) {
+            it->matched = true;
+            mc = static_cast<Tcont*>(it->contact);
+            break;
+        }
+    }
+
+    if (mc) {
+        // reuse the contact, with its material (unless the user callback may change it)
+        if (GetAddContactCallback())
+            mc->Reset(objA, objB, cinfo);
+        else
+            mc->ResetGeometry(objA, objB, cinfo);
+        n_persistent++;
+    } else {
+        // new contact: recycle a contact object that was not reused, if any
+        auto& free_list = persistent_free[&contactlist];
+        if (!free_list.empty()) {
+            mc = static_cast<Tcont*>(free_list.back().contact);
+            free_list.pop_back();
+            mc->Reset(objA, objB, cinfo);
+        } else {
+            mc = new Tcont(this, objA, objB, cinfo);
+        }
+    }
+
+    // the contact objects in the list are owned by the persistent contacts, so they can be overwritten
+    if (lastcontact != contactlist.end()) {
+        *lastcontact = mc;
+        lastcontact++;
+    } else {
+        contactlist.push_back(mc);
+        lastcontact = contactlist.end();
+    }
+    n_added++;
+
+    key.contact = mc;
+    persistent_added.push_back(key);
+}
+
 void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontact) {
     assert(mcontact.modelA->GetContactable());
     assert(mcontact.modelB->GetContactable());
@@ -264,84 +411,76 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
     if (auto mmboA = dynamic_cast<ChContactable_1vars<3>*>(contactableA)) {
         if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
             // 3_3
-            _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_3_3, lastcontact_3_3, n_added_3_3, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
             // 3_6 -> 6_3
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboB, mmboA, swapped_contact);
+            InsertContact(contactlist_6_3, lastcontact_6_3, n_added_6_3, mmboB, mmboA, swapped_contact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
             // 3_333 -> 333_3
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboB, mmboA,
-                                  swapped_contact);
+            InsertContact(contactlist_333_3, lastcontact_333_3, n_added_333_3, mmboB, mmboA, swapped_contact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
             // 3_666 -> 666_3
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboB, mmboA,
-                                  swapped_contact);
+            InsertContact(contactlist_666_3, lastcontact_666_3, n_added_666_3, mmboB, mmboA, swapped_contact);
         }
     }
 
     else if (auto mmboA = dynamic_cast<ChContactable_1vars<6>*>(contactableA)) {
         if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
             // 6_3
-            _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_6_3, lastcontact_6_3, n_added_6_3, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
             // 6_6    ***NOTE: for body-body one could have rolling friction: ***
             if ((mmatA->rolling_friction && mmatB->rolling_friction) ||
                 (mmatA->spinning_friction && mmatB->spinning_friction)) {
-                _OptimalContactInsert(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling, this,
-                                      mmboA, mmboB, mcontact);
+                InsertContact(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling, mmboA, mmboB,
+                              mcontact);
             } else {
-                _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, mmboA, mmboB, mcontact);
+                InsertContact(contactlist_6_6, lastcontact_6_6, n_added_6_6, mmboA, mmboB, mcontact);
             }
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
             // 6_333 -> 333_6
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboB, mmboA,
-                                  swapped_contact);
+            InsertContact(contactlist_333_6, lastcontact_333_6, n_added_333_6, mmboB, mmboA, swapped_contact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
             // 6_666 -> 666_6
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboB, mmboA,
-                                  swapped_contact);
+            InsertContact(contactlist_666_6, lastcontact_666_6, n_added_666_6, mmboB, mmboA, swapped_contact);
         }
     }
 
     else if (auto mmboA = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableA)) {
         if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
             // 333_3
-            _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_333_3, lastcontact_333_3, n_added_333_3, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
             // 333_6
-            _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_333_6, lastcontact_333_6, n_added_333_6, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
             // 333_333
-            _OptimalContactInsert(contactlist_333_333, lastcontact_333_333, n_added_333_333, this, mmboA, mmboB,
-                                  mcontact);
+            InsertContact(contactlist_333_333, lastcontact_333_333, n_added_333_333, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
             // 333_666 -> 666_333
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboB, mmboA,
-                                  swapped_contact);
+            InsertContact(contactlist_666_333, lastcontact_666_333, n_added_666_333, mmboB, mmboA, swapped_contact);
         }
     }
 
     else if (auto mmboA = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableA)) {
         if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
             // 666_3
-            _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_666_3, lastcontact_666_3, n_added_666_3, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
             // 666_6
-            _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_666_6, lastcontact_666_6, n_added_666_6, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
             // 666_333
-            _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboA, mmboB,
-                                  mcontact);
+            InsertContact(contactlist_666_333, lastcontact_666_333, n_added_666_333, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
             // 666_666
-            _OptimalContactInsert(contactlist_666_666, lastcontact_666_666, n_added_666_666, this, mmboA, mmboB,
-                                  mcontact);
+            InsertContact(contactlist_666_666, lastcontact_666_666, n_added_666_666, mmboA, mmboB, mcontact);
         }
     }
 
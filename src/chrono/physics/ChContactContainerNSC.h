@@ -16,10 +16,13 @@
 #define CH_CONTACTCONTAINER_NSC_H
 
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 #include "chrono/physics/ChContactContainer.h"
 #include "chrono/physics/ChContactNSC.h"
 #include "chrono/physics/ChContactNSCrolling.h"
+#include "chrono/physics/ChContactReactionCache.h"
 #include "chrono/physics/ChContactable.h"
 
 namespace chrono {
@@ -85,6 +88,30 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
 
     std::list<ChContactNSCrolling_6_6*>::iterator lastcontact_6_6_rolling;
 
+    ChContactReactionCache reaction_cache;  ///< persistent contact reactions, for warm starting
+    bool use_reaction_cache;                ///< true if the reaction cache is used in the current step
+
+    /// Key of a persistent contact, and the contact object itself.
+    struct PersistentContact {
+        const void* list;        ///< contact list of the contact
+        ChContactable* objA;     ///< contactable object A
+        ChContactable* objB;     ///< contactable object B
+        int shapeA;              ///< shape (or feature) of object A
+        int shapeB;              ///< shape (or feature) of object B
+        void* contact;           ///< contact object
+        void (*destroy)(void*);  ///< function deleting the contact object
+        bool matched;            ///< true if the contact has been reused in the current step
+    };
+
+    bool use_persistent;                                  ///< persistent contacts requested by the user
+    bool persistent_active;                               ///< persistent contacts used in the current step
+    std::vector<PersistentContact> persistent_contacts;  ///< contacts of the previous step, sorted by key
+    std::vector<PersistentContact> persistent_added;     ///< contacts added in the current step
+    int n_persistent;                                     ///< number of contacts reused in the current step
+
+    /// Contact objects of the previous steps that were not reused, available for new contacts (per contact list).
+    std::unordered_map<const void*, std::vector<PersistentContact>> persistent_free;
+
   public:
     ChContactContainerNSC();
     ChContactContainerNSC(const ChContactContainerNSC& other);
@@ -117,6 +144,29 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     /// purges the end of the list of contacts that were not reused (if any).
     virtual void EndAddContact() override;
 
+    /// Enable or disable persistent contacts (default: false).
+    /// If enabled, a contact between the same two objects, generated by the same pair of shapes (or shape features,
+    /// e.g. the triangles of a mesh), in two consecutive steps keeps its contact object: only the geometric part of
+    /// the contact (contact points, jacobians) is recomputed, while the composite material is that computed when the
+    /// contact was created. Hence, changes of the material properties of the contactables apply only to new contacts.
+    /// If a callback for added contacts is set (see RegisterAddContactCallback()), the material is always recomputed.
+    /// Contact objects that are not reused are kept and recycled for the new contacts of the next steps.
+    /// This requires a collision system that reports the shape indices (see ChCollisionInfo::shapeA).
+    void SetPersistentContacts(bool val) { use_persistent = val; }
+
+    /// Return true if persistent contacts are enabled.
+    bool GetPersistentContacts() const { return use_persistent; }
+
+    /// Return the number of contacts reused from the previous step in the last collision detection
+    /// (always 0 if persistent contacts are not enabled).
+    int GetNumPersistentContacts() const { return n_persistent; }
+
+    /// Access the persistent cache of contact reactions.
+    /// The cache is used (and updated at each collision detection) only if the solver warm starting is enabled,
+    /// see ChSystem::SetSolverWarmStarting(). Then, the reactions of each contact are initialized with those of the
+    /// same contact in the previous step.
+    ChContactReactionCache& GetReactionCache() { return reaction_cache; }
+
     /// Scans all the contacts and for each contact executes the OnReportContact()
     /// function of the provided callback object.
     virtual void ReportAllContacts(ReportContactCallback* mcallback) override;
@@ -181,6 +231,16 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
 
     /// Method to allow de-serialization of transient data from archives.
     virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  private:
+    /// Add a contact to the given list, reusing a persistent contact object if possible.
+    template <class Tcont, class Titer, class Ta, class Tb>
+    void InsertContact(std::list<Tcont*>& contactlist,
+                       Titer& lastcontact,
+                       int& n_added,
+                       Ta* objA,
+                       Tb* objB,
+                       const collision::ChCollisionInfo& cinfo);
 };
 
 CH_CLASS_VERSION(ChContactContainerNSC, 0)
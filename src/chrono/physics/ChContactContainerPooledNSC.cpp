@@ -0,0 +1,372 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/physics/ChContactContainerPooledNSC.h"
+#include "chrono/physics/ChSystem.h"
+
+namespace chrono {
+
+using namespace collision;
+using namespace geometry;
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChContactContainerPooledNSC)
+
+ChContactContainerPooledNSC::ChContactContainerPooledNSC(const ChContactContainerPooledNSC& other)
+    : ChContactContainer(other), use_reaction_cache(false), use_parallel_add(other.use_parallel_add) {}
+
+ChContactContainerPooledNSC::~ChContactContainerPooledNSC() {
+    RemoveAllContacts();
+}
+
+void ChContactContainerPooledNSC::Update(double mytime, bool update_assets) {
+    // Inherit time changes of parent class, basically doing nothing :)
+    ChContactContainer::Update(mytime, update_assets);
+}
+
+void ChContactContainerPooledNSC::RemoveAllContacts() {
+    ForEachPool([](auto& pool, int stride) { pool.Clear(); });
+}
+
+void ChContactContainerPooledNSC::BeginAddContact() {
+    // Before the contact objects are reused, store the reactions of the last step in the persistent cache.
+    if (use_reaction_cache) {
+        reaction_cache.BeginStore();
+        ForEachPool([this](auto& pool, int stride) {
+            ChVector<> force;
+            ChVector<> torque;
+            pool.ForEach([&](auto& contact) {
+                contact.GetAbsReactions(force, torque);
+                reaction_cache.Store(contact.GetObjA(), contact.GetObjB(), contact.GetShapeA(), contact.GetShapeB(),
+                                     force, torque);
+            });
+        });
+        reaction_cache.EndStore();
+    }
+
+    use_reaction_cache = GetSystem() && GetSystem()->GetSolverWarmStarting();
+    if (!use_reaction_cache)
+        reaction_cache.Clear();
+
+    ForEachPool([](auto& pool, int stride) { pool.Rewind(); });
+}
+
+template <class F>
+void ChContactContainerPooledNSC::DispatchContact(const collision::ChCollisionInfo& mcontact, F f) {
+    assert(mcontact.modelA->GetContactable());
+    assert(mcontact.modelB->GetContactable());
+
+    auto contactableA = mcontact.modelA->GetContactable();
+    auto contactableB = mcontact.modelB->GetContactable();
+
+    // See if both collision models use NSC i.e. 'non-smooth dynamics' material
+    // of type ChMaterialSurfaceNSC, trying to downcast from ChMaterialSurface.
+    // If not NSC vs NSC, just bailout (ex it could be that this was a SMC vs SMC contact)
+
+    auto mmatA = std::dynamic_pointer_cast<ChMaterialSurfaceNSC>(contactableA->GetMaterialSurfaceBase());
+    auto mmatB = std::dynamic_pointer_cast<ChMaterialSurfaceNSC>(contactableB->GetMaterialSurfaceBase());
+
+    if (!mmatA || !mmatB)
+        return;
+
+    // Bail out if any of the two contactable objects is
+    // not contact-active:
+
+    bool inactiveA = !contactableA->IsContactActive();
+    bool inactiveB = !contactableB->IsContactActive();
+
+    if ((inactiveA && inactiveB))
+        return;
+
+    // CREATE THE CONTACTS
+    //
+    // Switch among the various cases of contacts, as in ChContactContainerNSC::AddContact().
+
+    if (auto mmboA = dynamic_cast<ChContactable_1vars<3>*>(contactableA)) {
+        if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
+            // 3_3
+            f(pool_3_3, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
+            // 3_6 -> 6_3
+            f(pool_6_3, mmboB, mmboA, true);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
+            // 3_333 -> 333_3
+            f(pool_333_3, mmboB, mmboA, true);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
+            // 3_666 -> 666_3
+            f(pool_666_3, mmboB, mmboA, true);
+        }
+    }
+
+    else if (auto mmboA = dynamic_cast<ChContactable_1vars<6>*>(contactableA)) {
+        if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
+            // 6_3
+            f(pool_6_3, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
+            // 6_6    ***NOTE: for body-body one could have rolling friction: ***
+            if ((mmatA->rolling_friction && mmatB->rolling_friction) ||
+                (mmatA->spinning_friction && mmatB->spinning_friction)) {
+                f(pool_6_6_rolling, mmboA, mmboB, false);
+            } else {
+                f(pool_6_6, mmboA, mmboB, false);
+            }
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
+            // 6_333 -> 333_6
+            f(pool_333_6, mmboB, mmboA, true);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
+            // 6_666 -> 666_6
+            f(pool_666_6, mmboB, mmboA, true);
+        }
+    }
+
+    else if (auto mmboA = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableA)) {
+        if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
+            // 333_3
+            f(pool_333_3, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
+            // 333_6
+            f(pool_333_6, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
+            // 333_333
+            f(pool_333_333, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
+            // 333_666 -> 666_333
+            f(pool_666_333, mmboB, mmboA, true);
+        }
+    }
+
+    else if (auto mmboA = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableA)) {
+        if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
+            // 666_3
+            f(pool_666_3, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
+            // 666_6
+            f(pool_666_6, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
+            // 666_333
+            f(pool_666_333, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
+            // 666_666
+            f(pool_666_666, mmboA, mmboB, false);
+        }
+    }
+}
+
+void ChContactContainerPooledNSC::AddContact(const collision::ChCollisionInfo& mcontact) {
+    DispatchContact(mcontact, [&](auto& pool, auto* objA, auto* objB, bool swap) {
+        if (swap)
+            pool.Add(this, objA, objB, collision::ChCollisionInfo(mcontact, true));
+        else
+            pool.Add(this, objA, objB, mcontact);
+    });
+}
+
+void ChContactContainerPooledNSC::AddContacts(const std::vector<collision::ChCollisionInfo>& contacts) {
+    int nthreads = GetSystem() ? GetSystem()->GetParallelThreadNumber() : 1;
+
+    // The user callback, if any, is not assumed to be thread-safe.
+    if (!use_parallel_add || nthreads < 2 || GetAddContactCallback()) {
+        for (const auto& contact : contacts)
+            ChContactContainerPooledNSC::AddContact(contact);
+        return;
+    }
+
+    ChContactPoolsAddBatch(
+        contacts, this, nthreads,
+        [this](const collision::ChCollisionInfo& mcontact, auto f) { DispatchContact(mcontact, f); },
+        [this](auto g) { ForEachPool([&](auto& pool, int stride) { g(pool); }); }, batch_pool, batch_slot);
+}
+
+void ChContactContainerPooledNSC::ComputeContactForces() {
+    contact_forces.clear();
+    ForEachPool([this](auto& pool, int stride) {
+        pool.ForEach([this](auto& contact) { SumContactForce(contact, contact_forces); });
+    });
+}
+
+template <class Tpool>
+void _ReportAllPooledContacts(Tpool& pool, ChContactContainer::ReportContactCallback* mcallback) {
+    for (size_t i = 0; i < pool.size(); ++i) {
+        auto& contact = pool[i];
+        bool proceed = mcallback->OnReportContact(contact.GetContactP1(), contact.GetContactP2(),
+                                                  contact.GetContactPlane(), contact.GetContactDistance(),
+                                                  contact.GetEffectiveCurvatureRadius(), contact.GetContactForce(),
+                                                  VNULL, contact.GetObjA(), contact.GetObjB());
+        if (!proceed)
+            break;
+    }
+}
+
+void ChContactContainerPooledNSC::EndAddContact() {
+    // Initialize the reactions of the new contacts with those of the same contacts in the previous step.
+    if (use_reaction_cache) {
+        ForEachPool([this](auto& pool, int stride) {
+            ChVector<> force;
+            ChVector<> torque;
+            pool.ForEach([&](auto& contact) {
+                if (reaction_cache.Match(contact.GetObjA(), contact.GetObjB(), contact.GetShapeA(),
+                                         contact.GetShapeB(), contact.GetContactP1(), force, torque))
+                    contact.SetAbsReactions(force, torque);
+            });
+        });
+    }
+}
+
+void ChContactContainerPooledNSC::ReportAllContacts(ReportContactCallback* mcallback) {
+    _ReportAllPooledContacts(pool_6_6, mcallback);
+    _ReportAllPooledContacts(pool_6_3, mcallback);
+    _ReportAllPooledContacts(pool_3_3, mcallback);
+    _ReportAllPooledContacts(pool_333_3, mcallback);
+    _ReportAllPooledContacts(pool_333_6, mcallback);
+    _ReportAllPooledContacts(pool_333_333, mcallback);
+    _ReportAllPooledContacts(pool_666_3, mcallback);
+    _ReportAllPooledContacts(pool_666_6, mcallback);
+    _ReportAllPooledContacts(pool_666_333, mcallback);
+    _ReportAllPooledContacts(pool_666_666, mcallback);
+
+    for (size_t i = 0; i < pool_6_6_rolling.size(); ++i) {
+        auto& contact = pool_6_6_rolling[i];
+        bool proceed = mcallback->OnReportContact(
+            contact.GetContactP1(), contact.GetContactP2(), contact.GetContactPlane(), contact.GetContactDistance(),
+            contact.GetEffectiveCurvatureRadius(), contact.GetContactForce(), contact.GetContactTorque(),
+            contact.GetObjA(), contact.GetObjB());
+        if (!proceed)
+            break;
+    }
+}
+
+////////// STATE INTERFACE ////
+
+void ChContactContainerPooledNSC::IntStateGatherReactions(const unsigned int off_L, ChVectorDynamic<>& L) {
+    unsigned int coffset = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        pool.ForEach([&](auto& contact) {
+            contact.ContIntStateGatherReactions(off_L + coffset, L);
+            coffset += stride;
+        });
+    });
+}
+
+void ChContactContainerPooledNSC::IntStateScatterReactions(const unsigned int off_L, const ChVectorDynamic<>& L) {
+    unsigned int coffset = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        pool.ForEach([&](auto& contact) {
+            contact.ContIntStateScatterReactions(off_L + coffset, L);
+            coffset += stride;
+        });
+    });
+}
+
+void ChContactContainerPooledNSC::IntLoadResidual_CqL(const unsigned int off_L,
+                                                      ChVectorDynamic<>& R,
+                                                      const ChVectorDynamic<>& L,
+                                                      const double c) {
+    unsigned int coffset = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        pool.ForEach([&](auto& contact) {
+            contact.ContIntLoadResidual_CqL(off_L + coffset, R, L, c);
+            coffset += stride;
+        });
+    });
+}
+
+void ChContactContainerPooledNSC::IntLoadConstraint_C(const unsigned int off,
+                                                      ChVectorDynamic<>& Qc,
+                                                      const double c,
+                                                      bool do_clamp,
+                                                      double recovery_clamp) {
+    unsigned int coffset = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        pool.ForEach([&](auto& contact) {
+            contact.ContIntLoadConstraint_C(off + coffset, Qc, c, do_clamp, recovery_clamp);
+            coffset += stride;
+        });
+    });
+}
+
+void ChContactContainerPooledNSC::IntToDescriptor(const unsigned int off_v,
+                                                  const ChStateDelta& v,
+                                                  const ChVectorDynamic<>& R,
+                                                  const unsigned int off_L,
+                                                  const ChVectorDynamic<>& L,
+                                                  const ChVectorDynamic<>& Qc) {
+    unsigned int coffset = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        pool.ForEach([&](auto& contact) {
+            contact.ContIntToDescriptor(off_L + coffset, L, Qc);
+            coffset += stride;
+        });
+    });
+}
+
+void ChContactContainerPooledNSC::IntFromDescriptor(const unsigned int off_v,
+                                                    ChStateDelta& v,
+                                                    const unsigned int off_L,
+                                                    ChVectorDynamic<>& L) {
+    unsigned int coffset = 0;
+    ForEachPool([&](auto& pool, int stride) {
+        pool.ForEach([&](auto& contact) {
+            contact.ContIntFromDescriptor(off_L + coffset, L);
+            coffset += stride;
+        });
+    });
+}
+
+// SOLVER INTERFACES
+
+void ChContactContainerPooledNSC::InjectConstraints(ChSystemDescriptor& mdescriptor) {
+    ForEachPool([&](auto& pool, int stride) {
+        pool.ForEach([&](auto& contact) { contact.InjectConstraints(mdescriptor); });
+    });
+}
+
+void ChContactContainerPooledNSC::ConstraintsBiReset() {
+    ForEachPool([](auto& pool, int stride) { pool.ForEach([](auto& contact) { contact.ConstraintsBiReset(); }); });
+}
+
+void ChContactContainerPooledNSC::ConstraintsBiLoad_C(double factor, double recovery_clamp, bool do_clamp) {
+    ForEachPool([&](auto& pool, int stride) {
+        pool.ForEach([&](auto& contact) { contact.ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp); });
+    });
+}
+
+void ChContactContainerPooledNSC::ConstraintsLoadJacobians() {
+    // already loaded when contact objects are created
+}
+
+void ChContactContainerPooledNSC::ConstraintsFetch_react(double factor) {
+    ForEachPool([&](auto& pool, int stride) {
+        pool.ForEach([&](auto& contact) { contact.ConstraintsFetch_react(factor); });
+    });
+}
+
+void ChContactContainerPooledNSC::ArchiveOUT(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChContactContainerPooledNSC>();
+    // serialize parent class
+    ChContactContainer::ArchiveOUT(marchive);
+    // serialize all member data:
+    // NO SERIALIZATION of contact pools because assume they are volatile and generated when needed
+}
+
+/// Method to allow de serialization of transient data from archives.
+void ChContactContainerPooledNSC::ArchiveIN(ChArchiveIn& marchive) {
+    // version number
+    int version = marchive.VersionRead<ChContactContainerPooledNSC>();
+    // deserialize parent class
+    ChContactContainer::ArchiveIN(marchive);
+    // stream in all member data:
+    RemoveAllContacts();
+    // NO SERIALIZATION of contact pools because assume they are volatile and generated when needed
+}
+
+}  // end namespace chrono
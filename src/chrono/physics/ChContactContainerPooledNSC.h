@@ -0,0 +1,203 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_CONTACTCONTAINER_POOLED_NSC_H
+#define CH_CONTACTCONTAINER_POOLED_NSC_H
+
+#include "chrono/physics/ChContactContainerNSC.h"
+#include "chrono/physics/ChContactPool.h"
+#include "chrono/physics/ChContactReactionCache.h"
+
+namespace chrono {
+
+/// Class representing a container of many non-smooth contacts, stored in contiguous pools.
+/// This is an alternative to ChContactContainerNSC with the same behavior: contacts are grouped by the
+/// type of the two contactable objects, but each group is stored in a ChContactPool rather than in a
+/// linked list of heap-allocated contacts. Contact objects are recycled from one step to the next,
+/// so that adding contacts does not allocate memory once the pools have reached the peak number of
+/// contacts, and all traversals (state functions, solver interface, contact reporting) are linear in memory.
+/// Use it with ChSystemNSC::SetContactContainer().
+class ChApi ChContactContainerPooledNSC : public ChContactContainer {
+
+  public:
+    typedef ChContactContainerNSC::ChContactNSC_6_6 ChContactNSC_6_6;
+    typedef ChContactContainerNSC::ChContactNSC_6_3 ChContactNSC_6_3;
+    typedef ChContactContainerNSC::ChContactNSC_3_3 ChContactNSC_3_3;
+    typedef ChContactContainerNSC::ChContactNSC_333_3 ChContactNSC_333_3;
+    typedef ChContactContainerNSC::ChContactNSC_333_6 ChContactNSC_333_6;
+    typedef ChContactContainerNSC::ChContactNSC_333_333 ChContactNSC_333_333;
+    typedef ChContactContainerNSC::ChContactNSC_666_3 ChContactNSC_666_3;
+    typedef ChContactContainerNSC::ChContactNSC_666_6 ChContactNSC_666_6;
+    typedef ChContactContainerNSC::ChContactNSC_666_333 ChContactNSC_666_333;
+    typedef ChContactContainerNSC::ChContactNSC_666_666 ChContactNSC_666_666;
+
+    typedef ChContactContainerNSC::ChContactNSCrolling_6_6 ChContactNSCrolling_6_6;
+
+  protected:
+    ChContactPool<ChContactNSC_6_6> pool_6_6;
+    ChContactPool<ChContactNSC_6_3> pool_6_3;
+    ChContactPool<ChContactNSC_3_3> pool_3_3;
+    ChContactPool<ChContactNSC_333_3> pool_333_3;
+    ChContactPool<ChContactNSC_333_6> pool_333_6;
+    ChContactPool<ChContactNSC_333_333> pool_333_333;
+    ChContactPool<ChContactNSC_666_3> pool_666_3;
+    ChContactPool<ChContactNSC_666_6> pool_666_6;
+    ChContactPool<ChContactNSC_666_333> pool_666_333;
+    ChContactPool<ChContactNSC_666_666> pool_666_666;
+
+    ChContactPool<ChContactNSCrolling_6_6> pool_6_6_rolling;
+
+    ChContactReactionCache reaction_cache;  ///< persistent contact reactions, for warm starting
+    bool use_reaction_cache;                ///< true if the reaction cache is used in the current step
+
+    bool use_parallel_add;           ///< add batches of contacts in parallel
+    std::vector<int> batch_pool;     ///< pool of each contact of a batch (work data)
+    std::vector<size_t> batch_slot;  ///< slot of each contact of a batch (work data)
+
+  public:
+    ChContactContainerPooledNSC() : use_reaction_cache(false), use_parallel_add(false) {}
+    ChContactContainerPooledNSC(const ChContactContainerPooledNSC& other);
+    virtual ~ChContactContainerPooledNSC();
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChContactContainerPooledNSC* Clone() const override { return new ChContactContainerPooledNSC(*this); }
+
+    /// Tell the number of added contacts
+    virtual int GetNcontacts() const override { return (int)(GetNcontactsSliding() + pool_6_6_rolling.size()); }
+
+    /// Remove (delete) all contained contact data, releasing the memory of the pools.
+    virtual void RemoveAllContacts() override;
+
+    /// The collision system will call BeginAddContact() before adding all contacts.
+    /// This rewinds all the pools, so that the existing contact objects are reused.
+    virtual void BeginAddContact() override;
+
+    /// Add a contact between two frames.
+    /// This is final, since the parallel path of AddContacts() does not go through it.
+    virtual void AddContact(const collision::ChCollisionInfo& mcontact) override final;
+
+    /// Add a batch of contacts. If enabled with SetUseParallelAddContacts(), the contact objects are
+    /// initialized in parallel (with the number of threads of the system), with the same result as
+    /// adding the contacts one at a time.
+    virtual void AddContacts(const std::vector<collision::ChCollisionInfo>& contacts) override;
+
+    /// Enable/disable the parallel initialization of the contacts added in a batch (default: false).
+    /// This is not used if an AddContactCallback is registered, since the callback may not be thread-safe.
+    void SetUseParallelAddContacts(bool val) { use_parallel_add = val; }
+
+    /// Return true if the contacts added in a batch are initialized in parallel.
+    bool GetUseParallelAddContacts() const { return use_parallel_add; }
+
+    /// The collision system will call EndAddContact() after adding all contacts.
+    /// Contact objects that were not reused are kept in the pools, for use in later steps.
+    virtual void EndAddContact() override;
+
+    /// Access the persistent cache of contact reactions (see ChContactContainerNSC::GetReactionCache()).
+    ChContactReactionCache& GetReactionCache() { return reaction_cache; }
+
+    /// Scans all the contacts and for each contact executes the OnReportContact()
+    /// function of the provided callback object.
+    virtual void ReportAllContacts(ReportContactCallback* mcallback) override;
+
+    /// Tell the number of scalar bilateral constraints (actually, friction
+    /// constraints aren't exactly as unilaterals, but count them too)
+    virtual int GetDOC_d() override { return (int)(3 * GetNcontactsSliding() + 6 * pool_6_6_rolling.size()); }
+
+    /// In detail, it computes jacobians, violations, etc. and stores
+    /// results in inner structures of contacts.
+    virtual void Update(double mtime, bool update_assets = true) override;
+
+    /// Compute contact forces on all contactable objects in this container.
+    virtual void ComputeContactForces() override;
+
+    //
+    // STATE FUNCTIONS
+    //
+
+    virtual void IntStateGatherReactions(const unsigned int off_L, ChVectorDynamic<>& L) override;
+    virtual void IntStateScatterReactions(const unsigned int off_L, const ChVectorDynamic<>& L) override;
+    virtual void IntLoadResidual_CqL(const unsigned int off_L,
+                                     ChVectorDynamic<>& R,
+                                     const ChVectorDynamic<>& L,
+                                     const double c) override;
+    virtual void IntLoadConstraint_C(const unsigned int off,
+                                     ChVectorDynamic<>& Qc,
+                                     const double c,
+                                     bool do_clamp,
+                                     double recovery_clamp) override;
+    virtual void IntToDescriptor(const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const ChVectorDynamic<>& R,
+                                 const unsigned int off_L,
+                                 const ChVectorDynamic<>& L,
+                                 const ChVectorDynamic<>& Qc) override;
+    virtual void IntFromDescriptor(const unsigned int off_v,
+                                   ChStateDelta& v,
+                                   const unsigned int off_L,
+                                   ChVectorDynamic<>& L) override;
+
+    //
+    // SOLVER INTERFACE
+    //
+
+    virtual void InjectConstraints(ChSystemDescriptor& mdescriptor) override;
+    virtual void ConstraintsBiReset() override;
+    virtual void ConstraintsBiLoad_C(double factor = 1, double recovery_clamp = 0.1, bool do_clamp = false) override;
+    virtual void ConstraintsLoadJacobians() override;
+    virtual void ConstraintsFetch_react(double factor = 1) override;
+
+    //
+    // SERIALIZATION
+    //
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override;
+
+    /// Method to allow de-serialization of transient data from archives.
+    virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  private:
+    /// Call f(pool, objA, objB, swap) for the pool of the given contact, with the two contactable objects in the
+    /// order of the pool (swap is true if swapped with respect to the contact). Not called if the contact is discarded.
+    template <class F>
+    void DispatchContact(const collision::ChCollisionInfo& mcontact, F f);
+
+    /// Number of contacts with 3 reactions (i.e. all but the rolling ones).
+    size_t GetNcontactsSliding() const {
+        return pool_6_6.size() + pool_6_3.size() + pool_3_3.size() + pool_333_3.size() + pool_333_6.size() +
+               pool_333_333.size() + pool_666_3.size() + pool_666_6.size() + pool_666_333.size() +
+               pool_666_666.size();
+    }
+
+    /// Execute the given function on all the pools, in the same order used for the offsets of the reactions.
+    /// The function receives the pool and the number of reactions of its contacts.
+    template <class F>
+    void ForEachPool(F f) {
+        f(pool_6_6, 3);
+        f(pool_6_3, 3);
+        f(pool_3_3, 3);
+        f(pool_333_3, 3);
+        f(pool_333_6, 3);
+        f(pool_333_333, 3);
+        f(pool_666_3, 3);
+        f(pool_666_6, 3);
+        f(pool_666_333, 3);
+        f(pool_666_666, 3);
+        f(pool_6_6_rolling, 6);
+    }
+};
+
+CH_CLASS_VERSION(ChContactContainerPooledNSC, 0)
+
+}  // end namespace chrono
+
+#endif
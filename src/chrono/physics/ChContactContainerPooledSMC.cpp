@@ -0,0 +1,225 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/physics/ChContactContainerPooledSMC.h"
+#include "chrono/physics/ChSystemSMC.h"
+
+namespace chrono {
+
+using namespace collision;
+using namespace geometry;
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChContactContainerPooledSMC)
+
+ChContactContainerPooledSMC::ChContactContainerPooledSMC(const ChContactContainerPooledSMC& other)
+    : ChContactContainer(other), use_parallel_add(other.use_parallel_add) {}
+
+ChContactContainerPooledSMC::~ChContactContainerPooledSMC() {
+    RemoveAllContacts();
+}
+
+void ChContactContainerPooledSMC::Update(double mytime, bool update_assets) {
+    // Inherit time changes of parent class, basically doing nothing :)
+    ChContactContainer::Update(mytime, update_assets);
+}
+
+void ChContactContainerPooledSMC::RemoveAllContacts() {
+    ForEachPool([](auto& pool) { pool.Clear(); });
+}
+
+void ChContactContainerPooledSMC::BeginAddContact() {
+    ForEachPool([](auto& pool) { pool.Rewind(); });
+}
+
+template <class F>
+void ChContactContainerPooledSMC::DispatchContact(const collision::ChCollisionInfo& mcontact, F f) {
+    assert(mcontact.modelA->GetContactable());
+    assert(mcontact.modelB->GetContactable());
+
+    // Do nothing if the shapes are separated
+    if (mcontact.distance >= 0)
+        return;
+
+    auto contactableA = mcontact.modelA->GetContactable();
+    auto contactableB = mcontact.modelB->GetContactable();
+
+    // Check that the two collision models are compatible with penalty contact.
+    // If either one has a contact material for complementarity, skip processing this contact.
+    auto mmatA = std::dynamic_pointer_cast<ChMaterialSurfaceSMC>(contactableA->GetMaterialSurfaceBase());
+    auto mmatB = std::dynamic_pointer_cast<ChMaterialSurfaceSMC>(contactableB->GetMaterialSurfaceBase());
+    if (!mmatA || !mmatB)
+        return;
+
+    // Bail out if any of the two contactable objects is not contact-active:
+    bool inactiveA = !contactableA->IsContactActive();
+    bool inactiveB = !contactableB->IsContactActive();
+    if (inactiveA && inactiveB)
+        return;
+
+    // CREATE THE CONTACTS
+    //
+    // Switch among the various cases of contacts, as in ChContactContainerSMC::AddContact().
+
+    if (auto mmboA = dynamic_cast<ChContactable_1vars<3>*>(contactableA)) {
+        if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
+            // 3_3
+            f(pool_3_3, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
+            // 3_6 -> 6_3
+            f(pool_6_3, mmboB, mmboA, true);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
+            // 3_333 -> 333_3
+            f(pool_333_3, mmboB, mmboA, true);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
+            // 3_666 -> 666_3
+            f(pool_666_3, mmboB, mmboA, true);
+        }
+    }
+
+    else if (auto mmboA = dynamic_cast<ChContactable_1vars<6>*>(contactableA)) {
+        if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
+            // 6_3
+            f(pool_6_3, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
+            // 6_6
+            f(pool_6_6, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
+            // 6_333 -> 333_6
+            f(pool_333_6, mmboB, mmboA, true);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
+            // 6_666 -> 666_6
+            f(pool_666_6, mmboB, mmboA, true);
+        }
+    }
+
+    else if (auto mmboA = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableA)) {
+        if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
+            // 333_3
+            f(pool_333_3, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
+            // 333_6
+            f(pool_333_6, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
+            // 333_333
+            f(pool_333_333, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
+            // 333_666 -> 666_333
+            f(pool_666_333, mmboB, mmboA, true);
+        }
+    }
+
+    else if (auto mmboA = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableA)) {
+        if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
+            // 666_3
+            f(pool_666_3, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
+            // 666_6
+            f(pool_666_6, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
+            // 666_333
+            f(pool_666_333, mmboA, mmboB, false);
+        } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
+            // 666_666
+            f(pool_666_666, mmboA, mmboB, false);
+        }
+    }
+}
+
+void ChContactContainerPooledSMC::AddContact(const collision::ChCollisionInfo& mcontact) {
+    DispatchContact(mcontact, [&](auto& pool, auto* objA, auto* objB, bool swap) {
+        if (swap)
+            pool.Add(this, objA, objB, collision::ChCollisionInfo(mcontact, true));
+        else
+            pool.Add(this, objA, objB, mcontact);
+    });
+}
+
+void ChContactContainerPooledSMC::AddContacts(const std::vector<collision::ChCollisionInfo>& contacts) {
+    int nthreads = GetSystem() ? GetSystem()->GetParallelThreadNumber() : 1;
+
+    // The user callback, if any, is not assumed to be thread-safe.
+    if (!use_parallel_add || nthreads < 2 || GetAddContactCallback()) {
+        for (const auto& contact : contacts)
+            ChContactContainerPooledSMC::AddContact(contact);
+        return;
+    }
+
+    ChContactPoolsAddBatch(
+        contacts, this, nthreads,
+        [this](const collision::ChCollisionInfo& mcontact, auto f) { DispatchContact(mcontact, f); },
+        [this](auto g) { ForEachPool(g); }, batch_pool, batch_slot);
+}
+
+void ChContactContainerPooledSMC::ComputeContactForces() {
+    contact_forces.clear();
+    ForEachPool([this](auto& pool) {
+        pool.ForEach([this](auto& contact) { SumContactForce(contact, contact_forces); });
+    });
+}
+
+template <class Tpool>
+void _ReportAllPooledContacts(Tpool& pool, ChContactContainer::ReportContactCallback* mcallback) {
+    for (size_t i = 0; i < pool.size(); ++i) {
+        auto& contact = pool[i];
+        bool proceed = mcallback->OnReportContact(contact.GetContactP1(), contact.GetContactP2(),
+                                                  contact.GetContactPlane(), contact.GetContactDistance(),
+                                                  contact.GetEffectiveCurvatureRadius(), contact.GetContactForce(),
+                                                  VNULL, contact.GetObjA(), contact.GetObjB());
+        if (!proceed)
+            break;
+    }
+}
+
+void ChContactContainerPooledSMC::ReportAllContacts(ReportContactCallback* mcallback) {
+    ForEachPool([mcallback](auto& pool) { _ReportAllPooledContacts(pool, mcallback); });
+}
+
+// STATE INTERFACE
+
+void ChContactContainerPooledSMC::IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) {
+    ForEachPool([&](auto& pool) { pool.ForEach([&](auto& contact) { contact.ContIntLoadResidual_F(R, c); }); });
+}
+
+void ChContactContainerPooledSMC::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
+    ForEachPool([&](auto& pool) {
+        pool.ForEach([&](auto& contact) { contact.ContKRMmatricesLoad(Kfactor, Rfactor); });
+    });
+}
+
+void ChContactContainerPooledSMC::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
+    ForEachPool([&](auto& pool) {
+        pool.ForEach([&](auto& contact) { contact.ContInjectKRMmatrices(mdescriptor); });
+    });
+}
+
+void ChContactContainerPooledSMC::ArchiveOUT(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChContactContainerPooledSMC>();
+    // serialize parent class
+    ChContactContainer::ArchiveOUT(marchive);
+    // serialize all member data:
+    // NO SERIALIZATION of contact pools because assume they are volatile and generated when needed
+}
+
+/// Method to allow de serialization of transient data from archives.
+void ChContactContainerPooledSMC::ArchiveIN(ChArchiveIn& marchive) {
+    // version number
+    int version = marchive.VersionRead<ChContactContainerPooledSMC>();
+    // deserialize parent class
+    ChContactContainer::ArchiveIN(marchive);
+    // stream in all member data:
+    RemoveAllContacts();
+    // NO SERIALIZATION of contact pools because assume they are volatile and generated when needed
+}
+
+}  // end namespace chrono
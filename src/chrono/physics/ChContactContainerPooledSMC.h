@@ -0,0 +1,149 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_CONTACTCONTAINER_POOLED_SMC_H
+#define CH_CONTACTCONTAINER_POOLED_SMC_H
+
+#include "chrono/physics/ChContactContainerSMC.h"
+#include "chrono/physics/ChContactPool.h"
+
+namespace chrono {
+
+/// Class representing a container of many smooth (penalty) contacts, stored in contiguous pools.
+/// This is an alternative to ChContactContainerSMC with the same behavior, where each group of contacts
+/// (by type of the two contactable objects) is stored in a ChContactPool rather than in a linked list
+/// of heap-allocated contacts. See ChContactContainerPooledNSC.
+/// Use it with ChSystemSMC::SetContactContainer().
+class ChApi ChContactContainerPooledSMC : public ChContactContainer {
+
+  public:
+    typedef ChContactContainerSMC::ChContactSMC_3_3 ChContactSMC_3_3;
+    typedef ChContactContainerSMC::ChContactSMC_6_3 ChContactSMC_6_3;
+    typedef ChContactContainerSMC::ChContactSMC_6_6 ChContactSMC_6_6;
+    typedef ChContactContainerSMC::ChContactSMC_333_3 ChContactSMC_333_3;
+    typedef ChContactContainerSMC::ChContactSMC_333_6 ChContactSMC_333_6;
+    typedef ChContactContainerSMC::ChContactSMC_333_333 ChContactSMC_333_333;
+    typedef ChContactContainerSMC::ChContactSMC_666_3 ChContactSMC_666_3;
+    typedef ChContactContainerSMC::ChContactSMC_666_6 ChContactSMC_666_6;
+    typedef ChContactContainerSMC::ChContactSMC_666_333 ChContactSMC_666_333;
+    typedef ChContactContainerSMC::ChContactSMC_666_666 ChContactSMC_666_666;
+
+  protected:
+    ChContactPool<ChContactSMC_3_3> pool_3_3;
+    ChContactPool<ChContactSMC_6_3> pool_6_3;
+    ChContactPool<ChContactSMC_6_6> pool_6_6;
+    ChContactPool<ChContactSMC_333_3> pool_333_3;
+    ChContactPool<ChContactSMC_333_6> pool_333_6;
+    ChContactPool<ChContactSMC_333_333> pool_333_333;
+    ChContactPool<ChContactSMC_666_3> pool_666_3;
+    ChContactPool<ChContactSMC_666_6> pool_666_6;
+    ChContactPool<ChContactSMC_666_333> pool_666_333;
+    ChContactPool<ChContactSMC_666_666> pool_666_666;
+
+    bool use_parallel_add;           ///< add batches of contacts in parallel
+    std::vector<int> batch_pool;     ///< pool of each contact of a batch (work data)
+    std::vector<size_t> batch_slot;  ///< slot of each contact of a batch (work data)
+
+  public:
+    ChContactContainerPooledSMC() : use_parallel_add(false) {}
+    ChContactContainerPooledSMC(const ChContactContainerPooledSMC& other);
+    virtual ~ChContactContainerPooledSMC();
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChContactContainerPooledSMC* Clone() const override { return new ChContactContainerPooledSMC(*this); }
+
+    /// Tell the number of added contacts
+    virtual int GetNcontacts() const override {
+        return (int)(pool_3_3.size() + pool_6_3.size() + pool_6_6.size() + pool_333_3.size() + pool_333_6.size() +
+                     pool_333_333.size() + pool_666_3.size() + pool_666_6.size() + pool_666_333.size() +
+                     pool_666_666.size());
+    }
+
+    /// Remove (delete) all contained contact data, releasing the memory of the pools.
+    virtual void RemoveAllContacts() override;
+
+    /// The collision system will call BeginAddContact() before adding all contacts.
+    /// This rewinds all the pools, so that the existing contact objects are reused.
+    virtual void BeginAddContact() override;
+
+    /// Add a contact between two frames.
+    /// This is final, since the parallel path of AddContacts() does not go through it.
+    virtual void AddContact(const collision::ChCollisionInfo& mcontact) override final;
+
+    /// Add a batch of contacts. If enabled with SetUseParallelAddContacts(), the contact objects are
+    /// initialized in parallel (with the number of threads of the system), with the same result as
+    /// adding the contacts one at a time.
+    virtual void AddContacts(const std::vector<collision::ChCollisionInfo>& contacts) override;
+
+    /// Enable/disable the parallel initialization of the contacts added in a batch (default: false).
+    /// This is not used if an AddContactCallback is registered, since the callback may not be thread-safe.
+    void SetUseParallelAddContacts(bool val) { use_parallel_add = val; }
+
+    /// Return true if the contacts added in a batch are initialized in parallel.
+    bool GetUseParallelAddContacts() const { return use_parallel_add; }
+
+    /// The collision system will call EndAddContact() after adding all contacts.
+    /// Contact objects that were not reused are kept in the pools, for use in later steps.
+    virtual void EndAddContact() override {}
+
+    /// Scans all the contacts and for each contact executes the OnReportContact()
+    /// function of the provided callback object.
+    virtual void ReportAllContacts(ReportContactCallback* mcallback) override;
+
+    /// In detail, it computes jacobians, violations, etc. and stores
+    /// results in inner structures of contacts.
+    virtual void Update(double mtime, bool update_assets = true) override;
+
+    /// Compute contact forces on all contactable objects in this container.
+    virtual void ComputeContactForces() override;
+
+    // STATE FUNCTIONS
+
+    virtual void IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) override;
+    virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override;
+    virtual void InjectKRMmatrices(ChSystemDescriptor& mdescriptor) override;
+
+    // SERIALIZATION
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override;
+
+    /// Method to allow de-serialization of transient data from archives.
+    virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  private:
+    /// Call f(pool, objA, objB, swap) for the pool of the given contact, with the two contactable objects in the
+    /// order of the pool (swap is true if swapped with respect to the contact). Not called if the contact is discarded.
+    template <class F>
+    void DispatchContact(const collision::ChCollisionInfo& mcontact, F f);
+
+    /// Execute the given function on all the pools.
+    template <class F>
+    void ForEachPool(F f) {
+        f(pool_3_3);
+        f(pool_6_3);
+        f(pool_6_6);
+        f(pool_333_3);
+        f(pool_333_6);
+        f(pool_333_333);
+        f(pool_666_3);
+        f(pool_666_6);
+        f(pool_666_333);
+        f(pool_666_666);
+    }
+};
+
+CH_CLASS_VERSION(ChContactContainerPooledSMC, 0)
+
+}  // end namespace chrono
+
+#endif
@@ -76,6 +76,17 @@ class ChContactNSC : public ChContactTuple<Ta, Tb> {
                        Tb* mobjB,                               ///< collidable object B
                        const collision::ChCollisionInfo& cinfo  ///< data for the contact pair
                        ) override {
+        ResetGeometry(mobjA, mobjB, cinfo);
+        ResetMaterial(cinfo);
+    }
+
+    /// Initialize again the geometric part of this constraint (contact points, variables, jacobians,
+    /// cached reactions), keeping the current material properties.
+    /// Used for contacts that persist from one step to the next between the same pair of objects.
+    virtual void ResetGeometry(Ta* mobjA,                               ///< collidable object A
+                               Tb* mobjB,                               ///< collidable object B
+                               const collision::ChCollisionInfo& cinfo  ///< data for the contact pair
+                               ) {
         // inherit base class:
         ChContactTuple<Ta, Tb>::Reset(mobjA, mobjB, cinfo);
 
@@ -86,25 +97,6 @@ class ChContactNSC : public ChContactTuple<Ta, Tb> {
         Tv.Get_tuple_a().SetVariables(*this->objA);
         Tv.Get_tuple_b().SetVariables(*this->objB);
 
-        // Calculate composite material properties
-        ChMaterialCompositeNSC mat(
-            this->container->GetSystem()->composition_strategy.get(),
-            std::static_pointer_cast<ChMaterialSurfaceNSC>(this->objA->GetMaterialSurfaceBase()),
-            std::static_pointer_cast<ChMaterialSurfaceNSC>(this->objB->GetMaterialSurfaceBase()));
-
-        // Check for a user-provided callback to modify the material
-        if (this->container->GetAddContactCallback()) {
-            this->container->GetAddContactCallback()->OnAddContact(cinfo, &mat);
-        }
-
-        Nx.SetFrictionCoefficient(mat.static_friction);
-        Nx.SetCohesion(mat.cohesion);
-
-        this->restitution = mat.restitution;
-        this->dampingf = mat.dampingf;
-        this->compliance = mat.compliance;
-        this->complianceT = mat.complianceT;
-
         this->reactions_cache = cinfo.reaction_cache;
 
         // COMPUTE JACOBIANS
@@ -128,9 +120,44 @@ class ChContactNSC : public ChContactTuple<Ta, Tb> {
 		}
     }
 
+    /// Initialize again the material properties of this constraint, from the materials of the two objects
+    /// (and the user callback for added contacts, if any). The geometry must have been set already.
+    virtual void ResetMaterial(const collision::ChCollisionInfo& cinfo  ///< data for the contact pair
+                               ) {
+        // Calculate composite material properties
+        ChMaterialCompositeNSC mat(
+            this->container->GetSystem()->composition_strategy.get(),
+            std::static_pointer_cast<ChMaterialSurfaceNSC>(this->objA->GetMaterialSurfaceBase()),
+            std::static_pointer_cast<ChMaterialSurfaceNSC>(this->objB->GetMaterialSurfaceBase()));
+
+        // Check for a user-provided callback to modify the material
+        if (this->container->GetAddContactCallback()) {
+            this->container->GetAddContactCallback()->OnAddContact(cinfo, &mat);
+        }
+
+        Nx.SetFrictionCoefficient(mat.static_friction);
+        Nx.SetCohesion(mat.cohesion);
+
+        this->restitution = mat.restitution;
+        this->dampingf = mat.dampingf;
+        this->compliance = mat.compliance;
+        this->complianceT = mat.complianceT;
+    }
+
     /// Get the contact force, if computed, in contact coordinate system
     virtual ChVector<> GetContactForce() const override { return react_force; }
 
+    /// Get the contact reactions in absolute coordinates (the torque is null, except for rolling contacts).
+    virtual void GetAbsReactions(ChVector<>& force, ChVector<>& torque) const {
+        force = this->contact_plane.Matr_x_Vect(react_force);
+        torque = VNULL;
+    }
+
+    /// Set the contact reactions from values in absolute coordinates (used to warm start the solver).
+    virtual void SetAbsReactions(const ChVector<>& force, const ChVector<>& torque) {
+        react_force = this->contact_plane.MatrT_x_Vect(force);
+    }
+
     /// Get the contact friction coefficient
     virtual double GetFriction() { return Nx.GetFrictionCoefficient(); }
 
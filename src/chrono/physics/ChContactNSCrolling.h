@@ -62,17 +62,15 @@ class ChContactNSCrolling : public ChContactNSC<Ta, Tb> {
         Rx.SetRollingConstraintV(&this->Rv);
         Rx.SetNormalConstraint(&this->Nx);
 
-        Reset(mobjA, mobjB, cinfo);
+        this->Reset(mobjA, mobjB, cinfo);
     }
 
     virtual ~ChContactNSCrolling() {}
 
-    /// Initialize again this constraint.
-    virtual void Reset(Ta* mobjA,
-                       Tb* mobjB,
-                       const collision::ChCollisionInfo& cinfo) {
+    /// Initialize again the geometric part of this constraint, keeping the current material properties.
+    virtual void ResetGeometry(Ta* mobjA, Tb* mobjB, const collision::ChCollisionInfo& cinfo) override {
         // Base method call:
-        ChContactNSC<Ta, Tb>::Reset(mobjA, mobjB, cinfo);
+        ChContactNSC<Ta, Tb>::ResetGeometry(mobjA, mobjB, cinfo);
 
         Rx.Get_tuple_a().SetVariables(*this->objA);
         Rx.Get_tuple_b().SetVariables(*this->objB);
@@ -81,6 +79,30 @@ class ChContactNSCrolling : public ChContactNSC<Ta, Tb> {
         Rv.Get_tuple_a().SetVariables(*this->objA);
         Rv.Get_tuple_b().SetVariables(*this->objB);
 
+        // COMPUTE JACOBIANS
+
+        // delegate objA to compute its half of jacobian
+        this->objA->ComputeJacobianForRollingContactPart(this->p1, this->contact_plane, Rx.Get_tuple_a(),
+                                                         Ru.Get_tuple_a(), Rv.Get_tuple_a(), false);
+
+        // delegate objB to compute its half of jacobian
+        this->objB->ComputeJacobianForRollingContactPart(this->p2, this->contact_plane, Rx.Get_tuple_b(),
+                                                         Ru.Get_tuple_b(), Rv.Get_tuple_b(), true);
+
+        if (this->reactions_cache) {
+            react_torque.x() = this->reactions_cache[3];
+            react_torque.y() = this->reactions_cache[4];
+            react_torque.z() = this->reactions_cache[5];
+        } else {
+            react_torque = VNULL;
+        }
+    }
+
+    /// Initialize again the material properties of this constraint.
+    virtual void ResetMaterial(const collision::ChCollisionInfo& cinfo) override {
+        // Base method call:
+        ChContactNSC<Ta, Tb>::ResetMaterial(cinfo);
+
         // Calculate composite material properties
         ChMaterialCompositeNSC mat(
             this->container->GetSystem()->composition_strategy.get(),
@@ -92,23 +114,21 @@ class ChContactNSCrolling : public ChContactNSC<Ta, Tb> {
 
         this->complianceRoll = mat.complianceRoll;
         this->complianceSpin = mat.complianceSpin;
-
-        // COMPUTE JACOBIANS
-
-        // delegate objA to compute its half of jacobian
-        this->objA->ComputeJacobianForRollingContactPart(this->p1, this->contact_plane, Rx.Get_tuple_a(),
-                                                         Ru.Get_tuple_a(), Rv.Get_tuple_a(), false);
-
-        // delegate objB to compute its half of jacobian
-        this->objB->ComputeJacobianForRollingContactPart(this->p2, this->contact_plane, Rx.Get_tuple_b(),
-                                                         Ru.Get_tuple_b(), Rv.Get_tuple_b(), true);
-
-        this->react_torque = VNULL;
     }
 
     /// Get the contact force, if computed, in contact coordinate system
     virtual ChVector<> GetContactTorque() { return react_torque; };
 
+    virtual void GetAbsReactions(ChVector<>& force, ChVector<>& torque) const override {
+        ChContactNSC<Ta, Tb>::GetAbsReactions(force, torque);
+        torque = this->contact_plane.Matr_x_Vect(react_torque);
+    }
+
+    virtual void SetAbsReactions(const ChVector<>& force, const ChVector<>& torque) override {
+        ChContactNSC<Ta, Tb>::SetAbsReactions(force, torque);
+        react_torque = this->contact_plane.MatrT_x_Vect(torque);
+    }
+
     /// Get the contact rolling friction coefficient
     virtual float GetRollingFriction() { return Rx.GetRollingFrictionCoefficient(); };
     /// Set the contact rolling friction coefficient
@@ -137,6 +157,12 @@ class ChContactNSCrolling : public ChContactNSC<Ta, Tb> {
         react_torque.x() = L(off_L + 3);
         react_torque.y() = L(off_L + 4);
         react_torque.z() = L(off_L + 5);
+
+        if (this->reactions_cache) {
+            this->reactions_cache[3] = (float)L(off_L + 3);
+            this->reactions_cache[4] = (float)L(off_L + 4);
+            this->reactions_cache[5] = (float)L(off_L + 5);
+        }
     }
 
     virtual void ContIntLoadResidual_CqL(const unsigned int off_L,  
@@ -0,0 +1,198 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_CONTACTPOOL_H
+#define CH_CONTACTPOOL_H
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "chrono/collision/ChCCollisionInfo.h"
+
+namespace chrono {
+
+class ChContactContainer;
+
+/// Pool of contact objects of a single type, stored in contiguous blocks.
+/// Contact objects are constructed in place the first time a slot is used and are then recycled
+/// (via their Reset() function) in the following steps, so that, once the pool has grown to the
+/// peak number of contacts, adding contacts does not involve any memory allocation.
+/// Blocks are never reallocated, hence the address of a contact object never changes while it is
+/// in the pool (this is needed because the system descriptor keeps pointers to the contact constraints).
+/// Traversal of the active contacts, via ForEach(), runs linearly through memory.
+template <class Tcont, int block_size = 512>
+class ChContactPool {
+  public:
+    ChContactPool() : n_active(0), n_constructed(0) {}
+    ~ChContactPool() { Clear(); }
+
+    /// Number of active contacts (i.e. contacts added since the last call to Rewind()).
+    size_t size() const { return n_active; }
+
+    /// Number of contact objects constructed so far (active or waiting to be recycled).
+    size_t capacity() const { return n_constructed; }
+
+    /// Deactivate all contacts, keeping the contact objects for later reuse.
+    void Rewind() { n_active = 0; }
+
+    /// Add a contact between the two given objects, recycling an existing contact object if possible.
+    template <class Ta, class Tb>
+    void Add(ChContactContainer* mcontainer, Ta* objA, Tb* objB, const collision::ChCollisionInfo& cinfo) {
+        if (n_active < n_constructed) {
+            // reuse old contact
+            (*this)[n_active].Reset(objA, objB, cinfo);
+        } else {
+            // construct a new contact in the next free slot
+            if (n_constructed == blocks.size() * block_size)
+                blocks.push_back(allocator.allocate(block_size));
+            Tcont* slot = blocks[n_constructed / block_size] + (n_constructed % block_size);
+            new (slot) Tcont(mcontainer, objA, objB, cinfo);
+            n_constructed++;
+        }
+        n_active++;
+    }
+
+    /// Add n contacts at once, returning the index of the first one.
+    /// The new contacts must then be initialized with Set() (this can be done in parallel, since it does not
+    /// allocate memory), and the batch completed with EndAddBatch().
+    size_t BeginAddBatch(size_t n) {
+        while (blocks.size() * block_size < n_active + n)
+            blocks.push_back(allocator.allocate(block_size));
+        size_t first = n_active;
+        n_active += n;
+        return first;
+    }
+
+    /// Initialize the i-th contact of a batch (see BeginAddBatch()), recycling the contact object if possible.
+    template <class Ta, class Tb>
+    void Set(size_t i, ChContactContainer* mcontainer, Ta* objA, Tb* objB, const collision::ChCollisionInfo& cinfo) {
+        if (i < n_constructed)
+            (*this)[i].Reset(objA, objB, cinfo);
+        else
+            new (&(*this)[i]) Tcont(mcontainer, objA, objB, cinfo);
+    }
+
+    /// Complete a batch of contacts (see BeginAddBatch()).
+    void EndAddBatch() {
+        if (n_active > n_constructed)
+            n_constructed = n_active;
+    }
+
+    /// Access the i-th contact (active or not).
+    Tcont& operator[](size_t i) { return blocks[i / block_size][i % block_size]; }
+    const Tcont& operator[](size_t i) const { return blocks[i / block_size][i % block_size]; }
+
+    /// Execute the given function on all active contacts, in order of insertion.
+    template <class F>
+    void ForEach(F f) {
+        size_t remaining = n_active;
+        for (size_t ib = 0; remaining > 0; ++ib) {
+            size_t n = remaining < (size_t)block_size ? remaining : (size_t)block_size;
+            Tcont* block = blocks[ib];
+            for (size_t i = 0; i < n; ++i)
+                f(block[i]);
+            remaining -= n;
+        }
+    }
+
+    /// Destroy all contact objects and release the memory.
+    void Clear() {
+        for (size_t i = 0; i < n_constructed; ++i)
+            (*this)[i].~Tcont();
+        for (auto block : blocks)
+            allocator.deallocate(block, block_size);
+        blocks.clear();
+        n_active = 0;
+        n_constructed = 0;
+    }
+
+  private:
+    ChContactPool(const ChContactPool&);             // not copyable
+    ChContactPool& operator=(const ChContactPool&);  // not assignable
+
+    std::allocator<Tcont> allocator;
+    std::vector<Tcont*> blocks;
+    size_t n_active;
+    size_t n_constructed;
+};
+
+/// Add a batch of contacts to a set of contact pools, with the same result as adding them in order with
+/// ChContactPool::Add(), but with the classification of the contacts and the initialization of the contact
+/// objects done in parallel (the contact objects must support concurrent initialization, i.e. no user callback
+/// can be called when they are reset).
+/// - dispatch(cinfo, f) must call f(pool, objA, objB, swap) for the pool of the contact, with the two objects in the
+///   order of the pool (swap is true if they are swapped with respect to cinfo), or not call f if the contact is
+///   discarded.
+/// - for_each_pool(g) must call g(pool) for all the pools.
+/// - contact_pool and contact_slot are work arrays.
+template <class Tdispatch, class Tforeach>
+void ChContactPoolsAddBatch(const std::vector<collision::ChCollisionInfo>& contacts,
+                            ChContactContainer* mcontainer,
+                            int nthreads,
+                            Tdispatch dispatch,
+                            Tforeach for_each_pool,
+                            std::vector<int>& contact_pool,
+                            std::vector<size_t>& contact_slot) {
+    int n = (int)contacts.size();
+    contact_pool.resize(n);
+    contact_slot.resize(n);
+
+    std::vector<const void*> pools;
+    for_each_pool([&](auto& pool) { pools.push_back(&pool); });
+    int npools = (int)pools.size();
+
+    // Pool of each contact.
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < n; i++) {
+        int k = -1;
+        dispatch(contacts[i], [&](auto& pool, auto* objA, auto* objB, bool swap) {
+            k = (int)(std::find(pools.begin(), pools.end(), (const void*)&pool) - pools.begin());
+        });
+        contact_pool[i] = k;
+    }
+
+    // Slots of the contacts, appended to each pool in order.
+    std::vector<size_t> next(npools, 0);
+    for (int i = 0; i < n; i++) {
+        if (contact_pool[i] >= 0)
+            next[contact_pool[i]]++;
+    }
+    int ip = 0;
+    for_each_pool([&](auto& pool) {
+        next[ip] = pool.BeginAddBatch(next[ip]);
+        ip++;
+    });
+    for (int i = 0; i < n; i++) {
+        if (contact_pool[i] >= 0)
+            contact_slot[i] = next[contact_pool[i]]++;
+    }
+
+    // Initialization of the contact objects.
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < n; i++) {
+        if (contact_pool[i] < 0)
+            continue;
+        dispatch(contacts[i], [&](auto& pool, auto* objA, auto* objB, bool swap) {
+            if (swap)
+                pool.Set(contact_slot[i], mcontainer, objA, objB, collision::ChCollisionInfo(contacts[i], true));
+            else
+                pool.Set(contact_slot[i], mcontainer, objA, objB, contacts[i]);
+        });
+    }
+
+    for_each_pool([](auto& pool) { pool.EndAddBatch(); });
+}
+
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,123 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <functional>
+
+#include "chrono/collision/ChCCollisionModel.h"
+#include "chrono/physics/ChContactReactionCache.h"
+
+namespace chrono {
+
+// Ordering of the cache entries by pair of contactable objects, then by pair of shapes.
+static bool EntryLess(ChContactable* a1,
+                      ChContactable* b1,
+                      int sa1,
+                      int sb1,
+                      ChContactable* a2,
+                      ChContactable* b2,
+                      int sa2,
+                      int sb2) {
+    std::less<ChContactable*> less;
+    if (a1 != a2)
+        return less(a1, a2);
+    if (b1 != b2)
+        return less(b1, b2);
+    return sa1 < sa2 || (sa1 == sa2 && sb1 < sb2);
+}
+
+ChContactReactionCache::ChContactReactionCache()
+    : n_stored(0), n_matched(0), matching_dist(collision::ChCollisionModel::GetDefaultSuggestedEnvelope()) {}
+
+void ChContactReactionCache::Clear() {
+    entries.clear();
+    points.clear();
+    n_stored = 0;
+    n_matched = 0;
+}
+
+void ChContactReactionCache::BeginStore() {
+    entries.clear();
+    n_stored = 0;
+}
+
+void ChContactReactionCache::Store(ChContactable* objA,
+                                   ChContactable* objB,
+                                   int shapeA,
+                                   int shapeB,
+                                   const ChVector<>& force,
+                                   const ChVector<>& torque) {
+    // Contacts that were not matched (e.g. added while the cache was not in use) have no recorded point.
+    if (n_stored >= points.size())
+        return;
+    Entry entry;
+    entry.objA = objA;
+    entry.objB = objB;
+    entry.shapeA = shapeA;
+    entry.shapeB = shapeB;
+    entry.point = points[n_stored++];
+    entry.force = force;
+    entry.torque = torque;
+    entry.matched = false;
+    entries.push_back(entry);
+}
+
+void ChContactReactionCache::EndStore() {
+    std::sort(entries.begin(), entries.end(), [](const Entry& e1, const Entry& e2) {
+        return EntryLess(e1.objA, e1.objB, e1.shapeA, e1.shapeB, e2.objA, e2.objB, e2.shapeA, e2.shapeB);
+    });
+    points.clear();
+    n_stored = 0;
+    n_matched = 0;
+}
+
+bool ChContactReactionCache::Match(ChContactable* objA,
+                                   ChContactable* objB,
+                                   int shapeA,
+                                   int shapeB,
+                                   const ChVector<>& pA,
+                                   ChVector<>& force,
+                                   ChVector<>& torque) {
+    ChVector<> point = objA->GetCsysForCollisionModel().TransformParentToLocal(pA);
+    points.push_back(point);
+
+    // Find the range of entries with the same objects and shapes (at most the few points of a contact manifold).
+    auto first = std::lower_bound(entries.begin(), entries.end(), objA, [&](const Entry& e, ChContactable* a) {
+        return EntryLess(e.objA, e.objB, e.shapeA, e.shapeB, a, objB, shapeA, shapeB);
+    });
+
+    // Pick the closest point within the matching distance, among those not inherited yet.
+    Entry* match = nullptr;
+    double min_dist2 = matching_dist * matching_dist;
+    for (auto e = first; e != entries.end() && e->objA == objA && e->objB == objB && e->shapeA == shapeA &&
+                         e->shapeB == shapeB;
+         ++e) {
+        if (e->matched)
+            continue;
+        double dist2 = (e->point - point).Length2();
+        if (dist2 <= min_dist2) {
+            min_dist2 = dist2;
+            match = &(*e);
+        }
+    }
+
+    if (!match)
+        return false;
+
+    match->matched = true;
+    force = match->force;
+    torque = match->torque;
+    n_matched++;
+    return true;
+}
+
+}  // end namespace chrono
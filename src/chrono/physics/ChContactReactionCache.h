@@ -0,0 +1,103 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHCONTACTREACTIONCACHE_H
+#define CHCONTACTREACTIONCACHE_H
+
+#include <vector>
+
+#include "chrono/core/ChVector.h"
+#include "chrono/physics/ChContactable.h"
+
+namespace chrono {
+
+/// Persistent cache of the reactions of non-smooth contacts, used to warm start the iterative solvers.\n
+/// The collision detection creates all contacts anew at each step, and a contact container reuses its contact
+/// objects in the order in which the collision system reports the contacts. The cache gives contacts a persistent
+/// identity instead: a contact is identified by its pair of contactable objects, by its pair of shapes (or shape
+/// features, see ChCollisionInfo::shapeA) and by the position of its point on the first object, in the collision
+/// frame of that object. A contact inherits the reactions of the contact of the previous step with the same objects
+/// and shapes and the closest point, if closer than the matching distance. Each contact of the previous step is
+/// inherited by at most one new contact.\n
+/// Reactions are stored in absolute coordinates, so they are not affected by a change of the tangent directions
+/// of the contact plane.\n
+/// Used by ChContactContainerNSC and ChContactContainerPooledNSC when the solver warm starting is enabled
+/// (see ChSystem::SetSolverWarmStarting()).
+class ChApi ChContactReactionCache {
+  public:
+    ChContactReactionCache();
+
+    /// Set the max. distance between the points of two contacts, in two consecutive steps, to be identified
+    /// as the same contact (default: the default suggested envelope of collision models).
+    void SetMatchingDistance(double dist) { matching_dist = dist; }
+
+    /// Get the max. distance between the points of two contacts to be identified as the same contact.
+    double GetMatchingDistance() const { return matching_dist; }
+
+    /// Return the number of contacts stored from the previous step.
+    int GetNumEntries() const { return (int)entries.size(); }
+
+    /// Return the number of contacts of the current step that inherited the reactions of a previous contact.
+    int GetNumMatched() const { return n_matched; }
+
+    /// Discard all the stored contacts.
+    void Clear();
+
+    /// Start storing the contacts of the last step, after the solver computed their reactions.
+    /// Contacts must be stored in the same order in which they were passed to Match().
+    void BeginStore();
+
+    /// Store the reactions (in absolute coordinates) of the next contact of the last step.
+    void Store(ChContactable* objA,
+               ChContactable* objB,
+               int shapeA,
+               int shapeB,
+               const ChVector<>& force,
+               const ChVector<>& torque);
+
+    /// Finish storing the contacts of the last step.
+    void EndStore();
+
+    /// Look for the contact of the previous step that corresponds to a new contact between the given objects and
+    /// shapes, at the absolute point \a pA on the first object. If found (and not already inherited by another new
+    /// contact), return true and its reactions (in absolute coordinates). The new contact is recorded, to be stored
+    /// after the solution of this step.
+    bool Match(ChContactable* objA,
+               ChContactable* objB,
+               int shapeA,
+               int shapeB,
+               const ChVector<>& pA,
+               ChVector<>& force,
+               ChVector<>& torque);
+
+  private:
+    struct Entry {
+        ChContactable* objA;
+        ChContactable* objB;
+        int shapeA;
+        int shapeB;
+        ChVector<> point;  // contact point, in the collision frame of objA
+        ChVector<> force;
+        ChVector<> torque;
+        bool matched;  // already inherited by a contact of the current step
+    };
+
+    std::vector<Entry> entries;       // contacts of the previous step, sorted by objects and shapes
+    std::vector<ChVector<>> points;  // points of the contacts of the current step, in order of matching
+    size_t n_stored;
+    int n_matched;
+    double matching_dist;
+};
+
+}  // end namespace chrono
+
+#endif
@@ -48,6 +48,9 @@ class ChContactTuple {
     double norm_dist;   ///< penetration distance (negative if going inside) after refining
     double eff_radius;  ///< effective radius of curvature at contact
 
+    int shapeA;  ///< shape (or shape feature) of object A, -1 if not available
+    int shapeB;  ///< shape (or shape feature) of object B, -1 if not available
+
   public:
     //
     // CONSTRUCTORS
@@ -91,6 +94,8 @@ class ChContactTuple {
         this->normal = cinfo.vN;
         this->norm_dist = cinfo.distance;
         this->eff_radius = cinfo.eff_radius;
+        this->shapeA = cinfo.shapeA;
+        this->shapeB = cinfo.shapeB;
 
         // Contact plane
         ChVector<> Vx, Vy, Vz;
@@ -104,6 +109,12 @@ class ChContactTuple {
     /// Get the colliding object B, with point P2
     Tb* GetObjB() { return this->objB; }
 
+    /// Get the index of the shape (or shape feature) of object A, -1 if not reported by the collision system.
+    int GetShapeA() const { return shapeA; }
+
+    /// Get the index of the shape (or shape feature) of object B, -1 if not reported by the collision system.
+    int GetShapeB() const { return shapeB; }
+
     /// Get the contact coordinate system, expressed in absolute frame.
     /// This represents the 'main' reference of the link: reaction forces
     /// are expressed in this coordinate system. Its origin is point P2.
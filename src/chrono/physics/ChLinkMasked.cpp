@@ -189,11 +189,19 @@ void ChLinkMasked::DestroyLink() {
 void ChLinkMasked::ChangeLinkMask(ChLinkMask* new_mask) {
     DestroyLink();
     BuildLink(new_mask);
+
+    // the constraints have been reallocated: they must be injected again in the system descriptor
+    if (GetSystem())
+        GetSystem()->ForceDescriptorRebuild();
 }
 
 void ChLinkMasked::ChangedLinkMask() {
     DestroyLink();
     BuildLink();
+
+    // the constraints have been reallocated: they must be injected again in the system descriptor
+    if (GetSystem())
+        GetSystem()->ForceDescriptorRebuild();
 }
 
 void ChLinkMasked::SetDisabled(bool mdis) {
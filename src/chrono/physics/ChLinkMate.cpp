@@ -123,6 +123,10 @@ void ChLinkMateGeneric::ChangedLinkMask() {
     ndoc = mask->GetMaskDoc();
     ndoc_c = mask->GetMaskDoc_c();
     ndoc_d = mask->GetMaskDoc_d();
+
+    // the constraints of the mask may have been reallocated: they must be injected again in the system descriptor
+    if (GetSystem())
+        GetSystem()->ForceDescriptorRebuild();
 }
 
 void ChLinkMateGeneric::SetDisabled(bool mdis) {
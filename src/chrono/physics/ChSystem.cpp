@@ -13,9 +13,11 @@
 // =============================================================================
 
 #include <algorithm>
+#include <unordered_map>
 
 #include "chrono/collision/ChCCollisionSystemBullet.h"
 #include "chrono/collision/ChCModelBullet.h"
+#include "chrono/core/ChDisjointSets.h"
 #include "chrono/parallel/ChOpenMP.h"
 #include "chrono/physics/ChProximityContainer.h"
 #include "chrono/physics/ChSystem.h"
@@ -26,11 +28,13 @@
 #include "chrono/solver/ChSolverPCG.h"
 #include "chrono/solver/ChSolverPMINRES.h"
 #include "chrono/solver/ChSolverSOR.h"
+#include "chrono/solver/ChSolverSORcolored.h"
 #include "chrono/solver/ChSolverSORmultithread.h"
 #include "chrono/solver/ChSolverSymmSOR.h"
 #include "chrono/timestepper/ChStaticAnalysis.h"
 #include "chrono/core/ChLinkedListMatrix.h"
 #include "chrono/utils/ChProfiler.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 using namespace chrono::collision;
 
@@ -42,6 +46,7 @@ namespace chrono {
 
 ChSystem::ChSystem()
     : ChAssembly(),
+      G_acc(ChVector<>(0, -9.8, 0)),
       end_time(1),
       step(0.04),
       step_min(0.002),
@@ -49,19 +54,30 @@ ChSystem::ChSystem()
       tol(2e-4),
       tol_force(1e-3),
       maxiter(6),
+      use_sleeping(false),
+      nislands(0),
+      nislands_sleep(0),
+      next_island_tag(0),
+      use_incremental_descriptor(false),
+      descriptor_dirty(true),
+      ndescriptor_rebuilds(0),
+      descriptor_injected(nullptr),
+      descriptor_nconstraints(0),
+      descriptor_nvariables(0),
+      descriptor_nkblocks(0),
+      structure_counts(),
+      structure_counts_injected(),
       max_iter_solver_speed(30),
       max_iter_solver_stab(10),
-      ncontacts(0),
       min_bounce_speed(0.15),
       max_penetration_recovery_speed(0.6),
-      use_sleeping(false),
-      G_acc(ChVector<>(0, -9.8, 0)),
       stepcount(0),
-      solvecount(0),
       setupcount(0),
+      solvecount(0),
       dump_matrices(false),
-      last_err(false),
-      composition_strategy(new ChMaterialCompositionStrategy<float>) {
+      ncontacts(0),
+      composition_strategy(new ChMaterialCompositionStrategy<float>),
+      last_err(false) {
     // Required by ChAssembly
     system = this;
 
@@ -101,6 +117,16 @@ ChSystem::ChSystem(const ChSystem& other) : ChAssembly(other) {
     SetSolverType(GetSolverType());
     parallel_thread_number = other.parallel_thread_number;
     use_sleeping = other.use_sleeping;
+    nislands = 0;
+    nislands_sleep = 0;
+    next_island_tag = 0;
+    use_incremental_descriptor = other.use_incremental_descriptor;
+    descriptor_dirty = true;
+    ndescriptor_rebuilds = 0;
+    descriptor_injected = nullptr;
+    descriptor_nconstraints = 0;
+    descriptor_nvariables = 0;
+    descriptor_nkblocks = 0;
 
     ncontacts = other.ncontacts;
 
@@ -164,6 +190,10 @@ void ChSystem::SetSolverType(ChSolver::Type type) {
             solver_speed = std::make_shared<ChSolverSORmultithread>("speedSolver", parallel_thread_number);
             solver_stab = std::make_shared<ChSolverSORmultithread>("posSolver", parallel_thread_number);
             break;
+        case ChSolver::Type::SOR_COLORED:
+            solver_speed = std::make_shared<ChSolverSORcolored>();
+            solver_stab = std::make_shared<ChSolverSORcolored>();
+            break;
         case ChSolver::Type::PMINRES:
             solver_speed = std::make_shared<ChSolverPMINRES>();
             solver_stab = std::make_shared<ChSolverPMINRES>();
@@ -271,6 +301,9 @@ void ChSystem::SetParallelThreadNumber(int mthreads) {
 
     descriptor->SetNumThreads(mthreads);
 
+    if (collision_system)
+        collision_system->SetNumThreads(mthreads);
+
     if (solver_speed->GetType() == ChSolver::Type::SOR_MULTITHREAD) {
         std::static_pointer_cast<ChSolverSORmultithread>(solver_speed)->ChangeNumberOfThreads(mthreads);
         std::static_pointer_cast<ChSolverSORmultithread>(solver_stab)->ChangeNumberOfThreads(mthreads);
@@ -303,6 +336,7 @@ void ChSystem::SetCollisionSystem(std::shared_ptr<ChCollisionSystem> newcollsyst
     assert(GetNbodies() == 0);
     assert(newcollsystem);
     collision_system = newcollsystem;
+    collision_system->SetNumThreads(parallel_thread_number);
 }
 
 void ChSystem::SetMaterialCompositionStrategy(std::unique_ptr<ChMaterialCompositionStrategy<float>>&& strategy) {
@@ -480,21 +514,61 @@ bool ChSystem::ManageSleepingBodies() {
     if (!GetUseSleeping())
         return 0;
 
+    CH_TRACE("ManageSleepingBodies");
+
+    int nb = (int)bodylist.size();
+
     // STEP 1:
     // See if some body could change from no sleep-> sleep
 
-    for (int ip = 0; ip < bodylist.size(); ++ip) {
+    for (int ip = 0; ip < nb; ++ip) {
         // mark as 'could sleep' candidate
         bodylist[ip]->TrySleeping();
     }
 
     // STEP 2:
-    // See if some sleeping or potential sleeping body is touching a non sleeping one,
-    // if so, set to no sleep.
+    // Build the simulation islands, i.e. the connected components of the graph whose nodes are the bodies
+    // and whose edges are the links and the contacts. Fixed bodies do not propagate the connectivity
+    // (two piles of debris resting on the same ground are two different islands).
+    // Contacts between two sleeping bodies are not generated, so the bodies of a sleeping island are kept
+    // together through the tag assigned when the island fell asleep.
+
+    ChDisjointSets islands(nb);
+    std::vector<char> fixed(nb);
+    std::vector<char> keep_awake(nb, 0);
+    std::unordered_map<ChContactable*, int> body_index(2 * nb);
+    std::unordered_map<int, int> sleep_tags;
+
+    for (int ip = 0; ip < nb; ++ip) {
+        ChBody* body = bodylist[ip].get();
+        body_index[body] = ip;
+        fixed[ip] = body->GetBodyFixed();
+        if (body->GetSleeping() && body->GetSleepIsland() >= 0) {
+            auto tag = sleep_tags.insert(std::make_pair(body->GetSleepIsland(), ip));
+            if (!tag.second)
+                islands.Union(tag.first->second, ip);
+        }
+    }
+
+    // scan all links and join connected bodies
+    for (auto& link : linklist) {
+        if (!link->IsActive())
+            continue;
+        ChBody* b1 = dynamic_cast<ChBody*>(link->GetBody1());
+        ChBody* b2 = dynamic_cast<ChBody*>(link->GetBody2());
+        if (!(b1 && b2))
+            continue;
+        auto i1 = body_index.find(b1);
+        auto i2 = body_index.find(b2);
+        if (i1 == body_index.end() || i2 == body_index.end())
+            continue;
+        if (!fixed[i1->second] && !fixed[i2->second])
+            islands.Union(i1->second, i2->second);
+    }
 
-    // Make this class for iterating through contacts
+    // scan all contacts and join touching bodies
 
-    class _wakeup_reporter_class : public ChContactContainer::ReportContactCallback {
+    class _island_reporter_class : public ChContactContainer::ReportContactCallback {
       public:
         // Callback, used to report contact points already added to the container.
         // If returns false, the contact scanning will be stopped.
@@ -511,101 +585,108 @@ bool ChSystem::ManageSleepingBodies() {
             ) override {
             if (!(contactobjA && contactobjB))
                 return true;
-            ChBody* b1 = dynamic_cast<ChBody*>(contactobjA);
-            ChBody* b2 = dynamic_cast<ChBody*>(contactobjB);
-            if (!(b1 && b2))
-                return true;
-            bool sleep1 = b1->GetSleeping();
-            bool sleep2 = b2->GetSleeping();
-            bool could_sleep1 = b1->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-            bool could_sleep2 = b2->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-            bool ground1 = b1->GetBodyFixed();
-            bool ground2 = b2->GetBodyFixed();
-            if (sleep1 && !(sleep2 || could_sleep2) && !ground2) {
-                b1->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (sleep2 && !(sleep1 || could_sleep1) && !ground1) {
-                b2->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (could_sleep1 && !(sleep2 || could_sleep2) && !ground2) {
-                b1->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
+            auto iA = body_index->find(contactobjA);
+            auto iB = body_index->find(contactobjB);
+            bool bodyA = iA != body_index->end();
+            bool bodyB = iB != body_index->end();
+            if (bodyA && bodyB) {
+                if (!(*fixed)[iA->second] && !(*fixed)[iB->second])
+                    islands->Union(iA->second, iB->second);
+            } else if (bodyA && contactobjB->IsContactActive()) {
+                // touching some other moving object (e.g. a FEA mesh): stay awake
+                (*keep_awake)[iA->second] = 1;
+            } else if (bodyB && contactobjA->IsContactActive()) {
+                (*keep_awake)[iB->second] = 1;
             }
-            if (could_sleep2 && !(sleep1 || could_sleep1) && !ground1) {
-                b2->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-            }
-            someone_sleeps = sleep1 | sleep2 | someone_sleeps;
-
             return true;  // to continue scanning contacts
         }
 
         // Data
-        bool someone_sleeps;
-        bool need_Setup_A;
+        std::unordered_map<ChContactable*, int>* body_index;
+        std::vector<char>* fixed;
+        std::vector<char>* keep_awake;
+        ChDisjointSets* islands;
     };
 
-    _wakeup_reporter_class my_waker;
-    my_waker.need_Setup_A = false;
-
-    bool need_Setup_L = false;
-
-    for (int i = 0; i < 1; i++)  //***TO DO*** reconfigurable number of wakeup cycles
-    {
-        my_waker.someone_sleeps = false;
-
-        // scan all links and wake connected bodies
-        for (unsigned int ip = 0; ip < linklist.size(); ++ip)  // ITERATE on links
-        {
-            std::shared_ptr<ChLink> Lpointer = linklist[ip];
-
-            if (Lpointer->IsRequiringWaking()) {
-                ChBody* b1 = dynamic_cast<ChBody*>(Lpointer->GetBody1());
-                ChBody* b2 = dynamic_cast<ChBody*>(Lpointer->GetBody2());
-                if (b1 && b2) {
-                    bool sleep1 = b1->GetSleeping();
-                    bool sleep2 = b2->GetSleeping();
-                    bool could_sleep1 = b1->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-                    bool could_sleep2 = b2->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-                    if (sleep1 && !(sleep2 || could_sleep2)) {
-                        b1->SetSleeping(false);
-                        need_Setup_L = true;
-                    }
-                    if (sleep2 && !(sleep1 || could_sleep1)) {
-                        b2->SetSleeping(false);
-                        need_Setup_L = true;
-                    }
-                    if (could_sleep1 && !(sleep2 || could_sleep2)) {
-                        b1->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-                    }
-                    if (could_sleep2 && !(sleep1 || could_sleep1)) {
-                        b2->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-                    }
-                }
-            }
-        }
-
-        // scan all contacts and wake neighboring bodies
-        contact_container->ReportAllContacts(&my_waker);
+    _island_reporter_class my_reporter;
+    my_reporter.body_index = &body_index;
+    my_reporter.fixed = &fixed;
+    my_reporter.keep_awake = &keep_awake;
+    my_reporter.islands = &islands;
+    contact_container->ReportAllContacts(&my_reporter);
+
+    // STEP 3:
+    // An island can sleep only if all its bodies are at rest (or already sleeping).
+
+    std::vector<char> island_awake(nb, 0);
+    for (int ip = 0; ip < nb; ++ip) {
+        if (fixed[ip])
+            continue;
+        ChBody* body = bodylist[ip].get();
+        if (keep_awake[ip] || !(body->GetSleeping() || body->BFlagGet(ChBody::BodyFlag::COULDSLEEP)))
+            island_awake[islands.Find(ip)] = 1;
+    }
 
-        // bailout wakeup cycle prematurely, if all bodies are not sleeping
-        if (!my_waker.someone_sleeps)
-            break;
+    // STEP 4:
+    // Tag the sleeping islands. Body indices change when bodies are removed, so they cannot be used as tags:
+    // an island that was already asleep keeps the tag shared by all its bodies, any other island gets a new one.
+
+    const int tag_unset = -2;
+    std::vector<int> island_tag(nb, tag_unset);
+    for (int ip = 0; ip < nb; ++ip) {
+        if (fixed[ip])
+            continue;
+        int root = islands.Find(ip);
+        if (island_awake[root])
+            continue;
+        ChBody* body = bodylist[ip].get();
+        int tag = body->GetSleeping() ? body->GetSleepIsland() : -1;
+        if (island_tag[root] == tag_unset)
+            island_tag[root] = tag;
+        else if (island_tag[root] != tag)
+            island_tag[root] = -1;
+    }
+    for (int ip = 0; ip < nb; ++ip) {
+        if (island_tag[ip] == -1)
+            island_tag[ip] = next_island_tag++;
     }
 
-    /// If some body still must change from no sleep-> sleep, do it
-    int need_Setup_B = 0;
-    for (int ip = 0; ip < bodylist.size(); ++ip) {
-        if (bodylist[ip]->BFlagGet(ChBody::BodyFlag::COULDSLEEP)) {
-            bodylist[ip]->SetSleeping(true);
-            ++need_Setup_B;
+    // STEP 5:
+    // Put to sleep or wake up the islands as a whole.
+
+    bool need_Setup = false;
+    nislands = 0;
+    nislands_sleep = 0;
+    for (int ip = 0; ip < nb; ++ip) {
+        if (fixed[ip])
+            continue;
+        ChBody* body = bodylist[ip].get();
+        int root = islands.Find(ip);
+        if (root == ip) {
+            nislands++;
+            if (!island_awake[root])
+                nislands_sleep++;
+        }
+        if (island_awake[root]) {
+            body->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
+            if (body->GetSleeping()) {
+                body->SetSleeping(false);
+                need_Setup = true;
+            }
+        } else {
+            if (!body->GetSleeping()) {
+                body->SetSleeping(true);
+                need_Setup = true;
+            }
+            body->SetSleepIsland(island_tag[root]);
         }
     }
 
     // if some body has been activated/deactivated because of sleep state changes,
-    // the offsets and DOF counts must be updated:
-    if (my_waker.need_Setup_A || need_Setup_B || need_Setup_L) {
+    // the offsets and DOF counts must be updated (and the variables injected again):
+    if (need_Setup) {
         Setup();
+        descriptor_dirty = true;
         return true;
     }
     return false;
@@ -616,13 +697,53 @@ bool ChSystem::ManageSleepingBodies() {
 // -----------------------------------------------------------------------------
 
 void ChSystem::DescriptorPrepareInject(ChSystemDescriptor& mdescriptor) {
-    mdescriptor.BeginInsertion();  // This resets the vectors of constr. and var. pointers.
+    CH_TRACE("DescriptorPrepareInject");
+
+    if (!use_incremental_descriptor) {
+        mdescriptor.BeginInsertion();  // This resets the vectors of constr. and var. pointers.
+
+        InjectConstraints(mdescriptor);
+        InjectVariables(mdescriptor);
+        InjectKRMmatrices(mdescriptor);
+
+        mdescriptor.EndInsertion();
+        return;
+    }
+
+    // Incremental mode: if the assembly did not change since the last full injection, its items are still
+    // registered at the beginning of the descriptor lists, so only the contacts must be injected again.
+    if (!descriptor_dirty && &mdescriptor == descriptor_injected && structure_counts == structure_counts_injected) {
+        mdescriptor.BeginIncrementalInsertion(descriptor_nconstraints, descriptor_nvariables, descriptor_nkblocks);
+
+        contact_container->InjectConstraints(mdescriptor);
+        contact_container->InjectVariables(mdescriptor);
+        contact_container->InjectKRMmatrices(mdescriptor);
 
-    InjectConstraints(mdescriptor);
-    InjectVariables(mdescriptor);
-    InjectKRMmatrices(mdescriptor);
+        mdescriptor.EndInsertion();
+        return;
+    }
+
+    // Full injection, keeping track of the number of items injected by the assembly.
+    mdescriptor.BeginInsertion();
+
+    ChAssembly::InjectConstraints(mdescriptor);
+    ChAssembly::InjectVariables(mdescriptor);
+    ChAssembly::InjectKRMmatrices(mdescriptor);
+
+    descriptor_nconstraints = mdescriptor.GetConstraintsList().size();
+    descriptor_nvariables = mdescriptor.GetVariablesList().size();
+    descriptor_nkblocks = mdescriptor.GetKblocksList().size();
+
+    contact_container->InjectConstraints(mdescriptor);
+    contact_container->InjectVariables(mdescriptor);
+    contact_container->InjectKRMmatrices(mdescriptor);
 
     mdescriptor.EndInsertion();
+
+    descriptor_injected = &mdescriptor;
+    structure_counts_injected = structure_counts;
+    descriptor_dirty = false;
+    ndescriptor_rebuilds++;
 }
 
 // -----------------------------------------------------------------------------
@@ -640,6 +761,10 @@ void ChSystem::Setup() {
     // inherit the parent class (compute offsets of bodies, links, etc.)
     ChAssembly::Setup();
 
+    // keep track of the structure of the assembly, to detect when the descriptor must be injected again
+    structure_counts = {{nstructure_changes, nbodies, nbodies_sleep, nbodies_fixed, nlinks, nphysicsitems, ncoords_w,
+                         ndoc_w}};
+
     // also compute offsets for contact container
     {
         contact_container->SetOffset_L(offset_L + ndoc_w);
@@ -1101,6 +1226,8 @@ bool ChSystem::StateSolveCorrection(ChStateDelta& Dv,             // result: com
     // If the solver's Setup() must be called or if the solver's Solve() requires it,
     // fill the sparse system structures with information in G and Cq.
     if (force_setup || GetSolver()->SolveRequiresMatrix()) {
+        CH_TRACE("LoadMatrices");
+
         // Cq  matrix
         ConstraintsLoadJacobians();
 
@@ -1133,6 +1260,7 @@ bool ChSystem::StateSolveCorrection(ChStateDelta& Dv,             // result: com
     // If indicated, first perform a solver setup.
     // Return 'false' if the setup phase fails.
     if (force_setup) {
+        CH_TRACE("SolverSetup");
         timer_setup.start();
         bool success = GetSolver()->Setup(*descriptor);
         timer_setup.stop();
@@ -1143,9 +1271,12 @@ bool ChSystem::StateSolveCorrection(ChStateDelta& Dv,             // result: com
 
     // Solve the problem
     // The solution is scattered in the provided system descriptor
-    timer_solver.start();
-    GetSolver()->Solve(*descriptor);
-    timer_solver.stop();
+    {
+        CH_TRACE("SolverSolve");
+        timer_solver.start();
+        GetSolver()->Solve(*descriptor);
+        timer_solver.stop();
+    }
     
 
     // Dv and L vectors  <-- sparse solver structures
@@ -1388,7 +1519,13 @@ void ChSystem::DumpSystemMatrices(bool save_M, bool save_K, bool save_R, bool sa
 
 int ChSystem::DoStepDynamics(double m_step) {
     step = m_step;
-    return Integrate_Y();
+    bool success = Integrate_Y();
+
+    // Mark the end of the step in the recorded timelines
+    if (utils::ChTraceProfiler::IsEnabled())
+        utils::ChTraceProfiler::NextStep();
+
+    return success;
 }
 
 // -----------------------------------------------------------------------------
@@ -15,6 +15,7 @@
 #ifndef CHSYSTEM_H
 #define CHSYSTEM_H
 
+#include <array>
 #include <cfloat>
 #include <memory>
 #include <cstdlib>
@@ -182,6 +183,8 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     /// Choose the solver type, to be used for the simultaneous solution of the constraints
     /// in dynamical simulations (as well as in kinematics, statics, etc.)
     ///   - Suggested solver for speed, but lower precision: SOR
+    ///   - Suggested solver for speed on multicore machines: SOR_COLORED (deterministic, uses
+    ///     the number of threads set with SetParallelThreadNumber)
     ///   - Suggested solver for higher precision: BARZILAIBORWEIN or APGD
     ///   - For problems that involve a stiffness matrix: MINRES
     ///
@@ -258,6 +261,7 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
 
     /// Changes the number of parallel threads (by default is n.of cores).
     /// Note that not all solvers use parallel computation.
+    /// The number of threads is also passed to the collision system (see ChCollisionSystem::SetNumThreads).
     /// If you have a N-core processor, this should be set at least =N for maximum performance.
     void SetParallelThreadNumber(int mthreads = 2);
     /// Get the number of parallel threads.
@@ -607,8 +611,41 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     /// Tell if the system will put to sleep the bodies whose motion has almost come to a rest.
     bool GetUseSleeping() const { return use_sleeping; }
 
+    /// Return the number of simulation islands found at the last step, i.e. the number of groups of
+    /// non-fixed bodies connected (directly or indirectly) by links and contacts.
+    /// Islands are computed only if sleeping is enabled (see SetUseSleeping()).
+    int GetNumIslands() const { return nislands; }
+
+    /// Return the number of simulation islands that are sleeping after the last step.
+    int GetNumSleepingIslands() const { return nislands_sleep; }
+
+    /// Enable or disable the incremental injection of the system descriptor (default: disabled).
+    /// By default, at each step all the variables, constraints and K blocks of bodies, links, meshes, etc. are
+    /// pushed again into the system descriptor. In incremental mode, the items injected by the assembly stay
+    /// registered in the descriptor from step to step, and only the contact container is injected again.
+    /// A full injection is still performed when bodies, links or other items are added or removed, when bodies go
+    /// to sleep or wake up, and when the number of active bodies, coordinates or constraints found by Setup()
+    /// changes. Changes that do not affect these counts (e.g. new elements added to a mesh between two steps)
+    /// must be notified with ForceDescriptorRebuild().
+    void SetUseIncrementalDescriptor(bool val) {
+        use_incremental_descriptor = val;
+        descriptor_dirty = true;
+    }
+
+    /// Tell if the incremental injection of the system descriptor is enabled.
+    bool GetUseIncrementalDescriptor() const { return use_incremental_descriptor; }
+
+    /// Force a full injection of the system descriptor at the next step (see SetUseIncrementalDescriptor()).
+    void ForceDescriptorRebuild() { descriptor_dirty = true; }
+
+    /// Return the number of full injections of the system descriptor performed so far.
+    int GetNumDescriptorRebuilds() const { return ndescriptor_rebuilds; }
+
   private:
     /// Put bodies to sleep if possible. Also awakens sleeping bodies, if needed.
+    /// Bodies are grouped in simulation islands (connected components of the graph of links and contacts,
+    /// where fixed bodies do not propagate the connectivity): an island falls asleep only when all its bodies
+    /// are at rest, and it is woken up as a whole as soon as one of its bodies is touched by an awake one.
     /// Returns true if some body changed from sleep to no sleep or viceversa,
     /// returns false if nothing changed. In the former case, also performs Setup()
     /// because the sleeping policy changed the totalDOFs and offsets.
@@ -801,7 +838,20 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
 
     int maxiter;  ///< max iterations for nonlinear convergence in DoAssembly()
 
-    bool use_sleeping;  ///< if true, put to sleep objects that come to rest
+    bool use_sleeping;    ///< if true, put to sleep objects that come to rest
+    int nislands;         ///< number of simulation islands found at the last step (if sleeping is enabled)
+    int nislands_sleep;   ///< number of sleeping simulation islands after the last step (if sleeping is enabled)
+    int next_island_tag;  ///< tag to be given to the next island that falls asleep
+
+    bool use_incremental_descriptor;               ///< if true, inject only the contacts when the assembly is unchanged
+    bool descriptor_dirty;                         ///< if true, a full injection of the descriptor is needed
+    int ndescriptor_rebuilds;                      ///< number of full injections of the descriptor
+    ChSystemDescriptor* descriptor_injected;       ///< descriptor used at the last full injection
+    size_t descriptor_nconstraints;                ///< number of constraints injected by the assembly
+    size_t descriptor_nvariables;                  ///< number of variables injected by the assembly
+    size_t descriptor_nkblocks;                    ///< number of K blocks injected by the assembly
+    std::array<int, 8> structure_counts;           ///< counts of the assembly items at the last Setup()
+    std::array<int, 8> structure_counts_injected;  ///< counts of the assembly items at the last full injection
 
     std::shared_ptr<ChSystemDescriptor> descriptor;  ///< the system descriptor
     std::shared_ptr<ChSolver> solver_speed;          ///< the solver for speed problem
@@ -21,6 +21,7 @@
 
 #include "chrono/physics/ChSystemNSC.h"
 #include "chrono/physics/ChContactContainerNSC.h"
+#include "chrono/physics/ChContactContainerPooledNSC.h"
 
 #include "chrono/physics/ChProximityContainer.h"
 
@@ -51,6 +52,7 @@ ChSystemNSC::ChSystemNSC(unsigned int max_objects, double scene_size, bool init_
 
         // Set default collision engine
         collision_system = std::make_shared<collision::ChCollisionSystemBullet>(max_objects, scene_size);
+        collision_system->SetNumThreads(parallel_thread_number);
 
         // Set the system descriptor
         descriptor = std::make_shared<ChSystemDescriptor>();
@@ -68,7 +70,8 @@ ChSystemNSC::ChSystemNSC(unsigned int max_objects, double scene_size, bool init_
 ChSystemNSC::ChSystemNSC(const ChSystemNSC& other) : ChSystem(other) {}
 
 void ChSystemNSC::SetContactContainer(std::shared_ptr<ChContactContainer> container) {
-    if (std::dynamic_pointer_cast<ChContactContainerNSC>(container))
+    if (std::dynamic_pointer_cast<ChContactContainerNSC>(container) ||
+        std::dynamic_pointer_cast<ChContactContainerPooledNSC>(container))
         ChSystem::SetContactContainer(container);
 }
 
@@ -63,6 +63,7 @@ class ChApi ChSystemNSC : public ChSystem {
     virtual ChBodyAuxRef* NewBodyAuxRef() override { return new ChBodyAuxRef(ChMaterialSurface::NSC); }
 
     /// Replace the contact container.
+    /// The provided container object must be inherited from ChContactContainerNSC or ChContactContainerPooledNSC.
     virtual void SetContactContainer(std::shared_ptr<ChContactContainer> container) override;
 
     // SERIALIZATION
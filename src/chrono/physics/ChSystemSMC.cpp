@@ -19,6 +19,7 @@
 
 #include "chrono/physics/ChSystemSMC.h"
 #include "chrono/physics/ChContactContainerSMC.h"
+#include "chrono/physics/ChContactContainerPooledSMC.h"
 
 #include "chrono/solver/ChSystemDescriptor.h"
 #include "chrono/solver/ChSolverSMC.h"
@@ -44,6 +45,7 @@ ChSystemSMC::ChSystemSMC(bool use_material_properties, unsigned int max_objects,
     solver_stab = std::make_shared<ChSolverSMC>();
 
     collision_system = std::make_shared<collision::ChCollisionSystemBullet>(max_objects, scene_size);
+    collision_system->SetNumThreads(parallel_thread_number);
 
     // For default SMC there is no need to create contacts 'in advance'
     // when models are closer than the safety envelope, so set default envelope to 0
@@ -59,7 +61,8 @@ ChSystemSMC::ChSystemSMC(bool use_material_properties, unsigned int max_objects,
 ChSystemSMC::ChSystemSMC(const ChSystemSMC& other) : ChSystem(other) {}
 
 void ChSystemSMC::SetContactContainer(std::shared_ptr<ChContactContainer> container) {
-    if (std::dynamic_pointer_cast<ChContactContainerSMC>(container))
+    if (std::dynamic_pointer_cast<ChContactContainerSMC>(container) ||
+        std::dynamic_pointer_cast<ChContactContainerPooledSMC>(container))
         ChSystem::SetContactContainer(container);
 }
 
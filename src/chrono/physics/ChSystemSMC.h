@@ -84,7 +84,7 @@ class ChApi ChSystemSMC : public ChSystem {
     virtual ChBodyAuxRef* NewBodyAuxRef() override { return new ChBodyAuxRef(ChMaterialSurface::SMC); }
 
     /// Replace the contact container.
-    /// The provided container object must be inherited from ChContactContainerSMC.
+    /// The provided container object must be inherited from ChContactContainerSMC or ChContactContainerPooledSMC.
     virtual void SetContactContainer(std::shared_ptr<ChContactContainer> container) override;
 
     /// Enable/disable using physical contact material properties.
@@ -15,6 +15,8 @@
 #ifndef CHCONSTRAINT_H
 #define CHCONSTRAINT_H
 
+#include <vector>
+
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChClassFactory.h"
 #include "chrono/core/ChMatrix.h"
@@ -22,6 +24,8 @@
 
 namespace chrono {
 
+class ChVariables;
+
 /// Modes for constraint
 enum eChConstraintMode {
     CONSTRAINT_FREE = 0,        ///< the constraint does not enforce anything
@@ -298,6 +302,26 @@ class ChApi ChConstraint {
     /// Same as Build_Cq, but puts the _transposed_ jacobian row as a column.
     virtual void Build_CqT(ChSparseMatrix& storage, int inscol) = 0;
 
+    /// Append to 'mvariables' the active ChVariables objects referenced by this constraint,
+    /// i.e. the variables read by Compute_Cq_q() and modified by Increment_q(), and return true
+    /// (nothing is appended if all the referenced variables are inactive, e.g. bodies fixed to ground).
+    /// This is used by solvers that need the connectivity of the constraint graph (ex: ChSolverSORcolored).
+    /// The default implementation appends nothing and returns false, meaning that the referenced variables are unknown.
+    virtual bool GetConstrainedVariables(std::vector<ChVariables*>& mvariables) const { return false; }
+
+    /// If the constraint couples exactly two blocks of 6 variables (e.g. two rigid bodies), return true and set
+    /// the two variables and the pointers to the jacobians [Cq_a], [Cq_b] and to the products [Eq_a], [Eq_b]
+    /// (6 elements each). Such constraints are processed in batches by the iterative solvers (see ChConstraintBatch).
+    /// The default implementation returns false.
+    virtual bool GetTwoBlocks6(ChVariables*& var_a,
+                               ChVariables*& var_b,
+                               const double*& Cq_a,
+                               const double*& Cq_b,
+                               const double*& Eq_a,
+                               const double*& Eq_b) const {
+        return false;
+    }
+
     /// Set offset in global q vector (set automatically by ChSystemDescriptor)
     void SetOffset(int moff) { offset = moff; }
 
@@ -0,0 +1,177 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <cstdint>
+
+#include "chrono/solver/ChConstraintBatch.h"
+#include "chrono/solver/ChVariables.h"
+
+namespace chrono {
+
+void ChConstraintBatch::Update(std::vector<ChConstraint*>& constraints) {
+    int n = (int)constraints.size();
+    slots.assign(n, -1);
+    others.clear();
+    offsets.clear();
+    cfm.clear();
+    q_a.clear();
+    q_b.clear();
+
+    ChVariables* var_a;
+    ChVariables* var_b;
+    const double* Cq_a;
+    const double* Cq_b;
+    const double* Eq_a;
+    const double* Eq_b;
+
+    // First pass: select the constraints to pack.
+    for (int ic = 0; ic < n; ic++) {
+        if (!constraints[ic]->IsActive())
+            continue;
+        if (constraints[ic]->GetTwoBlocks6(var_a, var_b, Cq_a, Cq_b, Eq_a, Eq_b)) {
+            slots[ic] = (int)offsets.size();
+            offsets.push_back(constraints[ic]->GetOffset());
+        } else {
+            others.push_back(ic);
+        }
+    }
+
+    // Allocate the blocks, aligned to 32 bytes.
+    int nb = (int)offsets.size();
+    buffer.resize((size_t)nb * block_size + 4);
+    uintptr_t address = reinterpret_cast<uintptr_t>(buffer.data());
+    data = buffer.data() + ((32 - address % 32) % 32) / sizeof(double);
+
+    // Second pass: copy the jacobians and the [Eq] products.
+    cfm.resize(nb);
+    q_a.resize(nb);
+    q_b.resize(nb);
+    for (int ic = 0; ic < n; ic++) {
+        int s = slots[ic];
+        if (s < 0)
+            continue;
+        constraints[ic]->GetTwoBlocks6(var_a, var_b, Cq_a, Cq_b, Eq_a, Eq_b);
+        double* block = Block(s);
+        for (int i = 0; i < 6; i++) {
+            block[i] = var_a->IsActive() ? Cq_a[i] : 0;
+            block[6 + i] = var_b->IsActive() ? Cq_b[i] : 0;
+            block[12 + i] = var_a->IsActive() ? Eq_a[i] : 0;
+            block[18 + i] = var_b->IsActive() ? Eq_b[i] : 0;
+        }
+        for (int i = 24; i < block_size; i++)
+            block[i] = 0;
+        q_a[s] = var_a->IsActive() ? var_a->Get_qb().GetAddress() : block + 24;
+        q_b[s] = var_b->IsActive() ? var_b->Get_qb().GetAddress() : block + 24;
+        cfm[s] = constraints[ic]->Get_cfm_i();
+    }
+
+    valid = true;
+}
+
+#ifdef CHRONO_HAS_AVX
+
+// Partial sums of [Cq]*q for one constraint, in the 4 lanes of a 256-bit register.
+static inline __m256d PartialDot(const double* block, const double* qa, const double* qb) {
+    __m256d qmid = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(qa + 4)), _mm_loadu_pd(qb), 1);
+    __m256d sum = _mm256_mul_pd(_mm256_load_pd(block), _mm256_loadu_pd(qa));
+    sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_load_pd(block + 4), qmid));
+    sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_load_pd(block + 8), _mm256_loadu_pd(qb + 2)));
+    return sum;
+}
+
+double ChConstraintBatch::Compute_Cq_q(int s) const {
+    __m256d sum = PartialDot(Block(s), q_a[s], q_b[s]);
+    __m128d sum2 = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+    return _mm_cvtsd_f64(_mm_hadd_pd(sum2, sum2));
+}
+
+void ChConstraintBatch::Increment_q(int s, double deltal) const {
+    const double* Eq = Block(s) + 12;
+    double* qa = q_a[s];
+    double* qb = q_b[s];
+    __m256d l4 = _mm256_set1_pd(deltal);
+    __m128d l2 = _mm_set1_pd(deltal);
+    _mm256_storeu_pd(qa, _mm256_add_pd(_mm256_loadu_pd(qa), _mm256_mul_pd(_mm256_load_pd(Eq), l4)));
+    _mm_storeu_pd(qa + 4, _mm_add_pd(_mm_loadu_pd(qa + 4), _mm_mul_pd(_mm_load_pd(Eq + 4), l2)));
+    _mm_storeu_pd(qb, _mm_add_pd(_mm_loadu_pd(qb), _mm_mul_pd(_mm_load_pd(Eq + 6), l2)));
+    _mm256_storeu_pd(qb + 2, _mm256_add_pd(_mm256_loadu_pd(qb + 2), _mm256_mul_pd(_mm256_load_pd(Eq + 8), l4)));
+}
+
+void ChConstraintBatch::Add_Cq_q_All(ChMatrix<>& result) const {
+    double* res = result.GetAddress();
+    int nb = (int)offsets.size();
+    int s = 0;
+
+    // Four constraints at once: reduce the four registers of partial sums into one register of results.
+    alignas(32) double r[4];
+    for (; s + 4 <= nb; s += 4) {
+        __m256d s0 = PartialDot(Block(s), q_a[s], q_b[s]);
+        __m256d s1 = PartialDot(Block(s + 1), q_a[s + 1], q_b[s + 1]);
+        __m256d s2 = PartialDot(Block(s + 2), q_a[s + 2], q_b[s + 2]);
+        __m256d s3 = PartialDot(Block(s + 3), q_a[s + 3], q_b[s + 3]);
+        __m256d t01 = _mm256_hadd_pd(s0, s1);
+        __m256d t23 = _mm256_hadd_pd(s2, s3);
+        __m256d sum = _mm256_add_pd(_mm256_permute2f128_pd(t01, t23, 0x20), _mm256_permute2f128_pd(t01, t23, 0x31));
+        _mm256_store_pd(r, sum);
+        res[offsets[s]] += r[0];
+        res[offsets[s + 1]] += r[1];
+        res[offsets[s + 2]] += r[2];
+        res[offsets[s + 3]] += r[3];
+    }
+
+    for (; s < nb; s++)
+        res[offsets[s]] += Compute_Cq_q(s);
+}
+
+#else
+
+double ChConstraintBatch::Compute_Cq_q(int s) const {
+    const double* block = Block(s);
+    const double* qa = q_a[s];
+    const double* qb = q_b[s];
+    double ret = 0;
+    for (int i = 0; i < 6; i++)
+        ret += block[i] * qa[i] + block[6 + i] * qb[i];
+    return ret;
+}
+
+void ChConstraintBatch::Increment_q(int s, double deltal) const {
+    const double* Eq = Block(s) + 12;
+    double* qa = q_a[s];
+    double* qb = q_b[s];
+    for (int i = 0; i < 6; i++) {
+        qa[i] += Eq[i] * deltal;
+        qb[i] += Eq[6 + i] * deltal;
+    }
+}
+
+void ChConstraintBatch::Add_Cq_q_All(ChMatrix<>& result) const {
+    double* res = result.GetAddress();
+    int nb = (int)offsets.size();
+    for (int s = 0; s < nb; s++)
+        res[offsets[s]] += Compute_Cq_q(s);
+}
+
+#endif
+
+void ChConstraintBatch::Increment_q_All(const ChMatrix<>& lvector, ChMatrix<>& result) const {
+    const double* l = lvector.GetAddress();
+    double* res = result.GetAddress();
+    int nb = (int)offsets.size();
+    for (int s = 0; s < nb; s++) {
+        double li = l[offsets[s]];
+        Increment_q(s, li);
+        res[offsets[s]] = cfm[s] * li;
+    }
+}
+
+}  // end namespace chrono
@@ -0,0 +1,92 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHCONSTRAINTBATCH_H
+#define CHCONSTRAINTBATCH_H
+
+#include <vector>
+
+#include "chrono/core/ChMatrix.h"
+#include "chrono/solver/ChConstraint.h"
+
+namespace chrono {
+
+/// Batch of the constraints that couple two blocks of 6 variables (e.g. contacts and links between rigid bodies),
+/// packed for vectorized processing in the inner loops of the iterative solvers.\n
+/// For each constraint, the batch keeps a copy of the jacobians [Cq_a], [Cq_b] and of the products
+/// [Eq_a]=[invM_a]*[Cq_a]', [Eq_b]=[invM_b]*[Cq_b]' in a contiguous block of 32-byte aligned memory, plus pointers
+/// to the speeds q of the two variables. This avoids the virtual calls and the scattered memory accesses of the
+/// generic ChConstraint interface. With AVX (see CHRONO_HAS_AVX), each product is computed with 256-bit
+/// instructions and Add_Cq_q_All() processes four constraints at once.\n
+/// Other constraints (e.g. constraints on FEA nodes or shafts) are not packed and must be processed through the
+/// ChConstraint interface (see GetOthers()).\n
+/// The batch is a snapshot: it must be refreshed with Update() whenever the jacobians, the masses or the set of
+/// active constraints change (the iterative solvers do it at each call of Solve(), via
+/// ChSystemDescriptor::UpdateConstraintBatch()).
+class ChApi ChConstraintBatch {
+  public:
+    ChConstraintBatch() : data(nullptr), valid(false) {}
+
+    /// Pack all the active constraints of the list that couple two blocks of 6 variables.
+    /// Update_auxiliary() must have been called on the constraints (to compute the [Eq] products).
+    void Update(std::vector<ChConstraint*>& constraints);
+
+    /// Mark the batch as out of date (until the next call to Update()).
+    void Invalidate() { valid = false; }
+
+    /// Return true if the batch was updated and not invalidated since.
+    bool IsValid() const { return valid; }
+
+    /// Return the number of packed constraints.
+    int GetNumConstraints() const { return (int)offsets.size(); }
+
+    /// Return the position in the batch of the i-th constraint of the list passed to Update(),
+    /// or -1 if the constraint is not in the batch.
+    int GetSlot(int i) const { return slots[i]; }
+
+    /// Return the indices (in the list passed to Update()) of the active constraints that are not in the batch.
+    const std::vector<int>& GetOthers() const { return others; }
+
+    /// Compute [Cq]*q for the constraint in the given slot (as ChConstraint::Compute_Cq_q()).
+    double Compute_Cq_q(int s) const;
+
+    /// Compute q += [Eq]*deltal for the constraint in the given slot (as ChConstraint::Increment_q()).
+    void Increment_q(int s, double deltal) const;
+
+    /// For all the packed constraints, add [Cq]*q to the element of \a result at the offset of the constraint.
+    void Add_Cq_q_All(ChMatrix<>& result) const;
+
+    /// For all the packed constraints, compute q += [Eq]*l_i, with l_i taken from \a lvector at the offset of the
+    /// constraint, and set the element of \a result at the offset of the constraint to cfm_i*l_i.
+    void Increment_q_All(const ChMatrix<>& lvector, ChMatrix<>& result) const;
+
+  private:
+    // Layout of the block of each constraint: [Cq_a | Cq_b | Eq_a | Eq_b | pad], where the pad is used, zeroed,
+    // in place of the speeds of an inactive variable.
+    static const int block_size = 32;
+
+    double* Block(int s) const { return data + (size_t)s * block_size; }
+
+    std::vector<double> buffer;  ///< storage for the blocks (over-allocated for the alignment)
+    double* data;                ///< first block, 32-byte aligned
+    std::vector<double*> q_a;    ///< speeds of the first variable of each constraint
+    std::vector<double*> q_b;    ///< speeds of the second variable of each constraint
+    std::vector<int> offsets;    ///< offset of each constraint (see ChConstraint::GetOffset())
+    std::vector<double> cfm;     ///< constraint force mixing term of each constraint
+    std::vector<int> slots;      ///< position in the batch of each constraint of the list, or -1
+    std::vector<int> others;     ///< active constraints not in the batch
+    bool valid;
+};
+
+}  // end namespace chrono
+
+#endif
@@ -39,6 +39,16 @@ ChConstraintThree& ChConstraintThree::operator=(const ChConstraintThree& other)
     return *this;
 }
 
+bool ChConstraintThree::GetConstrainedVariables(std::vector<ChVariables*>& mvariables) const {
+    if (variables_a->IsActive())
+        mvariables.push_back(variables_a);
+    if (variables_b->IsActive())
+        mvariables.push_back(variables_b);
+    if (variables_c->IsActive())
+        mvariables.push_back(variables_c);
+    return true;
+}
+
 void ChConstraintThree::ArchiveOUT(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChConstraintThree>();
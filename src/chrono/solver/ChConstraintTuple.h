@@ -128,6 +128,21 @@ class ChConstraintTuple_1vars {
         if (variables->IsActive())
             storage.PasteTranspMatrix(Cq, variables->GetOffset(), inscol);
     }
+
+    void GetConstrainedVariables(std::vector<ChVariables*>& mvariables) const {
+        if (variables->IsActive())
+            mvariables.push_back(variables);
+    }
+
+    /// If the tuple is a single block of 6 variables, return true and set the variables, the jacobian and [Eq].
+    bool GetBlock6(ChVariables*& var, const double*& mCq, const double*& mEq) const {
+        if (T::nvars1 != 6)
+            return false;
+        var = variables;
+        mCq = Cq.GetAddress();
+        mEq = Eq.GetAddress();
+        return true;
+    }
 };
 
 /// Case of tuple with reference to 2 ChVariable objects:
@@ -281,6 +296,16 @@ class ChConstraintTuple_2vars {
         if (variables_2->IsActive())
             storage.PasteTranspMatrix(Cq_2, variables_2->GetOffset(), inscol);
     }
+
+    void GetConstrainedVariables(std::vector<ChVariables*>& mvariables) const {
+        if (variables_1->IsActive())
+            mvariables.push_back(variables_1);
+        if (variables_2->IsActive())
+            mvariables.push_back(variables_2);
+    }
+
+    /// The tuple is not a single block of variables: return false.
+    bool GetBlock6(ChVariables*& var, const double*& mCq, const double*& mEq) const { return false; }
 };
 
 /// Case of tuple with reference to 3 ChVariable objects:
@@ -480,6 +505,18 @@ class ChConstraintTuple_3vars {
         if (variables_3->IsActive())
             storage.PasteTranspMatrix(Cq_3, variables_3->GetOffset(), inscol);
     }
+
+    void GetConstrainedVariables(std::vector<ChVariables*>& mvariables) const {
+        if (variables_1->IsActive())
+            mvariables.push_back(variables_1);
+        if (variables_2->IsActive())
+            mvariables.push_back(variables_2);
+        if (variables_3->IsActive())
+            mvariables.push_back(variables_3);
+    }
+
+    /// The tuple is not a single block of variables: return false.
+    bool GetBlock6(ChVariables*& var, const double*& mCq, const double*& mEq) const { return false; }
 };
 
 
@@ -726,6 +763,20 @@ class ChConstraintTuple_4vars {
         if (variables_4->IsActive())
             storage.PasteTranspMatrix(Cq_4, variables_4->GetOffset(), inscol);
     }
+
+    void GetConstrainedVariables(std::vector<ChVariables*>& mvariables) const {
+        if (variables_1->IsActive())
+            mvariables.push_back(variables_1);
+        if (variables_2->IsActive())
+            mvariables.push_back(variables_2);
+        if (variables_3->IsActive())
+            mvariables.push_back(variables_3);
+        if (variables_4->IsActive())
+            mvariables.push_back(variables_4);
+    }
+
+    /// The tuple is not a single block of variables: return false.
+    bool GetBlock6(ChVariables*& var, const double*& mCq, const double*& mEq) const { return false; }
 };
 
 /// This is a set of 'helper' classes that make easier to manage the templated
@@ -37,6 +37,14 @@ ChConstraintTwo& ChConstraintTwo::operator=(const ChConstraintTwo& other) {
     return *this;
 }
 
+bool ChConstraintTwo::GetConstrainedVariables(std::vector<ChVariables*>& mvariables) const {
+    if (variables_a->IsActive())
+        mvariables.push_back(variables_a);
+    if (variables_b->IsActive())
+        mvariables.push_back(variables_b);
+    return true;
+}
+
 void ChConstraintTwo::ArchiveOUT(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChConstraintTwo>();
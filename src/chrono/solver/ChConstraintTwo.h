@@ -66,6 +66,9 @@ class ChApi ChConstraintTwo : public ChConstraint {
     /// automatically creating/resizing jacobians if needed.
     virtual void SetVariables(ChVariables* mvariables_a, ChVariables* mvariables_b) = 0;
 
+    /// Append the active constrained variables to the given list (and return true).
+    virtual bool GetConstrainedVariables(std::vector<ChVariables*>& mvariables) const override;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive) override;
 
@@ -103,6 +103,22 @@ class ChApi ChConstraintTwoBodies : public ChConstraintTwo {
     /// indexes in result and vect;
     virtual void MultiplyTandAdd(ChMatrix<double>& result, double l) override;
 
+    /// Return the variables, the jacobians and the [Eq] products of both bodies.
+    virtual bool GetTwoBlocks6(ChVariables*& var_a,
+                               ChVariables*& var_b,
+                               const double*& mCq_a,
+                               const double*& mCq_b,
+                               const double*& mEq_a,
+                               const double*& mEq_b) const override {
+        var_a = variables_a;
+        var_b = variables_b;
+        mCq_a = Cq_a.GetAddress();
+        mCq_b = Cq_b.GetAddress();
+        mEq_a = Eq_a.GetAddress();
+        mEq_b = Eq_b.GetAddress();
+        return true;
+    }
+
     /// Puts the two jacobian parts into the 'insrow' row of a sparse matrix,
     /// where both portions of the jacobian are shifted in order to match the
     /// offset of the corresponding ChVariable.The same is done
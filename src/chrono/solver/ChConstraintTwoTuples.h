@@ -123,6 +123,24 @@ class ChConstraintTwoTuples : public ChConstraint {
         tuple_a.Build_CqT(storage, inscol);
         tuple_b.Build_CqT(storage, inscol);
     }
+
+    /// Append the active constrained variables of both tuples to the given list (and return true).
+    virtual bool GetConstrainedVariables(std::vector<ChVariables*>& mvariables) const override {
+        tuple_a.GetConstrainedVariables(mvariables);
+        tuple_b.GetConstrainedVariables(mvariables);
+        return true;
+    }
+
+    /// Return the variables, the jacobians and the [Eq] products of both tuples, if each tuple is made of
+    /// a single block of 6 variables.
+    virtual bool GetTwoBlocks6(ChVariables*& var_a,
+                               ChVariables*& var_b,
+                               const double*& Cq_a,
+                               const double*& Cq_b,
+                               const double*& Eq_a,
+                               const double*& Eq_b) const override {
+        return tuple_a.GetBlock6(var_a, Cq_a, Eq_a) && tuple_b.GetBlock6(var_b, Cq_b, Eq_b);
+    }
 };
 
 }  // end namespace chrono
@@ -0,0 +1,113 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/solver/ChIterativeSolver.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+bool ChIterativeSolver::SolveByIslands(ChSystemDescriptor& sysd, double& maxviolation) {
+    if (solving_island)
+        return false;
+
+    // Constraints with unknown variables may couple any two islands: in that case, solve all constraints at once.
+    num_islands = 0;
+    if (!solve_islands || record_violation_history)
+        return false;
+    sysd.ComputeIslands();
+    if (!sysd.GetUnknownConstraints().empty())
+        return false;
+
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+    const std::vector<int>& island_start = sysd.GetIslandStart();
+    const std::vector<int>& island_constraints = sysd.GetIslandConstraints();
+    int nislands = sysd.GetNumIslands();
+
+    // Collect the variables of each island. The descriptor of an island sets its own offsets in the variables and
+    // in the constraints, so the offsets of the whole system are saved here and restored at the end.
+    int nv = sysd.CountActiveVariables();
+    std::vector<int> var_island(nv, -1);
+    std::vector<int> island_var_start(nislands + 1, 0);
+    std::vector<ChVariables*> island_vars;
+    std::vector<ChVariables*> cvars;
+    for (int island = 0; island < nislands; island++) {
+        for (int k = island_start[island]; k < island_start[island + 1]; k++) {
+            cvars.clear();
+            mconstraints[island_constraints[k]]->GetConstrainedVariables(cvars);
+            for (auto var : cvars) {
+                if (var_island[var->GetOffset()] != island) {
+                    var_island[var->GetOffset()] = island;
+                    island_vars.push_back(var);
+                }
+            }
+        }
+        island_var_start[island + 1] = (int)island_vars.size();
+    }
+
+    std::vector<int> var_offsets;
+    for (auto var : mvariables) {
+        if (var->IsActive())
+            var_offsets.push_back(var->GetOffset());
+    }
+    std::vector<int> constraint_offsets;
+    for (auto constr : mconstraints) {
+        if (constr->IsActive())
+            constraint_offsets.push_back(constr->GetOffset());
+    }
+
+    // Variables not affected by any constraint: q = [M]'*fb
+    for (auto var : mvariables) {
+        if (var->IsActive() && var_island[var->GetOffset()] < 0)
+            var->Compute_invMb_v(var->Get_qb(), var->Get_fb());
+    }
+
+    // Solve the islands one after the other (the solver keeps its work data in its members).
+    ChSystemDescriptor island_sysd;
+    island_sysd.SetNumThreads(sysd.GetNumThreads());
+    island_sysd.SetUseConstraintBatch(sysd.GetUseConstraintBatch());
+
+    maxviolation = 0;
+    int max_island_iterations = 0;
+    solving_island = true;
+    for (int island = 0; island < nislands; island++) {
+        island_sysd.BeginInsertion();
+        for (int k = island_var_start[island]; k < island_var_start[island + 1]; k++)
+            island_sysd.InsertVariables(island_vars[k]);
+        for (int k = island_start[island]; k < island_start[island + 1]; k++)
+            island_sysd.InsertConstraint(mconstraints[island_constraints[k]]);
+        island_sysd.EndInsertion();
+
+        tot_iterations = 0;
+        maxviolation = ChMax(maxviolation, Solve(island_sysd));
+        max_island_iterations = ChMax(max_island_iterations, tot_iterations);
+    }
+    solving_island = false;
+
+    num_islands = nislands;
+    tot_iterations = max_island_iterations;
+
+    size_t iv = 0;
+    for (auto var : mvariables) {
+        if (var->IsActive())
+            var->SetOffset(var_offsets[iv++]);
+    }
+    size_t ic = 0;
+    for (auto constr : mconstraints) {
+        if (constr->IsActive())
+            constr->SetOffset(constraint_offsets[ic++]);
+    }
+
+    return true;
+}
+
+}  // end namespace chrono
@@ -48,6 +48,10 @@ class ChApi ChIterativeSolver : public ChSolver {
     std::vector<double> violation_history;
     std::vector<double> dlambda_history;
 
+    bool solve_islands;   ///< solve the islands of constraints as separate subproblems?
+    int num_islands;      ///< number of islands solved in the last call to Solve()
+    bool solving_island;  ///< true while SolveByIslands() solves an island
+
   public:
     ChIterativeSolver(int mmax_iters = 50,       ///< max.number of iterations
                       bool mwarm_start = false,  ///< uses warm start?
@@ -61,7 +65,10 @@ class ChApi ChIterativeSolver : public ChSolver {
           tolerance(mtolerance),
           omega(momega),
           shlambda(mshlambda),
-          record_violation_history(false) {}
+          record_violation_history(false),
+          solve_islands(false),
+          num_islands(0),
+          solving_island(false) {}
 
     virtual ~ChIterativeSolver() {}
 
@@ -135,7 +142,32 @@ class ChApi ChIterativeSolver : public ChSolver {
     /// Note that collection of constraint violations must be enabled through SetRecordViolation.
     const std::vector<double>& GetDeltalambdaHistory() const { return dlambda_history; };
 
+    /// Enable/disable solving the independent islands of constraints as separate subproblems (default: false).
+    /// The constraints are partitioned in islands that do not share any variable (see
+    /// ChSystemDescriptor::ComputeIslands()), and each island is solved with its own termination criterion:
+    /// islands at rest stop iterating as soon as they converge, instead of sweeping until the worst island of the
+    /// system converges. Not used if the violation history is recorded.
+    /// Supported by ChSolverSOR (which solves the islands in parallel), ChSolverSymmSOR, ChSolverJacobi,
+    /// ChSolverAPGD and ChSolverBB (which solve them one after the other); ignored by the other solvers.
+    /// Note: constraints must report their variables (see ChConstraint::GetConstrainedVariables); if any active
+    /// constraint does not, all the constraints are solved at once as if this option were disabled.
+    void SetSolveByIslands(bool val) { solve_islands = val; }
+
+    /// Tell if the independent islands of constraints are solved as separate subproblems.
+    bool GetSolveByIslands() const { return solve_islands; }
+
+    /// Return the number of islands solved in the last call to Solve() (0 if not solved by islands).
+    int GetNumIslands() const { return num_islands; }
+
   protected:
+    /// Solve the problem island by island, if enabled (see SetSolveByIslands()), by calling Solve() on a
+    /// descriptor that holds only the constraints of each island and their variables. Variables not affected by
+    /// any constraint are set to q = [M]'*fb. To be called at the beginning of Solve() by the solvers that support
+    /// islands.
+    /// Return false, doing nothing, if the problem must be solved at once; otherwise return true and set the
+    /// max. constraint violation of the worst island (the total iterations are those of the slowest island).
+    bool SolveByIslands(ChSystemDescriptor& sysd, double& maxviolation);
+
     /// This method MUST be called by all iterative methods INSIDE their iteration loops
     /// (at the end). If history recording is enabled, this function will store the
     /// current values as passed as arguments.
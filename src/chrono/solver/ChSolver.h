@@ -48,6 +48,7 @@ class ChApi ChSolver {
           MINRES,
           SOLVER_SMC,
           CUSTOM,
+          SOR_COLORED,
       };
 
     ChSolver() : verbose(false) {}
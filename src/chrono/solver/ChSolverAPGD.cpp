@@ -73,6 +73,11 @@ double ChSolverAPGD::Res4(ChSystemDescriptor& sysd) {
 }
 
 double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
+    // Solve island by island, if enabled.
+    double island_residual;
+    if (SolveByIslands(sysd, island_residual))
+        return island_residual;
+
     bool verbose = false;
     const std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
     const std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
@@ -85,6 +90,9 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
     for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
         mconstraints[ic]->Update_auxiliary();
 
+    // Pack the constraints between rigid bodies for the vectorized Schur complement products (if enabled)
+    sysd.UpdateConstraintBatch();
+
     double L, t;
     double theta;
     double thetaNew;
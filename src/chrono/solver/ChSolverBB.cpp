@@ -48,6 +48,12 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd  ///< system description with
 
     int i_friction_comp = 0;
     tot_iterations = 0;
+
+    // Solve island by island, if enabled.
+    double island_residual;
+    if (SolveByIslands(sysd, island_residual))
+        return island_residual;
+
     // Allocate auxiliary vectors;
 
     int nc = sysd.CountActiveConstraints();
@@ -72,6 +78,9 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd  ///< system description with
     for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
         mconstraints[ic]->Update_auxiliary();
 
+    // Pack the constraints between rigid bodies for the vectorized Schur complement products (if enabled)
+    sysd.UpdateConstraintBatch();
+
     // Average all g_i for the triplet of contact constraints n,u,v.
     //  Can be used for the fixed point phase and/or by preconditioner.
     int j_friction_comp = 0;
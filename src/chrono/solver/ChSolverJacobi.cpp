@@ -27,6 +27,11 @@ double ChSolverJacobi::Solve(ChSystemDescriptor& sysd  ///< system description w
     tot_iterations = 0;
     double maxviolation = 0.;
     double maxdeltalambda = 0;
+
+    // Solve island by island, if enabled.
+    if (SolveByIslands(sysd, maxviolation))
+        return maxviolation;
+
     int i_friction_comp = 0;
     double old_lambda_friction[3];
 
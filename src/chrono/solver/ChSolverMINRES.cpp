@@ -40,6 +40,9 @@ double ChSolverMINRES::Solve(ChSystemDescriptor& sysd  ///< system description w
     for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
         mconstraints[ic]->Update_auxiliary();
 
+    // Pack the constraints between rigid bodies for the vectorized Schur complement products (if enabled)
+    sysd.UpdateConstraintBatch();
+
     // Average all g_i for the triplet of contact constraints n,u,v.
     //  Can be used for the fixed point phase and/or by preconditioner.
     int j_friction_comp = 0;
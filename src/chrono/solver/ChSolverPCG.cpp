@@ -32,6 +32,9 @@ double ChSolverPCG::Solve(ChSystemDescriptor& sysd  ///< system description with
     for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
         mconstraints[ic]->Update_auxiliary();
 
+    // Pack the constraints between rigid bodies for the vectorized Schur complement products (if enabled)
+    sysd.UpdateConstraintBatch();
+
     // Allocate auxiliary vectors;
 
     int nc = sysd.CountActiveConstraints();
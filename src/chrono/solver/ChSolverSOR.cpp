@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/solver/ChSolverSOR.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 namespace chrono {
 
@@ -27,14 +28,16 @@ double ChSolverSOR::Solve(ChSystemDescriptor& sysd  ///< system description with
     tot_iterations = 0;
     double maxviolation = 0.;
     double maxdeltalambda = 0.;
-    int i_friction_comp = 0;
-    double old_lambda_friction[3];
 
     // 1)  Update auxiliary data in all constraints before starting,
     //     that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
     for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
         mconstraints[ic]->Update_auxiliary();
 
+    // Pack the constraints between rigid bodies for the vectorized kernels (if enabled)
+    sysd.UpdateConstraintBatch();
+    const ChConstraintBatch* batch = sysd.GetConstraintBatch().IsValid() ? &sysd.GetConstraintBatch() : nullptr;
+
     // Average all g_i for the triplet of contact constraints n,u,v.
     //
     int j_friction_comp = 0;
@@ -73,113 +76,185 @@ double ChSolverSOR::Solve(ChSystemDescriptor& sysd  ///< system description with
             mconstraints[ic]->Set_l_i(0.);
     }
 
-    // 4)  Perform the iteration loops
+    // 4)  Perform the iteration loops, either island by island or on all constraints at once
     //
 
+    // Constraints with unknown variables may couple any two islands: in that case, sweep all constraints at once.
+    num_islands = 0;
+    if (solve_islands && !record_violation_history) {
+        sysd.ComputeIslands();
+        if (sysd.GetUnknownConstraints().empty())
+            return SolveIslands(sysd, batch);
+    }
+
     for (int iter = 0; iter < max_iterations; iter++) {
         // The iteration on all constraints
         //
+        CH_TRACE("SOR iteration");
 
-        maxviolation = 0;
         maxdeltalambda = 0;
-        i_friction_comp = 0;
-
-        for (unsigned int ic = 0; ic < mconstraints.size(); ic++) {
-            // skip computations if constraint not active.
-            if (mconstraints[ic]->IsActive()) {
-                // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
-                double mresidual = mconstraints[ic]->Compute_Cq_q() + mconstraints[ic]->Get_b_i() +
-                                   mconstraints[ic]->Get_cfm_i() * mconstraints[ic]->Get_l_i();
-
-                // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
-                double candidate_violation = fabs(mconstraints[ic]->Violation(mresidual));
-
-                // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
-                double deltal = (omega / mconstraints[ic]->Get_g_i()) * (-mresidual);
-
-                if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC) {
-                    candidate_violation = 0;
-
-                    // update:   lambda += delta_lambda;
-                    old_lambda_friction[i_friction_comp] = mconstraints[ic]->Get_l_i();
-                    mconstraints[ic]->Set_l_i(old_lambda_friction[i_friction_comp] + deltal);
-                    i_friction_comp++;
-
-                    if (i_friction_comp == 1)
-                        candidate_violation = fabs(ChMin(0.0, mresidual));
-
-                    if (i_friction_comp == 3) {
-                        mconstraints[ic - 2]->Project();  // the N normal component will take care of N,U,V
-                        double new_lambda_0 = mconstraints[ic - 2]->Get_l_i();
-                        double new_lambda_1 = mconstraints[ic - 1]->Get_l_i();
-                        double new_lambda_2 = mconstraints[ic - 0]->Get_l_i();
-                        // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
-                        if (this->shlambda != 1.0) {
-                            new_lambda_0 = shlambda * new_lambda_0 + (1.0 - shlambda) * old_lambda_friction[0];
-                            new_lambda_1 = shlambda * new_lambda_1 + (1.0 - shlambda) * old_lambda_friction[1];
-                            new_lambda_2 = shlambda * new_lambda_2 + (1.0 - shlambda) * old_lambda_friction[2];
-                            mconstraints[ic - 2]->Set_l_i(new_lambda_0);
-                            mconstraints[ic - 1]->Set_l_i(new_lambda_1);
-                            mconstraints[ic - 0]->Set_l_i(new_lambda_2);
-                        }
-                        double true_delta_0 = new_lambda_0 - old_lambda_friction[0];
-                        double true_delta_1 = new_lambda_1 - old_lambda_friction[1];
-                        double true_delta_2 = new_lambda_2 - old_lambda_friction[2];
-                        mconstraints[ic - 2]->Increment_q(true_delta_0);
-                        mconstraints[ic - 1]->Increment_q(true_delta_1);
-                        mconstraints[ic - 0]->Increment_q(true_delta_2);
-
-                        if (this->record_violation_history) {
-                            maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_0));
-                            maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_1));
-                            maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_2));
-                        }
-                        i_friction_comp = 0;
-                    }
-                } else {
-                    // update:   lambda += delta_lambda;
-                    double old_lambda = mconstraints[ic]->Get_l_i();
-                    mconstraints[ic]->Set_l_i(old_lambda + deltal);
+        maxviolation = Sweep(mconstraints, batch, nullptr, (int)mconstraints.size(), maxdeltalambda);
+
+        // For recording into violation history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(maxviolation, maxdeltalambda, iter);
+
+        tot_iterations++;
+        // Terminate the loop if violation in constraints has been successfully limited.
+        if (maxviolation < tolerance)
+            break;
+
+    }  // end iteration loop
+
+    return maxviolation;
+}
+
+double ChSolverSOR::Sweep(std::vector<ChConstraint*>& mconstraints,
+                          const ChConstraintBatch* batch,
+                          const int* list,
+                          int n,
+                          double& maxdeltalambda) {
+    // [Cq_i]*q and q += [Eq_i]*deltal, through the batch if the constraint is packed
+    auto compute_Cq_q = [&](int ic) {
+        int s = batch ? batch->GetSlot(ic) : -1;
+        return s >= 0 ? batch->Compute_Cq_q(s) : mconstraints[ic]->Compute_Cq_q();
+    };
+    auto increment_q = [&](int ic, double deltal) {
+        int s = batch ? batch->GetSlot(ic) : -1;
+        if (s >= 0)
+            batch->Increment_q(s, deltal);
+        else
+            mconstraints[ic]->Increment_q(deltal);
+    };
+
+    double maxviolation = 0;
+    int i_friction_comp = 0;
+    double old_lambda_friction[3];
+
+    for (int k = 0; k < n; k++) {
+        int ic = list ? list[k] : k;
 
-                    // If new lagrangian multiplier does not satisfy inequalities, project
-                    // it into an admissible orthant (or, in general, onto an admissible set)
-                    mconstraints[ic]->Project();
+        // skip computations if constraint not active.
+        if (mconstraints[ic]->IsActive()) {
+            // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+            double mresidual = compute_Cq_q(ic) + mconstraints[ic]->Get_b_i() +
+                               mconstraints[ic]->Get_cfm_i() * mconstraints[ic]->Get_l_i();
 
-                    // After projection, the lambda may have changed a bit..
-                    double new_lambda = mconstraints[ic]->Get_l_i();
+            // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
+            double candidate_violation = fabs(mconstraints[ic]->Violation(mresidual));
 
+            // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+            double deltal = (omega / mconstraints[ic]->Get_g_i()) * (-mresidual);
+
+            if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC) {
+                candidate_violation = 0;
+
+                // update:   lambda += delta_lambda;
+                old_lambda_friction[i_friction_comp] = mconstraints[ic]->Get_l_i();
+                mconstraints[ic]->Set_l_i(old_lambda_friction[i_friction_comp] + deltal);
+                i_friction_comp++;
+
+                if (i_friction_comp == 1)
+                    candidate_violation = fabs(ChMin(0.0, mresidual));
+
+                if (i_friction_comp == 3) {
+                    mconstraints[ic - 2]->Project();  // the N normal component will take care of N,U,V
+                    double new_lambda_0 = mconstraints[ic - 2]->Get_l_i();
+                    double new_lambda_1 = mconstraints[ic - 1]->Get_l_i();
+                    double new_lambda_2 = mconstraints[ic - 0]->Get_l_i();
                     // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
                     if (this->shlambda != 1.0) {
-                        new_lambda = shlambda * new_lambda + (1.0 - shlambda) * old_lambda;
-                        mconstraints[ic]->Set_l_i(new_lambda);
+                        new_lambda_0 = shlambda * new_lambda_0 + (1.0 - shlambda) * old_lambda_friction[0];
+                        new_lambda_1 = shlambda * new_lambda_1 + (1.0 - shlambda) * old_lambda_friction[1];
+                        new_lambda_2 = shlambda * new_lambda_2 + (1.0 - shlambda) * old_lambda_friction[2];
+                        mconstraints[ic - 2]->Set_l_i(new_lambda_0);
+                        mconstraints[ic - 1]->Set_l_i(new_lambda_1);
+                        mconstraints[ic - 0]->Set_l_i(new_lambda_2);
+                    }
+                    double true_delta_0 = new_lambda_0 - old_lambda_friction[0];
+                    double true_delta_1 = new_lambda_1 - old_lambda_friction[1];
+                    double true_delta_2 = new_lambda_2 - old_lambda_friction[2];
+                    increment_q(ic - 2, true_delta_0);
+                    increment_q(ic - 1, true_delta_1);
+                    increment_q(ic - 0, true_delta_2);
+
+                    if (this->record_violation_history) {
+                        maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_0));
+                        maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_1));
+                        maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_2));
                     }
+                    i_friction_comp = 0;
+                }
+            } else {
+                // update:   lambda += delta_lambda;
+                double old_lambda = mconstraints[ic]->Get_l_i();
+                mconstraints[ic]->Set_l_i(old_lambda + deltal);
+
+                // If new lagrangian multiplier does not satisfy inequalities, project
+                // it into an admissible orthant (or, in general, onto an admissible set)
+                mconstraints[ic]->Project();
+
+                // After projection, the lambda may have changed a bit..
+                double new_lambda = mconstraints[ic]->Get_l_i();
+
+                // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+                if (this->shlambda != 1.0) {
+                    new_lambda = shlambda * new_lambda + (1.0 - shlambda) * old_lambda;
+                    mconstraints[ic]->Set_l_i(new_lambda);
+                }
 
-                    double true_delta = new_lambda - old_lambda;
+                double true_delta = new_lambda - old_lambda;
 
-                    // For all items with variables, add the effect of incremented
-                    // (and projected) lagrangian reactions:
-                    mconstraints[ic]->Increment_q(true_delta);
+                // For all items with variables, add the effect of incremented
+                // (and projected) lagrangian reactions:
+                increment_q(ic, true_delta);
 
-                    if (this->record_violation_history)
-                        maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta));
-                }
+                if (this->record_violation_history)
+                    maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta));
+            }
 
-                maxviolation = ChMax(maxviolation, fabs(candidate_violation));
+            maxviolation = ChMax(maxviolation, fabs(candidate_violation));
 
-            }  // end IsActive()
+        }  // end IsActive()
 
-        }  // end loop on constraints
+    }  // end loop on constraints
 
-        // For recording into violation history, if debugging
-        if (this->record_violation_history)
-            AtIterationEnd(maxviolation, maxdeltalambda, iter);
+    return maxviolation;
+}
 
-        tot_iterations++;
-        // Terminate the loop if violation in constraints has been successfully limited.
-        if (maxviolation < tolerance)
-            break;
+double ChSolverSOR::SolveIslands(ChSystemDescriptor& sysd, const ChConstraintBatch* batch) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    const std::vector<int>& island_start = sysd.GetIslandStart();
+    const std::vector<int>& island_constraints = sysd.GetIslandConstraints();
+    int nthreads = sysd.GetNumThreads();
+
+    num_islands = sysd.GetNumIslands();
+    std::vector<double> island_violation(num_islands, 0.0);
+    std::vector<int> island_iterations(num_islands, 0);
+
+    // The islands do not share variables, so they are solved in parallel without locks, each one with its own
+    // iteration loop and termination criterion (e.g. islands at rest converge after a few iterations).
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) if (nthreads > 1)
+    for (int island = 0; island < num_islands; island++) {
+        CH_TRACE("SOR island");
+        const int* list = island_constraints.data() + island_start[island];
+        int n = island_start[island + 1] - island_start[island];
+        for (int iter = 0; iter < max_iterations; iter++) {
+            double maxdeltalambda = 0;
+            island_violation[island] = Sweep(mconstraints, batch, list, n, maxdeltalambda);
+            island_iterations[island]++;
+            if (island_violation[island] < tolerance)
+                break;
+        }
+    }
 
-    }  // end iteration loop
+    // Report the worst island.
+    double maxviolation = 0;
+    tot_iterations = 0;
+    for (int island = 0; island < num_islands; island++) {
+        maxviolation = ChMax(maxviolation, island_violation[island]);
+        tot_iterations = ChMax(tot_iterations, island_iterations[island]);
+    }
 
     return maxviolation;
 }
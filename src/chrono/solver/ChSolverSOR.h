@@ -21,6 +21,8 @@ namespace chrono {
 
 /// An iterative solver based on projective fixed point method, with overrelaxation
 /// and immediate variable update as in SOR methods.\n
+/// When solving by islands (see SetSolveByIslands()), the islands are solved in parallel, using the number of
+/// threads set in the ChSystemDescriptor (see ChSystem::SetParallelThreadNumber).\n
 /// See ChSystemDescriptor for more information about the problem formulation and the data structures
 /// passed to the solver.
 
@@ -42,6 +44,20 @@ class ChApi ChSolverSOR : public ChIterativeSolver {
     /// \return  the maximum constraint violation after termination.
     virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
                          ) override;
+
+  private:
+    /// Perform one projected SOR sweep on the active constraints in the given list of indices
+    /// (on the first \a n constraints if the list is null). Constraints packed in the batch, if not null,
+    /// are processed with its vectorized kernels.
+    /// Return the max. constraint violation and update the max. change of the multipliers.
+    double Sweep(std::vector<ChConstraint*>& mconstraints,
+                 const ChConstraintBatch* batch,
+                 const int* list,
+                 int n,
+                 double& maxdeltalambda);
+
+    /// Perform the iteration loops island by island.
+    double SolveIslands(ChSystemDescriptor& sysd, const ChConstraintBatch* batch);
 };
 
 }  // end namespace chrono
@@ -0,0 +1,276 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <cstdint>
+
+#include "chrono/solver/ChSolverSORcolored.h"
+#include "chrono/utils/ChTraceProfiler.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChSolverSORcolored)
+
+void ChSolverSORcolored::ColorConstraints(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+
+    // The offsets of the active variables are used to index the color masks below.
+    int nv = sysd.CountActiveVariables();
+
+    // 1)  Group the active constraints: the three constraints of a frictional contact
+    //     (n,u,v) are projected together, hence they must be processed by the same thread.
+    group_constraint.clear();
+    group_size.clear();
+    int i_friction_comp = 0;
+    for (unsigned int ic = 0; ic < mconstraints.size(); ic++) {
+        if (!mconstraints[ic]->IsActive())
+            continue;
+        if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC) {
+            i_friction_comp++;
+            if (i_friction_comp == 3) {
+                group_constraint.push_back(ic - 2);
+                group_size.push_back(3);
+                i_friction_comp = 0;
+            }
+        } else {
+            group_constraint.push_back(ic);
+            group_size.push_back(1);
+        }
+    }
+
+    // 2)  Greedy coloring: each group gets the lowest color not yet used by any of its variables.
+    //     Each active variable keeps a bit mask of the colors used so far by its constraints.
+    int ngroups = (int)group_constraint.size();
+    std::vector<uint64_t> var_colors(nv, 0);
+    std::vector<int> group_color(ngroups);
+    std::vector<int> color_count;
+    std::vector<ChVariables*> group_vars;
+    sequential_groups.clear();
+
+    for (int ig = 0; ig < ngroups; ig++) {
+        group_vars.clear();
+        bool known = true;
+        for (int k = 0; k < group_size[ig]; k++)
+            known &= mconstraints[group_constraint[ig] + k]->GetConstrainedVariables(group_vars);
+
+        uint64_t used = 0;
+        for (auto var : group_vars)
+            used |= var_colors[var->GetOffset()];
+
+        // Unknown variables or no free color: leave the group to the sequential pass.
+        if (!known || used == ~uint64_t(0)) {
+            group_color[ig] = -1;
+            sequential_groups.push_back(ig);
+            continue;
+        }
+
+        int color = 0;
+        while (used & (uint64_t(1) << color))
+            color++;
+        for (auto var : group_vars)
+            var_colors[var->GetOffset()] |= uint64_t(1) << color;
+
+        group_color[ig] = color;
+        if (color >= (int)color_count.size())
+            color_count.resize(color + 1, 0);
+        color_count[color]++;
+    }
+
+    // 3)  Sort the groups by color (counting sort, stable, so the order is deterministic).
+    int ncolors = (int)color_count.size();
+    color_start.assign(ncolors + 1, 0);
+    for (int ic = 0; ic < ncolors; ic++)
+        color_start[ic + 1] = color_start[ic] + color_count[ic];
+
+    colored_groups.resize(color_start[ncolors]);
+    std::vector<int> color_fill(color_start.begin(), color_start.end() - 1);
+    for (int ig = 0; ig < ngroups; ig++) {
+        if (group_color[ig] >= 0)
+            colored_groups[color_fill[group_color[ig]]++] = ig;
+    }
+}
+
+double ChSolverSORcolored::SolveGroup(int group, std::vector<ChConstraint*>& mconstraints, double& maxdeltalambda) {
+    ChConstraint** mc = &mconstraints[group_constraint[group]];
+
+    if (group_size[group] == 1) {
+        // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+        double mresidual = mc[0]->Compute_Cq_q() + mc[0]->Get_b_i() + mc[0]->Get_cfm_i() * mc[0]->Get_l_i();
+
+        // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
+        double candidate_violation = fabs(mc[0]->Violation(mresidual));
+
+        // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+        double deltal = (omega / mc[0]->Get_g_i()) * (-mresidual);
+
+        // update:   lambda += delta_lambda, and project onto the admissible set
+        double old_lambda = mc[0]->Get_l_i();
+        mc[0]->Set_l_i(old_lambda + deltal);
+        mc[0]->Project();
+        double new_lambda = mc[0]->Get_l_i();
+
+        // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+        if (shlambda != 1.0) {
+            new_lambda = shlambda * new_lambda + (1.0 - shlambda) * old_lambda;
+            mc[0]->Set_l_i(new_lambda);
+        }
+
+        double true_delta = new_lambda - old_lambda;
+        mc[0]->Increment_q(true_delta);
+
+        if (record_violation_history)
+            maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta));
+
+        return candidate_violation;
+    }
+
+    // Friction triplet: update the three multipliers, then project onto the friction cone
+    // (the N normal component will take care of N,U,V) and update the variables.
+    double old_lambda[3];
+    double candidate_violation = 0;
+    for (int k = 0; k < 3; k++) {
+        double mresidual = mc[k]->Compute_Cq_q() + mc[k]->Get_b_i() + mc[k]->Get_cfm_i() * mc[k]->Get_l_i();
+        double deltal = (omega / mc[k]->Get_g_i()) * (-mresidual);
+        old_lambda[k] = mc[k]->Get_l_i();
+        mc[k]->Set_l_i(old_lambda[k] + deltal);
+        if (k == 0)
+            candidate_violation = fabs(ChMin(0.0, mresidual));
+    }
+
+    mc[0]->Project();
+
+    for (int k = 0; k < 3; k++) {
+        double new_lambda = mc[k]->Get_l_i();
+        if (shlambda != 1.0) {
+            new_lambda = shlambda * new_lambda + (1.0 - shlambda) * old_lambda[k];
+            mc[k]->Set_l_i(new_lambda);
+        }
+        double true_delta = new_lambda - old_lambda[k];
+        mc[k]->Increment_q(true_delta);
+
+        if (record_violation_history)
+            maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta));
+    }
+
+    return candidate_violation;
+}
+
+double ChSolverSORcolored::Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
+                                 ) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+    int nthreads = sysd.GetNumThreads();
+
+    tot_iterations = 0;
+    double maxviolation = 0.;
+    double maxdeltalambda = 0.;
+
+    // 1)  Update auxiliary data in all constraints before starting,
+    //     that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
+    //     (each constraint only writes its own data, so this can run in parallel)
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ic = 0; ic < (int)mconstraints.size(); ic++)
+        mconstraints[ic]->Update_auxiliary();
+
+    // Average all g_i for the triplet of contact constraints n,u,v.
+    //
+    int j_friction_comp = 0;
+    double gi_values[3];
+    for (unsigned int ic = 0; ic < mconstraints.size(); ic++) {
+        if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC) {
+            gi_values[j_friction_comp] = mconstraints[ic]->Get_g_i();
+            j_friction_comp++;
+            if (j_friction_comp == 3) {
+                double average_g_i = (gi_values[0] + gi_values[1] + gi_values[2]) / 3.0;
+                mconstraints[ic - 2]->Set_g_i(average_g_i);
+                mconstraints[ic - 1]->Set_g_i(average_g_i);
+                mconstraints[ic - 0]->Set_g_i(average_g_i);
+                j_friction_comp = 0;
+            }
+        }
+    }
+
+    // 2)  Compute, for all items with variables, the initial guess for
+    //     still unconstrained system:
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int iv = 0; iv < (int)mvariables.size(); iv++) {
+        if (mvariables[iv]->IsActive())
+            mvariables[iv]->Compute_invMb_v(mvariables[iv]->Get_qb(), mvariables[iv]->Get_fb());  // q = [M]'*fb
+    }
+
+    // 3)  For all items with variables, add the effect of initial (guessed)
+    //     lagrangian reactions of constraints, if a warm start is desired.
+    //     Otherwise, if no warm start, simply resets initial lagrangians to zero.
+    if (warm_start) {
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+            if (mconstraints[ic]->IsActive())
+                mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+    } else {
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+            mconstraints[ic]->Set_l_i(0.);
+    }
+
+    // 4)  Color the constraint graph
+    ColorConstraints(sysd);
+    int ncolors = GetNumColors();
+
+    // 5)  Perform the iteration loops.
+    //     Colors are processed in sequence (the implicit barrier at the end of each 'omp for'
+    //     makes sure that a color is complete before the next one starts); the groups of a same
+    //     color do not share variables, so they are processed in parallel without locks.
+
+    for (int iter = 0; iter < max_iterations; iter++) {
+        maxviolation = 0;
+        maxdeltalambda = 0;
+
+#pragma omp parallel num_threads(nthreads) if (nthreads > 1)
+        {
+            CH_TRACE("SOR colored iteration");
+            double t_maxviolation = 0;
+            double t_maxdeltalambda = 0;
+
+            for (int color = 0; color < ncolors; color++) {
+#pragma omp for schedule(static)
+                for (int i = color_start[color]; i < color_start[color + 1]; i++) {
+                    double violation = SolveGroup(colored_groups[i], mconstraints, t_maxdeltalambda);
+                    t_maxviolation = ChMax(t_maxviolation, violation);
+                }
+            }
+
+#pragma omp critical
+            {
+                maxviolation = ChMax(maxviolation, t_maxviolation);
+                maxdeltalambda = ChMax(maxdeltalambda, t_maxdeltalambda);
+            }
+        }
+
+        // Groups that could not be colored are processed sequentially.
+        for (auto group : sequential_groups) {
+            double violation = SolveGroup(group, mconstraints, maxdeltalambda);
+            maxviolation = ChMax(maxviolation, violation);
+        }
+
+        // For recording into violation history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(maxviolation, maxdeltalambda, iter);
+
+        tot_iterations++;
+        // Terminate the loop if violation in constraints has been successfully limited.
+        if (maxviolation < tolerance)
+            break;
+
+    }  // end iteration loop
+
+    return maxviolation;
+}
+
+}  // end namespace chrono
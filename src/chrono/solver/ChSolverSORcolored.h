@@ -0,0 +1,76 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHSOLVERSORCOLORED_H
+#define CHSOLVERSORCOLORED_H
+
+#include "chrono/solver/ChIterativeSolver.h"
+
+namespace chrono {
+
+/// An iterative solver based on projective fixed point method, with overrelaxation
+/// and immediate variable update as in SOR methods. Multi-threaded, lock-free and deterministic.\n
+/// At each call to Solve(), the constraints (or the triplets of constraints of a frictional contact)
+/// are partitioned in colors, such that two constraints of the same color never share a ChVariables
+/// object. The Gauss-Seidel sweep then processes the colors one after the other, and the constraints
+/// of a color in parallel: no two threads ever update the same variables, hence no locks are needed
+/// and the result does not depend on the number of threads.\n
+/// Constraints that cannot be colored (i.e. constraints that do not report their variables, see
+/// ChConstraint::GetConstrainedVariables, or constraints that would need more than 64 colors) are
+/// processed sequentially at the end of each sweep.\n
+/// The number of threads is the one set in the ChSystemDescriptor (see ChSystem::SetParallelThreadNumber).\n
+/// See ChSystemDescriptor for more information about the problem formulation and the data structures
+/// passed to the solver.
+
+class ChApi ChSolverSORcolored : public ChIterativeSolver {
+
+  public:
+    ChSolverSORcolored(int mmax_iters = 50,       ///< max.number of iterations
+                       bool mwarm_start = false,  ///< uses warm start?
+                       double mtolerance = 0.0,   ///< tolerance for termination criterion
+                       double momega = 1.0        ///< overrelaxation criterion
+                       )
+        : ChIterativeSolver(mmax_iters, mwarm_start, mtolerance, momega) {}
+
+    virtual ~ChSolverSORcolored() {}
+
+    virtual Type GetType() const override { return Type::SOR_COLORED; }
+
+    /// Performs the solution of the problem.
+    /// \return  the maximum constraint violation after termination.
+    virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
+                         ) override;
+
+    /// Return the number of colors used in the last call to Solve().
+    int GetNumColors() const { return color_start.empty() ? 0 : (int)color_start.size() - 1; }
+
+    /// Return the number of constraint groups that were processed sequentially in the last call to Solve().
+    int GetNumSequentialGroups() const { return (int)sequential_groups.size(); }
+
+  private:
+    /// Partition the active constraints in groups (single constraints or friction triplets) and color them.
+    void ColorConstraints(ChSystemDescriptor& sysd);
+
+    /// Perform one projected SOR update on the given group of constraints.
+    /// Return the constraint violation of the group and update the max. change of the multipliers.
+    double SolveGroup(int group, std::vector<ChConstraint*>& mconstraints, double& maxdeltalambda);
+
+    std::vector<int> group_constraint;   ///< index of the first constraint of each group
+    std::vector<int> group_size;         ///< number of constraints in each group (1 or 3)
+    std::vector<int> colored_groups;     ///< groups sorted by color
+    std::vector<int> color_start;        ///< start of each color in colored_groups (size: num. colors + 1)
+    std::vector<int> sequential_groups;  ///< groups that could not be colored
+};
+
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,156 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <limits>
+
+#include "chrono/solver/ChSolverSparseLU.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChSolverSparseLU)
+
+ChSolverSparseLU::ChSolverSparseLU()
+    : m_mat(1, 1),
+      m_dim(0),
+      m_topology(0),
+      m_solve_call(0),
+      m_setup_call(0),
+      m_analysis_call(0),
+      m_cache_hits(0),
+      m_cache_misses(0) {
+    // Explicit zeros are kept in the matrix, so that its layout (and its scatter map) only depends on the
+    // structure of the system.
+    m_mat.SetSparsityPatternLock(true);
+}
+
+bool ChSolverSparseLU::Setup(ChSystemDescriptor& sysd) {
+    m_timer_setup_assembly.start();
+
+    // Problem size (variables first, then constraints).
+    int nv = sysd.CountActiveVariables();
+    int dim = nv + sysd.CountActiveConstraints();
+
+    // Detect changes in the structure of the system since the last call. If there are none, the matrix keeps its
+    // layout and its values are scattered through the cached map (which also checks that the sequence of assembly
+    // calls did not change). Otherwise, perform a full reset of the matrix, so that the layout is rebuilt from scratch.
+    size_t topology = sysd.GetTopologyHash();
+    bool cached = m_setup_call > 0 && dim == m_dim && topology == m_topology;
+    // The nonzeros hint is computed in floating point (dim * dim overflows an int for large systems) and clamped.
+    if (!cached) {
+        double nnz_hint = std::min(static_cast<double>(dim) * dim * SPM_DEF_FULLNESS,
+                                   static_cast<double>(std::numeric_limits<int>::max()));
+        m_mat.Reset(dim, dim, static_cast<int>(nnz_hint));
+    }
+    m_dim = dim;
+    m_topology = topology;
+
+    m_mat.BeginScatterMap();
+    sysd.ConvertToMatrixForm(&m_mat, nullptr);
+    bool same_pattern = m_mat.EndScatterMap();
+    m_mat.Compress();
+
+    m_timer_setup_assembly.stop();
+
+    // Ordering and symbolic factorization, only if the sparsity pattern changed.
+    // The explicit comparison of the patterns is skipped if the assembly did not add any element (unless the engine
+    // discarded its analysis, e.g. after a change of the ordering).
+    bool analyzed = false;
+    if ((!same_pattern || !m_engine.IsAnalyzed()) && m_engine.PatternChanged(m_mat)) {
+        m_timer_setup_analysis.start();
+        m_engine.Analyze(m_mat, nv);
+        m_analysis_call++;
+        m_timer_setup_analysis.stop();
+        analyzed = true;
+    }
+
+    if (cached && !analyzed)
+        m_cache_hits++;
+    else
+        m_cache_misses++;
+
+    // Numeric factorization.
+    m_timer_setup_factorization.start();
+    bool success = m_engine.Factorize(m_mat);
+    m_timer_setup_factorization.stop();
+
+    m_setup_call++;
+
+    if (verbose) {
+        GetLog() << " SparseLU setup n = " << m_dim << "  nnz = " << m_mat.GetNNZ()
+                 << "  nnz(L) = " << m_engine.GetFactorNNZ()
+                 << "  perturbed pivots = " << m_engine.GetNumPerturbedPivots() << "\n";
+        GetLog() << "  assembly: " << m_timer_setup_assembly.GetTimeSecondsIntermediate() << "s"
+                 << "  analysis: " << m_timer_setup_analysis.GetTimeSecondsIntermediate() << "s"
+                 << "  factorization: " << m_timer_setup_factorization.GetTimeSecondsIntermediate() << "s\n";
+    }
+
+    if (!success) {
+        GetLog() << "SparseLU factorization error: zero pivot at row "
+                 << m_engine.GetPermutation()[m_engine.GetZeroPivot()]
+                 << " (singular matrix, e.g. redundant constraints: see ChSparseLUEngine::SetPivotPerturbation)\n";
+        return false;
+    }
+
+    return true;
+}
+
+double ChSolverSparseLU::Solve(ChSystemDescriptor& sysd) {
+    // Assemble the problem right-hand side vector.
+    m_timer_solve_assembly.start();
+    sysd.ConvertToMatrixForm(nullptr, &m_rhs);
+    m_timer_solve_assembly.stop();
+
+    // Forward/backward substitutions.
+    m_timer_solve_solvercall.start();
+    m_engine.Solve(m_rhs, m_sol);
+    m_timer_solve_solvercall.stop();
+
+    m_solve_call++;
+
+    if (verbose) {
+        GetLog() << " SparseLU solve call " << m_solve_call << "\n";
+        GetLog() << "  assembly: " << m_timer_solve_assembly.GetTimeSecondsIntermediate() << "s\n"
+                 << "  solver_call: " << m_timer_solve_solvercall.GetTimeSecondsIntermediate() << "\n";
+    }
+
+    // Scatter solution vector to the system descriptor.
+    m_timer_solve_assembly.start();
+    sysd.FromVectorToUnknowns(m_sol);
+    m_timer_solve_assembly.stop();
+
+    return 0.0;
+}
+
+void ChSolverSparseLU::ArchiveOUT(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChSolverSparseLU>();
+    // serialize parent class
+    ChSolver::ArchiveOUT(marchive);
+    // serialize all member data:
+    bool m_symmetric = m_engine.IsSymmetric();
+    marchive << CHNVP(m_symmetric);
+}
+
+void ChSolverSparseLU::ArchiveIN(ChArchiveIn& marchive) {
+    // version number
+    int version = marchive.VersionRead<ChSolverSparseLU>();
+    // deserialize parent class
+    ChSolver::ArchiveIN(marchive);
+    // stream in all member data:
+    bool m_symmetric;
+    marchive >> CHNVP(m_symmetric);
+    SetSymmetric(m_symmetric);
+}
+
+}  // end namespace chrono
@@ -0,0 +1,154 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHSOLVERSPARSELU_H
+#define CHSOLVERSPARSELU_H
+
+#include "chrono/core/ChCSMatrix.h"
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/solver/ChSolver.h"
+#include "chrono/solver/ChSparseLUEngine.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/** \class ChSolverSparseLU
+\brief Built-in sparse direct solver (LDU / LDL' factorization), with no external dependencies.
+
+Sparse linear direct solver, meant as a replacement for ChSolverMKL and ChSolverMumps where those are not available
+(e.g. for implicit integration of FEA problems with ChTimestepperHHT).
+Cannot handle VI and complementarity problems, so it cannot be used with NSC formulations.
+
+The system matrix is assembled in a ChCSMatrix and factorized by a ChSparseLUEngine:
+- the fill-reducing ordering and the symbolic factorization are computed only when the sparsity pattern of the
+  matrix changes, hence they are reused from call to call;
+- the numeric factorization is performed at each call to Setup() (e.g. at each Newton iteration).
+
+Changes in the topology of the system are detected automatically through ChSystemDescriptor::GetTopologyHash().
+As long as the topology does not change, the layout of the matrix and the symbolic factorization are cached, and
+the assembly only refills the values through the scatter map of the matrix (see ChCSMatrix::BeginScatterMap()),
+which also checks that the sparsity pattern did not change. No manual sparsity pattern lock is needed.
+The cache efficiency is reported by #GetNumCacheHits() and #GetNumCacheMisses().
+
+If the problem matrix is known to be symmetric, #SetSymmetric() halves the cost of the numeric factorization.
+
+The factorization does not pivot. Redundant constraints (e.g. a closed loop of joints, or two links imposing the
+same condition) make the matrix singular: the factorization then hits a zero pivot and #Setup() fails, whereas an
+iterative solver such as ChSolverMINRES still converges to one of the solutions. In this case, enable the static
+perturbation of small pivots, which solves a slightly regularized problem instead:
+\code{.cpp}
+lu_solver->GetEngine().SetPivotPerturbation(1e-10);
+\endcode
+The default fill-reducing ordering (approximate minimum degree) can be changed with ChSparseLUEngine::SetOrdering().
+
+Minimal usage example, to be put anywhere in the code, before starting the main simulation loop:
+\code{.cpp}
+auto lu_solver = std::make_shared<ChSolverSparseLU>();
+system.SetSolver(lu_solver);
+\endcode
+
+See ChSystemDescriptor for more information about the problem formulation and the data structures
+passed to the solver.
+*/
+class ChApi ChSolverSparseLU : public ChSolver {
+  public:
+    ChSolverSparseLU();
+
+    ~ChSolverSparseLU() override {}
+
+    /// Get a handle to the underlying factorization engine.
+    ChSparseLUEngine& GetEngine() { return m_engine; }
+
+    /// Get a handle to the underlying matrix.
+    ChCSMatrix& GetMatrix() { return m_mat; }
+
+    /// Enable/disable the assumption of a symmetric problem matrix (default: false).
+    void SetSymmetric(bool val) { m_engine.SetSymmetric(val); }
+
+    /// Reset timers for internal phases in Solve and Setup.
+    void ResetTimers() {
+        m_timer_setup_assembly.reset();
+        m_timer_setup_analysis.reset();
+        m_timer_setup_factorization.reset();
+        m_timer_solve_assembly.reset();
+        m_timer_solve_solvercall.reset();
+    }
+
+    /// Get cumulative time for assembly operations in Solve phase.
+    double GetTimeSolve_Assembly() const { return m_timer_solve_assembly(); }
+    /// Get cumulative time for the forward/backward substitutions in Solve phase.
+    double GetTimeSolve_SolverCall() const { return m_timer_solve_solvercall(); }
+    /// Get cumulative time for assembly operations in Setup phase.
+    double GetTimeSetup_Assembly() const { return m_timer_setup_assembly(); }
+    /// Get cumulative time for ordering and symbolic factorization in Setup phase.
+    double GetTimeSetup_Analysis() const { return m_timer_setup_analysis(); }
+    /// Get cumulative time for numeric factorization in Setup phase.
+    double GetTimeSetup_Factorization() const { return m_timer_setup_factorization(); }
+    /// Return the number of calls to the solver's Setup function.
+    int GetNumSetupCalls() const { return m_setup_call; }
+    /// Return the number of calls to the solver's Solve function.
+    int GetNumSolveCalls() const { return m_solve_call; }
+    /// Return the number of symbolic factorizations performed so far.
+    int GetNumAnalysisCalls() const { return m_analysis_call; }
+    /// Return the number of calls to Setup that reused the cached matrix layout and symbolic factorization.
+    int GetNumCacheHits() const { return m_cache_hits; }
+    /// Return the number of calls to Setup that rebuilt the matrix layout or the symbolic factorization.
+    int GetNumCacheMisses() const { return m_cache_misses; }
+
+    /// Indicate whether or not the #Solve() phase requires an up-to-date problem matrix.
+    /// As typical of direct solvers, only the #Setup() phase requires the matrix.
+    virtual bool SolveRequiresMatrix() const override { return false; }
+
+    /// Perform the solver setup operations: assemble the system matrix, update the symbolic factorization
+    /// if the sparsity pattern changed, and perform the numeric factorization.
+    /// Returns true if successful and false otherwise.
+    virtual bool Setup(ChSystemDescriptor& sysd) override;
+
+    /// Solve the linear system, using the factorization obtained at the last call to Setup().
+    virtual double Solve(ChSystemDescriptor& sysd) override;
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override;
+
+    /// Method to allow de serialization of transient data from archives.
+    virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  private:
+    ChSparseLUEngine m_engine;      ///< factorization engine
+    ChCSMatrix m_mat;               ///< problem matrix
+    ChMatrixDynamic<double> m_rhs;  ///< right-hand side vector
+    ChMatrixDynamic<double> m_sol;  ///< solution vector
+
+    int m_dim;            ///< problem size
+    size_t m_topology;    ///< topology signature of the system at the last call to Setup
+    int m_solve_call;     ///< counter for calls to Solve
+    int m_setup_call;     ///< counter for calls to Setup
+    int m_analysis_call;  ///< counter for symbolic factorizations
+    int m_cache_hits;     ///< counter for calls to Setup that reused the cached layout and analysis
+    int m_cache_misses;   ///< counter for calls to Setup that rebuilt the layout or the analysis
+
+    ChTimer<> m_timer_setup_assembly;       ///< timer for matrix assembly
+    ChTimer<> m_timer_setup_analysis;       ///< timer for ordering and symbolic factorization
+    ChTimer<> m_timer_setup_factorization;  ///< timer for numeric factorization
+    ChTimer<> m_timer_solve_assembly;       ///< timer for RHS assembly
+    ChTimer<> m_timer_solve_solvercall;     ///< timer for solution
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -31,6 +31,10 @@ double ChSolverSymmSOR::Solve(ChSystemDescriptor& sysd  ///< system description
     const unsigned int nConstr = (unsigned int)mconstraints.size();
     const unsigned int nVars = (unsigned int)mvariables.size();
 
+    // Solve island by island, if enabled.
+    if (SolveByIslands(sysd, maxviolation))
+        return maxviolation;
+
     // 1)  Update auxiliary data in all constraints before starting,
     //     that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
     for (unsigned int ic = 0; ic < nConstr; ic++)
@@ -0,0 +1,492 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// The symbolic and numeric factorizations follow the up-looking LDL' algorithm
+// of T. Davis ("Algorithm 849: a concise sparse Cholesky factorization package",
+// ACM TOMS 31(4), 2005), extended to LDU factorizations of matrices with
+// symmetric sparsity pattern.
+// The default ordering is the approximate minimum degree of P. Amestoy, T. Davis
+// and I. Duff ("An approximate minimum degree ordering algorithm", SIAM J. Matrix
+// Anal. Appl. 17(4), 1996), on the quotient graph of the elimination, with
+// element absorption and aggressive absorption (but no supervariables).
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <set>
+
+#include "chrono/solver/ChSparseLUEngine.h"
+
+namespace chrono {
+
+bool ChSparseLUEngine::PatternChanged(const ChCSMatrix& mat) const {
+    int n = mat.GetNumRows();
+    if (n != m_n || (int)m_ia.size() != n + 1)
+        return true;
+
+    const int* ia = mat.GetCS_LeadingIndexArray();
+    const int* ja = mat.GetCS_TrailingIndexArray();
+    int nnz = ia[n];
+    if (nnz != (int)m_ja.size())
+        return true;
+
+    return !std::equal(ia, ia + n + 1, m_ia.begin()) || !std::equal(ja, ja + nnz, m_ja.begin());
+}
+
+// Reverse Cuthill-McKee ordering of a graph: breadth-first visit of each connected component, starting from a node
+// of minimum degree and visiting the neighbors in order of increasing degree, then reversed.
+static void OrderRCM(const std::vector<int>& adj_p,
+                     const std::vector<int>& adj_i,
+                     const std::vector<int>& degree,
+                     std::vector<int>& order) {
+    int n = (int)degree.size();
+    auto by_degree = [&degree](int a, int b) { return degree[a] < degree[b] || (degree[a] == degree[b] && a < b); };
+
+    std::vector<int> nodes(n);
+    std::iota(nodes.begin(), nodes.end(), 0);
+    std::sort(nodes.begin(), nodes.end(), by_degree);
+
+    order.clear();
+    order.reserve(n);
+    std::vector<char> visited(n, 0);
+    for (auto start : nodes) {
+        if (visited[start])
+            continue;
+        visited[start] = 1;
+        size_t head = order.size();
+        order.push_back(start);
+        while (head < order.size()) {
+            int v = order[head++];
+            size_t first = order.size();
+            for (int p = adj_p[v]; p < adj_p[v] + degree[v]; p++) {
+                if (!visited[adj_i[p]]) {
+                    visited[adj_i[p]] = 1;
+                    order.push_back(adj_i[p]);
+                }
+            }
+            std::sort(order.begin() + first, order.end(), by_degree);
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+}
+
+// Approximate minimum degree ordering of a graph. The elimination is simulated on the quotient graph: each
+// eliminated node becomes an element, whose list holds the uneliminated nodes it connects; each node keeps the list
+// of its adjacent elements and of the adjacent nodes not yet reached through an element. The node of minimum
+// approximate degree is eliminated at each step (ties broken by index, so the ordering is deterministic).
+static void OrderAMD(const std::vector<int>& adj_p,
+                     const std::vector<int>& adj_i,
+                     const std::vector<int>& degree,
+                     std::vector<int>& order) {
+    int n = (int)degree.size();
+
+    std::vector<std::vector<int>> A(n);  // adjacent nodes
+    std::vector<std::vector<int>> E(n);  // adjacent elements
+    std::vector<std::vector<int>> L(n);  // nodes of each element
+    std::vector<char> status(n, 0);      // 0: node, 1: element, 2: absorbed element
+    std::vector<int> deg(degree);        // approximate external degree
+    std::set<std::pair<int, int>> queue;
+    for (int i = 0; i < n; i++) {
+        A[i].assign(adj_i.begin() + adj_p[i], adj_i.begin() + adj_p[i] + degree[i]);
+        queue.insert(std::make_pair(deg[i], i));
+    }
+
+    std::vector<int> mark(n, -1);   // mark[i] == k: node i belongs to the element formed at step k
+    std::vector<int> wmark(n, -1);  // wmark[e] == k: w[e] is up to date at step k
+    std::vector<int> w(n);          // size of L[e] minus the nodes of the new element
+
+    order.clear();
+    order.reserve(n);
+    for (int k = 0; k < n; k++) {
+        int p = queue.begin()->second;
+        queue.erase(queue.begin());
+        order.push_back(p);
+
+        // Form the new element p from the nodes adjacent to p, directly or through its elements (which are absorbed).
+        std::vector<int>& Lp = L[p];
+        mark[p] = k;
+        for (int e : E[p]) {
+            if (status[e] != 1)
+                continue;
+            for (int i : L[e]) {
+                if (status[i] == 0 && mark[i] != k) {
+                    mark[i] = k;
+                    Lp.push_back(i);
+                }
+            }
+            status[e] = 2;
+            std::vector<int>().swap(L[e]);
+        }
+        for (int i : A[p]) {
+            if (status[i] == 0 && mark[i] != k) {
+                mark[i] = k;
+                Lp.push_back(i);
+            }
+        }
+        status[p] = 1;
+        std::vector<int>().swap(A[p]);
+        std::vector<int>().swap(E[p]);
+
+        // Number of nodes of the other elements that are not in the new element.
+        for (int i : Lp) {
+            for (int e : E[i]) {
+                if (status[e] != 1)
+                    continue;
+                if (wmark[e] != k) {
+                    wmark[e] = k;
+                    w[e] = (int)L[e].size();
+                }
+                w[e]--;
+            }
+        }
+
+        // Update the nodes of the new element and their approximate degrees.
+        int ext = (int)Lp.size() - 1;
+        int max_deg = n - k - 2;
+        for (int i : Lp) {
+            // Elements entirely contained in the new element are absorbed (aggressive absorption).
+            int sum = 0;
+            size_t m = 0;
+            for (int e : E[i]) {
+                if (status[e] != 1)
+                    continue;
+                if (w[e] == 0) {
+                    status[e] = 2;
+                    std::vector<int>().swap(L[e]);
+                    continue;
+                }
+                sum += w[e];
+                E[i][m++] = e;
+            }
+            E[i].resize(m);
+            E[i].push_back(p);
+
+            // Nodes of the new element are now reached through it.
+            m = 0;
+            for (int j : A[i]) {
+                if (status[j] == 0 && mark[j] != k)
+                    A[i][m++] = j;
+            }
+            A[i].resize(m);
+
+            int d = std::min(max_deg, std::min(deg[i] + ext, (int)A[i].size() + ext + sum));
+            d = std::max(d, 0);
+            if (d != deg[i]) {
+                queue.erase(std::make_pair(deg[i], i));
+                deg[i] = d;
+                queue.insert(std::make_pair(d, i));
+            }
+        }
+    }
+}
+
+void ChSparseLUEngine::ComputeOrdering(const int* ia, const int* ja) {
+    int n = m_n;
+
+    // Adjacency structure of the graph of (A+A'), without self loops.
+    std::vector<int> adj_p(n + 1, 0);
+    for (int r = 0; r < n; r++) {
+        for (int s = ia[r]; s < ia[r + 1]; s++) {
+            if (ja[s] != r) {
+                adj_p[r + 1]++;
+                adj_p[ja[s] + 1]++;
+            }
+        }
+    }
+    for (int r = 0; r < n; r++)
+        adj_p[r + 1] += adj_p[r];
+    std::vector<int> adj_i(adj_p[n]);
+    std::vector<int> fill(adj_p.begin(), adj_p.end() - 1);
+    for (int r = 0; r < n; r++) {
+        for (int s = ia[r]; s < ia[r + 1]; s++) {
+            if (ja[s] != r) {
+                adj_i[fill[r]++] = ja[s];
+                adj_i[fill[ja[s]]++] = r;
+            }
+        }
+    }
+    // remove duplicates (entries present in both triangles)
+    std::vector<int> degree(n);
+    for (int r = 0; r < n; r++) {
+        std::sort(adj_i.begin() + adj_p[r], adj_i.begin() + adj_p[r + 1]);
+        degree[r] = (int)(std::unique(adj_i.begin() + adj_p[r], adj_i.begin() + adj_p[r + 1]) - adj_i.begin()) -
+                    adj_p[r];
+    }
+
+    std::vector<int> order;
+    if (m_ordering == Ordering::RCM)
+        OrderRCM(adj_p, adj_i, degree, order);
+    else
+        OrderAMD(adj_p, adj_i, degree, order);
+
+    // Move each non-primary node right after the last primary node it is coupled to.
+    std::vector<int> rank(n);
+    for (int i = 0; i < n; i++)
+        rank[order[i]] = i;
+
+    std::vector<std::pair<int, int>> deferred;  // (rank of anchor, rank of node)
+    for (int v = m_num_primary; v < n; v++) {
+        int anchor = -1;
+        for (int p = adj_p[v]; p < adj_p[v] + degree[v]; p++) {
+            if (adj_i[p] < m_num_primary)
+                anchor = std::max(anchor, rank[adj_i[p]]);
+        }
+        // nodes not coupled to any primary node go last
+        deferred.push_back(std::make_pair(anchor >= 0 ? anchor : n, rank[v]));
+    }
+    std::sort(deferred.begin(), deferred.end());
+
+    m_P.clear();
+    m_P.reserve(n);
+    size_t id = 0;
+    for (int i = 0; i < n; i++) {
+        if (order[i] >= m_num_primary)
+            continue;
+        m_P.push_back(order[i]);
+        for (; id < deferred.size() && deferred[id].first == i; id++)
+            m_P.push_back(order[deferred[id].second]);
+    }
+    for (; id < deferred.size(); id++)
+        m_P.push_back(order[deferred[id].second]);
+
+    m_Pinv.resize(n);
+    for (int i = 0; i < n; i++)
+        m_Pinv[m_P[i]] = i;
+}
+
+void ChSparseLUEngine::Analyze(const ChCSMatrix& mat, int num_primary) {
+    const int* ia = mat.GetCS_LeadingIndexArray();
+    const int* ja = mat.GetCS_TrailingIndexArray();
+
+    m_n = mat.GetNumRows();
+    m_num_primary = (num_primary < 0 || num_primary > m_n) ? m_n : num_primary;
+    int n = m_n;
+    int nnz = ia[n];
+
+    m_ia.assign(ia, ia + n + 1);
+    m_ja.assign(ja, ja + nnz);
+
+    // 1) Fill-reducing ordering.
+    ComputeOrdering(ia, ja);
+
+    // 2) Upper triangle of the permuted matrix, by columns, keeping track of the position of
+    //    both A(i,k) and A(k,i) in the original value array.
+    std::vector<int> count(n + 1, 0);
+    m_Cdiag.assign(n, -1);
+    for (int r = 0; r < n; r++) {
+        for (int s = ia[r]; s < ia[r + 1]; s++) {
+            int pr = m_Pinv[r];
+            int pc = m_Pinv[ja[s]];
+            if (pr == pc)
+                m_Cdiag[pr] = s;
+            else
+                count[std::max(pr, pc) + 1]++;
+        }
+    }
+    for (int k = 0; k < n; k++)
+        count[k + 1] += count[k];
+
+    std::vector<int> tmp_i(count[n]);
+    std::vector<int> tmp_s(count[n]);
+    std::vector<int> fill(count.begin(), count.end() - 1);
+    for (int r = 0; r < n; r++) {
+        for (int s = ia[r]; s < ia[r + 1]; s++) {
+            int pr = m_Pinv[r];
+            int pc = m_Pinv[ja[s]];
+            if (pr == pc)
+                continue;
+            int k = std::max(pr, pc);
+            tmp_i[fill[k]] = std::min(pr, pc);
+            tmp_s[fill[k]] = (pr < pc) ? s : -(s + 1);  // negative: entry from the lower triangle
+            fill[k]++;
+        }
+    }
+
+    m_Cp.assign(n + 1, 0);
+    m_Ci.clear();
+    m_Cup.clear();
+    m_Clo.clear();
+    std::vector<int> mark(n, -1);
+    std::vector<int> where(n);
+    for (int k = 0; k < n; k++) {
+        for (int p = count[k]; p < count[k + 1]; p++) {
+            int i = tmp_i[p];
+            if (mark[i] != k) {
+                mark[i] = k;
+                where[i] = (int)m_Ci.size();
+                m_Ci.push_back(i);
+                m_Cup.push_back(-1);
+                m_Clo.push_back(-1);
+            }
+            if (tmp_s[p] >= 0)
+                m_Cup[where[i]] = tmp_s[p];
+            else
+                m_Clo[where[i]] = -tmp_s[p] - 1;
+        }
+        m_Cp[k + 1] = (int)m_Ci.size();
+    }
+
+    // 3) Elimination tree and number of non-zeros in each column of L.
+    m_parent.assign(n, -1);
+    m_Lnz.assign(n, 0);
+    m_flag.assign(n, -1);
+    for (int k = 0; k < n; k++) {
+        m_flag[k] = k;
+        for (int p = m_Cp[k]; p < m_Cp[k + 1]; p++) {
+            for (int i = m_Ci[p]; m_flag[i] != k; i = m_parent[i]) {
+                if (m_parent[i] == -1)
+                    m_parent[i] = k;
+                m_Lnz[i]++;
+                m_flag[i] = k;
+            }
+        }
+    }
+
+    m_Lp.assign(n + 1, 0);
+    for (int k = 0; k < n; k++)
+        m_Lp[k + 1] = m_Lp[k] + m_Lnz[k];
+
+    m_Li.resize(m_Lp[n]);
+    m_Lx.resize(m_Lp[n]);
+    m_Ux.resize(m_symmetric ? 0 : m_Lp[n]);
+    m_D.resize(n);
+    m_pattern.resize(n);
+    m_Y.assign(n, 0.0);
+    m_Z.assign(n, 0.0);
+}
+
+bool ChSparseLUEngine::Factorize(const ChCSMatrix& mat) {
+    const double* Ax = mat.GetCS_ValueArray();
+    int n = m_n;
+
+    if (!m_symmetric)
+        m_Ux.resize(m_Lp[n]);
+
+    m_zero_pivot = -1;
+    m_num_perturbed = 0;
+    std::fill(m_flag.begin(), m_flag.end(), -1);
+
+    // Threshold for the perturbation of small pivots.
+    double threshold = 0;
+    if (m_pivot_perturbation > 0) {
+        for (int s = 0; s < m_ia[n]; s++)
+            threshold = std::max(threshold, std::abs(Ax[s]));
+        threshold *= m_pivot_perturbation;
+    }
+
+    for (int k = 0; k < n; k++) {
+        // Scatter column k of the upper triangle (and row k of the lower triangle) in the work
+        // arrays, and find the nonzero pattern of row k of L by walking the elimination tree.
+        int top = n;
+        m_flag[k] = k;
+        m_Lnz[k] = 0;
+        for (int p = m_Cp[k]; p < m_Cp[k + 1]; p++) {
+            int i = m_Ci[p];
+            double a_ik = m_Cup[p] >= 0 ? Ax[m_Cup[p]] : 0.0;
+            double a_ki = m_Clo[p] >= 0 ? Ax[m_Clo[p]] : 0.0;
+            if (m_symmetric) {
+                m_Y[i] += m_Cup[p] >= 0 ? a_ik : a_ki;
+            } else {
+                m_Y[i] += a_ik;
+                m_Z[i] += a_ki;
+            }
+            int len = 0;
+            for (; m_flag[i] != k; i = m_parent[i]) {
+                m_pattern[len++] = i;
+                m_flag[i] = k;
+            }
+            while (len > 0)
+                m_pattern[--top] = m_pattern[--len];
+        }
+
+        // Sparse triangular solves: L*y = A(0:k-1,k) and U'*z = A(k,0:k-1)'
+        double d = m_Cdiag[k] >= 0 ? Ax[m_Cdiag[k]] : 0.0;
+        for (; top < n; top++) {
+            int i = m_pattern[top];
+            int p2 = m_Lp[i] + m_Lnz[i];
+            double yi = m_Y[i];
+            m_Y[i] = 0;
+            if (m_symmetric) {
+                for (int p = m_Lp[i]; p < p2; p++)
+                    m_Y[m_Li[p]] -= m_Lx[p] * yi;
+                double l_ki = yi / m_D[i];
+                d -= l_ki * yi;
+                m_Li[p2] = k;
+                m_Lx[p2] = l_ki;
+            } else {
+                double zi = m_Z[i];
+                m_Z[i] = 0;
+                for (int p = m_Lp[i]; p < p2; p++) {
+                    m_Y[m_Li[p]] -= m_Lx[p] * yi;
+                    m_Z[m_Li[p]] -= m_Ux[p] * zi;
+                }
+                d -= zi * yi / m_D[i];
+                m_Li[p2] = k;
+                m_Lx[p2] = zi / m_D[i];
+                m_Ux[p2] = yi / m_D[i];
+            }
+            m_Lnz[i]++;
+        }
+
+        if (threshold > 0 && std::abs(d) < threshold) {
+            // constraint rows have negative pivots
+            bool negative = d < 0 || (d == 0 && m_P[k] >= m_num_primary);
+            d = negative ? -threshold : threshold;
+            m_num_perturbed++;
+        }
+        if (d == 0) {
+            m_zero_pivot = k;
+            return false;
+        }
+        m_D[k] = d;
+    }
+
+    return true;
+}
+
+void ChSparseLUEngine::Solve(const ChMatrix<>& b, ChMatrix<>& x) const {
+    int n = m_n;
+    const std::vector<double>& Ux = m_symmetric ? m_Lx : m_Ux;
+
+    m_X.resize(n);
+    for (int k = 0; k < n; k++)
+        m_X[k] = b.GetElementN(m_P[k]);
+
+    // L*y = P*b
+    for (int j = 0; j < n; j++) {
+        double xj = m_X[j];
+        for (int p = m_Lp[j]; p < m_Lp[j + 1]; p++)
+            m_X[m_Li[p]] -= m_Lx[p] * xj;
+    }
+
+    // D*z = y
+    for (int j = 0; j < n; j++)
+        m_X[j] /= m_D[j];
+
+    // U*w = z
+    for (int j = n - 1; j >= 0; j--) {
+        double xj = m_X[j];
+        for (int p = m_Lp[j]; p < m_Lp[j + 1]; p++)
+            xj -= Ux[p] * m_X[m_Li[p]];
+        m_X[j] = xj;
+    }
+
+    // x = P'*w
+    x.Resize(n, 1);
+    for (int k = 0; k < n; k++)
+        x.SetElementN(m_P[k], m_X[k]);
+}
+
+}  // end namespace chrono
@@ -0,0 +1,169 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHSPARSELUENGINE_H
+#define CHSPARSELUENGINE_H
+
+#include <vector>
+
+#include "chrono/core/ChCSMatrix.h"
+#include "chrono/core/ChMatrixDynamic.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Sparse direct factorization engine, used by ChSolverSparseLU.
+/// Factorizes a square matrix in compressed sparse row format (ChCSMatrix) as P*A*P' = L*D*U, with L unit lower
+/// triangular, D diagonal and U unit upper triangular (for a symmetric matrix U = L', i.e. an LDL' factorization).
+/// The work is split in the usual phases:
+/// - Analyze(): fill-reducing ordering (approximate minimum degree by default, see SetOrdering()) and symbolic
+///   factorization (elimination tree and structure of the factors). It depends only on the sparsity pattern, hence
+///   it can be reused as long as the pattern of the matrix does not change (see PatternChanged()).
+/// - Factorize(): numeric factorization (up-looking, no pivoting), to be repeated whenever the values change.
+/// - Solve(): forward/backward substitution.
+///
+/// No pivoting is performed, so the factorization relies on the ordering to avoid zero pivots. For the saddle-point
+/// matrices assembled by ChSystemDescriptor::ConvertToMatrixForm() (variables first, then constraints, with a
+/// possibly zero diagonal in the constraint block) the constraint rows are ordered right after the last of the
+/// variables they act on, so that their pivots are the (nonzero) Schur complement. This is not enough if the matrix
+/// is singular, e.g. with redundant constraints: see SetPivotPerturbation().
+class ChApi ChSparseLUEngine {
+  public:
+    /// Fill-reducing orderings.
+    enum class Ordering {
+        AMD,  ///< approximate minimum degree (default)
+        RCM   ///< reverse Cuthill-McKee (bandwidth reducing, usually more fill-in than AMD on 3D meshes)
+    };
+
+    ChSparseLUEngine()
+        : m_n(0),
+          m_num_primary(0),
+          m_ordering(Ordering::AMD),
+          m_symmetric(false),
+          m_pivot_perturbation(0),
+          m_zero_pivot(-1),
+          m_num_perturbed(0) {}
+
+    /// Set the fill-reducing ordering used by the next call to Analyze() (default: AMD).
+    void SetOrdering(Ordering ordering) {
+        m_ordering = ordering;
+        m_ia.clear();  // force a new analysis
+    }
+
+    /// Return the fill-reducing ordering.
+    Ordering GetOrdering() const { return m_ordering; }
+
+    /// Set the relative threshold for the static perturbation of small pivots (default: 0, i.e. no perturbation).
+    /// If positive, each pivot smaller in magnitude than eps*max|A(i,j)| is replaced by +/-eps*max|A(i,j)|
+    /// (negative for the constraint rows), so that the factorization of a singular matrix (e.g. a mechanism with
+    /// redundant constraints) succeeds. The solution is then that of a slightly regularized problem; a value such as
+    /// 1e-10 works for the saddle-point matrices of ChSystemDescriptor.
+    void SetPivotPerturbation(double eps) { m_pivot_perturbation = eps; }
+
+    /// Return the relative threshold for the static perturbation of small pivots.
+    double GetPivotPerturbation() const { return m_pivot_perturbation; }
+
+    /// Assume a symmetric matrix: an LDL' factorization is computed, reading each off-diagonal pair from the
+    /// upper triangle (or from the lower one, if the upper entry is not stored).
+    /// Default: false (general LDU factorization of a matrix with symmetric sparsity pattern; entries missing
+    /// from one of the two triangles are treated as zeros).
+    void SetSymmetric(bool val) { m_symmetric = val; }
+
+    /// Return true if the engine assumes a symmetric matrix.
+    bool IsSymmetric() const { return m_symmetric; }
+
+    /// Check whether the sparsity pattern of the given matrix differs from the one used in the last call to
+    /// Analyze(), i.e. whether a new symbolic factorization is needed.
+    bool PatternChanged(const ChCSMatrix& mat) const;
+
+    /// Compute the ordering and the symbolic factorization of the given matrix (row major, compressed).
+    /// The first 'num_primary' rows are the regular unknowns; the remaining ones (e.g. constraints) are
+    /// ordered after the primary unknowns they are coupled to. Use num_primary = -1 if all rows are primary.
+    void Analyze(const ChCSMatrix& mat, int num_primary = -1);
+
+    /// Compute the numeric factorization of the given matrix, which must have the same sparsity pattern
+    /// used in the last call to Analyze().
+    /// Return false if a zero pivot was found (see GetZeroPivot()).
+    bool Factorize(const ChCSMatrix& mat);
+
+    /// Solve A*x = b using the current factorization. 'x' is resized as needed and may not alias 'b'.
+    void Solve(const ChMatrix<>& b, ChMatrix<>& x) const;
+
+    /// Return the problem size.
+    int GetDimension() const { return m_n; }
+
+    /// Return the number of non-zeros in the strictly lower triangular factor L.
+    int GetFactorNNZ() const { return m_n ? m_Lp[m_n] : 0; }
+
+    /// Return true if a symbolic factorization is available (reset by SetOrdering()).
+    bool IsAnalyzed() const { return !m_ia.empty(); }
+
+    /// Return the index (in the permuted matrix) of the zero pivot found by the last call to Factorize(), or -1.
+    int GetZeroPivot() const { return m_zero_pivot; }
+
+    /// Return the number of pivots perturbed by the last call to Factorize() (see SetPivotPerturbation()).
+    int GetNumPerturbedPivots() const { return m_num_perturbed; }
+
+    /// Access the permutation vector: row 'i' of the permuted matrix is row GetPermutation()[i] of the original one.
+    const std::vector<int>& GetPermutation() const { return m_P; }
+
+  private:
+    /// Compute the fill-reducing ordering of the graph of the matrix (A+A').
+    void ComputeOrdering(const int* ia, const int* ja);
+
+    int m_n;                      ///< problem size
+    int m_num_primary;            ///< number of primary unknowns
+    Ordering m_ordering;          ///< fill-reducing ordering
+    bool m_symmetric;             ///< use LDL' instead of LDU?
+    double m_pivot_perturbation;  ///< relative threshold for the perturbation of small pivots (0: none)
+    int m_zero_pivot;             ///< zero pivot found in the last numeric factorization (-1 if none)
+    int m_num_perturbed;          ///< number of pivots perturbed in the last numeric factorization
+
+    // sparsity pattern used for the last analysis (to detect changes)
+    std::vector<int> m_ia;
+    std::vector<int> m_ja;
+
+    // permutation
+    std::vector<int> m_P;     ///< new index -> old index
+    std::vector<int> m_Pinv;  ///< old index -> new index
+
+    // upper triangle of the permuted matrix, by columns, with the positions of the values in the original arrays
+    std::vector<int> m_Cp;    ///< column pointers
+    std::vector<int> m_Ci;    ///< row indices (strictly upper triangle)
+    std::vector<int> m_Cup;   ///< position of A(i,k) in the original value array (or -1)
+    std::vector<int> m_Clo;   ///< position of A(k,i) in the original value array (or -1)
+    std::vector<int> m_Cdiag; ///< position of A(k,k) in the original value array (or -1)
+
+    // factors: column j of L holds L(i,j), i>j; the same slots of U hold U(j,i)
+    std::vector<int> m_parent;  ///< elimination tree
+    std::vector<int> m_Lp;
+    std::vector<int> m_Li;
+    std::vector<double> m_Lx;
+    std::vector<double> m_Ux;
+    std::vector<double> m_D;
+
+    // work arrays for the numeric factorization
+    std::vector<int> m_Lnz;
+    std::vector<int> m_flag;
+    std::vector<int> m_pattern;
+    std::vector<double> m_Y;
+    std::vector<double> m_Z;
+    mutable std::vector<double> m_X;
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -10,10 +10,15 @@
 //
 // =============================================================================
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "chrono/solver/ChSystemDescriptor.h"
 #include "chrono/solver/ChConstraintTwoTuplesContactN.h"
 #include "chrono/solver/ChConstraintTwoTuplesFrictionT.h"
+#include "chrono/core/ChCSMatrix.h"
 #include "chrono/core/ChLinkedListMatrix.h"
+#include "chrono/core/ChDisjointSets.h"
 
 namespace chrono {
 
@@ -30,10 +35,21 @@ ChSystemDescriptor::ChSystemDescriptor() {
 
     c_a = 1.0;
 
+    use_constraint_batch = false;
+
     n_q = 0;
     n_c = 0;
     freeze_count = false;
 
+    topology_hash = 0;
+    topology_valid = false;
+
+    use_parallel_kblocks = false;
+    kblock_map_valid = false;
+    kblock_map_topology = 0;
+    kblock_map_matrix = nullptr;
+    kblock_map_stamp = 0;
+
     this->num_threads = CHOMPfunctions::GetNumProcs();
 
     spinlocktable = new ChSpinlock[CH_SPINLOCK_HASHSIZE];
@@ -101,11 +117,154 @@ int ChSystemDescriptor::CountActiveConstraints() {
     return n_c;
 }
 
+void ChSystemDescriptor::UpdateConstraintBatch() {
+    if (use_constraint_batch)
+        constraint_batch.Update(vconstraints);
+    else
+        constraint_batch.Invalidate();
+}
+
 void ChSystemDescriptor::UpdateCountsAndOffsets() {
     freeze_count = false;
     CountActiveVariables();
     CountActiveConstraints();
     freeze_count = true;
+    topology_valid = false;
+}
+
+// Mix a value into a running hash (as in boost::hash_combine).
+static inline void HashCombine(size_t& seed, size_t val) {
+    seed ^= val + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+size_t ChSystemDescriptor::GetTopologyHash() {
+    if (topology_valid)
+        return topology_hash;
+
+    size_t hash = 0;
+    HashCombine(hash, vvariables.size());
+    HashCombine(hash, vconstraints.size());
+    HashCombine(hash, vstiffness.size());
+    HashCombine(hash, CountActiveVariables());
+    HashCombine(hash, CountActiveConstraints());
+
+    // Active state and size of the variables (their offsets follow from the insertion order).
+    for (unsigned int iv = 0; iv < vvariables.size(); iv++) {
+        HashCombine(hash, vvariables[iv]->IsActive() ? vvariables[iv]->Get_ndof() : 0);
+    }
+
+    // Variables referenced by the active constraints.
+    std::vector<ChVariables*> cvars;
+    for (unsigned int ic = 0; ic < vconstraints.size(); ic++) {
+        if (!vconstraints[ic]->IsActive()) {
+            HashCombine(hash, 0);
+            continue;
+        }
+        cvars.clear();
+        vconstraints[ic]->GetConstrainedVariables(cvars);
+        HashCombine(hash, cvars.size() + 1);
+        for (auto var : cvars)
+            HashCombine(hash, var->GetOffset());
+    }
+
+    // Variables referenced by the K blocks.
+    for (unsigned int ik = 0; ik < vstiffness.size(); ik++) {
+        size_t nvars = vstiffness[ik]->GetNvars();
+        HashCombine(hash, nvars);
+        for (size_t iv = 0; iv < nvars; iv++) {
+            ChVariables* var = vstiffness[ik]->GetVariableN(static_cast<unsigned int>(iv));
+            HashCombine(hash, var->IsActive() ? var->GetOffset() + 1 : 0);
+        }
+    }
+
+    topology_hash = hash;
+    topology_valid = true;
+    return topology_hash;
+}
+
+int ChSystemDescriptor::ComputeIslands() {
+    int nv = CountActiveVariables();
+    CountActiveConstraints();
+
+    // Join the active variables coupled by constraints and K blocks (variables are indexed by their offset).
+    // Each constraint keeps one of its variables, or -1 if it has no active variables, -2 if they are unknown.
+    ChDisjointSets sets(nv);
+    std::vector<int> constraint_var(vconstraints.size(), -1);
+    std::vector<ChVariables*> cvars;
+    for (unsigned int ic = 0; ic < vconstraints.size(); ic++) {
+        if (!vconstraints[ic]->IsActive())
+            continue;
+        cvars.clear();
+        if (!vconstraints[ic]->GetConstrainedVariables(cvars)) {
+            constraint_var[ic] = -2;
+            continue;
+        }
+        if (cvars.empty())
+            continue;
+        constraint_var[ic] = cvars[0]->GetOffset();
+        for (size_t k = 1; k < cvars.size(); k++)
+            sets.Union(constraint_var[ic], cvars[k]->GetOffset());
+    }
+
+    for (unsigned int ik = 0; ik < vstiffness.size(); ik++) {
+        int first = -1;
+        for (unsigned int iv = 0; iv < vstiffness[ik]->GetNvars(); iv++) {
+            ChVariables* var = vstiffness[ik]->GetVariableN(iv);
+            if (!var->IsActive())
+                continue;
+            if (first < 0)
+                first = var->GetOffset();
+            else
+                sets.Union(first, var->GetOffset());
+        }
+    }
+
+    // Number the islands in the order of their first constraint, so that the partition is deterministic.
+    std::vector<int> root_island(nv, -1);
+    std::vector<int> constraint_island(vconstraints.size(), -1);
+    std::vector<int> island_size;
+    int isolated = -1;
+    unknown_constraints.clear();
+    for (unsigned int ic = 0; ic < vconstraints.size(); ic++) {
+        if (!vconstraints[ic]->IsActive())
+            continue;
+        if (constraint_var[ic] == -2) {
+            unknown_constraints.push_back(ic);
+            continue;
+        }
+        int island;
+        if (constraint_var[ic] == -1) {
+            if (isolated < 0) {
+                isolated = (int)island_size.size();
+                island_size.push_back(0);
+            }
+            island = isolated;
+        } else {
+            int root = sets.Find(constraint_var[ic]);
+            if (root_island[root] < 0) {
+                root_island[root] = (int)island_size.size();
+                island_size.push_back(0);
+            }
+            island = root_island[root];
+        }
+        constraint_island[ic] = island;
+        island_size[island]++;
+    }
+
+    // Sort the constraints by island (counting sort, stable).
+    int nislands = (int)island_size.size();
+    island_start.assign(nislands + 1, 0);
+    for (int i = 0; i < nislands; i++)
+        island_start[i + 1] = island_start[i] + island_size[i];
+
+    island_constraints.resize(island_start[nislands]);
+    std::vector<int> island_fill(island_start.begin(), island_start.end() - 1);
+    for (unsigned int ic = 0; ic < vconstraints.size(); ic++) {
+        if (constraint_island[ic] >= 0)
+            island_constraints[island_fill[constraint_island[ic]]++] = ic;
+    }
+
+    return nislands;
 }
 
 void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Cq,
@@ -201,6 +360,137 @@ void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Cq,
     }
 }
 
+// Sparse matrix that records the position, in the value array of a CSR matrix, of each element set by a K block.
+class ChKblockSlotRecorder : public ChSparseMatrix {
+  public:
+    ChKblockSlotRecorder(const ChCSMatrix& mat, std::vector<int>& slots)
+        : ChSparseMatrix(mat.GetNumRows(), mat.GetNumColumns()), m_mat(mat), m_slots(slots) {}
+
+    virtual void SetElement(int insrow, int inscol, double insval, bool overwrite = true) override {
+        m_slots.push_back(m_mat.GetElementSlot(insrow, inscol));
+    }
+    virtual double GetElement(int row, int col) const override { return 0; }
+    virtual void Reset(int row, int col, int nonzeros = 0) override {}
+    virtual bool Resize(int nrows, int ncols, int nonzeros = 0) override { return false; }
+
+  private:
+    const ChCSMatrix& m_mat;
+    std::vector<int>& m_slots;
+};
+
+// Sparse matrix that stores the elements set by a K block in their recorded positions.
+class ChKblockSlotWriter : public ChSparseMatrix {
+  public:
+    ChKblockSlotWriter(double* values, const int* slots, const int* slots_end)
+        : m_values(values), m_slot(slots), m_slots_end(slots_end) {}
+
+    virtual void SetElement(int insrow, int inscol, double insval, bool overwrite = true) override {
+        assert(m_slot < m_slots_end);
+        double& value = m_values[*m_slot++];
+        value = overwrite ? insval : value + insval;
+    }
+    virtual double GetElement(int row, int col) const override { return 0; }
+    virtual void Reset(int row, int col, int nonzeros = 0) override {}
+    virtual bool Resize(int nrows, int ncols, int nonzeros = 0) override { return false; }
+
+  private:
+    double* m_values;
+    const int* m_slot;
+    const int* m_slots_end;
+};
+
+bool ChSystemDescriptor::UpdateKblockMap(const ChCSMatrix& mat) {
+    kblock_map_valid = false;
+    int nblocks = (int)vstiffness.size();
+
+    // Record the slots of the elements of each K block, in the order in which Build_K() sets them
+    kblock_slot_start.assign(nblocks + 1, 0);
+    kblock_slots.clear();
+    ChKblockSlotRecorder recorder(mat, kblock_slots);
+    for (int ik = 0; ik < nblocks; ik++) {
+        vstiffness[ik]->Build_K(recorder, true);
+        kblock_slot_start[ik + 1] = (int)kblock_slots.size();
+    }
+    if (std::find(kblock_slots.begin(), kblock_slots.end(), -1) != kblock_slots.end())
+        return false;
+
+    // Greedy coloring: K blocks of the same color do not share active variables
+    std::unordered_map<ChVariables*, std::vector<int>> variable_colors;
+    std::vector<int> block_color(nblocks);
+    std::vector<int> used;
+    int ncolors = 0;
+    for (int ik = 0; ik < nblocks; ik++) {
+        used.clear();
+        size_t nvars = vstiffness[ik]->GetNvars();
+        for (size_t iv = 0; iv < nvars; iv++) {
+            ChVariables* var = vstiffness[ik]->GetVariableN((unsigned int)iv);
+            if (var->IsActive()) {
+                const std::vector<int>& colors = variable_colors[var];
+                used.insert(used.end(), colors.begin(), colors.end());
+            }
+        }
+        int color = 0;
+        while (std::find(used.begin(), used.end(), color) != used.end())
+            color++;
+        for (size_t iv = 0; iv < nvars; iv++) {
+            ChVariables* var = vstiffness[ik]->GetVariableN((unsigned int)iv);
+            if (var->IsActive())
+                variable_colors[var].push_back(color);
+        }
+        block_color[ik] = color;
+        ncolors = std::max(ncolors, color + 1);
+    }
+
+    // Group the K blocks by color, keeping their order within each color
+    kblock_color_start.assign(ncolors + 1, 0);
+    for (int ik = 0; ik < nblocks; ik++)
+        kblock_color_start[block_color[ik] + 1]++;
+    for (int color = 0; color < ncolors; color++)
+        kblock_color_start[color + 1] += kblock_color_start[color];
+    std::vector<int> next(kblock_color_start.begin(), kblock_color_start.end() - 1);
+    kblock_color_list.resize(nblocks);
+    for (int ik = 0; ik < nblocks; ik++)
+        kblock_color_list[next[block_color[ik]]++] = ik;
+
+    kblock_map_valid = true;
+    kblock_map_topology = GetTopologyHash();
+    kblock_map_matrix = &mat;
+    kblock_map_stamp = mat.GetLayoutStamp();
+    return true;
+}
+
+bool ChSystemDescriptor::BuildKblocksParallel(ChSparseMatrix& Z) {
+    ChCSMatrix* mat = dynamic_cast<ChCSMatrix*>(&Z);
+    if (!use_parallel_kblocks || !mat || !mat->IsCompressed() || vstiffness.empty())
+        return false;
+
+    // The map is still valid if neither the structure of the system nor the layout of the matrix changed
+    if (!kblock_map_valid || kblock_map_matrix != mat || kblock_map_stamp != mat->GetLayoutStamp() ||
+        kblock_map_topology != GetTopologyHash()) {
+        if (!UpdateKblockMap(*mat))
+            return false;
+    }
+
+    double* values = mat->GetCS_ValueArray();
+    const int* slots = kblock_slots.data();
+    int ncolors = (int)kblock_color_start.size() - 1;
+    int nthreads = num_threads;
+
+    // K blocks of one color do not share variables: no concurrent writes to the same slots.
+    // The implicit barrier at the end of each 'omp for' separates the colors.
+#pragma omp parallel num_threads(nthreads) if (nthreads > 1)
+    for (int color = 0; color < ncolors; color++) {
+#pragma omp for schedule(dynamic, 16)
+        for (int k = kblock_color_start[color]; k < kblock_color_start[color + 1]; k++) {
+            int ik = kblock_color_list[k];
+            ChKblockSlotWriter writer(values, slots + kblock_slot_start[ik], slots + kblock_slot_start[ik + 1]);
+            vstiffness[ik]->Build_K(writer, true);
+        }
+    }
+
+    return true;
+}
+
 void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Z, ChMatrix<>* rhs) {
 
     std::vector<ChConstraint*>& mconstraints = this->GetConstraintsList();
@@ -232,9 +522,10 @@ void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Z, ChMatrix<>* rhs)
 		}
 
 		// If present, add stiffness matrix K to upper-left block of Z.
-		int s_k = 0;
-		for (unsigned int ik = 0; ik < this->vstiffness.size(); ik++) {
-			this->vstiffness[ik]->Build_K(*Z, true);
+		if (!BuildKblocksParallel(*Z)) {
+			for (unsigned int ik = 0; ik < this->vstiffness.size(); ik++) {
+				this->vstiffness[ik]->Build_K(*Z, true);
+			}
 		}
 
 		// Fill Z by looping over constraints.
@@ -559,6 +850,23 @@ void ChSystemDescriptor::ShurComplementProduct(ChMatrix<>& result, ChMatrix<>* l
             vvariables[iv]->Get_qb().FillElem(0);
     }
 
+    // If the constraints are packed, process them in batch (only the others through the ChConstraint interface)
+
+    if (constraint_batch.IsValid() && lvector && !enabled) {
+        constraint_batch.Increment_q_All(*lvector, result);
+        for (int ic : constraint_batch.GetOthers()) {
+            int s_c = vconstraints[ic]->GetOffset();
+            double li = (*lvector)(s_c, 0);
+            vconstraints[ic]->Increment_q(li);
+            result(s_c, 0) = vconstraints[ic]->Get_cfm_i() * li;
+        }
+
+        constraint_batch.Add_Cq_q_All(result);
+        for (int ic : constraint_batch.GetOthers())
+            result(vconstraints[ic]->GetOffset(), 0) += vconstraints[ic]->Compute_Cq_q();
+        return;
+    }
+
     // 2 - performs    qb=[M^(-1)][Cq']*l  by
     //     iterating over all constraints (when implemented in parallel this
     //     could be non-trivial because race conditions might occur -> reduction buffer etc.)
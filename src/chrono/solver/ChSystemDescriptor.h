@@ -18,11 +18,14 @@
 #include "chrono/parallel/ChOpenMP.h"
 #include "chrono/parallel/ChThreadsSync.h"
 #include "chrono/solver/ChConstraint.h"
+#include "chrono/solver/ChConstraintBatch.h"
 #include "chrono/solver/ChKblock.h"
 #include "chrono/solver/ChVariables.h"
 
 namespace chrono {
 
+class ChCSMatrix;
+
 /// Base class for collecting objects inherited from ChConstraint,
 /// ChVariables and optionally ChKblock. These objects
 /// can be used to define a sparse representation of the system.
@@ -84,11 +87,31 @@ class ChApi ChSystemDescriptor {
 
     double c_a;  // coefficient form M mass matrices in vvariables
 
+    ChConstraintBatch constraint_batch;  ///< packed copy of the constraints between two 6-dof variables
+    bool use_constraint_batch;           ///< if true, UpdateConstraintBatch() packs the constraints
+
   private:
     int n_q;            ///< number of active variables
     int n_c;            ///< number of active constraints
     bool freeze_count;  ///< for optimization: avoid to re-count the number of active variables and constraints
 
+    size_t topology_hash;  ///< signature of the structure of the system (see GetTopologyHash())
+    bool topology_valid;   ///< for optimization: the signature is computed only on demand, once per insertion
+
+    std::vector<int> island_start;         ///< start of each island in island_constraints (size: num. islands + 1)
+    std::vector<int> island_constraints;   ///< indices of the active constraints, sorted by island
+    std::vector<int> unknown_constraints;  ///< indices of the active constraints with unknown variables
+
+    bool use_parallel_kblocks;             ///< assemble the K blocks in parallel (see SetUseParallelKblocks())
+    bool kblock_map_valid;                 ///< true if the map below matches kblock_map_topology and stamp
+    size_t kblock_map_topology;            ///< signature of the structure when the map was built
+    const ChCSMatrix* kblock_map_matrix;   ///< matrix whose value array is addressed by the map
+    unsigned int kblock_map_stamp;         ///< layout stamp of that matrix when the map was built
+    std::vector<int> kblock_slot_start;    ///< start of the slots of each K block in kblock_slots
+    std::vector<int> kblock_slots;         ///< position in the value array of each element set by the K blocks
+    std::vector<int> kblock_color_start;   ///< start of each color in kblock_color_list
+    std::vector<int> kblock_color_list;    ///< indices of the K blocks, grouped by color
+
   public:
     /// Constructor
     ChSystemDescriptor();
@@ -114,6 +137,19 @@ class ChApi ChSystemDescriptor {
         vconstraints.clear();
         vvariables.clear();
         vstiffness.clear();
+        topology_valid = false;
+        constraint_batch.Invalidate();
+    }
+
+    /// Begin insertion of items, keeping the first items that were inserted in each list.
+    /// This allows the caller to insert again only the trailing items that change from call to call (e.g. contacts),
+    /// while the others stay registered.
+    virtual void BeginIncrementalInsertion(size_t keep_constraints, size_t keep_variables, size_t keep_kblocks) {
+        vconstraints.resize(keep_constraints);
+        vvariables.resize(keep_variables);
+        vstiffness.resize(keep_kblocks);
+        topology_valid = false;
+        constraint_batch.Invalidate();
     }
 
     /// Insert reference to a ChConstraint object
@@ -146,6 +182,77 @@ class ChApi ChSystemDescriptor {
     /// otherwise CountActiveVariables() and CountActiveConstraints() might fail.
     virtual void UpdateCountsAndOffsets();
 
+    /// Enable/disable the packing of the constraints between two blocks of 6 variables (e.g. contacts between
+    /// rigid bodies) in a ChConstraintBatch, used by the iterative solvers and by ShurComplementProduct() for
+    /// vectorized processing (default: false).
+    /// Note that the products are then summed in a different order, so results may differ by round-off.
+    void SetUseConstraintBatch(bool use) {
+        use_constraint_batch = use;
+        constraint_batch.Invalidate();
+    }
+
+    /// Tell if the constraints are packed in a ChConstraintBatch.
+    bool GetUseConstraintBatch() const { return use_constraint_batch; }
+
+    /// Refresh the batch of packed constraints, if enabled (see SetUseConstraintBatch()).
+    /// To be called after the jacobians and the [Eq] products of the constraints were updated (see
+    /// ChConstraint::Update_auxiliary()), and before ShurComplementProduct().
+    virtual void UpdateConstraintBatch();
+
+    /// Access the batch of packed constraints (valid only after UpdateConstraintBatch(), if enabled).
+    const ChConstraintBatch& GetConstraintBatch() const { return constraint_batch; }
+
+    /// Return a signature of the structure of the system, i.e. of everything that determines the sparsity
+    /// pattern of the assembled system matrix: number of inserted items, active state, size and offsets of
+    /// the variables, variables referenced by the constraints and by the K blocks.
+    /// Numeric values (masses, jacobians, stiffness) do not contribute to the signature.
+    /// Direct solvers can compare it from call to call to detect topology changes, and reuse the
+    /// assembled matrix layout and the symbolic factorization as long as it does not change.
+    /// The signature is computed on demand (at most once after each EndInsertion() or UpdateCountsAndOffsets()).
+    virtual size_t GetTopologyHash();
+
+    /// Partition the active constraints in islands, i.e. in groups of constraints that are coupled (directly or
+    /// through other constraints and K blocks) by active variables. Constraints of different islands never share
+    /// a variable, so that iterative solvers can solve the islands as independent subproblems, possibly in parallel.
+    /// Within each island, the constraints keep the order of the descriptor (so the triplets of frictional contacts
+    /// stay contiguous); islands are numbered in the order of their first constraint.
+    /// Constraints without active variables (e.g. links between fixed bodies) do not interact with the others and
+    /// are collected in one more island. Constraints that do not report their variables (see
+    /// ChConstraint::GetConstrainedVariables) may touch any variable, so they are not part of any island: they are
+    /// listed in GetUnknownConstraints() and must be solved together with all the islands.
+    /// Returns the number of islands.
+    virtual int ComputeIslands();
+
+    /// Return the number of islands found by the last call to ComputeIslands().
+    int GetNumIslands() const { return island_start.empty() ? 0 : (int)island_start.size() - 1; }
+
+    /// Return the start of each island in the list returned by GetIslandConstraints() (size: num. islands + 1).
+    const std::vector<int>& GetIslandStart() const { return island_start; }
+
+    /// Return the indices (in the list of constraints) of the active constraints, sorted by island.
+    const std::vector<int>& GetIslandConstraints() const { return island_constraints; }
+
+    /// Return the indices of the active constraints with unknown variables (see ComputeIslands()).
+    const std::vector<int>& GetUnknownConstraints() const { return unknown_constraints; }
+
+    /// Enable/disable the multithreaded assembly of the K blocks in ConvertToMatrixForm() (default: false).
+    /// It applies when the matrix is a compressed ChCSMatrix that already contains all the elements of the
+    /// K blocks (e.g. a matrix with locked sparsity pattern, reused by a direct solver from step to step).
+    /// The position of each element of each K block in the value array of the matrix is mapped once, and
+    /// mapped again only when the structure of the system (see GetTopologyHash()) or the layout of the matrix
+    /// change. K blocks are partitioned in colors, such that blocks of the same color do not share active
+    /// variables; colors are processed one after the other, and the blocks of a color in parallel, writing
+    /// directly in their slots. Results do not depend on the number of threads (see SetNumThreads()), but the
+    /// contributions to each element are summed in color order, so they may differ by round-off from the
+    /// sequential assembly.
+    void SetUseParallelKblocks(bool val) { use_parallel_kblocks = val; }
+
+    /// Tell if the multithreaded assembly of the K blocks is enabled.
+    bool GetUseParallelKblocks() const { return use_parallel_kblocks; }
+
+    /// Return the number of colors of the K blocks, as computed by the last parallel assembly.
+    int GetNumKblockColors() const { return kblock_map_valid ? (int)kblock_color_start.size() - 1 : 0; }
+
     /// Sets the c_a coefficient (default=1) used for scaling the M masses of the vvariables
     /// when performing ShurComplementProduct(), SystemProduct(), ConvertToMatrixForm(),
     virtual void SetMassFactor(const double mc_a) { c_a = mc_a; }
@@ -387,6 +494,15 @@ class ChApi ChSystemDescriptor {
         // stream in all member data:
         marchive >> CHNVP(num_threads);
     }
+
+  private:
+    /// Add the K blocks to the matrix in parallel, writing in the mapped slots of its value array.
+    /// Return false (and do nothing) if this is not possible (see SetUseParallelKblocks()).
+    bool BuildKblocksParallel(ChSparseMatrix& Z);
+
+    /// Map the elements set by the K blocks to their slots in the value array of the matrix, and color the
+    /// K blocks. Return false if some element is not stored in the matrix.
+    bool UpdateKblockMap(const ChCSMatrix& mat);
 };
 
 CH_CLASS_VERSION(ChSystemDescriptor, 0)
@@ -46,6 +46,7 @@ CODE MODIFIED FROM:
 #include <ratio>
 #include <chrono>
 #include "chrono/core/ChApiCE.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 namespace chrono {
 namespace utils {
@@ -158,9 +159,12 @@ private:
 
 ///ProfileSampleClass is a simple way to profile a function's scope
 ///Use the BT_PROFILE macro at the start of scope to time
+///The scope is also recorded by the (thread-safe) trace profiler, see ChTraceProfiler.
+///Note: the profile tree is not thread-safe, so CH_PROFILE must be used only in the main thread;
+///use CH_TRACE in code executed by multiple threads (e.g. OpenMP parallel regions).
 class  ChApi  CProfileSample {
 public:
-	CProfileSample( const char * name )
+	CProfileSample( const char * name ) : trace( name )
 	{ 
 		ChProfileManager::Start_Profile( name ); 
 	}
@@ -169,6 +173,9 @@ public:
 	{ 
 		ChProfileManager::Stop_Profile(); 
 	}
+
+private:
+	ChTraceScope trace;
 };
 
 
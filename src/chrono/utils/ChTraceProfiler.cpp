@@ -0,0 +1,214 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "chrono/utils/ChTraceProfiler.h"
+
+namespace chrono {
+namespace utils {
+
+std::atomic<bool> ChTraceProfiler::enabled(false);
+std::atomic<int> ChTraceProfiler::step(0);
+size_t ChTraceProfiler::buffer_capacity = 65536;
+
+namespace {
+
+// Ring buffer with the events recorded by one thread.
+struct ChTraceBuffer {
+    std::vector<ChTraceEvent> events;
+    size_t head = 0;   // slot of the next event
+    size_t count = 0;  // number of stored events
+    size_t lost = 0;   // number of overwritten events
+    int depth = 0;     // number of open scopes
+
+    void Reset(size_t capacity) {
+        events.assign(capacity, ChTraceEvent());
+        head = 0;
+        count = 0;
+        lost = 0;
+    }
+};
+
+// Buffers of all the threads, in order of registration (the index is the thread id in the exported traces).
+// Buffers are never released, so that the events of terminated threads can still be exported.
+std::mutex& RegistryMutex() {
+    static std::mutex registry_mutex;
+    return registry_mutex;
+}
+
+std::vector<std::unique_ptr<ChTraceBuffer>>& Registry() {
+    static std::vector<std::unique_ptr<ChTraceBuffer>> registry;
+    return registry;
+}
+
+thread_local ChTraceBuffer* thread_buffer = nullptr;
+
+ChTraceBuffer* GetThreadBuffer() {
+    if (!thread_buffer) {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        Registry().emplace_back(new ChTraceBuffer);
+        thread_buffer = Registry().back().get();
+        thread_buffer->Reset(ChTraceProfiler::GetBufferCapacity());
+    }
+    return thread_buffer;
+}
+
+const std::chrono::steady_clock::time_point trace_epoch = std::chrono::steady_clock::now();
+
+std::string JsonEscape(const char* str) {
+    std::string out;
+    for (const char* c = str; *c; c++) {
+        if (*c == '"' || *c == '\\')
+            out += '\\';
+        out += *c;
+    }
+    return out;
+}
+
+}  // end anonymous namespace
+
+void ChTraceProfiler::SetBufferCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    buffer_capacity = capacity > 0 ? capacity : 1;
+    for (auto& buffer : Registry())
+        buffer->Reset(buffer_capacity);
+}
+
+void ChTraceProfiler::Clear() {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    for (auto& buffer : Registry())
+        buffer->Reset(buffer_capacity);
+    step.store(0, std::memory_order_relaxed);
+}
+
+int64_t ChTraceProfiler::Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - trace_epoch)
+        .count();
+}
+
+int64_t ChTraceProfiler::BeginScope() {
+    GetThreadBuffer()->depth++;
+    return Now();
+}
+
+void ChTraceProfiler::EndScope(const char* name, int64_t start) {
+    int64_t end = Now();
+    ChTraceBuffer* buffer = GetThreadBuffer();
+    buffer->depth--;
+
+    ChTraceEvent& event = buffer->events[buffer->head];
+    event.name = name;
+    event.start = start;
+    event.end = end;
+    event.step = GetStep();
+    event.depth = buffer->depth;
+
+    buffer->head = (buffer->head + 1) % buffer->events.size();
+    if (buffer->count < buffer->events.size())
+        buffer->count++;
+    else
+        buffer->lost++;
+}
+
+int ChTraceProfiler::GetNumThreads() {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    return (int)Registry().size();
+}
+
+std::vector<ChTraceEvent> ChTraceProfiler::GetEvents(int thread) {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    if (thread < 0 || thread >= (int)Registry().size())
+        return std::vector<ChTraceEvent>();
+    const ChTraceBuffer& buffer = *Registry()[thread];
+    size_t capacity = buffer.events.size();
+    std::vector<ChTraceEvent> events(buffer.count);
+    for (size_t k = 0; k < buffer.count; k++)
+        events[k] = buffer.events[(buffer.head + capacity - buffer.count + k) % capacity];
+    return events;
+}
+
+size_t ChTraceProfiler::GetNumLostEvents(int thread) {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    if (thread < 0 || thread >= (int)Registry().size())
+        return 0;
+    return Registry()[thread]->lost;
+}
+
+bool ChTraceProfiler::ExportChromeTrace(const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out)
+        return false;
+
+    // Timestamps and durations are in microseconds.
+    out << std::fixed << std::setprecision(3);
+    out << "{\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"Chrono\"}}";
+
+    int nthreads = GetNumThreads();
+    for (int thread = 0; thread < nthreads; thread++) {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread
+            << ",\"args\":{\"name\":\"thread " << thread << "\"}}";
+        for (const auto& event : GetEvents(thread)) {
+            out << ",\n{\"name\":\"" << JsonEscape(event.name) << "\",\"cat\":\"chrono\",\"ph\":\"X\",\"ts\":"
+                << event.start * 1e-3 << ",\"dur\":" << (event.end - event.start) * 1e-3 << ",\"pid\":0,\"tid\":"
+                << thread << ",\"args\":{\"step\":" << event.step << ",\"depth\":" << event.depth << "}}";
+        }
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    return out.good();
+}
+
+bool ChTraceProfiler::ExportCSV(const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out)
+        return false;
+
+    struct Stats {
+        int calls = 0;
+        int64_t total = 0;
+        int64_t max = 0;
+    };
+
+    // Aggregate over all threads, sorted by step and name.
+    std::map<std::pair<int, std::string>, Stats> table;
+    int nthreads = GetNumThreads();
+    for (int thread = 0; thread < nthreads; thread++) {
+        for (const auto& event : GetEvents(thread)) {
+            Stats& stats = table[std::make_pair(event.step, std::string(event.name))];
+            int64_t duration = event.end - event.start;
+            stats.calls++;
+            stats.total += duration;
+            if (duration > stats.max)
+                stats.max = duration;
+        }
+    }
+
+    out << std::fixed << std::setprecision(6);
+    out << "step,name,calls,total_ms,max_ms\n";
+    for (const auto& row : table) {
+        out << row.first.first << ",\"" << row.first.second << "\"," << row.second.calls << ","
+            << row.second.total * 1e-6 << "," << row.second.max * 1e-6 << "\n";
+    }
+
+    return out.good();
+}
+
+}  // end namespace utils
+}  // end namespace chrono
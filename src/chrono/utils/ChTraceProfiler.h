@@ -0,0 +1,142 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHTRACEPROFILER_H
+#define CHTRACEPROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+
+namespace chrono {
+namespace utils {
+
+/// Event recorded by the trace profiler: the execution of a named scope by a thread.
+struct ChTraceEvent {
+    const char* name;  ///< name of the scope (a string literal, or a string that lives until the export)
+    int64_t start;     ///< start time [ns], since the start of the program
+    int64_t end;       ///< end time [ns], since the start of the program
+    int step;          ///< step in which the scope was closed (see ChTraceProfiler::NextStep())
+    int depth;         ///< nesting level of the scope in its thread (0 for outermost scopes)
+};
+
+/// Thread-aware, low-overhead profiler.\n
+/// Scopes are instrumented with the CH_TRACE(name) macro (the CH_PROFILE scopes are recorded too).
+/// Each thread (including OpenMP worker threads) records its events, with nanosecond timestamps, in its
+/// own ring buffer, without locks: when a buffer is full the oldest events are overwritten.\n
+/// The recorded timelines can be exported in the Chrome trace-event JSON format (to be opened with
+/// chrome://tracing or https://ui.perfetto.dev) and as a CSV table with the time spent in each scope,
+/// aggregated over all threads, at each step.\n
+/// The profiler is disabled by default: then, each instrumented scope costs a single test of a flag.
+/// Define CH_NO_PROFILE to compile out all the instrumentation.\n
+/// Note: Clear(), SetBufferCapacity() and the export functions must not be called while other threads
+/// are recording events.
+class ChApi ChTraceProfiler {
+  public:
+    /// Enable/disable the recording of events (default: false).
+    static void Enable(bool val) { enabled.store(val, std::memory_order_relaxed); }
+
+    /// Return true if the recording of events is enabled.
+    static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    /// Set the capacity of the ring buffer of each thread, in number of events (default: 65536).
+    /// All the recorded events are discarded.
+    static void SetBufferCapacity(size_t capacity);
+
+    /// Get the capacity of the ring buffer of each thread, in number of events.
+    static size_t GetBufferCapacity() { return buffer_capacity; }
+
+    /// Mark the end of a step (also called at the end of ChSystem::DoStepDynamics, if recording).
+    static void NextStep() { step.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Get the current step.
+    static int GetStep() { return step.load(std::memory_order_relaxed); }
+
+    /// Discard all the recorded events and reset the step counter.
+    static void Clear();
+
+    /// Return the current time [ns], since the start of the program.
+    static int64_t Now();
+
+    /// Open a scope in the calling thread; return the start time.
+    static int64_t BeginScope();
+
+    /// Close the scope opened at time \a start in the calling thread, and record the event.
+    static void EndScope(const char* name, int64_t start);
+
+    /// Return the number of threads that recorded events since the start of the program.
+    static int GetNumThreads();
+
+    /// Return the events currently stored in the buffer of the given thread, from the oldest to the newest
+    /// (none if there is no such thread).
+    static std::vector<ChTraceEvent> GetEvents(int thread);
+
+    /// Return the number of events of the given thread that were overwritten because its buffer was full
+    /// (0 if there is no such thread).
+    static size_t GetNumLostEvents(int thread);
+
+    /// Export the recorded events in the Chrome trace-event JSON format.
+    /// Returns false if the file cannot be written.
+    static bool ExportChromeTrace(const std::string& filename);
+
+    /// Export the time spent in each scope at each step, aggregated over all threads, as CSV.
+    /// Columns: step, name, number of calls, total time [ms], max. time of a call [ms].
+    /// Returns false if the file cannot be written.
+    static bool ExportCSV(const std::string& filename);
+
+  private:
+    static std::atomic<bool> enabled;
+    static std::atomic<int> step;
+    static size_t buffer_capacity;
+};
+
+/// Scoped marker for the trace profiler (see CH_TRACE).
+/// Records an event from its construction to its destruction, if the profiler is enabled at construction.
+class ChTraceScope {
+  public:
+    explicit ChTraceScope(const char* name) : m_name(nullptr), m_start(0) {
+        if (ChTraceProfiler::IsEnabled()) {
+            m_name = name;
+            m_start = ChTraceProfiler::BeginScope();
+        }
+    }
+
+    ~ChTraceScope() {
+        if (m_name)
+            ChTraceProfiler::EndScope(m_name, m_start);
+    }
+
+  private:
+    ChTraceScope(const ChTraceScope&) = delete;
+    ChTraceScope& operator=(const ChTraceScope&) = delete;
+
+    const char* m_name;
+    int64_t m_start;
+};
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#define CH_TRACE_CONCAT_IMPL(a, b) a##b
+#define CH_TRACE_CONCAT(a, b) CH_TRACE_CONCAT_IMPL(a, b)
+
+#ifndef CH_NO_PROFILE
+/// Record the enclosing scope in the trace profiler, with the given name (a string literal).
+#define CH_TRACE(name) ::chrono::utils::ChTraceScope CH_TRACE_CONCAT(ch_trace_scope_, __LINE__)(name)
+#else
+#define CH_TRACE(name)
+#endif
+
+#endif
@@ -71,6 +71,9 @@ class ChApiFea ChElementBar : public ChElementGeneric {
         mD.PasteVector(this->nodes[1]->GetPos(), 3, 0);
     }
 
+    /// The mass matrix (lumped nodal masses) does not depend on the state.
+    virtual bool HasConstantMass() const override { return true; }
+
     /// Sets H as the global stiffness matrix K, scaled  by Kfactor. Optionally, also
     /// superimposes global damping matrix R, scaled by Rfactor, and global mass matrix M multiplied by Mfactor.
     /// (For the spring matrix there is no need to corotate local matrices: we already know a closed form expression.)
@@ -86,6 +86,10 @@ class ChApiFea ChElementBase {
     /// stiffness of each element, if any, the mass, etc.
     virtual void SetupInitial(ChSystem* system) {}
 
+    /// Cache the mass matrix, if the element can do so (see ChElementGeneric).
+    /// This is called by the mesh after SetupInitial().
+    virtual void UpdateMassCache() {}
+
     /// Update: this is called at least at each time step. If the
     /// element has to keep updated some auxiliary data, such as the rotation
     /// matrices for corotational approach, this is the proper place.
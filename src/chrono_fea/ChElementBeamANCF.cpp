@@ -71,6 +71,7 @@ void ChElementBeamANCF::SetNodes(std::shared_ptr<ChNodeFEAxyzDD> nodeA,
 void ChElementBeamANCF::SetupInitial(ChSystem* system) {
     // Compute mass matrix and gravitational forces (constant)
     m_GaussScaling = (m_lenX * m_thicknessY * m_thicknessZ) / 8;
+    ComputeGaussPointData();
     ComputeMassMatrix();
     ComputeGravityForce(system->Get_G_acc());
     // Cache the scaling factor (due to change of integration intervals)
@@ -243,531 +244,125 @@ void ChElementBeamANCF::ComputeGravityForce(const ChVector<>& g_acc) {
 // Elastic force calculation
 // -----------------------------------------------------------------------------
 
-// The class MyForceBeam provides the integrand for the calculation of the internal forces
-// for one layer of an ANCF shell element.
-// The 27 entries in the integrand represent the internal force.
+// Compute the matrix T of the transformation of the strains to the local frame of the material (which could be
+// orthotropic), strain = T * strain_til, from the coefficients beta of the contravariant transformation.
+static void CalcStrainTransformation(ChMatrixNM<double, 6, 6>& T, const double* beta) {
+    T(0, 0) = beta[0] * beta[0];
+    T(0, 1) = beta[3] * beta[3];
+    T(0, 2) = beta[0] * beta[3];
+    T(0, 3) = beta[6] * beta[6];
+    T(0, 4) = beta[0] * beta[6];
+    T(0, 5) = beta[3] * beta[6];
+    T(1, 0) = beta[1] * beta[1];
+    T(1, 1) = beta[4] * beta[4];
+    T(1, 2) = beta[1] * beta[4];
+    T(1, 3) = beta[7] * beta[7];
+    T(1, 4) = beta[1] * beta[7];
+    T(1, 5) = beta[4] * beta[7];
+    T(2, 0) = 2.0 * beta[0] * beta[1];
+    T(2, 1) = 2.0 * beta[3] * beta[4];
+    T(2, 2) = beta[1] * beta[3] + beta[0] * beta[4];
+    T(2, 3) = 2.0 * beta[6] * beta[7];
+    T(2, 4) = beta[1] * beta[6] + beta[0] * beta[7];
+    T(2, 5) = beta[4] * beta[6] + beta[3] * beta[7];
+    T(3, 0) = beta[2] * beta[2];
+    T(3, 1) = beta[5] * beta[5];
+    T(3, 2) = beta[2] * beta[5];
+    T(3, 3) = beta[8] * beta[8];
+    T(3, 4) = beta[2] * beta[8];
+    T(3, 5) = beta[5] * beta[8];
+    T(4, 0) = 2.0 * beta[0] * beta[2];
+    T(4, 1) = 2.0 * beta[3] * beta[5];
+    T(4, 2) = beta[2] * beta[3] + beta[0] * beta[5];
+    T(4, 3) = 2.0 * beta[6] * beta[8];
+    T(4, 4) = beta[2] * beta[6] + beta[0] * beta[8];
+    T(4, 5) = beta[5] * beta[6] + beta[3] * beta[8];
+    T(5, 0) = 2.0 * beta[1] * beta[2];
+    T(5, 1) = 2.0 * beta[4] * beta[5];
+    T(5, 2) = beta[2] * beta[4] + beta[1] * beta[5];
+    T(5, 3) = 2.0 * beta[7] * beta[8];
+    T(5, 4) = beta[2] * beta[7] + beta[1] * beta[8];
+    T(5, 5) = beta[5] * beta[7] + beta[4] * beta[8];
+}
+
+// The class MyForceBeam evaluates the internal forces at the quadrature points, for the given matrix of
+// elastic coefficients (the full matrix for the three-dimensional integration, or the matrix of the Poisson
+// terms for the integration over the centerline).
+// The data of the reference configuration at each point is computed once, in SetupInitial(), so that the
+// integration is a plain loop over the points, with no virtual calls and no shape function evaluations.
 
-class MyForceBeam : public ChIntegrable3D<ChMatrixNM<double, 27, 1> > {
+class MyForceBeam {
   public:
-    MyForceBeam(ChElementBeamANCF* element)  // Containing element
-        : m_element(element) {}
-    ~MyForceBeam() {}
+    MyForceBeam(ChElementBeamANCF* element,             // Containing element
+                const ChMatrixNM<double, 6, 6>& E_eps)  // Matrix of elastic coefficients
+        : m_element(element), m_E_eps(E_eps) {}
+
+    /// Add (strainD'*stress) at the given quadrature point to Fint.
+    void Evaluate(ChMatrixNM<double, 27, 1>& Fint, const ChElementBeamANCF::GaussPointData& gp);
 
   private:
     ChElementBeamANCF* m_element;
-
-    /// Evaluate (strainD'*strain)  at point x, include ANS and EAS.
-    virtual void Evaluate(ChMatrixNM<double, 27, 1>& result, const double x, const double y, const double z) override;
+    const ChMatrixNM<double, 6, 6>& m_E_eps;
 };
 
-void MyForceBeam::Evaluate(ChMatrixNM<double, 27, 1>& result, const double x, const double y, const double z) {
-    // Element shape function
-    ChMatrixNM<double, 1, 9> N;
-    m_element->ShapeFunctions(N, x, y, z);
-
-    // Determinant of position vector gradient matrix: Initial configuration
-    ChMatrixNM<double, 1, 9> Nx;
-    ChMatrixNM<double, 1, 9> Ny;
-    ChMatrixNM<double, 1, 9> Nz;
-    ChMatrixNM<double, 1, 3> Nx_d0;
-    ChMatrixNM<double, 1, 3> Ny_d0;
-    ChMatrixNM<double, 1, 3> Nz_d0;
-    double detJ0 = m_element->Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
-
-    // Transformation : Orthogonal transformation (A and J)
-    ChVector<double> G1xG2;  // Cross product of first and second column of
-    double G1dotG1;          // Dot product of first column of position vector gradient
-
-    G1xG2.x() = Nx_d0[0][1] * Ny_d0[0][2] - Nx_d0[0][2] * Ny_d0[0][1];
-    G1xG2.y() = Nx_d0[0][2] * Ny_d0[0][0] - Nx_d0[0][0] * Ny_d0[0][2];
-    G1xG2.z() = Nx_d0[0][0] * Ny_d0[0][1] - Nx_d0[0][1] * Ny_d0[0][0];
-    G1dotG1 = Nx_d0[0][0] * Nx_d0[0][0] + Nx_d0[0][1] * Nx_d0[0][1] + Nx_d0[0][2] * Nx_d0[0][2];
-
-    // Tangent Frame
-    ChVector<double> A1;
-    ChVector<double> A2;
-    ChVector<double> A3;
-    A1.x() = Nx_d0[0][0];
-    A1.y() = Nx_d0[0][1];
-    A1.z() = Nx_d0[0][2];
-    A1 = A1 / sqrt(G1dotG1);
-    A3 = G1xG2.GetNormalized();
-    A2.Cross(A3, A1);
-
-    double theta = 0.0;  // TODO
-    ChVector<double> AA1;
-    ChVector<double> AA2;
-    ChVector<double> AA3;
-    AA1 = A1 * cos(theta) + A2 * sin(theta);
-    AA2 = -A1 * sin(theta) + A2 * cos(theta);
-    AA3 = A3;
-
-    /// Beta
-    ChMatrixNM<double, 3, 3> j0;
-    ChVector<double> j01;
-    ChVector<double> j02;
-    ChVector<double> j03;
-    ChMatrixNM<double, 9, 1> beta;
-    // Calculates inverse of rd0 (j0) (position vector gradient: Initial Configuration)
-    j0(0, 0) = Ny_d0[0][1] * Nz_d0[0][2] - Nz_d0[0][1] * Ny_d0[0][2];
-    j0(0, 1) = Ny_d0[0][2] * Nz_d0[0][0] - Ny_d0[0][0] * Nz_d0[0][2];
-    j0(0, 2) = Ny_d0[0][0] * Nz_d0[0][1] - Nz_d0[0][0] * Ny_d0[0][1];
-    j0(1, 0) = Nz_d0[0][1] * Nx_d0[0][2] - Nx_d0[0][1] * Nz_d0[0][2];
-    j0(1, 1) = Nz_d0[0][2] * Nx_d0[0][0] - Nx_d0[0][2] * Nz_d0[0][0];
-    j0(1, 2) = Nz_d0[0][0] * Nx_d0[0][1] - Nz_d0[0][1] * Nx_d0[0][0];
-    j0(2, 0) = Nx_d0[0][1] * Ny_d0[0][2] - Ny_d0[0][1] * Nx_d0[0][2];
-    j0(2, 1) = Ny_d0[0][0] * Nx_d0[0][2] - Nx_d0[0][0] * Ny_d0[0][2];
-    j0(2, 2) = Nx_d0[0][0] * Ny_d0[0][1] - Ny_d0[0][0] * Nx_d0[0][1];
-    j0.MatrDivScale(detJ0);
-
-    j01[0] = j0(0, 0);
-    j02[0] = j0(1, 0);
-    j03[0] = j0(2, 0);
-    j01[1] = j0(0, 1);
-    j02[1] = j0(1, 1);
-    j03[1] = j0(2, 1);
-    j01[2] = j0(0, 2);
-    j02[2] = j0(1, 2);
-    j03[2] = j0(2, 2);
-
-    // Coefficients of contravariant transformation
-    beta(0, 0) = Vdot(AA1, j01);
-    beta(1, 0) = Vdot(AA2, j01);
-    beta(2, 0) = Vdot(AA3, j01);
-    beta(3, 0) = Vdot(AA1, j02);
-    beta(4, 0) = Vdot(AA2, j02);
-    beta(5, 0) = Vdot(AA3, j02);
-    beta(6, 0) = Vdot(AA1, j03);
-    beta(7, 0) = Vdot(AA2, j03);
-    beta(8, 0) = Vdot(AA3, j03);
-
-    ChMatrixNM<double, 9, 1> ddNx;
-    ChMatrixNM<double, 9, 1> ddNy;
-    ChMatrixNM<double, 9, 1> ddNz;
-    ddNx.MatrMultiplyT(m_element->m_ddT, Nx);
-    ddNy.MatrMultiplyT(m_element->m_ddT, Ny);
-    ddNz.MatrMultiplyT(m_element->m_ddT, Nz);
-
-    ChMatrixNM<double, 9, 1> d0d0Nx;
-    ChMatrixNM<double, 9, 1> d0d0Ny;
-    ChMatrixNM<double, 9, 1> d0d0Nz;
-    d0d0Nx.MatrMultiplyT(m_element->m_d0d0T, Nx);
-    d0d0Ny.MatrMultiplyT(m_element->m_d0d0T, Ny);
-    d0d0Nz.MatrMultiplyT(m_element->m_d0d0T, Nz);
-
-    // Strain component
-    ChMatrixNM<double, 6, 1> strain_til;
-    strain_til(0, 0) = 0.5 * ((Nx * ddNx)(0, 0) - (Nx * d0d0Nx)(0, 0));
-    strain_til(1, 0) = 0.5 * ((Ny * ddNy)(0, 0) - (Ny * d0d0Ny)(0, 0));
-    strain_til(2, 0) = (Nx * ddNy)(0, 0) - (Nx * d0d0Ny)(0, 0);
-    strain_til(3, 0) = 0.5 * ((Nz * ddNz)(0, 0) - (Nz * d0d0Nz)(0, 0));
-    strain_til(4, 0) = (Nx * ddNz)(0, 0) - (Nx * d0d0Nz)(0, 0);
-    strain_til(5, 0) = (Ny * ddNz)(0, 0) - (Ny * d0d0Nz)(0, 0);
-
-    // For orthotropic material
-    ChMatrixNM<double, 6, 1> strain;
-
-    strain(0, 0) = strain_til(0, 0) * beta(0) * beta(0) + strain_til(1, 0) * beta(3) * beta(3) +
-                   strain_til(2, 0) * beta(0) * beta(3) + strain_til(3, 0) * beta(6) * beta(6) +
-                   strain_til(4, 0) * beta(0) * beta(6) + strain_til(5, 0) * beta(3) * beta(6);
-    strain(1, 0) = strain_til(0, 0) * beta(1) * beta(1) + strain_til(1, 0) * beta(4) * beta(4) +
-                   strain_til(2, 0) * beta(1) * beta(4) + strain_til(3, 0) * beta(7) * beta(7) +
-                   strain_til(4, 0) * beta(1) * beta(7) + strain_til(5, 0) * beta(4) * beta(7);
-    strain(2, 0) = strain_til(0, 0) * 2.0 * beta(0) * beta(1) + strain_til(1, 0) * 2.0 * beta(3) * beta(4) +
-                   strain_til(2, 0) * (beta(1) * beta(3) + beta(0) * beta(4)) +
-                   strain_til(3, 0) * 2.0 * beta(6) * beta(7) +
-                   strain_til(4, 0) * (beta(1) * beta(6) + beta(0) * beta(7)) +
-                   strain_til(5, 0) * (beta(4) * beta(6) + beta(3) * beta(7));
-    strain(3, 0) = strain_til(0, 0) * beta(2) * beta(2) + strain_til(1, 0) * beta(5) * beta(5) +
-                   strain_til(2, 0) * beta(2) * beta(5) + strain_til(3, 0) * beta(8) * beta(8) +
-                   strain_til(4, 0) * beta(2) * beta(8) + strain_til(5, 0) * beta(5) * beta(8);
-    strain(4, 0) = strain_til(0, 0) * 2.0 * beta(0) * beta(2) + strain_til(1, 0) * 2.0 * beta(3) * beta(5) +
-                   strain_til(2, 0) * (beta(2) * beta(3) + beta(0) * beta(5)) +
-                   strain_til(3, 0) * 2.0 * beta(6) * beta(8) +
-                   strain_til(4, 0) * (beta(2) * beta(6) + beta(0) * beta(8)) +
-                   strain_til(5, 0) * (beta(5) * beta(6) + beta(3) * beta(8));
-    strain(5, 0) = strain_til(0, 0) * 2.0 * beta(1) * beta(2) + strain_til(1, 0) * 2.0 * beta(4) * beta(5) +
-                   strain_til(2, 0) * (beta(2) * beta(4) + beta(1) * beta(5)) +
-                   strain_til(3, 0) * 2.0 * beta(7) * beta(8) +
-                   strain_til(4, 0) * (beta(2) * beta(7) + beta(1) * beta(8)) +
-                   strain_til(5, 0) * (beta(5) * beta(7) + beta(4) * beta(8));
-    // std::cout << "With beta: " << strain(0, 0) << " " << strain(1, 0) << " " << strain(2, 0) << " " <<
-    //    strain(3, 0) << " " << strain(4, 0) << " " << strain(5, 0) << " \n";
-
-    // Strain derivative component
-    ChMatrixNM<double, 6, 27> strainD_til;
-    ChMatrixNM<double, 1, 27> tempB;
-    ChMatrixNM<double, 1, 3> tempB3;   // x
-    ChMatrixNM<double, 1, 3> tempB31;  // y
-    ChMatrixNM<double, 1, 3> tempB32;  // z
-
-    strainD_til.Reset();
-    tempB3.MatrMultiply(Nx, m_element->m_d);
-    for (int i = 0; i < 9; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB3(0, j) * Nx(0, i);
-        }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 27, 0, 0);  // xx
-    tempB31.MatrMultiply(Ny, m_element->m_d);
-    for (int i = 0; i < 9; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB31(0, j) * Ny(0, i);
-        }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 27, 1, 0);  // strainD for yy
-    for (int i = 0; i < 9; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB31(0, j) * Nx(0, i) + tempB3(0, j) * Ny(0, i);
-        }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 27, 2, 0);  // strainD for xy
-
-    tempB32.MatrMultiply(Nz, m_element->m_d);
-    for (int i = 0; i < 9; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB32(0, j) * Nz(0, i);
-        }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 27, 3, 0);  // strainD for zz
-
+void MyForceBeam::Evaluate(ChMatrixNM<double, 27, 1>& Fint, const ChElementBeamANCF::GaussPointData& gp) {
+    // Columns of the current position vector gradient (rx, ry, rz) and their time derivatives (vx, vy, vz)
+    ChVector<> rx(0, 0, 0);
+    ChVector<> ry(0, 0, 0);
+    ChVector<> rz(0, 0, 0);
+    ChVector<> vx(0, 0, 0);
+    ChVector<> vy(0, 0, 0);
+    ChVector<> vz(0, 0, 0);
     for (int i = 0; i < 9; i++) {
         for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB3(0, j) * Nz(0, i) + tempB32(0, j) * Nx(0, i);
+            double d = m_element->m_d(i, j);
+            double d_dt = m_element->m_d_dt(i * 3 + j, 0);
+            rx[j] += gp.Nx[i] * d;
+            ry[j] += gp.Ny[i] * d;
+            rz[j] += gp.Nz[i] * d;
+            vx[j] += gp.Nx[i] * d_dt;
+            vy[j] += gp.Ny[i] * d_dt;
+            vz[j] += gp.Nz[i] * d_dt;
         }
     }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 27, 4, 0);  // strainD for xz
-
-    for (int i = 0; i < 9; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB31(0, j) * Nz(0, i) + tempB32(0, j) * Ny(0, i);
-        }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 27, 5, 0);  // strainD for yz
-
-    // For orthotropic material
-    ChMatrixNM<double, 6, 27> strainD;  // Derivative of the strains w.r.t. the coordinates. Includes orthotropy
-    for (int ii = 0; ii < 27; ii++) {
-        strainD(0, ii) = strainD_til(0, ii) * beta(0) * beta(0) + strainD_til(1, ii) * beta(3) * beta(3) +
-                         strainD_til(2, ii) * beta(0) * beta(3) + strainD_til(3, ii) * beta(6) * beta(6) +
-                         strainD_til(4, ii) * beta(0) * beta(6) + strainD_til(5, ii) * beta(3) * beta(6);
-        strainD(1, ii) = strainD_til(0, ii) * beta(1) * beta(1) + strainD_til(1, ii) * beta(4) * beta(4) +
-                         strainD_til(2, ii) * beta(1) * beta(4) + strainD_til(3, ii) * beta(7) * beta(7) +
-                         strainD_til(4, ii) * beta(1) * beta(7) + strainD_til(5, ii) * beta(4) * beta(7);
-        strainD(2, ii) = strainD_til(0, ii) * 2.0 * beta(0) * beta(1) + strainD_til(1, ii) * 2.0 * beta(3) * beta(4) +
-                         strainD_til(2, ii) * (beta(1) * beta(3) + beta(0) * beta(4)) +
-                         strainD_til(3, ii) * 2.0 * beta(6) * beta(7) +
-                         strainD_til(4, ii) * (beta(1) * beta(6) + beta(0) * beta(7)) +
-                         strainD_til(5, ii) * (beta(4) * beta(6) + beta(3) * beta(7));
-        strainD(3, ii) = strainD_til(0, ii) * beta(2) * beta(2) + strainD_til(1, ii) * beta(5) * beta(5) +
-                         strainD_til(2, ii) * beta(2) * beta(5) + strainD_til(3, ii) * beta(8) * beta(8) +
-                         strainD_til(4, ii) * beta(2) * beta(8) + strainD_til(5) * beta(5) * beta(8);
-        strainD(4, ii) = strainD_til(0, ii) * 2.0 * beta(0) * beta(2) + strainD_til(1, ii) * 2.0 * beta(3) * beta(5) +
-                         strainD_til(2, ii) * (beta(2) * beta(3) + beta(0) * beta(5)) +
-                         strainD_til(3, ii) * 2.0 * beta(6) * beta(8) +
-                         strainD_til(4, ii) * (beta(2) * beta(6) + beta(0) * beta(8)) +
-                         strainD_til(5, ii) * (beta(5) * beta(6) + beta(3) * beta(8));
-        strainD(5, ii) = strainD_til(0, ii) * 2.0 * beta(1) * beta(2) + strainD_til(1, ii) * 2.0 * beta(4) * beta(5) +
-                         strainD_til(2, ii) * (beta(2) * beta(4) + beta(1) * beta(5)) +
-                         strainD_til(3, ii) * 2.0 * beta(7) * beta(8) +
-                         strainD_til(4, ii) * (beta(2) * beta(7) + beta(1) * beta(8)) +
-                         strainD_til(5, ii) * (beta(5) * beta(7) + beta(4) * beta(8));
-    }
-
-    // Strain time derivative for structural damping
-    ChMatrixNM<double, 6, 1> DEPS;
-    DEPS.Reset();
-    for (int ii = 0; ii < 27; ii++) {
-        DEPS(0, 0) = DEPS(0, 0) + strainD(0, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(1, 0) = DEPS(1, 0) + strainD(1, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(2, 0) = DEPS(2, 0) + strainD(2, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(3, 0) = DEPS(3, 0) + strainD(3, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(4, 0) = DEPS(4, 0) + strainD(4, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(5, 0) = DEPS(5, 0) + strainD(5, ii) * m_element->m_d_dt(ii, 0);
-    }
-
-    // Add structural damping
-    strain += DEPS * m_element->m_Alpha;
-
-    // Matrix of elastic coefficients: the input assumes the material *could* be orthotropic
-    const ChMatrixNM<double, 6, 6>& E_eps = m_element->GetMaterial()->Get_E_eps();
-
-    // Internal force calculation
-    ChMatrixNM<double, 27, 6> tempC;
-    tempC.MatrTMultiply(strainD, E_eps);
-
-    // for (unsigned int i = 0; i < 26; i++) {
-    //    tempC(i, 0) = E_eps(0, 0) * strainD(0, i);
-    //    tempC(i, 1) = E_eps(1, 1) * strainD(1, i);
-    //    tempC(i, 2) = E_eps(2, 2) * strainD(2, i);
-    //    tempC(i, 3) = E_eps(3, 3) * strainD(3, i);
-    //    tempC(i, 4) = E_eps(4, 4) * strainD(4, i);
-    //    tempC(i, 5) = E_eps(5, 5) * strainD(5, i);
-    //}
-    ChMatrixNM<double, 27, 1> Fint = (tempC * strain) * (detJ0 * m_element->m_GaussScaling);
-
-    // Total result vector
-    result.PasteClippedMatrix(Fint, 0, 0, 27, 1, 0, 0);
-}
-
-// The class MyForceBeam provides the integrand for the calculation of the internal forces
-// for one layer of an ANCF shell element.
-// The 27 entries in the integrand represent the internal force.
 
-class MyForceBeam_Nu : public ChIntegrable1D<ChMatrixNM<double, 27, 1> > {
-  public:
-    MyForceBeam_Nu(ChElementBeamANCF* element)  // Containing element
-        : m_element(element) {}
-    ~MyForceBeam_Nu() {}
-
-  private:
-    ChElementBeamANCF* m_element;
-
-    /// Evaluate (strainD'*strain)  at point x
-    virtual void Evaluate(ChMatrixNM<double, 27, 1>& result, const double x) override;
-};
-
-void MyForceBeam_Nu::Evaluate(ChMatrixNM<double, 27, 1>& result, const double x) {
-    // Element shape function
-    ChMatrixNM<double, 1, 9> N;
-    double y = 0;
-    double z = 0;
-
-    m_element->ShapeFunctions(N, x, y, z);
-
-    // Determinant of position vector gradient matrix: Initial configuration
-    ChMatrixNM<double, 1, 9> Nx;
-    ChMatrixNM<double, 1, 9> Ny;
-    ChMatrixNM<double, 1, 9> Nz;
-    ChMatrixNM<double, 1, 3> Nx_d0;
-    ChMatrixNM<double, 1, 3> Ny_d0;
-    ChMatrixNM<double, 1, 3> Nz_d0;
-    double detJ0 = m_element->Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
-
-    // Transformation : Orthogonal transformation (A and J)
-    ChVector<double> G1xG2;  // Cross product of first and second column of
-    double G1dotG1;          // Dot product of first column of position vector gradient
-
-    G1xG2.x() = Nx_d0[0][1] * Ny_d0[0][2] - Nx_d0[0][2] * Ny_d0[0][1];
-    G1xG2.y() = Nx_d0[0][2] * Ny_d0[0][0] - Nx_d0[0][0] * Ny_d0[0][2];
-    G1xG2.z() = Nx_d0[0][0] * Ny_d0[0][1] - Nx_d0[0][1] * Ny_d0[0][0];
-    G1dotG1 = Nx_d0[0][0] * Nx_d0[0][0] + Nx_d0[0][1] * Nx_d0[0][1] + Nx_d0[0][2] * Nx_d0[0][2];
-
-    // Tangent Frame
-    ChVector<double> A1;
-    ChVector<double> A2;
-    ChVector<double> A3;
-    A1.x() = Nx_d0[0][0];
-    A1.y() = Nx_d0[0][1];
-    A1.z() = Nx_d0[0][2];
-    A1 = A1 / sqrt(G1dotG1);
-    A3 = G1xG2.GetNormalized();
-    A2.Cross(A3, A1);
-
-    double theta = 0.0;  // TODO
-    ChVector<double> AA1;
-    ChVector<double> AA2;
-    ChVector<double> AA3;
-    AA1 = A1 * cos(theta) + A2 * sin(theta);
-    AA2 = -A1 * sin(theta) + A2 * cos(theta);
-    AA3 = A3;
-
-    /// Beta
-    ChMatrixNM<double, 3, 3> j0;
-    ChVector<double> j01;
-    ChVector<double> j02;
-    ChVector<double> j03;
-    ChMatrixNM<double, 9, 1> beta;
-    // Calculates inverse of rd0 (j0) (position vector gradient: Initial Configuration)
-    j0(0, 0) = Ny_d0[0][1] * Nz_d0[0][2] - Nz_d0[0][1] * Ny_d0[0][2];
-    j0(0, 1) = Ny_d0[0][2] * Nz_d0[0][0] - Ny_d0[0][0] * Nz_d0[0][2];
-    j0(0, 2) = Ny_d0[0][0] * Nz_d0[0][1] - Nz_d0[0][0] * Ny_d0[0][1];
-    j0(1, 0) = Nz_d0[0][1] * Nx_d0[0][2] - Nx_d0[0][1] * Nz_d0[0][2];
-    j0(1, 1) = Nz_d0[0][2] * Nx_d0[0][0] - Nx_d0[0][2] * Nz_d0[0][0];
-    j0(1, 2) = Nz_d0[0][0] * Nx_d0[0][1] - Nz_d0[0][1] * Nx_d0[0][0];
-    j0(2, 0) = Nx_d0[0][1] * Ny_d0[0][2] - Ny_d0[0][1] * Nx_d0[0][2];
-    j0(2, 1) = Ny_d0[0][0] * Nx_d0[0][2] - Nx_d0[0][0] * Ny_d0[0][2];
-    j0(2, 2) = Nx_d0[0][0] * Ny_d0[0][1] - Ny_d0[0][0] * Nx_d0[0][1];
-    j0.MatrDivScale(detJ0);
-
-    j01[0] = j0(0, 0);
-    j02[0] = j0(1, 0);
-    j03[0] = j0(2, 0);
-    j01[1] = j0(0, 1);
-    j02[1] = j0(1, 1);
-    j03[1] = j0(2, 1);
-    j01[2] = j0(0, 2);
-    j02[2] = j0(1, 2);
-    j03[2] = j0(2, 2);
-
-    // Coefficients of contravariant transformation
-    beta(0, 0) = Vdot(AA1, j01);
-    beta(1, 0) = Vdot(AA2, j01);
-    beta(2, 0) = Vdot(AA3, j01);
-    beta(3, 0) = Vdot(AA1, j02);
-    beta(4, 0) = Vdot(AA2, j02);
-    beta(5, 0) = Vdot(AA3, j02);
-    beta(6, 0) = Vdot(AA1, j03);
-    beta(7, 0) = Vdot(AA2, j03);
-    beta(8, 0) = Vdot(AA3, j03);
-
-    ChMatrixNM<double, 9, 1> ddNx;
-    ChMatrixNM<double, 9, 1> ddNy;
-    ChMatrixNM<double, 9, 1> ddNz;
-    ddNx.MatrMultiplyT(m_element->m_ddT, Nx);
-    ddNy.MatrMultiplyT(m_element->m_ddT, Ny);
-    ddNz.MatrMultiplyT(m_element->m_ddT, Nz);
-
-    ChMatrixNM<double, 9, 1> d0d0Nx;
-    ChMatrixNM<double, 9, 1> d0d0Ny;
-    ChMatrixNM<double, 9, 1> d0d0Nz;
-    d0d0Nx.MatrMultiplyT(m_element->m_d0d0T, Nx);
-    d0d0Ny.MatrMultiplyT(m_element->m_d0d0T, Ny);
-    d0d0Nz.MatrMultiplyT(m_element->m_d0d0T, Nz);
-
-    // Strain component
+    // Strain components, plus structural damping (strain rates are the products of the strain derivatives,
+    // strainD_til, and the nodal velocities)
+    double alpha = m_element->m_Alpha;
     ChMatrixNM<double, 6, 1> strain_til;
-    strain_til(0, 0) = 0.5 * ((Nx * ddNx)(0, 0) - (Nx * d0d0Nx)(0, 0));
-    strain_til(1, 0) = 0.5 * ((Ny * ddNy)(0, 0) - (Ny * d0d0Ny)(0, 0));
-    strain_til(2, 0) = (Nx * ddNy)(0, 0) - (Nx * d0d0Ny)(0, 0);
-    strain_til(3, 0) = 0.5 * ((Nz * ddNz)(0, 0) - (Nz * d0d0Nz)(0, 0));
-    strain_til(4, 0) = (Nx * ddNz)(0, 0) - (Nx * d0d0Nz)(0, 0);
-    strain_til(5, 0) = (Ny * ddNz)(0, 0) - (Ny * d0d0Nz)(0, 0);
+    strain_til(0, 0) = 0.5 * Vdot(rx, rx) - gp.strain0[0] + alpha * Vdot(rx, vx);
+    strain_til(1, 0) = 0.5 * Vdot(ry, ry) - gp.strain0[1] + alpha * Vdot(ry, vy);
+    strain_til(2, 0) = Vdot(rx, ry) - gp.strain0[2] + alpha * (Vdot(ry, vx) + Vdot(rx, vy));
+    strain_til(3, 0) = 0.5 * Vdot(rz, rz) - gp.strain0[3] + alpha * Vdot(rz, vz);
+    strain_til(4, 0) = Vdot(rx, rz) - gp.strain0[4] + alpha * (Vdot(rz, vx) + Vdot(rx, vz));
+    strain_til(5, 0) = Vdot(ry, rz) - gp.strain0[5] + alpha * (Vdot(rz, vy) + Vdot(ry, vz));
 
     // For orthotropic material
+    ChMatrixNM<double, 6, 6> T;
+    CalcStrainTransformation(T, gp.beta);
     ChMatrixNM<double, 6, 1> strain;
+    strain.MatrMultiply(T, strain_til);
 
-    strain(0, 0) = strain_til(0, 0) * beta(0) * beta(0) + strain_til(1, 0) * beta(3) * beta(3) +
-                   strain_til(2, 0) * beta(0) * beta(3) + strain_til(3, 0) * beta(6) * beta(6) +
-                   strain_til(4, 0) * beta(0) * beta(6) + strain_til(5, 0) * beta(3) * beta(6);
-    strain(1, 0) = strain_til(0, 0) * beta(1) * beta(1) + strain_til(1, 0) * beta(4) * beta(4) +
-                   strain_til(2, 0) * beta(1) * beta(4) + strain_til(3, 0) * beta(7) * beta(7) +
-                   strain_til(4, 0) * beta(1) * beta(7) + strain_til(5, 0) * beta(4) * beta(7);
-    strain(2, 0) = strain_til(0, 0) * 2.0 * beta(0) * beta(1) + strain_til(1, 0) * 2.0 * beta(3) * beta(4) +
-                   strain_til(2, 0) * (beta(1) * beta(3) + beta(0) * beta(4)) +
-                   strain_til(3, 0) * 2.0 * beta(6) * beta(7) +
-                   strain_til(4, 0) * (beta(1) * beta(6) + beta(0) * beta(7)) +
-                   strain_til(5, 0) * (beta(4) * beta(6) + beta(3) * beta(7));
-    strain(3, 0) = strain_til(0, 0) * beta(2) * beta(2) + strain_til(1, 0) * beta(5) * beta(5) +
-                   strain_til(2, 0) * beta(2) * beta(5) + strain_til(3, 0) * beta(8) * beta(8) +
-                   strain_til(4, 0) * beta(2) * beta(8) + strain_til(5, 0) * beta(5) * beta(8);
-    strain(4, 0) = strain_til(0, 0) * 2.0 * beta(0) * beta(2) + strain_til(1, 0) * 2.0 * beta(3) * beta(5) +
-                   strain_til(2, 0) * (beta(2) * beta(3) + beta(0) * beta(5)) +
-                   strain_til(3, 0) * 2.0 * beta(6) * beta(8) +
-                   strain_til(4, 0) * (beta(2) * beta(6) + beta(0) * beta(8)) +
-                   strain_til(5, 0) * (beta(5) * beta(6) + beta(3) * beta(8));
-    strain(5, 0) = strain_til(0, 0) * 2.0 * beta(1) * beta(2) + strain_til(1, 0) * 2.0 * beta(4) * beta(5) +
-                   strain_til(2, 0) * (beta(2) * beta(4) + beta(1) * beta(5)) +
-                   strain_til(3, 0) * 2.0 * beta(7) * beta(8) +
-                   strain_til(4, 0) * (beta(2) * beta(7) + beta(1) * beta(8)) +
-                   strain_til(5, 0) * (beta(5) * beta(7) + beta(4) * beta(8));
-
-    // Strain derivative component
-
-    ChMatrixNM<double, 6, 27> strainD_til;
-    ChMatrixNM<double, 1, 27> tempB;
-    ChMatrixNM<double, 1, 3> tempB3;   // x
-    ChMatrixNM<double, 1, 3> tempB31;  // y
-    ChMatrixNM<double, 1, 3> tempB32;  // z
-
-    strainD_til.Reset();
-    tempB3.MatrMultiply(Nx, m_element->m_d);
-    for (int i = 0; i < 9; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB3(0, j) * Nx(0, i);
-        }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 27, 0, 0);
-    tempB31.MatrMultiply(Ny, m_element->m_d);
-    for (int i = 0; i < 9; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB31(0, j) * Ny(0, i);
-        }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 27, 1, 0);  // strainD for yz
-    for (int i = 0; i < 9; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB31(0, j) * Nx(0, i) + tempB3(0, j) * Ny(0, i);
-        }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 27, 2, 0);  // strainD for xy
-
-    tempB32.MatrMultiply(Nz, m_element->m_d);
-    for (int i = 0; i < 9; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB32(0, j) * Nz(0, i);
-        }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 27, 3, 0);  // strainD for zz
-
-    for (int i = 0; i < 9; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB3(0, j) * Nz(0, i) + tempB32(0, j) * Nx(0, i);
-        }
+    // Internal forces, as strainD'*stress = strainD_til'*(T'*stress), without forming the 6x27 matrices of the
+    // strain derivatives
+    ChMatrixNM<double, 6, 1> stress;
+    stress.MatrMultiply(m_E_eps, strain);
+    ChMatrixNM<double, 6, 1> stress_til;
+    stress_til.MatrTMultiply(T, stress);
+
+    double Px[3];
+    double Py[3];
+    double Pz[3];
+    for (int j = 0; j < 3; j++) {
+        Px[j] = gp.weight * (rx[j] * stress_til(0) + ry[j] * stress_til(2) + rz[j] * stress_til(4));
+        Py[j] = gp.weight * (ry[j] * stress_til(1) + rx[j] * stress_til(2) + rz[j] * stress_til(5));
+        Pz[j] = gp.weight * (rz[j] * stress_til(3) + rx[j] * stress_til(4) + ry[j] * stress_til(5));
     }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 27, 4, 0);  // strainD for xz
-
     for (int i = 0; i < 9; i++) {
         for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB31(0, j) * Nz(0, i) + tempB32(0, j) * Ny(0, i);
+            Fint(i * 3 + j) += gp.Nx[i] * Px[j] + gp.Ny[i] * Py[j] + gp.Nz[i] * Pz[j];
         }
     }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 27, 5, 0);  // strainD for yz
-
-    // For orthotropic material
-    ChMatrixNM<double, 6, 27> strainD;  // Derivative of the strains w.r.t. the coordinates. Includes orthotropy
-    for (int ii = 0; ii < 27; ii++) {
-        strainD(0, ii) = strainD_til(0, ii) * beta(0) * beta(0) + strainD_til(1, ii) * beta(3) * beta(3) +
-                         strainD_til(2, ii) * beta(0) * beta(3) + strainD_til(3, ii) * beta(6) * beta(6) +
-                         strainD_til(4, ii) * beta(0) * beta(6) + strainD_til(5, ii) * beta(3) * beta(6);
-        strainD(1, ii) = strainD_til(0, ii) * beta(1) * beta(1) + strainD_til(1, ii) * beta(4) * beta(4) +
-                         strainD_til(2, ii) * beta(1) * beta(4) + strainD_til(3, ii) * beta(7) * beta(7) +
-                         strainD_til(4, ii) * beta(1) * beta(7) + strainD_til(5, ii) * beta(4) * beta(7);
-        strainD(2, ii) = strainD_til(0, ii) * 2.0 * beta(0) * beta(1) + strainD_til(1, ii) * 2.0 * beta(3) * beta(4) +
-                         strainD_til(2, ii) * (beta(1) * beta(3) + beta(0) * beta(4)) +
-                         strainD_til(3, ii) * 2.0 * beta(6) * beta(7) +
-                         strainD_til(4, ii) * (beta(1) * beta(6) + beta(0) * beta(7)) +
-                         strainD_til(5, ii) * (beta(4) * beta(6) + beta(3) * beta(7));
-        strainD(3, ii) = strainD_til(0, ii) * beta(2) * beta(2) + strainD_til(1, ii) * beta(5) * beta(5) +
-                         strainD_til(2, ii) * beta(2) * beta(5) + strainD_til(3, ii) * beta(8) * beta(8) +
-                         strainD_til(4, ii) * beta(2) * beta(8) + strainD_til(5) * beta(5) * beta(8);
-        strainD(4, ii) = strainD_til(0, ii) * 2.0 * beta(0) * beta(2) + strainD_til(1, ii) * 2.0 * beta(3) * beta(5) +
-                         strainD_til(2, ii) * (beta(2) * beta(3) + beta(0) * beta(5)) +
-                         strainD_til(3, ii) * 2.0 * beta(6) * beta(8) +
-                         strainD_til(4, ii) * (beta(2) * beta(6) + beta(0) * beta(8)) +
-                         strainD_til(5, ii) * (beta(5) * beta(6) + beta(3) * beta(8));
-        strainD(5, ii) = strainD_til(0, ii) * 2.0 * beta(1) * beta(2) + strainD_til(1, ii) * 2.0 * beta(4) * beta(5) +
-                         strainD_til(2, ii) * (beta(2) * beta(4) + beta(1) * beta(5)) +
-                         strainD_til(3, ii) * 2.0 * beta(7) * beta(8) +
-                         strainD_til(4, ii) * (beta(2) * beta(7) + beta(1) * beta(8)) +
-                         strainD_til(5, ii) * (beta(5) * beta(7) + beta(4) * beta(8));
-    }
-
-    // Strain time derivative for structural damping
-    ChMatrixNM<double, 6, 1> DEPS;
-    DEPS.Reset();
-    for (int ii = 0; ii < 27; ii++) {
-        DEPS(0, 0) = DEPS(0, 0) + strainD(0, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(1, 0) = DEPS(1, 0) + strainD(1, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(2, 0) = DEPS(2, 0) + strainD(2, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(3, 0) = DEPS(3, 0) + strainD(3, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(4, 0) = DEPS(4, 0) + strainD(4, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(5, 0) = DEPS(5, 0) + strainD(5, ii) * m_element->m_d_dt(ii, 0);
-    }
-
-    // Add structural damping
-    strain += DEPS * m_element->m_Alpha;
-
-    // Matrix of elastic coefficients: the input assumes the material *could* be orthotropic
-    const ChMatrixNM<double, 6, 6>& E_eps = m_element->GetMaterial()->Get_E_eps_Nu();
-
-    // Internal force calculation
-    ChMatrixNM<double, 27, 6> tempC;
-    tempC.MatrTMultiply(strainD, E_eps);
-    ChMatrixNM<double, 27, 1> Fint = (tempC * strain) * (detJ0 * m_element->GetLengthX() / 2);
-
-    // Total result vector
-    result.PasteClippedMatrix(Fint, 0, 0, 27, 1, 0, 0);
 }
 
 void ChElementBeamANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
@@ -780,36 +375,19 @@ void ChElementBeamANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
 
     // Three-dimensional integration of Poisson-less terms
     ChMatrixNM<double, 27, 1> Finternal0;
-    ChMatrixNM<double, 27, 1> result;
-    MyForceBeam formula(this);
-    ChQuadrature::Integrate3D<ChMatrixNM<double, 27, 1> >(result,   // result of integration
-                                                          formula,  // integrand formula
-                                                          -1, 1,    // x limits
-                                                          -1, 1,    // y limits
-                                                          -1, 1,    // z limits
-                                                          3         // order of integration
-                                                          );
-
-    // Extract vectors and matrices from result of integration
-    Finternal0.PasteClippedMatrix(result, 0, 0, 27, 1, 0, 0);
+    MyForceBeam formula(this, GetMaterial()->Get_E_eps());
+    for (int ip = 0; ip < 27; ip++)
+        formula.Evaluate(Finternal0, m_GaussPoints[ip]);
 
     // Accumulate internal force
     Fi -= Finternal0;
 
     if (GetStrainFormulation() == ChElementBeamANCF::StrainFormulation::CMPoisson) {
         // One-dimensional integration of Poisson terms (over centerline)
-        result.Reset();
         Finternal0.Reset();
-        MyForceBeam_Nu formula_Nu(this);
-        ChQuadrature::Integrate1D<ChMatrixNM<double, 27, 1> >(result,      // result of integration
-                                                              formula_Nu,  // integrand formula
-                                                              -1, 1,       // x limits
-                                                              2            // order of integration
-                                                              );
-
-        // Extract vectors and matrices from result of integration
-        result.MatrScale(GetThicknessY() * GetThicknessZ());
-        Finternal0.PasteClippedMatrix(result, 0, 0, 27, 1, 0, 0);
+        MyForceBeam formula_Nu(this, GetMaterial()->Get_E_eps_Nu());
+        for (int ip = 0; ip < 2; ip++)
+            formula_Nu.Evaluate(Finternal0, m_GaussPointsNu[ip]);
 
         // Accumulate internal force
         Fi -= Finternal0;
@@ -1644,6 +1222,67 @@ double ChElementBeamANCF::Calc_detJ0(double x, double y, double z) {
     return Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
 }
 
+void ChElementBeamANCF::ComputeGaussPointData() {
+    // Same points as the 3rd order quadrature of ChQuadrature::Integrate3D() over [-1,1]^3.
+    ChQuadraturePoints3D<3> points;
+    for (int ip = 0; ip < ChQuadraturePoints3D<3>::num_points; ip++)
+        ComputeGaussPoint(m_GaussPoints[ip], points.x[ip], points.y[ip], points.z[ip], points.w[ip] * m_GaussScaling);
+
+    // Same points as the 2nd order quadrature of ChQuadrature::Integrate1D() over [-1,1], on the centerline.
+    ChQuadraturePoints1D<2> points_Nu;
+    for (int ip = 0; ip < ChQuadraturePoints1D<2>::num_points; ip++)
+        ComputeGaussPoint(m_GaussPointsNu[ip], points_Nu.x[ip], 0, 0,
+                          points_Nu.w[ip] * (m_lenX / 2) * m_thicknessY * m_thicknessZ);
+}
+
+void ChElementBeamANCF::ComputeGaussPoint(GaussPointData& gp, double x, double y, double z, double weight) {
+    ChMatrixNM<double, 1, 9> Nx;
+    ChMatrixNM<double, 1, 9> Ny;
+    ChMatrixNM<double, 1, 9> Nz;
+    ChMatrixNM<double, 1, 3> Nx_d0;
+    ChMatrixNM<double, 1, 3> Ny_d0;
+    ChMatrixNM<double, 1, 3> Nz_d0;
+    double detJ0 = Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
+    for (int i = 0; i < 9; i++) {
+        gp.Nx[i] = Nx(0, i);
+        gp.Ny[i] = Ny(0, i);
+        gp.Nz[i] = Nz(0, i);
+    }
+    gp.weight = weight * detJ0;
+
+    // Tangent frame
+    ChVector<> rx0(Nx_d0(0, 0), Nx_d0(0, 1), Nx_d0(0, 2));
+    ChVector<> ry0(Ny_d0(0, 0), Ny_d0(0, 1), Ny_d0(0, 2));
+    ChVector<> rz0(Nz_d0(0, 0), Nz_d0(0, 1), Nz_d0(0, 2));
+    ChVector<> A1 = rx0 / rx0.Length();
+    ChVector<> A3 = Vcross(rx0, ry0).GetNormalized();
+    ChVector<> A2 = Vcross(A3, A1);
+
+    // Inverse of rd0 (position vector gradient: initial configuration), by rows j01, j02, j03
+    ChVector<> j01 = Vcross(ry0, rz0) / detJ0;
+    ChVector<> j02 = Vcross(rz0, rx0) / detJ0;
+    ChVector<> j03 = Vcross(rx0, ry0) / detJ0;
+
+    // Coefficients of contravariant transformation
+    gp.beta[0] = Vdot(A1, j01);
+    gp.beta[1] = Vdot(A2, j01);
+    gp.beta[2] = Vdot(A3, j01);
+    gp.beta[3] = Vdot(A1, j02);
+    gp.beta[4] = Vdot(A2, j02);
+    gp.beta[5] = Vdot(A3, j02);
+    gp.beta[6] = Vdot(A1, j03);
+    gp.beta[7] = Vdot(A2, j03);
+    gp.beta[8] = Vdot(A3, j03);
+
+    // Terms of the Green-Lagrange strains in the initial configuration
+    gp.strain0[0] = 0.5 * Vdot(rx0, rx0);
+    gp.strain0[1] = 0.5 * Vdot(ry0, ry0);
+    gp.strain0[2] = Vdot(rx0, ry0);
+    gp.strain0[3] = 0.5 * Vdot(rz0, rz0);
+    gp.strain0[4] = Vdot(rx0, rz0);
+    gp.strain0[5] = Vdot(ry0, rz0);
+}
+
 void ChElementBeamANCF::CalcCoordMatrix(ChMatrixNM<double, 9, 3>& d) {
     const ChVector<>& pA = m_nodes[0]->GetPos();
     const ChVector<>& dA = m_nodes[0]->GetD();
@@ -201,6 +201,19 @@ class ChApiFea ChElementBeamANCF : public ChElementBeam, public ChLoadableU, pub
     std::shared_ptr<ChMaterialBeamANCF> m_material;         ///< beam material
     StrainFormulation m_strain_form;                        ///< Strain formulation
 
+    /// Data of the reference configuration at a quadrature point of the internal forces.
+    struct GaussPointData {
+        double Nx[9];       ///< derivatives of the shape functions w.r.t. x
+        double Ny[9];       ///< derivatives of the shape functions w.r.t. y
+        double Nz[9];       ///< derivatives of the shape functions w.r.t. z
+        double beta[9];     ///< coefficients of the contravariant transformation
+        double strain0[6];  ///< reference terms of the Green-Lagrange strains
+        double weight;      ///< quadrature weight, times detJ0 and the scaling of the integration interval
+    };
+
+    GaussPointData m_GaussPoints[27];   ///< reference data at the 3x3x3 quadrature points of the internal forces
+    GaussPointData m_GaussPointsNu[2];  ///< reference data at the 2 quadrature points of the Poisson terms
+
   public:
     // Interface to ChElementBase base class
     // -------------------------------------
@@ -222,6 +235,9 @@ class ChApiFea ChElementBeamANCF : public ChElementBeam, public ChLoadableU, pub
     // Set M as the global mass matrix.
     virtual void ComputeMmatrixGlobal(ChMatrix<>& M) override;
 
+    // The mass matrix is constant, computed in SetupInitial().
+    virtual bool HasConstantMass() const override { return true; }
+
     /// Add contribution of element inertia to total nodal masses
     virtual void ComputeNodalMass() override;
 
@@ -302,6 +318,12 @@ class ChApiFea ChElementBeamANCF : public ChElementBeam, public ChLoadableU, pub
                       ChMatrixNM<double, 1, 3>& Ny_d0,
                       ChMatrixNM<double, 1, 3>& Nz_d0);
 
+    // Compute the data of the reference configuration at the quadrature points of the internal forces.
+    void ComputeGaussPointData();
+
+    // Compute the data of the reference configuration at the specified quadrature point.
+    void ComputeGaussPoint(GaussPointData& gp, double x, double y, double z, double weight);
+
     // Calculate the current 9x3 matrix of nodal coordinates.
     void CalcCoordMatrix(ChMatrixNM<double, 9, 3>& d);
 
@@ -391,7 +413,6 @@ class ChApiFea ChElementBeamANCF : public ChElementBeam, public ChLoadableU, pub
     friend class MyMassBeam;
     friend class MyGravityBeam;
     friend class MyForceBeam;
-    friend class MyForceBeam_Nu;
     friend class MyJacobianBeam;
     friend class MyJacobianBeam_Nu;
 };
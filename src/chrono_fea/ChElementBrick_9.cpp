@@ -88,6 +88,7 @@ void ChElementBrick_9::SetupInitial(ChSystem* system) {
 
     m_GaussScaling = (GetDimensions().x() * GetDimensions().y() * GetDimensions().z()) / 8;
 
+    ComputeGaussPointData();
     ComputeMassMatrix();
     ComputeGravityForce(system->Get_G_acc());
 }
@@ -284,75 +285,29 @@ void ChElementBrick_9::ComputeGravityForce(const ChVector<>& g_acc) {
 // Calculation of the internal forces
 // -----------------------------------------------------------------------------
 
-// Private class for quadrature of internal forces
-class MyForceBrick9 : public ChIntegrable3D<ChMatrixNM<double, 33, 1>> {
+// Private class for the evaluation of the internal forces at the quadrature points.
+// The data of the reference configuration at each point is computed once, in SetupInitial(), so that the
+// integration is a plain loop over the points, with no virtual calls and no shape function evaluations.
+class MyForceBrick9 {
   public:
-    MyForceBrick9(ChElementBrick_9* element) : m_element(element) {}
-    ~MyForceBrick9() {}
+    MyForceBrick9(ChElementBrick_9* element);
+
+    // Add to Fint the contribution of the given quadrature point.
+    void Evaluate(ChMatrixNM<double, 33, 1>& Fint, const ChElementBrick_9::GaussPointData& gp);
 
   private:
     ChElementBrick_9* m_element;
-    virtual void Evaluate(ChMatrixNM<double, 33, 1>& result, const double x, const double y, const double z) override;
+    double E;                         // Young modulus
+    double nu;                        // Poisson ratio
+    ChMatrixNM<double, 6, 6> E_eps;  // Matrix of elastic coefficients
 };
 
-// Evaluate integrand at the specified point
-void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x, const double y, const double z) {
-    ChMatrixNM<double, 1, 11> N;
-    m_element->ShapeFunctions(N, x, y, z);
-
-    // Determinant of position vector gradient matrix: Initial configuration
-    ChMatrixNM<double, 1, 11> Nx;
-    ChMatrixNM<double, 1, 11> Ny;
-    ChMatrixNM<double, 1, 11> Nz;
-    ChMatrixNM<double, 1, 3> Nx_d0;
-    ChMatrixNM<double, 1, 3> Ny_d0;
-    ChMatrixNM<double, 1, 3> Nz_d0;
-    ChMatrixNM<double, 1, 3> Nx_d;
-    ChMatrixNM<double, 1, 3> Ny_d;
-    ChMatrixNM<double, 1, 3> Nz_d;
-    double detJ0 = m_element->Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
-
-    Nx_d = Nx * m_element->m_d;
-    Ny_d = Ny * m_element->m_d;
-    Nz_d = Nz * m_element->m_d;
-
-    double detJ = Nx_d(0, 0) * Ny_d(0, 1) * Nz_d(0, 2) + Ny_d(0, 0) * Nz_d(0, 1) * Nx_d(0, 2) +
-                  Nz_d(0, 0) * Nx_d(0, 1) * Ny_d(0, 2) - Nx_d(0, 2) * Ny_d(0, 1) * Nz_d(0, 0) -
-                  Ny_d(0, 2) * Nz_d(0, 1) * Nx_d(0, 0) - Nz_d(0, 2) * Nx_d(0, 1) * Ny_d(0, 0);
-
-    ChMatrixNM<double, 3, 3> j0;
-
-    // Calculates inverse of rd0 (j0) (position vector gradient: Initial Configuration)
-    j0(0, 0) = Ny_d0(0, 1) * Nz_d0(0, 2) - Nz_d0(0, 1) * Ny_d0(0, 2);
-    j0(0, 1) = Ny_d0(0, 2) * Nz_d0(0, 0) - Ny_d0(0, 0) * Nz_d0(0, 2);
-    j0(0, 2) = Ny_d0(0, 0) * Nz_d0(0, 1) - Nz_d0(0, 0) * Ny_d0(0, 1);
-    j0(1, 0) = Nz_d0(0, 1) * Nx_d0(0, 2) - Nx_d0(0, 1) * Nz_d0(0, 2);
-    j0(1, 1) = Nz_d0(0, 2) * Nx_d0(0, 0) - Nx_d0(0, 2) * Nz_d0(0, 0);
-    j0(1, 2) = Nz_d0(0, 0) * Nx_d0(0, 1) - Nz_d0(0, 1) * Nx_d0(0, 0);
-    j0(2, 0) = Nx_d0(0, 1) * Ny_d0(0, 2) - Ny_d0(0, 1) * Nx_d0(0, 2);
-    j0(2, 1) = Ny_d0(0, 0) * Nx_d0(0, 2) - Nx_d0(0, 0) * Ny_d0(0, 2);
-    j0(2, 2) = Nx_d0(0, 0) * Ny_d0(0, 1) - Ny_d0(0, 0) * Nx_d0(0, 1);
-    j0.MatrDivScale(detJ0);
-
-    // Do we need to account for deformed initial configuration in DefF?
-    ChMatrixNM<double, 3, 3> DefF;
-    DefF(0, 0) = Nx_d(0, 0);
-    DefF(1, 0) = Nx_d(0, 1);
-    DefF(2, 0) = Nx_d(0, 2);
-    DefF(0, 1) = Ny_d(0, 0);
-    DefF(1, 1) = Ny_d(0, 1);
-    DefF(2, 1) = Ny_d(0, 2);
-    DefF(0, 2) = Nz_d(0, 0);
-    DefF(1, 2) = Nz_d(0, 1);
-    DefF(2, 2) = Nz_d(0, 2);
-
-    double E = m_element->GetMaterial()->Get_E();
-    double nu = m_element->GetMaterial()->Get_v();
+MyForceBrick9::MyForceBrick9(ChElementBrick_9* element) : m_element(element) {
+    E = m_element->GetMaterial()->Get_E();
+    nu = m_element->GetMaterial()->Get_v();
     double C1 = E * nu / ((1.0 + nu) * (1.0 - 2.0 * nu));
     double C2 = m_element->GetMaterial()->Get_G();
 
-    // Matrix of elastic coefficients
-    ChMatrixNM<double, 6, 6> E_eps;
     E_eps(0, 0) = C1 + 2.0 * C2;
     E_eps(1, 1) = C1 + 2.0 * C2;
     E_eps(3, 3) = C1 + 2.0 * C2;
@@ -365,109 +320,91 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
     E_eps(2, 2) = C2;
     E_eps(4, 4) = C2;
     E_eps(5, 5) = C2;
+}
+
+// Evaluate integrand at the specified point
+void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& Fint, const ChElementBrick_9::GaussPointData& gp) {
+    const ChMatrixNM<double, 1, 11>& Nx = gp.Nx;
+    const ChMatrixNM<double, 1, 11>& Ny = gp.Ny;
+    const ChMatrixNM<double, 1, 11>& Nz = gp.Nz;
+    const ChMatrixNM<double, 3, 3>& j0 = gp.j0;
 
-    // element->SetStrainFormulation(ChElementBrick_9::Hencky);
-    // element->SetPlasticityFormulation(ChElementBrick_9::DruckerPrager);
-    // if (ChElementBrick_9::Hencky == element->GetStrainFormulation) {
     switch (m_element->GetStrainFormulation()) {
         case ChElementBrick_9::GreenLagrange: {
-            // ddNx = e^{T}*Nx^{T}*Nx, ddNy = e^{T}*Ny^{T}*Ny, ddNz = e^{T}*Nz^{T}*Nz
-            ChMatrixNM<double, 11, 1> ddNx;
-            ChMatrixNM<double, 11, 1> ddNy;
-            ChMatrixNM<double, 11, 1> ddNz;
-            ddNx.MatrMultiplyT(m_element->m_ddT, Nx);
-            ddNy.MatrMultiplyT(m_element->m_ddT, Ny);
-            ddNz.MatrMultiplyT(m_element->m_ddT, Nz);
-
-            // d0d0Nx = e0^{T}*Nx^{T}*Nx, d0d0Ny = e0^{T}*Ny^{T}*Ny, d0d0Nz = e0^{T}*Nz^{T}*Nz
-            ChMatrixNM<double, 11, 1> d0d0Nx;
-            ChMatrixNM<double, 11, 1> d0d0Ny;
-            ChMatrixNM<double, 11, 1> d0d0Nz;
-            d0d0Nx.MatrMultiplyT(m_element->m_d0d0T, Nx);
-            d0d0Ny.MatrMultiplyT(m_element->m_d0d0T, Ny);
-            d0d0Nz.MatrMultiplyT(m_element->m_d0d0T, Nz);
-
-            // Green-Lagrange strain components
-            ChMatrixNM<double, 6, 1> strain;
-            strain(0, 0) = 0.5 * ((Nx * ddNx)(0, 0) - (Nx * d0d0Nx)(0, 0));
-            strain(1, 0) = 0.5 * ((Ny * ddNy)(0, 0) - (Ny * d0d0Ny)(0, 0));
-            strain(2, 0) = (Nx * ddNy)(0, 0) - (Nx * d0d0Ny)(0, 0);
-            strain(3, 0) = 0.5 * ((Nz * ddNz)(0, 0) - (Nz * d0d0Nz)(0, 0));
-            strain(4, 0) = (Nx * ddNz)(0, 0) - (Nx * d0d0Nz)(0, 0);
-            strain(5, 0) = (Ny * ddNz)(0, 0) - (Ny * d0d0Nz)(0, 0);
-
-            // Strain derivative component
-            ChMatrixNM<double, 6, 33> strainD;
-            ChMatrixNM<double, 1, 33> tempB;
-            ChMatrixNM<double, 1, 33> tempBB;
-            ChMatrixNM<double, 1, 3> tempB3;
-            ChMatrixNM<double, 1, 3> tempB31;
-            tempB3.MatrMultiply(Nx, m_element->m_d);
+            // Columns of the current position vector gradient (rx, ry, rz) and their time derivatives (vx, vy, vz)
+            ChVector<> rx(0, 0, 0);
+            ChVector<> ry(0, 0, 0);
+            ChVector<> rz(0, 0, 0);
+            ChVector<> vx(0, 0, 0);
+            ChVector<> vy(0, 0, 0);
+            ChVector<> vz(0, 0, 0);
             for (int i = 0; i < 11; i++) {
                 for (int j = 0; j < 3; j++) {
-                    tempB(0, i * 3 + j) = tempB3(0, j) * Nx(0, i);
+                    double d = m_element->m_d(i, j);
+                    double d_dt = m_element->m_d_dt(i * 3 + j, 0);
+                    rx[j] += Nx(0, i) * d;
+                    ry[j] += Ny(0, i) * d;
+                    rz[j] += Nz(0, i) * d;
+                    vx[j] += Nx(0, i) * d_dt;
+                    vy[j] += Ny(0, i) * d_dt;
+                    vz[j] += Nz(0, i) * d_dt;
                 }
             }
-            strainD.PasteClippedMatrix(tempB, 0, 0, 1, 33, 0, 0);
-            tempB3.MatrMultiply(Ny, m_element->m_d);
-            for (int i = 0; i < 11; i++) {
-                for (int j = 0; j < 3; j++) {
-                    tempB(0, i * 3 + j) = tempB3(0, j) * Ny(0, i);
-                }
-            }
-            strainD.PasteClippedMatrix(tempB, 0, 0, 1, 33, 1, 0);
-            tempB31.MatrMultiply(Nx, m_element->m_d);
-            for (int i = 0; i < 11; i++) {
-                for (int j = 0; j < 3; j++) {
-                    tempB(0, i * 3 + j) = tempB3(0, j) * Nx(0, i) + tempB31(0, j) * Ny(0, i);
-                }
-            }
-            strainD.PasteClippedMatrix(tempB, 0, 0, 1, 33, 2, 0);
 
-            tempB3.MatrMultiply(Nz, m_element->m_d);
-            for (int i = 0; i < 11; i++) {
-                for (int j = 0; j < 3; j++) {
-                    tempB(0, i * 3 + j) = tempB3(0, j) * Nz(0, i);
-                }
-            }
-            strainD.PasteClippedMatrix(tempB, 0, 0, 1, 33, 3, 0);
-            tempB31.MatrMultiply(Nx, m_element->m_d);
-            for (int i = 0; i < 11; i++) {
-                for (int j = 0; j < 3; j++) {
-                    tempB(0, i * 3 + j) = tempB3(0, j) * Nx(0, i) + tempB31(0, j) * Nz(0, i);
-                }
+            // Green-Lagrange strain components, plus structural damping (strain rates are the products of the
+            // strain derivatives, strainD, and the nodal velocities)
+            double alpha = m_element->m_Alpha;
+            ChMatrixNM<double, 6, 1> strain;
+            strain(0, 0) = 0.5 * Vdot(rx, rx) - gp.strain0[0] + alpha * Vdot(rx, vx);
+            strain(1, 0) = 0.5 * Vdot(ry, ry) - gp.strain0[1] + alpha * Vdot(ry, vy);
+            strain(2, 0) = Vdot(rx, ry) - gp.strain0[2] + alpha * (Vdot(ry, vx) + Vdot(rx, vy));
+            strain(3, 0) = 0.5 * Vdot(rz, rz) - gp.strain0[3] + alpha * Vdot(rz, vz);
+            strain(4, 0) = Vdot(rx, rz) - gp.strain0[4] + alpha * (Vdot(rz, vx) + Vdot(rx, vz));
+            strain(5, 0) = Vdot(ry, rz) - gp.strain0[5] + alpha * (Vdot(rz, vy) + Vdot(ry, vz));
+
+            // Internal forces, as strainD^T * stress, without forming the 6x33 matrix strainD
+            ChMatrixNM<double, 6, 1> stress;
+            stress.MatrMultiply(E_eps, strain);
+            double w = gp.detJ0 * gp.weight;
+            double Px[3];
+            double Py[3];
+            double Pz[3];
+            for (int j = 0; j < 3; j++) {
+                Px[j] = w * (rx[j] * stress(0) + ry[j] * stress(2) + rz[j] * stress(4));
+                Py[j] = w * (ry[j] * stress(1) + rx[j] * stress(2) + rz[j] * stress(5));
+                Pz[j] = w * (rz[j] * stress(3) + rx[j] * stress(4) + ry[j] * stress(5));
             }
-            strainD.PasteClippedMatrix(tempB, 0, 0, 1, 33, 4, 0);
-            tempB31.MatrMultiply(Ny, m_element->m_d);
             for (int i = 0; i < 11; i++) {
                 for (int j = 0; j < 3; j++) {
-                    tempB(0, i * 3 + j) = tempB3(0, j) * Ny(0, i) + tempB31(0, j) * Nz(0, i);
+                    Fint(i * 3 + j) += Nx(0, i) * Px[j] + Ny(0, i) * Py[j] + Nz(0, i) * Pz[j];
                 }
             }
-            strainD.PasteClippedMatrix(tempB, 0, 0, 1, 33, 5, 0);
-
-            // Add damping strains
-            ChMatrixNM<double, 6, 1> DEPS;
-            DEPS.Reset();
-            for (int ii = 0; ii < 33; ii++) {
-                DEPS(0, 0) = DEPS(0, 0) + strainD(0, ii) * m_element->m_d_dt(ii, 0);
-                DEPS(1, 0) = DEPS(1, 0) + strainD(1, ii) * m_element->m_d_dt(ii, 0);
-                DEPS(2, 0) = DEPS(2, 0) + strainD(2, ii) * m_element->m_d_dt(ii, 0);
-                DEPS(3, 0) = DEPS(3, 0) + strainD(3, ii) * m_element->m_d_dt(ii, 0);
-                DEPS(4, 0) = DEPS(4, 0) + strainD(4, ii) * m_element->m_d_dt(ii, 0);
-                DEPS(5, 0) = DEPS(5, 0) + strainD(5, ii) * m_element->m_d_dt(ii, 0);
-            }
-
-            // Add structural damping
-            strain += DEPS * m_element->m_Alpha;
-
-            // Internal force calculation
-            ChMatrixNM<double, 33, 6> tempC;
-            tempC.MatrTMultiply(strainD, E_eps);
-            result.MatrMultiply(tempC, strain);
-            result.MatrScale(detJ0 * m_element->m_GaussScaling);
         } break;
         case ChElementBrick_9::Hencky: {
+            // Current position vector gradient
+            ChMatrixNM<double, 1, 3> Nx_d;
+            ChMatrixNM<double, 1, 3> Ny_d;
+            ChMatrixNM<double, 1, 3> Nz_d;
+            Nx_d.MatrMultiply(Nx, m_element->m_d);
+            Ny_d.MatrMultiply(Ny, m_element->m_d);
+            Nz_d.MatrMultiply(Nz, m_element->m_d);
+
+            double detJ = Nx_d(0, 0) * Ny_d(0, 1) * Nz_d(0, 2) + Ny_d(0, 0) * Nz_d(0, 1) * Nx_d(0, 2) +
+                          Nz_d(0, 0) * Nx_d(0, 1) * Ny_d(0, 2) - Nx_d(0, 2) * Ny_d(0, 1) * Nz_d(0, 0) -
+                          Ny_d(0, 2) * Nz_d(0, 1) * Nx_d(0, 0) - Nz_d(0, 2) * Nx_d(0, 1) * Ny_d(0, 0);
+
+            // Do we need to account for deformed initial configuration in DefF?
+            ChMatrixNM<double, 3, 3> DefF;
+            DefF(0, 0) = Nx_d(0, 0);
+            DefF(1, 0) = Nx_d(0, 1);
+            DefF(2, 0) = Nx_d(0, 2);
+            DefF(0, 1) = Ny_d(0, 0);
+            DefF(1, 1) = Ny_d(0, 1);
+            DefF(2, 1) = Ny_d(0, 2);
+            DefF(0, 2) = Nz_d(0, 0);
+            DefF(1, 2) = Nz_d(0, 1);
+            DefF(2, 2) = Nz_d(0, 2);
+
             ChMatrixNM<double, 3, 3> Temp33;  ///< Temporary matrix
             ChMatrixNM<double, 3, 3> CCPinv;  ///< Inverse of F^{pT}*F^{p}, where F^{p} is the plastic deformation
             // gradient stemming from multiplicative decomposition
@@ -1269,8 +1206,11 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
             Stress(5, 0) = 0.5 * (StressK(2, 1) + StressK(1, 2)) + Stress_damp(5, 0);
 
             // Obtain generalized elato-(plastic) forces
-            result.MatrTMultiply(strainD, Stress);
-            result.MatrScale(detJ * m_element->m_GaussScaling);
+            double w = detJ * gp.weight;
+            for (int ii = 0; ii < 33; ii++) {
+                Fint(ii) += w * (strainD(0, ii) * Stress(0) + strainD(1, ii) * Stress(1) + strainD(2, ii) * Stress(2) +
+                                 strainD(3, ii) * Stress(3) + strainD(4, ii) * Stress(4) + strainD(5, ii) * Stress(5));
+            }
             m_element->m_InteCounter++;
         } break;
     }
@@ -1287,13 +1227,8 @@ void ChElementBrick_9::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
     m_InteCounter = 0;
     ChMatrixNM<double, 33, 1> result;
     MyForceBrick9 formula(this);
-    ChQuadrature::Integrate3D<ChMatrixNM<double, 33, 1>>(result,   // result of integration
-                                                         formula,  // integrand formula
-                                                         -1, 1,    // x limits
-                                                         -1, 1,    // y limits
-                                                         -1, 1,    // z limits
-                                                         2         // order of integration
-                                                         );
+    for (int ip = 0; ip < 8; ip++)
+        formula.Evaluate(result, m_GaussPoints[ip]);
     Fi -= result;
     if (m_gravity_on) {
         Fi += m_GravForce;
@@ -2687,11 +2622,11 @@ void ChElementBrick_9::ComputeNF(
 }
 
 void ChElementBrick_9::ComputeStrainD_Brick9(ChMatrixNM<double, 6, 33>& strainD,
-                                             ChMatrixNM<double, 1, 11> Nx,
-                                             ChMatrixNM<double, 1, 11> Ny,
-                                             ChMatrixNM<double, 1, 11> Nz,
-                                             ChMatrixNM<double, 3, 3> FI,
-                                             ChMatrixNM<double, 3, 3> J0I) {
+                                             const ChMatrixNM<double, 1, 11>& Nx,
+                                             const ChMatrixNM<double, 1, 11>& Ny,
+                                             const ChMatrixNM<double, 1, 11>& Nz,
+                                             const ChMatrixNM<double, 3, 3>& FI,
+                                             const ChMatrixNM<double, 3, 3>& J0I) {
     double Tempx = FI(0, 0) * J0I(0, 0) + FI(1, 0) * J0I(0, 1) + FI(2, 0) * J0I(0, 2);
     double Tempy = FI(0, 0) * J0I(1, 0) + FI(1, 0) * J0I(1, 1) + FI(2, 0) * J0I(1, 2);
     double Tempz = FI(0, 0) * J0I(2, 0) + FI(1, 0) * J0I(2, 1) + FI(2, 0) * J0I(2, 2);
@@ -2837,6 +2772,42 @@ double ChElementBrick_9::Calc_detJ0(double x, double y, double z) {
     return Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
 }
 
+void ChElementBrick_9::ComputeGaussPointData() {
+    // Same points as the 2nd order quadrature of ChQuadrature::Integrate3D() over [-1,1]^3.
+    ChQuadraturePoints3D<2> points;
+    for (int ip = 0; ip < ChQuadraturePoints3D<2>::num_points; ip++) {
+        GaussPointData& gp = m_GaussPoints[ip];
+        ChMatrixNM<double, 1, 3> Nx_d0;
+        ChMatrixNM<double, 1, 3> Ny_d0;
+        ChMatrixNM<double, 1, 3> Nz_d0;
+        gp.detJ0 = Calc_detJ0(points.x[ip], points.y[ip], points.z[ip], gp.Nx, gp.Ny, gp.Nz, Nx_d0, Ny_d0, Nz_d0);
+        gp.weight = points.w[ip] * m_GaussScaling;
+
+        // Inverse of rd0 (position vector gradient: initial configuration)
+        gp.j0(0, 0) = Ny_d0(0, 1) * Nz_d0(0, 2) - Nz_d0(0, 1) * Ny_d0(0, 2);
+        gp.j0(0, 1) = Ny_d0(0, 2) * Nz_d0(0, 0) - Ny_d0(0, 0) * Nz_d0(0, 2);
+        gp.j0(0, 2) = Ny_d0(0, 0) * Nz_d0(0, 1) - Nz_d0(0, 0) * Ny_d0(0, 1);
+        gp.j0(1, 0) = Nz_d0(0, 1) * Nx_d0(0, 2) - Nx_d0(0, 1) * Nz_d0(0, 2);
+        gp.j0(1, 1) = Nz_d0(0, 2) * Nx_d0(0, 0) - Nx_d0(0, 2) * Nz_d0(0, 0);
+        gp.j0(1, 2) = Nz_d0(0, 0) * Nx_d0(0, 1) - Nz_d0(0, 1) * Nx_d0(0, 0);
+        gp.j0(2, 0) = Nx_d0(0, 1) * Ny_d0(0, 2) - Ny_d0(0, 1) * Nx_d0(0, 2);
+        gp.j0(2, 1) = Ny_d0(0, 0) * Nx_d0(0, 2) - Nx_d0(0, 0) * Ny_d0(0, 2);
+        gp.j0(2, 2) = Nx_d0(0, 0) * Ny_d0(0, 1) - Ny_d0(0, 0) * Nx_d0(0, 1);
+        gp.j0.MatrDivScale(gp.detJ0);
+
+        // Terms of the Green-Lagrange strains in the initial configuration
+        ChVector<> rx0(Nx_d0(0, 0), Nx_d0(0, 1), Nx_d0(0, 2));
+        ChVector<> ry0(Ny_d0(0, 0), Ny_d0(0, 1), Ny_d0(0, 2));
+        ChVector<> rz0(Nz_d0(0, 0), Nz_d0(0, 1), Nz_d0(0, 2));
+        gp.strain0[0] = 0.5 * Vdot(rx0, rx0);
+        gp.strain0[1] = 0.5 * Vdot(ry0, ry0);
+        gp.strain0[2] = Vdot(rx0, ry0);
+        gp.strain0[3] = 0.5 * Vdot(rz0, rz0);
+        gp.strain0[4] = Vdot(rx0, rz0);
+        gp.strain0[5] = Vdot(ry0, rz0);
+    }
+}
+
 void ChElementBrick_9::CalcCoordMatrix(ChMatrixNM<double, 11, 3>& d) {
     for (int i = 0; i < 8; i++) {
         const ChVector<>& pos = m_nodes[i]->GetPos();
@@ -265,6 +265,19 @@ class ChApiFea ChElementBrick_9 : public ChElementGeneric, public ChLoadableUVW
     ChVectorDynamic<double> m_DPVector2;  /// ytab of hardening parameter look-up table
     int m_DPVector_size;                  /// row number n of hardening parameter look-up table
 
+    /// Data of the reference configuration at a quadrature point of the internal forces.
+    struct GaussPointData {
+        ChMatrixNM<double, 1, 11> Nx;  ///< derivatives of the shape functions w.r.t. x
+        ChMatrixNM<double, 1, 11> Ny;  ///< derivatives of the shape functions w.r.t. y
+        ChMatrixNM<double, 1, 11> Nz;  ///< derivatives of the shape functions w.r.t. z
+        ChMatrixNM<double, 3, 3> j0;   ///< inverse of the initial position vector gradient
+        double strain0[6];             ///< reference terms of the Green-Lagrange strains
+        double detJ0;                  ///< determinant of the initial position vector gradient
+        double weight;                 ///< quadrature weight, including the scaling of the integration interval
+    };
+
+    GaussPointData m_GaussPoints[8];  ///< reference data at the 2x2x2 quadrature points of the internal forces
+
     // -----------------------------------
     // Interface to base classes
     // -----------------------------------
@@ -279,6 +292,8 @@ class ChApiFea ChElementBrick_9 : public ChElementGeneric, public ChLoadableUVW
     virtual void SetupInitial(ChSystem* system) override;
     /// Set M as the global mass matrix.
     virtual void ComputeMmatrixGlobal(ChMatrix<>& M) override;
+    /// The mass matrix is constant, computed in SetupInitial().
+    virtual bool HasConstantMass() const override { return true; }
     /// Set H as the global stiffness matrix K, scaled  by Kfactor. Optionally, also
     /// superimposes global damping matrix R, scaled by Rfactor, and global mass matrix M multiplied by Mfactor.
     virtual void ComputeKRMmatricesGlobal(ChMatrix<>& H,
@@ -321,6 +336,9 @@ class ChApiFea ChElementBrick_9 : public ChElementGeneric, public ChLoadableUVW
                       ChMatrixNM<double, 1, 3>& Ny_d0,
                       ChMatrixNM<double, 1, 3>& Nz_d0);
 
+    /// Compute the data of the reference configuration at the quadrature points of the internal forces.
+    void ComputeGaussPointData();
+
     // Calculate the current 11x3 matrix of nodal coordinates.
     void CalcCoordMatrix(ChMatrixNM<double, 11, 3>& d);
 
@@ -328,11 +346,11 @@ class ChApiFea ChElementBrick_9 : public ChElementGeneric, public ChLoadableUVW
     void CalcCoordDerivMatrix(ChMatrixNM<double, 33, 1>& dt);
 
     void ComputeStrainD_Brick9(ChMatrixNM<double, 6, 33>& strainD,
-                               ChMatrixNM<double, 1, 11> Nx,
-                               ChMatrixNM<double, 1, 11> Ny,
-                               ChMatrixNM<double, 1, 11> Nz,
-                               ChMatrixNM<double, 3, 3> FI,
-                               ChMatrixNM<double, 3, 3> J0I);
+                               const ChMatrixNM<double, 1, 11>& Nx,
+                               const ChMatrixNM<double, 1, 11>& Ny,
+                               const ChMatrixNM<double, 1, 11>& Nz,
+                               const ChMatrixNM<double, 3, 3>& FI,
+                               const ChMatrixNM<double, 3, 3>& J0I);
 
     void ComputeHardening_a(double& MeanEffP,
                             double& Hi,
@@ -562,6 +562,9 @@ class ChElementCableANCF : public ChElementBeam, public ChLoadableU, public ChLo
     /// Sets M as the global mass matrix.
     virtual void ComputeMmatrixGlobal(ChMatrix<>& M) override { M = m_MassMatrix; }
 
+    /// The mass matrix is constant, computed in SetupInitial().
+    virtual bool HasConstantMass() const override { return true; }
+
     /// Sets H as the global stiffness matrix K, scaled  by Kfactor. Optionally, also
     /// superimposes global damping matrix R, scaled by Rfactor, and global mass matrix M multiplied by Mfactor.
     virtual void ComputeKRMmatricesGlobal(ChMatrix<>& H, double Kfactor, double Rfactor = 0, double Mfactor = 0) override {
@@ -12,7 +12,11 @@
 // Authors: Alessandro Tasora
 // =============================================================================
 
+#include <vector>
+
 #include "chrono_fea/ChElementGeneric.h"
+#include "chrono_fea/ChNodeFEAxyz.h"
+#include "chrono_fea/ChNodeFEAxyzrot.h"
 
 namespace chrono {
 namespace fea {
@@ -35,32 +39,152 @@ void ChElementGeneric::EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c
 }
 
 void ChElementGeneric::EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVectorDynamic<>& w, const double c) {
-    // This is a default (VERY UNOPTIMAL) book keeping so that in children classes you can avoid
+    // This is a default book keeping so that in children classes you can avoid
     // implementing this EleIntLoadResidual_Mv function, unless you need faster code)
 
-    ChMatrixDynamic<> mMi(this->GetNdofs(), this->GetNdofs());
-    this->ComputeMmatrixGlobal(mMi);
+    if (!Mcache_valid)
+        ComputeMassCache();
 
-    ChMatrixDynamic<> mqi(this->GetNdofs(), 1);
+    int ndofs = this->GetNdofs();
     int stride = 0;
+
+    if (Mcache_diagonal) {
+        for (int in = 0; in < this->GetNnodes(); in++) {
+            int nodedofs = GetNodeNdofs(in);
+            if (!GetNodeN(in)->GetFixed()) {
+                int offset = GetNodeN(in)->NodeGetOffset_w();
+                for (int i = 0; i < nodedofs; i++)
+                    R(offset + i) += c * Mdiag(stride + i) * w(offset + i);
+            }
+            stride += nodedofs;
+        }
+        return;
+    }
+
+    // Gather the element part of w (null for fixed nodes)
+    Mv_w.Resize(ndofs, 1);
+    double* wi = Mv_w.GetAddress();
     for (int in = 0; in < this->GetNnodes(); in++) {
         int nodedofs = GetNodeNdofs(in);
-        if (!GetNodeN(in)->GetFixed())
-            mqi.PasteClippedMatrix(w, GetNodeN(in)->NodeGetOffset_w(), 0, nodedofs, 1, stride, 0);
+        if (GetNodeN(in)->GetFixed()) {
+            for (int i = 0; i < nodedofs; i++)
+                wi[stride + i] = 0;
+        } else {
+            int offset = GetNodeN(in)->NodeGetOffset_w();
+            for (int i = 0; i < nodedofs; i++)
+                wi[stride + i] = w(offset + i);
+        }
         stride += nodedofs;
     }
 
-    ChMatrixDynamic<> mFi(this->GetNdofs(), 1);
-    mFi.MatrMultiply(mMi, mqi);
-    mFi.MatrScale(c);
-
+    // R += c * M * w, row by row
     stride = 0;
     for (int in = 0; in < this->GetNnodes(); in++) {
         int nodedofs = GetNodeNdofs(in);
-        if (!GetNodeN(in)->GetFixed())
-            R.PasteSumClippedMatrix(mFi, stride, 0, nodedofs, 1, GetNodeN(in)->NodeGetOffset_w(), 0);
+        if (!GetNodeN(in)->GetFixed()) {
+            int offset = GetNodeN(in)->NodeGetOffset_w();
+            for (int i = 0; i < nodedofs; i++) {
+                const double* Mrow = Mcache.GetAddress() + (stride + i) * ndofs;
+                double sum = 0;
+                for (int j = 0; j < ndofs; j++)
+                    sum += Mrow[j] * wi[j];
+                R(offset + i) += c * sum;
+            }
+        }
+        stride += nodedofs;
+    }
+}
+
+void ChElementGeneric::UpdateMassCache() {
+    Mcache_valid = false;
+    if (this->HasConstantMass())
+        ComputeMassCache();
+}
+
+void ChElementGeneric::ComputeMassCache() {
+    int ndofs = this->GetNdofs();
+    Mcache.Reset(ndofs, ndofs);
+    this->ComputeMmatrixGlobal(Mcache);
+
+    Mdiag.Resize(ndofs, 1);
+    if (lumped_mass) {
+        this->ComputeLumpedMmatrixGlobal(Mdiag);
+        Mcache_diagonal = true;
+    } else {
+        Mcache_diagonal = true;
+        for (int i = 0; i < ndofs; i++) {
+            for (int j = 0; j < ndofs; j++)
+                if (i != j && Mcache(i, j) != 0)
+                    Mcache_diagonal = false;
+            Mdiag(i) = Mcache(i, i);
+        }
+    }
+
+    Mcache_valid = this->HasConstantMass();
+
+    // A constant diagonal mass matrix is fully described by Mdiag
+    if (Mcache_valid && Mcache_diagonal && !lumped_mass)
+        Mcache.Resize(0, 0);
+}
+
+void ChElementGeneric::ComputeLumpedMmatrixGlobal(ChMatrix<>& Md) {
+    int ndofs = this->GetNdofs();
+    ChMatrixDynamic<> M(ndofs, ndofs);
+    this->ComputeMmatrixGlobal(M);
+    Md.Reset(ndofs, 1);
+
+    // Direction (0, 1, 2) of the translational dofs, -1 for the other dofs
+    std::vector<int> direction(ndofs, -1);
+    int stride = 0;
+    for (int in = 0; in < this->GetNnodes(); in++) {
+        int nodedofs = GetNodeNdofs(in);
+        auto node = GetNodeN(in);
+        if (nodedofs >= 3 && (std::dynamic_pointer_cast<ChNodeFEAxyz>(node) ||
+                              std::dynamic_pointer_cast<ChNodeFEAxyzrot>(node))) {
+            for (int i = 0; i < 3; i++)
+                direction[stride + i] = i;
+        }
         stride += nodedofs;
     }
+
+    // Total mass, and sum of the diagonal terms of the translational dofs (over the 3 directions)
+    double mass = 0;
+    double diag = 0;
+    for (int i = 0; i < ndofs; i++) {
+        if (direction[i] < 0)
+            continue;
+        diag += M(i, i);
+        for (int j = 0; j < ndofs; j++)
+            if (direction[j] == direction[i])
+                mass += M(i, j);
+    }
+
+    if (mass > 0 && diag > 0) {
+        double scale = mass / diag;
+        for (int i = 0; i < ndofs; i++)
+            Md(i) = scale * M(i, i);
+    } else {
+        for (int i = 0; i < ndofs; i++)
+            for (int j = 0; j < ndofs; j++)
+                Md(i) += M(i, j);
+    }
+}
+
+void ChElementGeneric::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
+    ChMatrix<>& H = *this->Kmatr.Get_K();
+    this->ComputeKRMmatricesGlobal(H, Kfactor, Rfactor, Mfactor);
+
+    if (lumped_mass && Mfactor) {
+        // Replace Mfactor*[M] with Mfactor*[Md]
+        if (!Mcache_valid)
+            ComputeMassCache();
+        int ndofs = this->GetNdofs();
+        for (int i = 0; i < ndofs; i++) {
+            for (int j = 0; j < ndofs; j++)
+                H(i, j) -= Mfactor * Mcache(i, j);
+            H(i, i) += Mfactor * Mdiag(i);
+        }
+    }
 }
 
 void ChElementGeneric::VariablesFbLoadInternalForces(double factor) {
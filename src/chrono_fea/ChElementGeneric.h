@@ -36,13 +36,43 @@ class ChApiFea ChElementGeneric : public ChElementBase {
   protected:
     ChKblockGeneric Kmatr;
 
+    ChMatrixDynamic<> Mcache;  ///< mass matrix (consistent), as used by EleIntLoadResidual_Mv
+    ChMatrixDynamic<> Mdiag;   ///< diagonal of the mass matrix, if diagonal or lumped
+    ChMatrixDynamic<> Mv_w;    ///< buffer for the element part of the w vector in EleIntLoadResidual_Mv
+    bool Mcache_valid;         ///< true if Mcache, Mdiag hold the constant mass matrix
+    bool Mcache_diagonal;      ///< true if the product uses Mdiag only
+    bool lumped_mass;          ///< use the lumped mass matrix (see SetLumpedMass())
+
   public:
-    ChElementGeneric(){};
+    ChElementGeneric() : Mcache_valid(false), Mcache_diagonal(false), lumped_mass(false){};
     virtual ~ChElementGeneric(){};
 
     /// Access the proxy to stiffness, for sparse solver
     ChKblockGeneric& Kstiffness() { return Kmatr; }
 
+    /// Tell if the mass matrix, in global reference, does not depend on the state of the element.
+    /// If so, the mass matrix is computed once, after SetupInitial(), and reused by EleIntLoadResidual_Mv;
+    /// otherwise it is recomputed at each call (in preallocated buffers).
+    /// Children classes whose mass matrix is constant should override this and return true.
+    virtual bool HasConstantMass() const { return false; }
+
+    /// Use a lumped (diagonal) mass matrix in place of the mass matrix of the element, in
+    /// EleIntLoadResidual_Mv and in the M part of KRMmatricesLoad (default: false).
+    /// The lumped matrix is computed by ComputeLumpedMmatrixGlobal(). Note that the mass proportional
+    /// Rayleigh damping, if any, still uses the mass matrix of the element.
+    void SetLumpedMass(bool val) {
+        lumped_mass = val;
+        Mcache_valid = false;
+    }
+
+    /// Tell if the lumped mass matrix is used.
+    bool GetLumpedMass() const { return lumped_mass; }
+
+    /// If HasConstantMass(), computes the mass matrix and its diagonal (if diagonal or lumped) once, for
+    /// EleIntLoadResidual_Mv. Called by the mesh after SetupInitial(); it must be called again if the
+    /// mass properties of the element change afterwards.
+    virtual void UpdateMassCache() override;
+
     //
     // Functions for interfacing to the state bookkeeping
     //
@@ -51,8 +81,9 @@ class ChApiFea ChElementGeneric : public ChElementBase {
     /// implementing this EleIntLoadResidual_F function, unless you need faster code)
     virtual void EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c) override;
 
-    /// (This is a default (VERY UNOPTIMAL) book keeping so that in children classes you can avoid
-    /// implementing this EleIntLoadResidual_Mv function, unless you need faster code.)
+    /// (This is a default book keeping so that in children classes you can avoid implementing this
+    /// EleIntLoadResidual_Mv function. It does not allocate memory, and it does not recompute the mass
+    /// matrix if HasConstantMass(); the product is diagonal if the mass matrix is diagonal or lumped.)
     virtual void EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVectorDynamic<>& w, const double c) override;
 
     //
@@ -64,6 +95,15 @@ class ChApiFea ChElementGeneric : public ChElementBase {
     /// Children classes may need to override this with a more efficient version.
     virtual void ComputeMmatrixGlobal(ChMatrix<>& M) override { ComputeKRMmatricesGlobal(M, 0, 0, 1.0); }
 
+    /// Sets Md as the diagonal (n.rows = n.of dof of element) of the lumped mass matrix, as used
+    /// when SetLumpedMass() is enabled.
+    /// This default implementation uses the HRZ method: the diagonal of the mass matrix is scaled such that
+    /// the total mass (the mass moved by a rigid translation of the element) is preserved. The first 3 dofs
+    /// of nodes of type ChNodeFEAxyz (and derived) or ChNodeFEAxyzrot are taken as translational dofs.
+    /// If the element has no translational dofs, the rows of the mass matrix are summed instead.
+    /// Children classes may override this with a lumping more suited to their shape functions.
+    virtual void ComputeLumpedMmatrixGlobal(ChMatrix<>& Md);
+
     //
     // Functions for interfacing to the solver
     //
@@ -75,9 +115,8 @@ class ChApiFea ChElementGeneric : public ChElementBase {
     /// Adds the current stiffness K and damping R and mass M matrices in encapsulated
     /// ChKblock item(s), if any. The K, R, M matrices are load with scaling
     /// values Kfactor, Rfactor, Mfactor.
-    virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override {
-        this->ComputeKRMmatricesGlobal(*this->Kmatr.Get_K(), Kfactor, Rfactor, Mfactor);
-    }
+    /// If SetLumpedMass() is enabled, the M part uses the lumped mass matrix.
+    virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override;
 
     /// Adds the internal forces, expressed as nodal forces, into the
     /// encapsulated ChVariables, in the 'fb' part: qf+=forces*factor
@@ -91,6 +130,10 @@ class ChApiFea ChElementGeneric : public ChElementBase {
     /// (This is a default (VERY UNOPTIMAL) book keeping so that in children classes you can avoid
     /// implementing this VariablesFbIncrementMq function, unless you need faster code.)
     virtual void VariablesFbIncrementMq() override;
+
+  protected:
+    /// Fill Mcache and Mdiag with the current mass matrix (or the lumped one).
+    void ComputeMassCache();
 };
 
 /// @} fea_elements
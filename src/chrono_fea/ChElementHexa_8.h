@@ -363,6 +363,9 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
         return mstress;
     }
 
+    /// The mass matrix (lumped nodal masses) does not depend on the state.
+    virtual bool HasConstantMass() const override { return true; }
+
     /// Sets H as the global stiffness matrix K, scaled  by Kfactor. Optionally, also
     /// superimposes global damping matrix R, scaled by Rfactor, and global mass matrix M multiplied by Mfactor.
     virtual void ComputeKRMmatricesGlobal(ChMatrix<>& H, double Kfactor, double Rfactor = 0, double Mfactor = 0) override {
@@ -35,7 +35,7 @@ const int ChElementShellANCF::m_maxIterationsEAS = 100;
 // ------------------------------------------------------------------------------
 
 ChElementShellANCF::ChElementShellANCF()
-    : m_gravity_on(false), m_numLayers(0), m_thickness(0), m_lenX(0), m_lenY(0), m_Alpha(0) {
+    : m_gravity_on(false), m_numLayers(0), m_thickness(0), m_lenX(0), m_lenY(0), m_Alpha(0), m_precompute(true) {
     m_nodes.resize(4);
 }
 
@@ -110,6 +110,14 @@ void ChElementShellANCF::SetupInitial(ChSystem* system) {
     // Cache the scaling factor (due to change of integration intervals)
     m_GaussScaling = (m_lenX * m_lenY * m_thickness) / 8;
 
+    // Precompute the reference configuration terms used in the evaluation of the internal forces
+    m_layerData.clear();
+    if (m_precompute) {
+        m_layerData.resize(m_numLayers);
+        for (size_t kl = 0; kl < m_numLayers; kl++)
+            ComputeLayerData(kl, m_layerData[kl]);
+    }
+
     // Compute mass matrix and gravitational forces (constant)
     ComputeMassMatrix();
     ComputeGravityForce(system->Get_G_acc());
@@ -283,307 +291,309 @@ void ChElementShellANCF::ComputeGravityForce(const ChVector<>& g_acc) {
 // Elastic force calculation
 // -----------------------------------------------------------------------------
 
-// The class MyForce provides the integrand for the calculation of the internal forces
-// for one layer of an ANCF shell element.
-// The first 24 entries in the integrand represent the internal force.
-// The next 5 entries represent the residual of the EAS nonlinear system.
-// The last 25 entries represent the 5x5 Jacobian of the EAS nonlinear system.
+// Compute the matrix T of the transformation of the strains to the local frame of the orthotropic material,
+// strain = T * strain_til, from the coefficients beta of the contravariant transformation.
+static void CalcStrainTransformation(ChMatrixNM<double, 6, 6>& T, const double* beta) {
+    T(0, 0) = beta[0] * beta[0];
+    T(0, 1) = beta[3] * beta[3];
+    T(0, 2) = beta[0] * beta[3];
+    T(0, 3) = beta[6] * beta[6];
+    T(0, 4) = beta[0] * beta[6];
+    T(0, 5) = beta[3] * beta[6];
+    T(1, 0) = beta[1] * beta[1];
+    T(1, 1) = beta[4] * beta[4];
+    T(1, 2) = beta[1] * beta[4];
+    T(1, 3) = beta[7] * beta[7];
+    T(1, 4) = beta[1] * beta[7];
+    T(1, 5) = beta[4] * beta[7];
+    T(2, 0) = 2.0 * beta[0] * beta[1];
+    T(2, 1) = 2.0 * beta[3] * beta[4];
+    T(2, 2) = beta[1] * beta[3] + beta[0] * beta[4];
+    T(2, 3) = 2.0 * beta[6] * beta[7];
+    T(2, 4) = beta[1] * beta[6] + beta[0] * beta[7];
+    T(2, 5) = beta[4] * beta[6] + beta[3] * beta[7];
+    T(3, 0) = beta[2] * beta[2];
+    T(3, 1) = beta[5] * beta[5];
+    T(3, 2) = beta[2] * beta[5];
+    T(3, 3) = beta[8] * beta[8];
+    T(3, 4) = beta[2] * beta[8];
+    T(3, 5) = beta[5] * beta[8];
+    T(4, 0) = 2.0 * beta[0] * beta[2];
+    T(4, 1) = 2.0 * beta[3] * beta[5];
+    T(4, 2) = beta[2] * beta[3] + beta[0] * beta[5];
+    T(4, 3) = 2.0 * beta[6] * beta[8];
+    T(4, 4) = beta[2] * beta[6] + beta[0] * beta[8];
+    T(4, 5) = beta[5] * beta[6] + beta[3] * beta[8];
+    T(5, 0) = 2.0 * beta[1] * beta[2];
+    T(5, 1) = 2.0 * beta[4] * beta[5];
+    T(5, 2) = beta[2] * beta[4] + beta[1] * beta[5];
+    T(5, 3) = 2.0 * beta[7] * beta[8];
+    T(5, 4) = beta[2] * beta[7] + beta[1] * beta[8];
+    T(5, 5) = beta[5] * beta[7] + beta[4] * beta[8];
+}
+
+// Calculate the reference configuration terms at the quadrature points of the specified layer.
+void ChElementShellANCF::ComputeLayerData(size_t kl, LayerData& data) {
+    // Transformation matrix, function of fiber angle
+    const ChMatrixNM<double, 6, 6>& T0 = m_layers[kl].Get_T0();
+    // Determinant of the initial position vector gradient at the element center
+    double detJ0C = m_layers[kl].Get_detJ0C();
+    // Direction for orthotropic material
+    double theta = m_layers[kl].Get_theta();  // Fiber angle
+    // Matrix of elastic coefficients
+    const ChMatrixNM<double, 6, 6>& E_eps = m_layers[kl].GetMaterial()->Get_E_eps();
+
+    data.Kalpha.Reset();
+
+    // Same points as the 2nd order quadrature of ChQuadrature::Integrate3D() over the layer
+    ChQuadraturePoints3D<2> points(-1, 1, -1, 1, m_GaussZ[kl], m_GaussZ[kl + 1]);
+
+    for (int ip = 0; ip < ChQuadraturePoints3D<2>::num_points; ip++) {
+        GaussPointData& p = data.points[ip];
+        double x = points.x[ip];
+        double y = points.y[ip];
+        double z = points.z[ip];
+
+        // Element shape function
+        ChMatrixNM<double, 1, 8> N;
+        ShapeFunctions(N, x, y, z);
+
+        // Determinant of position vector gradient matrix: Initial configuration
+        ChMatrixNM<double, 1, 8> Nx;
+        ChMatrixNM<double, 1, 8> Ny;
+        ChMatrixNM<double, 1, 8> Nz;
+        ChMatrixNM<double, 1, 3> Nx_d0;
+        ChMatrixNM<double, 1, 3> Ny_d0;
+        ChMatrixNM<double, 1, 3> Nz_d0;
+        double detJ0 = Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
+        p.weight = points.w[ip] * detJ0 * m_GaussScaling;
+
+        // ANS shape function
+        ChMatrixNM<double, 1, 4> S_ANS;  // Shape function vector for Assumed Natural Strain
+        ChMatrixNM<double, 6, 5> M;      // Shape function vector for Enhanced Assumed Strain
+        ShapeFunctionANSbilinearShell(S_ANS, x, y);
+        Basis_M(M, x, y, z);
+
+        // Tangent frame, rotated by the fiber angle
+        ChVector<> rx0(Nx_d0(0, 0), Nx_d0(0, 1), Nx_d0(0, 2));
+        ChVector<> ry0(Ny_d0(0, 0), Ny_d0(0, 1), Ny_d0(0, 2));
+        ChVector<> rz0(Nz_d0(0, 0), Nz_d0(0, 1), Nz_d0(0, 2));
+        ChVector<> A1 = rx0 / rx0.Length();
+        ChVector<> A3 = Vcross(rx0, ry0).GetNormalized();
+        ChVector<> A2 = Vcross(A3, A1);
+        ChVector<> AA1 = A1 * cos(theta) + A2 * sin(theta);
+        ChVector<> AA2 = -A1 * sin(theta) + A2 * cos(theta);
+        ChVector<> AA3 = A3;
+
+        // Inverse of rd0 (position vector gradient: initial configuration), by rows j01, j02, j03
+        ChVector<> j01 = Vcross(ry0, rz0) / detJ0;
+        ChVector<> j02 = Vcross(rz0, rx0) / detJ0;
+        ChVector<> j03 = Vcross(rx0, ry0) / detJ0;
+
+        // Coefficients of contravariant transformation
+        double beta[9] = {Vdot(AA1, j01), Vdot(AA2, j01), Vdot(AA3, j01),  //
+                          Vdot(AA1, j02), Vdot(AA2, j02), Vdot(AA3, j02),  //
+                          Vdot(AA1, j03), Vdot(AA2, j03), Vdot(AA3, j03)};
+        CalcStrainTransformation(p.T, beta);
+
+        // Enhanced Assumed Strain
+        p.G.MatrMultiply(T0, M);
+        p.G.MatrScale(detJ0C / detJ0);
+
+        for (int i = 0; i < 8; i++) {
+            p.Nx[i] = Nx(0, i);
+            p.Ny[i] = Ny(0, i);
+        }
+
+        // In-plane strain terms of the initial configuration
+        p.strain0[0] = 0.5 * Vdot(rx0, rx0);
+        p.strain0[1] = 0.5 * Vdot(ry0, ry0);
+        p.strain0[2] = Vdot(rx0, ry0);
+
+        // Coefficients of the ANS strains: the transverse normal strain is interpolated with the bilinear shape
+        // functions, the transverse shear strains with the ANS shape functions.
+        p.N_ANS[0] = N(0, 0);
+        p.N_ANS[1] = N(0, 2);
+        p.N_ANS[2] = N(0, 4);
+        p.N_ANS[3] = N(0, 6);
+        p.N_ANS[4] = S_ANS(0, 0);
+        p.N_ANS[5] = S_ANS(0, 1);
+        p.N_ANS[6] = S_ANS(0, 2);
+        p.N_ANS[7] = S_ANS(0, 3);
+
+        // EAS Jacobian
+        ChMatrixNM<double, 6, 5> EG;
+        EG.MatrMultiply(E_eps, p.G);
+        for (int i = 0; i < 5; i++)
+            for (int j = 0; j < 5; j++)
+                for (int k = 0; k < 6; k++)
+                    data.Kalpha(i, j) += p.G(k, i) * EG(k, j) * p.weight;
+    }
+}
+
+// The class MyForce evaluates the internal forces for one layer of an ANCF shell element, at the 2x2x2
+// quadrature points of the layer.
 // Capabilities of this class include: application of enhanced assumed strain (EAS) and
 // assumed natural strain (ANS) formulations to avoid thickness and (transverse and in-plane)
 // shear locking. This implementation also features a composite material implementation
 // that allows for selecting a number of layers over the element thickness; each of which
 // has an independent, user-selected fiber angle (direction for orthotropic constitutive behavior)
-class MyForce : public ChIntegrable3D<ChMatrixNM<double, 54, 1> > {
+// The terms that depend only on the reference configuration are taken from the element, if precomputed, or
+// calculated in the constructor. The strains at the quadrature points, except for the EAS terms, are computed
+// once in the constructor. The residual of the EAS nonlinear system is then evaluated at each EAS iteration
+// with a few products of small matrices, and the internal forces are assembled for the final EAS parameters,
+// as strainD'*stress, without forming the 6x24 matrices of the strain derivatives.
+class MyForce {
   public:
-    MyForce(ChElementShellANCF* element,         // Containing element
-            size_t kl,                           // Current layer index
-            ChMatrixNM<double, 5, 1>* alpha_eas  // Vector of internal parameters for EAS formulation
-            )
-        : m_element(element), m_kl(kl), m_alpha_eas(alpha_eas) {}
-    ~MyForce() {}
-
-  private:
-    ChElementShellANCF* m_element;
-    size_t m_kl;
-    ChMatrixNM<double, 5, 1>* m_alpha_eas;
-
-    /// Evaluate (strainD'*strain)  at point x, include ANS and EAS.
-    virtual void Evaluate(ChMatrixNM<double, 54, 1>& result, const double x, const double y, const double z) override;
-};
+    MyForce(ChElementShellANCF* element,  // Containing element
+            size_t kl                     // Current layer index
+            );
 
-void MyForce::Evaluate(ChMatrixNM<double, 54, 1>& result, const double x, const double y, const double z) {
-    // Element shape function
-    ChMatrixNM<double, 1, 8> N;
-    m_element->ShapeFunctions(N, x, y, z);
+    /// Compute the residual of the EAS nonlinear system, for the given EAS parameters.
+    void EvaluateEAS(const ChMatrixNM<double, 5, 1>& alpha_eas, ChMatrixNM<double, 5, 1>& HE);
 
-    // Determinant of position vector gradient matrix: Initial configuration
-    ChMatrixNM<double, 1, 8> Nx;
-    ChMatrixNM<double, 1, 8> Ny;
-    ChMatrixNM<double, 1, 8> Nz;
-    ChMatrixNM<double, 1, 3> Nx_d0;
-    ChMatrixNM<double, 1, 3> Ny_d0;
-    ChMatrixNM<double, 1, 3> Nz_d0;
-    double detJ0 = m_element->Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
-
-    // ANS shape function
-    ChMatrixNM<double, 1, 4> S_ANS;  // Shape function vector for Assumed Natural Strain
-    ChMatrixNM<double, 6, 5> M;      // Shape function vector for Enhanced Assumed Strain
-    m_element->ShapeFunctionANSbilinearShell(S_ANS, x, y);
-    m_element->Basis_M(M, x, y, z);
+    /// Compute the internal forces, for the given EAS parameters.
+    void EvaluateForce(const ChMatrixNM<double, 5, 1>& alpha_eas, ChMatrixNM<double, 24, 1>& Fint);
 
-    // Transformation : Orthogonal transformation (A and J)
-    ChVector<double> G1xG2;  // Cross product of first and second column of
-    double G1dotG1;          // Dot product of first column of position vector gradient
+    /// Return the Jacobian of the EAS nonlinear system (it does not depend on the EAS parameters).
+    const ChMatrixNM<double, 5, 5>& GetKalpha() const { return m_ref->Kalpha; }
 
-    G1xG2.x() = Nx_d0[0][1] * Ny_d0[0][2] - Nx_d0[0][2] * Ny_d0[0][1];
-    G1xG2.y() = Nx_d0[0][2] * Ny_d0[0][0] - Nx_d0[0][0] * Ny_d0[0][2];
-    G1xG2.z() = Nx_d0[0][0] * Ny_d0[0][1] - Nx_d0[0][1] * Ny_d0[0][0];
-    G1dotG1 = Nx_d0[0][0] * Nx_d0[0][0] + Nx_d0[0][1] * Nx_d0[0][1] + Nx_d0[0][2] * Nx_d0[0][2];
+  private:
+    typedef ChElementShellANCF::LayerData LayerData;
+    typedef ChElementShellANCF::GaussPointData GaussPointData;
 
-    // Tangent Frame
-    ChVector<double> A1;
-    ChVector<double> A2;
-    ChVector<double> A3;
-    A1.x() = Nx_d0[0][0];
-    A1.y() = Nx_d0[0][1];
-    A1.z() = Nx_d0[0][2];
-    A1 = A1 / sqrt(G1dotG1);
-    A3 = G1xG2.GetNormalized();
-    A2.Cross(A3, A1);
+    // Stress at the given point, for the given EAS parameters.
+    void CalcStress(int ip, const ChMatrixNM<double, 5, 1>& alpha_eas, ChMatrixNM<double, 6, 1>& stress);
 
-    // Direction for orthotropic material
-    double theta = m_element->GetLayer(m_kl).Get_theta();  // Fiber angle
-    ChVector<double> AA1;
-    ChVector<double> AA2;
-    ChVector<double> AA3;
-    AA1 = A1 * cos(theta) + A2 * sin(theta);
-    AA2 = -A1 * sin(theta) + A2 * cos(theta);
-    AA3 = A3;
+    ChElementShellANCF* m_element;
+    const ChMatrixNM<double, 6, 6>& m_E_eps;  // Matrix of elastic coefficients
+    const LayerData* m_ref;                   // Reference configuration terms
+    LayerData m_refLocal;                     // Reference configuration terms, if not precomputed
+    ChVector<> m_rx[8];                       // First column of the position vector gradient
+    ChVector<> m_ry[8];                       // Second column of the position vector gradient
+    ChMatrixNM<double, 6, 1> m_strain[8];     // Strains with structural damping, without the EAS terms
+};
 
-    /// Beta
-    ChMatrixNM<double, 3, 3> j0;
-    ChVector<double> j01;
-    ChVector<double> j02;
-    ChVector<double> j03;
-    ChMatrixNM<double, 9, 1> beta;
-    // Calculates inverse of rd0 (j0) (position vector gradient: Initial Configuration)
-    j0(0, 0) = Ny_d0[0][1] * Nz_d0[0][2] - Nz_d0[0][1] * Ny_d0[0][2];
-    j0(0, 1) = Ny_d0[0][2] * Nz_d0[0][0] - Ny_d0[0][0] * Nz_d0[0][2];
-    j0(0, 2) = Ny_d0[0][0] * Nz_d0[0][1] - Nz_d0[0][0] * Ny_d0[0][1];
-    j0(1, 0) = Nz_d0[0][1] * Nx_d0[0][2] - Nx_d0[0][1] * Nz_d0[0][2];
-    j0(1, 1) = Nz_d0[0][2] * Nx_d0[0][0] - Nx_d0[0][2] * Nz_d0[0][0];
-    j0(1, 2) = Nz_d0[0][0] * Nx_d0[0][1] - Nz_d0[0][1] * Nx_d0[0][0];
-    j0(2, 0) = Nx_d0[0][1] * Ny_d0[0][2] - Ny_d0[0][1] * Nx_d0[0][2];
-    j0(2, 1) = Ny_d0[0][0] * Nx_d0[0][2] - Nx_d0[0][0] * Ny_d0[0][2];
-    j0(2, 2) = Nx_d0[0][0] * Ny_d0[0][1] - Ny_d0[0][0] * Nx_d0[0][1];
-    j0.MatrDivScale(detJ0);
+MyForce::MyForce(ChElementShellANCF* element, size_t kl)
+    : m_element(element), m_E_eps(element->GetLayer(kl).GetMaterial()->Get_E_eps()) {
+    // The reference terms are not available if the precomputation was enabled after SetupInitial.
+    if (m_element->m_precompute && kl < m_element->m_layerData.size()) {
+        m_ref = &m_element->m_layerData[kl];
+    } else {
+        m_element->ComputeLayerData(kl, m_refLocal);
+        m_ref = &m_refLocal;
+    }
 
-    j01[0] = j0(0, 0);
-    j02[0] = j0(1, 0);
-    j03[0] = j0(2, 0);
-    j01[1] = j0(0, 1);
-    j02[1] = j0(1, 1);
-    j03[1] = j0(2, 1);
-    j01[2] = j0(0, 2);
-    j02[2] = j0(1, 2);
-    j03[2] = j0(2, 2);
+    // Time derivatives of the ANS strains
+    double ANS_dt[8];
+    for (int k = 0; k < 8; k++) {
+        ANS_dt[k] = 0;
+        for (int ii = 0; ii < 24; ii++)
+            ANS_dt[k] += m_element->m_strainANS_D(k, ii) * m_element->m_d_dt(ii, 0);
+    }
 
-    // Coefficients of contravariant transformation
-    beta(0, 0) = Vdot(AA1, j01);
-    beta(1, 0) = Vdot(AA2, j01);
-    beta(2, 0) = Vdot(AA3, j01);
-    beta(3, 0) = Vdot(AA1, j02);
-    beta(4, 0) = Vdot(AA2, j02);
-    beta(5, 0) = Vdot(AA3, j02);
-    beta(6, 0) = Vdot(AA1, j03);
-    beta(7, 0) = Vdot(AA2, j03);
-    beta(8, 0) = Vdot(AA3, j03);
+    double alpha = m_element->m_Alpha;
+    const ChMatrixNM<double, 8, 1>& ANS = m_element->m_strainANS;
+
+    for (int ip = 0; ip < 8; ip++) {
+        const GaussPointData& p = m_ref->points[ip];
+        ChVector<>& rx = m_rx[ip];
+        ChVector<>& ry = m_ry[ip];
+
+        // Current position vector gradient (first two columns) and its time derivative
+        ChVector<> vx(0, 0, 0);
+        ChVector<> vy(0, 0, 0);
+        rx = VNULL;
+        ry = VNULL;
+        for (int i = 0; i < 8; i++) {
+            for (int j = 0; j < 3; j++) {
+                double d = m_element->m_d(i, j);
+                double d_dt = m_element->m_d_dt(i * 3 + j, 0);
+                rx[j] += p.Nx[i] * d;
+                ry[j] += p.Ny[i] * d;
+                vx[j] += p.Nx[i] * d_dt;
+                vy[j] += p.Ny[i] * d_dt;
+            }
+        }
 
-    // Transformation matrix, function of fiber angle
-    const ChMatrixNM<double, 6, 6>& T0 = m_element->GetLayer(m_kl).Get_T0();
-    // Determinant of the initial position vector gradient at the element center
-    double detJ0C = m_element->GetLayer(m_kl).Get_detJ0C();
+        // Strain components, plus structural damping (strain rates are the products of the strain derivatives,
+        // strainD_til, and the nodal velocities)
+        ChMatrixNM<double, 6, 1> strain_til;
+        strain_til(0, 0) = 0.5 * Vdot(rx, rx) - p.strain0[0] + alpha * Vdot(rx, vx);
+        strain_til(1, 0) = 0.5 * Vdot(ry, ry) - p.strain0[1] + alpha * Vdot(ry, vy);
+        strain_til(2, 0) = Vdot(rx, ry) - p.strain0[2] + alpha * (Vdot(ry, vx) + Vdot(rx, vy));
+        strain_til(3, 0) = p.N_ANS[0] * (ANS(0, 0) + alpha * ANS_dt[0]) + p.N_ANS[1] * (ANS(1, 0) + alpha * ANS_dt[1]) +
+                           p.N_ANS[2] * (ANS(2, 0) + alpha * ANS_dt[2]) + p.N_ANS[3] * (ANS(3, 0) + alpha * ANS_dt[3]);
+        strain_til(4, 0) = p.N_ANS[6] * (ANS(6, 0) + alpha * ANS_dt[6]) + p.N_ANS[7] * (ANS(7, 0) + alpha * ANS_dt[7]);
+        strain_til(5, 0) = p.N_ANS[4] * (ANS(4, 0) + alpha * ANS_dt[4]) + p.N_ANS[5] * (ANS(5, 0) + alpha * ANS_dt[5]);
+
+        // For orthotropic material
+        m_strain[ip].MatrMultiply(p.T, strain_til);
+    }
+}
 
+void MyForce::CalcStress(int ip, const ChMatrixNM<double, 5, 1>& alpha_eas, ChMatrixNM<double, 6, 1>& stress) {
     // Enhanced Assumed Strain
-    ChMatrixNM<double, 6, 5> G = T0 * M * (detJ0C / detJ0);
-    ChMatrixNM<double, 6, 1> strain_EAS = G * (*m_alpha_eas);
-
-    ChMatrixNM<double, 8, 1> ddNx;
-    ChMatrixNM<double, 8, 1> ddNy;
-    ChMatrixNM<double, 8, 1> ddNz;
-    ddNx.MatrMultiplyT(m_element->m_ddT, Nx);
-    ddNy.MatrMultiplyT(m_element->m_ddT, Ny);
-    ddNz.MatrMultiplyT(m_element->m_ddT, Nz);
-
-    ChMatrixNM<double, 8, 1> d0d0Nx;
-    ChMatrixNM<double, 8, 1> d0d0Ny;
-    ChMatrixNM<double, 8, 1> d0d0Nz;
-    d0d0Nx.MatrMultiplyT(m_element->m_d0d0T, Nx);
-    d0d0Ny.MatrMultiplyT(m_element->m_d0d0T, Ny);
-    d0d0Nz.MatrMultiplyT(m_element->m_d0d0T, Nz);
-
-    // Strain component
-    ChMatrixNM<double, 6, 1> strain_til;
-    strain_til(0, 0) = 0.5 * ((Nx * ddNx)(0, 0) - (Nx * d0d0Nx)(0, 0));
-    strain_til(1, 0) = 0.5 * ((Ny * ddNy)(0, 0) - (Ny * d0d0Ny)(0, 0));
-    strain_til(2, 0) = (Nx * ddNy)(0, 0) - (Nx * d0d0Ny)(0, 0);
-    strain_til(3, 0) = N(0, 0) * m_element->m_strainANS(0, 0) + N(0, 2) * m_element->m_strainANS(1, 0) +
-                       N(0, 4) * m_element->m_strainANS(2, 0) + N(0, 6) * m_element->m_strainANS(3, 0);
-    strain_til(4, 0) = S_ANS(0, 2) * m_element->m_strainANS(6, 0) + S_ANS(0, 3) * m_element->m_strainANS(7, 0);
-    strain_til(5, 0) = S_ANS(0, 0) * m_element->m_strainANS(4, 0) + S_ANS(0, 1) * m_element->m_strainANS(5, 0);
-
-    // For orthotropic material
     ChMatrixNM<double, 6, 1> strain;
+    strain.MatrMultiply(m_ref->points[ip].G, alpha_eas);
+    strain += m_strain[ip];
 
-    strain(0, 0) = strain_til(0, 0) * beta(0) * beta(0) + strain_til(1, 0) * beta(3) * beta(3) +
-                   strain_til(2, 0) * beta(0) * beta(3) + strain_til(3, 0) * beta(6) * beta(6) +
-                   strain_til(4, 0) * beta(0) * beta(6) + strain_til(5, 0) * beta(3) * beta(6);
-    strain(1, 0) = strain_til(0, 0) * beta(1) * beta(1) + strain_til(1, 0) * beta(4) * beta(4) +
-                   strain_til(2, 0) * beta(1) * beta(4) + strain_til(3, 0) * beta(7) * beta(7) +
-                   strain_til(4, 0) * beta(1) * beta(7) + strain_til(5, 0) * beta(4) * beta(7);
-    strain(2, 0) = strain_til(0, 0) * 2.0 * beta(0) * beta(1) + strain_til(1, 0) * 2.0 * beta(3) * beta(4) +
-                   strain_til(2, 0) * (beta(1) * beta(3) + beta(0) * beta(4)) +
-                   strain_til(3, 0) * 2.0 * beta(6) * beta(7) +
-                   strain_til(4, 0) * (beta(1) * beta(6) + beta(0) * beta(7)) +
-                   strain_til(5, 0) * (beta(4) * beta(6) + beta(3) * beta(7));
-    strain(3, 0) = strain_til(0, 0) * beta(2) * beta(2) + strain_til(1, 0) * beta(5) * beta(5) +
-                   strain_til(2, 0) * beta(2) * beta(5) + strain_til(3, 0) * beta(8) * beta(8) +
-                   strain_til(4, 0) * beta(2) * beta(8) + strain_til(5, 0) * beta(5) * beta(8);
-    strain(4, 0) = strain_til(0, 0) * 2.0 * beta(0) * beta(2) + strain_til(1, 0) * 2.0 * beta(3) * beta(5) +
-                   strain_til(2, 0) * (beta(2) * beta(3) + beta(0) * beta(5)) +
-                   strain_til(3, 0) * 2.0 * beta(6) * beta(8) +
-                   strain_til(4, 0) * (beta(2) * beta(6) + beta(0) * beta(8)) +
-                   strain_til(5, 0) * (beta(5) * beta(6) + beta(3) * beta(8));
-    strain(5, 0) = strain_til(0, 0) * 2.0 * beta(1) * beta(2) + strain_til(1, 0) * 2.0 * beta(4) * beta(5) +
-                   strain_til(2, 0) * (beta(2) * beta(4) + beta(1) * beta(5)) +
-                   strain_til(3, 0) * 2.0 * beta(7) * beta(8) +
-                   strain_til(4, 0) * (beta(2) * beta(7) + beta(1) * beta(8)) +
-                   strain_til(5, 0) * (beta(5) * beta(7) + beta(4) * beta(8));
-
-    // Strain derivative component
+    stress.MatrMultiply(m_E_eps, strain);
+}
 
-    ChMatrixNM<double, 6, 24> strainD_til;
-    ChMatrixNM<double, 1, 24> tempB;
-    ChMatrixNM<double, 1, 24> tempBB;
-    ChMatrixNM<double, 1, 3> tempB3;
-    ChMatrixNM<double, 1, 3> tempB31;
-    strainD_til.Reset();
-    tempB3.MatrMultiply(Nx, m_element->m_d);
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB3(0, j) * Nx(0, i);
-        }
+void MyForce::EvaluateEAS(const ChMatrixNM<double, 5, 1>& alpha_eas, ChMatrixNM<double, 5, 1>& HE) {
+    HE.Reset();
+    for (int ip = 0; ip < 8; ip++) {
+        const GaussPointData& p = m_ref->points[ip];
+        ChMatrixNM<double, 6, 1> stress;
+        CalcStress(ip, alpha_eas, stress);
+        for (int i = 0; i < 5; i++)
+            for (int k = 0; k < 6; k++)
+                HE(i) += p.G(k, i) * stress(k) * p.weight;
     }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 24, 0, 0);
-    tempB3.MatrMultiply(Ny, m_element->m_d);
-    for (int i = 0; i < 8; i++) {
+}
+
+void MyForce::EvaluateForce(const ChMatrixNM<double, 5, 1>& alpha_eas, ChMatrixNM<double, 24, 1>& Fint) {
+    Fint.Reset();
+
+    // Accumulated coefficients of the rows of the ANS strain derivatives
+    double C_ANS[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+
+    for (int ip = 0; ip < 8; ip++) {
+        const GaussPointData& p = m_ref->points[ip];
+        const ChVector<>& rx = m_rx[ip];
+        const ChVector<>& ry = m_ry[ip];
+        ChMatrixNM<double, 6, 1> stress;
+        CalcStress(ip, alpha_eas, stress);
+        ChMatrixNM<double, 6, 1> stress_til;
+        stress_til.MatrTMultiply(p.T, stress);
+        stress_til.MatrScale(p.weight);
+
+        // In-plane terms
+        double Px[3];
+        double Py[3];
         for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB3(0, j) * Ny(0, i);
+            Px[j] = rx[j] * stress_til(0) + ry[j] * stress_til(2);
+            Py[j] = ry[j] * stress_til(1) + rx[j] * stress_til(2);
         }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 24, 1, 0);
-    tempB31.MatrMultiply(Nx, m_element->m_d);
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB3(0, j) * Nx(0, i) + tempB31(0, j) * Ny(0, i);
+        for (int i = 0; i < 8; i++) {
+            for (int j = 0; j < 3; j++) {
+                Fint(i * 3 + j) += p.Nx[i] * Px[j] + p.Ny[i] * Py[j];
+            }
         }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 24, 2, 0);
 
-    tempBB.Reset();
-    for (int i = 0; i < 4; i++) {
-        int ij = i * 2;
-        tempB.PasteClippedMatrix(m_element->m_strainANS_D, i, 0, 1, 24, 0, 0);
-        tempB *= N(0, ij);
-        tempBB += tempB;
+        // ANS terms (zz, yz, xz)
+        for (int k = 0; k < 4; k++)
+            C_ANS[k] += p.N_ANS[k] * stress_til(3);
+        C_ANS[4] += p.N_ANS[4] * stress_til(5);
+        C_ANS[5] += p.N_ANS[5] * stress_til(5);
+        C_ANS[6] += p.N_ANS[6] * stress_til(4);
+        C_ANS[7] += p.N_ANS[7] * stress_til(4);
     }
-    strainD_til.PasteClippedMatrix(tempBB, 0, 0, 1, 24, 3, 0);  // strainD for zz
-    //
-    tempBB.Reset();
-    for (int i = 0; i < 2; i++) {
-        int ij = i + 6;
-        int ij1 = i + 2;
-        tempB.PasteClippedMatrix(m_element->m_strainANS_D, ij, 0, 1, 24, 0, 0);
-        tempB *= S_ANS(0, ij1);
-        tempBB += tempB;
-    }
-    strainD_til.PasteClippedMatrix(tempBB, 0, 0, 1, 24, 4, 0);  // strainD for xz
-    //
-    tempBB.Reset();
-    for (int i = 0; i < 2; i++) {
-        int ij = i + 4;
-        int ij1 = i;
-        tempB.PasteClippedMatrix(m_element->m_strainANS_D, ij, 0, 1, 24, 0, 0);
-        tempB *= S_ANS(0, ij1);
-        tempBB += tempB;
-    }
-    strainD_til.PasteClippedMatrix(tempBB, 0, 0, 1, 24, 5, 0);  // strainD for yz
 
-    // For orthotropic material
-    ChMatrixNM<double, 6, 24> strainD;  // Derivative of the strains w.r.t. the coordinates. Includes orthotropy
-    for (int ii = 0; ii < 24; ii++) {
-        strainD(0, ii) = strainD_til(0, ii) * beta(0) * beta(0) + strainD_til(1, ii) * beta(3) * beta(3) +
-                         strainD_til(2, ii) * beta(0) * beta(3) + strainD_til(3, ii) * beta(6) * beta(6) +
-                         strainD_til(4, ii) * beta(0) * beta(6) + strainD_til(5, ii) * beta(3) * beta(6);
-        strainD(1, ii) = strainD_til(0, ii) * beta(1) * beta(1) + strainD_til(1, ii) * beta(4) * beta(4) +
-                         strainD_til(2, ii) * beta(1) * beta(4) + strainD_til(3, ii) * beta(7) * beta(7) +
-                         strainD_til(4, ii) * beta(1) * beta(7) + strainD_til(5, ii) * beta(4) * beta(7);
-        strainD(2, ii) = strainD_til(0, ii) * 2.0 * beta(0) * beta(1) + strainD_til(1, ii) * 2.0 * beta(3) * beta(4) +
-                         strainD_til(2, ii) * (beta(1) * beta(3) + beta(0) * beta(4)) +
-                         strainD_til(3, ii) * 2.0 * beta(6) * beta(7) +
-                         strainD_til(4, ii) * (beta(1) * beta(6) + beta(0) * beta(7)) +
-                         strainD_til(5, ii) * (beta(4) * beta(6) + beta(3) * beta(7));
-        strainD(3, ii) = strainD_til(0, ii) * beta(2) * beta(2) + strainD_til(1, ii) * beta(5) * beta(5) +
-                         strainD_til(2, ii) * beta(2) * beta(5) + strainD_til(3, ii) * beta(8) * beta(8) +
-                         strainD_til(4, ii) * beta(2) * beta(8) + strainD_til(5) * beta(5) * beta(8);
-        strainD(4, ii) = strainD_til(0, ii) * 2.0 * beta(0) * beta(2) + strainD_til(1, ii) * 2.0 * beta(3) * beta(5) +
-                         strainD_til(2, ii) * (beta(2) * beta(3) + beta(0) * beta(5)) +
-                         strainD_til(3, ii) * 2.0 * beta(6) * beta(8) +
-                         strainD_til(4, ii) * (beta(2) * beta(6) + beta(0) * beta(8)) +
-                         strainD_til(5, ii) * (beta(5) * beta(6) + beta(3) * beta(8));
-        strainD(5, ii) = strainD_til(0, ii) * 2.0 * beta(1) * beta(2) + strainD_til(1, ii) * 2.0 * beta(4) * beta(5) +
-                         strainD_til(2, ii) * (beta(2) * beta(4) + beta(1) * beta(5)) +
-                         strainD_til(3, ii) * 2.0 * beta(7) * beta(8) +
-                         strainD_til(4, ii) * (beta(2) * beta(7) + beta(1) * beta(8)) +
-                         strainD_til(5, ii) * (beta(5) * beta(7) + beta(4) * beta(8));
-    }
-
-    // Enhanced Assumed Strain 2nd
-    strain += strain_EAS;
-
-    // Strain time derivative for structural damping
-    ChMatrixNM<double, 6, 1> DEPS;
-    DEPS.Reset();
-    for (int ii = 0; ii < 24; ii++) {
-        DEPS(0, 0) = DEPS(0, 0) + strainD(0, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(1, 0) = DEPS(1, 0) + strainD(1, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(2, 0) = DEPS(2, 0) + strainD(2, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(3, 0) = DEPS(3, 0) + strainD(3, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(4, 0) = DEPS(4, 0) + strainD(4, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(5, 0) = DEPS(5, 0) + strainD(5, ii) * m_element->m_d_dt(ii, 0);
-    }
-
-    // Add structural damping
-    strain += DEPS * m_element->m_Alpha;
-
-    // Matrix of elastic coefficients: the input assumes the material *could* be orthotropic
-    const ChMatrixNM<double, 6, 6>& E_eps = m_element->GetLayer(m_kl).GetMaterial()->Get_E_eps();
-
-    // Internal force calculation
-    ChMatrixNM<double, 24, 6> tempC;
-    tempC.MatrTMultiply(strainD, E_eps);
-    ChMatrixNM<double, 24, 1> Fint = (tempC * strain) * (detJ0 * m_element->m_GaussScaling);
-
-    // EAS terms
-    ChMatrixNM<double, 5, 6> temp56;
-    temp56.MatrTMultiply(G, E_eps);
-    ChMatrixNM<double, 5, 1> HE = (temp56 * strain) * (detJ0 * m_element->m_GaussScaling);  // EAS residual
-    ChMatrixNM<double, 5, 5> KALPHA = (temp56 * G) * (detJ0 * m_element->m_GaussScaling);   // EAS Jacobian
-
-    /// Total result vector
-    result.PasteClippedMatrix(Fint, 0, 0, 24, 1, 0, 0);
-    result.PasteClippedMatrix(HE, 0, 0, 5, 1, 24, 0);
-    result.PasteClippedMatrixToVector(KALPHA, 0, 0, 5, 5, 29);
+    for (int ii = 0; ii < 24; ii++)
+        for (int k = 0; k < 8; k++)
+            Fint(ii) += m_element->m_strainANS_D(k, ii) * C_ANS[k];
 }
 
 void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
@@ -601,25 +611,20 @@ void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
         ChMatrixNM<double, 5, 1> HE;
         ChMatrixNM<double, 5, 5> KALPHA;
 
+        // Strains at the quadrature points of the layer, except for the EAS terms
+        MyForce formula(this, kl);
+
         // Initial guess for EAS parameters
         ChMatrixNM<double, 5, 1> alphaEAS = m_alphaEAS[kl];
+        ChMatrixNM<double, 5, 1> alphaEAS_eval;  // EAS parameters of the last evaluation
+        bool evaluated = false;
 
         // Newton loop for EAS
         for (int count = 0; count < m_maxIterationsEAS; count++) {
-            ChMatrixNM<double, 54, 1> result;
-            MyForce formula(this, kl, &alphaEAS);
-            ChQuadrature::Integrate3D<ChMatrixNM<double, 54, 1> >(result,   // result of integration
-                                                                  formula,  // integrand formula
-                                                                  -1, 1,    // x limits
-                                                                  -1, 1,    // y limits
-                                                                  m_GaussZ[kl], m_GaussZ[kl + 1],  // z limits
-                                                                  2  // order of integration
-                                                                  );
-
-            // Extract vectors and matrices from result of integration
-            Finternal.PasteClippedMatrix(result, 0, 0, 24, 1, 0, 0);
-            HE.PasteClippedMatrix(result, 24, 0, 5, 1, 0, 0);
-            KALPHA.PasteClippedVectorToMatrix(result, 0, 0, 5, 5, 29);
+            formula.EvaluateEAS(alphaEAS, HE);
+            KALPHA = formula.GetKalpha();
+            alphaEAS_eval = alphaEAS;
+            evaluated = true;
 
             // Check convergence (residual check)
             double norm_HE = HE.NormTwo();
@@ -639,6 +644,10 @@ void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
                 GetLog() << "  count " << count << "  NormHE " << norm_HE << "\n";
         }
 
+        // Internal forces for the EAS parameters of the last evaluation of the residual
+        if (evaluated)
+            formula.EvaluateForce(alphaEAS_eval, Finternal);
+
         // Accumulate internal force
         Fi -= Finternal;
 
@@ -172,6 +172,20 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     /// Set the structural damping.
     void SetAlphaDamp(double a) { m_Alpha = a; }
 
+    /// Enable/disable the precomputation of the reference configuration terms used in the evaluation of the
+    /// internal forces (shape function derivatives, ANS and EAS bases, orthotropic transformations at the
+    /// quadrature points). If enabled (default), these terms are computed once in SetupInitial, at the memory
+    /// cost reported by GetReferenceDataSize(); otherwise they are recomputed at each evaluation of the forces.
+    /// Must be called before SetupInitial (if enabled later, the terms are still recomputed at each evaluation).
+    void SetPrecomputeReferenceData(bool val) { m_precompute = val; }
+
+    /// Return true if the reference configuration terms are precomputed.
+    bool GetPrecomputeReferenceData() const { return m_precompute; }
+
+    /// Return the memory (in bytes) required by the precomputed reference configuration terms of this element,
+    /// whether or not the precomputation is enabled.
+    size_t GetReferenceDataSize() const { return m_layers.size() * sizeof(LayerData); }
+
     /// Get the element length in the X direction.
     double GetLengthX() const { return m_lenX; }
     /// Get the element length in the Y direction.
@@ -207,6 +221,23 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     ChVector<> EvaluateSectionStrains();
 
   private:
+    /// Reference configuration terms at a quadrature point of a layer.
+    struct GaussPointData {
+        double Nx[8];                  ///< shape function derivatives w.r.t. x
+        double Ny[8];                  ///< shape function derivatives w.r.t. y
+        double N_ANS[8];               ///< coefficients of the ANS strains in the interpolated strains
+        double strain0[3];             ///< initial in-plane terms 0.5*rx0.rx0, 0.5*ry0.ry0, rx0.ry0
+        double weight;                 ///< quadrature weight, times detJ0 and the scaling of the integration interval
+        ChMatrixNM<double, 6, 6> T;    ///< transformation of the strains (orthotropic material)
+        ChMatrixNM<double, 6, 5> G;    ///< EAS matrix
+    };
+
+    /// Reference configuration terms of a layer.
+    struct LayerData {
+        GaussPointData points[8];         ///< data at the 2x2x2 quadrature points of the layer
+        ChMatrixNM<double, 5, 5> Kalpha;  ///< EAS Jacobian (constant)
+    };
+
     std::vector<std::shared_ptr<ChNodeFEAxyzD> > m_nodes;  ///< element nodes
     std::vector<Layer> m_layers;                           ///< element layers
     size_t m_numLayers;                                    ///< number of layers for this element
@@ -229,6 +260,8 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     ChMatrixNM<double, 8, 24> m_strainANS_D;               ///< ANS strain derivatives
     std::vector<ChMatrixNM<double, 5, 1> > m_alphaEAS;     ///< EAS parameters (5 per layer)
     std::vector<ChMatrixNM<double, 5, 5> > m_KalphaEAS;    ///< EAS Jacobians (a 5x5 matrix per layer)
+    bool m_precompute;                                     ///< precompute the reference configuration terms?
+    std::vector<LayerData> m_layerData;                    ///< reference configuration terms (per layer)
 
     static const double m_toleranceEAS;   ///< tolerance for nonlinear EAS solver (on residual)
     static const int m_maxIterationsEAS;  ///< maximum number of nonlinear EAS iterations
@@ -254,6 +287,9 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     // Set M as the global mass matrix.
     virtual void ComputeMmatrixGlobal(ChMatrix<>& M) override;
 
+    // The mass matrix is constant, computed in SetupInitial().
+    virtual bool HasConstantMass() const override { return true; }
+
     /// Add contribution of element inertia to total nodal masses
     virtual void ComputeNodalMass() override;
 
@@ -330,6 +366,9 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
                       ChMatrixNM<double, 1, 3>& Ny_d0,
                       ChMatrixNM<double, 1, 3>& Nz_d0);
 
+    // Calculate the reference configuration terms for the specified layer.
+    void ComputeLayerData(size_t kl, LayerData& data);
+
     // Calculate the current 8x3 matrix of nodal coordinates.
     void CalcCoordMatrix(ChMatrixNM<double, 8, 3>& d);
 
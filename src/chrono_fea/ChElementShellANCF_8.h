@@ -245,6 +245,9 @@ class ChApiFea ChElementShellANCF_8 : public ChElementShell, public ChLoadableUV
     // Set M as the global mass matrix.
     virtual void ComputeMmatrixGlobal(ChMatrix<>& M) override;
 
+    // The mass matrix is constant, computed in SetupInitial().
+    virtual bool HasConstantMass() const override { return true; }
+
     /// Add contribution of element inertia to total nodal masses
     virtual void ComputeNodalMass() override;
 
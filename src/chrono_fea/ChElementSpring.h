@@ -65,6 +65,9 @@ class ChApiFea ChElementSpring : public ChElementGeneric {
         mD.PasteVector(this->nodes[1]->GetPos(), 3, 0);
     }
 
+    /// The element is mass-less.
+    virtual bool HasConstantMass() const override { return true; }
+
     /// Sets H as the global stiffness matrix K, scaled  by Kfactor. Optionally, also
     /// superimposes global damping matrix R, scaled by Rfactor, and global mass matrix M multiplied by Mfactor.
     /// (For the spring matrix there is no need to corotate local matrices: we already know a closed form expression.)
@@ -232,6 +232,9 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
         // GetLog() << "FEM rotation: \n" << A << "\n" ;
     }
 
+    /// The mass matrix (lumped nodal masses) does not depend on the state.
+    virtual bool HasConstantMass() const override { return true; }
+
     /// Sets H as the global stiffness matrix K, scaled  by Kfactor. Optionally, also
     /// superimposes global damping matrix R, scaled by Rfactor, and global mass matrix M multiplied by Mfactor.
     virtual void ComputeKRMmatricesGlobal(ChMatrix<>& H, double Kfactor, double Rfactor = 0, double Mfactor = 0) override {
@@ -668,6 +671,9 @@ class ChApiFea ChElementTetra_4_P : public ChElementTetrahedron, public ChLoadab
             this->A.MatrScale(-1.0);
     }
 
+    /// There is no mass matrix (see ComputeKRMmatricesGlobal()).
+    virtual bool HasConstantMass() const override { return true; }
+
     /// Sets H as the global stiffness matrix K, scaled  by Kfactor. Optionally, also
     /// superimposes global damping matrix R, scaled by Rfactor, and global mass matrix M multiplied by Mfactor.
     virtual void ComputeKRMmatricesGlobal(ChMatrix<>& H, double Kfactor, double Rfactor = 0, double Mfactor = 0) override {
@@ -18,11 +18,13 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "chrono/core/ChMath.h"
 #include "chrono/physics/ChLoad.h"
 #include "chrono/physics/ChObject.h"
 #include "chrono/physics/ChSystem.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 #include "chrono_fea/ChElementTetra_4.h"
 #include "chrono_fea/ChMesh.h"
@@ -46,6 +48,9 @@ ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other) {
     automatic_gravity_load = other.automatic_gravity_load;
     num_points_gravity = other.num_points_gravity;
 
+    use_parallel_internal_forces = other.use_parallel_internal_forces;
+    colors_valid = false;
+
     ncalls_internal_forces = 0;
     ncalls_KRMload = 0;
 }
@@ -65,7 +70,12 @@ void ChMesh::SetupInitial() {
     for (unsigned int i = 0; i < velements.size(); i++) {
         //    - precompute matrices, such as the [Kl] local stiffness of each element, if needed, etc.
         velements[i]->SetupInitial(GetSystem());
+        //    - cache the mass matrix, if constant
+        velements[i]->UpdateMassCache();
     }
+
+    // Elements may have changed their nodes since they were added
+    colors_valid = false;
 }
 
 void ChMesh::Relax() {
@@ -89,15 +99,18 @@ void ChMesh::AddNode(std::shared_ptr<ChNodeFEAbase> m_node) {
 
 void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
     velements.push_back(m_elem);
+    colors_valid = false;
 }
 
 void ChMesh::ClearElements() {
     velements.clear();
+    colors_valid = false;
     vcontactsurfaces.clear();
 }
 
 void ChMesh::ClearNodes() {
     velements.clear();
+    colors_valid = false;
     vnodes.clear();
     vcontactsurfaces.clear();
 }
@@ -251,6 +264,8 @@ void ChMesh::IntLoadResidual_F(const unsigned int off,
                                ChVectorDynamic<>& R,   
                                const double c          
                                ) {
+    CH_TRACE("ChMesh::IntLoadResidual_F");
+
     // applied nodal forces
     unsigned int local_off_v = 0;
     for (unsigned int j = 0; j < vnodes.size(); j++) {
@@ -262,9 +277,28 @@ void ChMesh::IntLoadResidual_F(const unsigned int off,
 
     // internal forces
     timer_internal_forces.start();
-#pragma omp parallel for schedule(dynamic, 4)
-    for (int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_F(R, c);
+    if (use_parallel_internal_forces) {
+        if (!colors_valid)
+            ColorElements();
+        int nthreads = GetSystem() ? GetSystem()->GetParallelThreadNumber() : 1;
+        int ncolors = (int)color_start.size() - 1;
+        // Elements of one color do not share nodes: no concurrent writes to the same entries of R.
+        // The implicit barrier at the end of each 'omp for' separates the colors.
+#pragma omp parallel num_threads(nthreads) if (nthreads > 1)
+        {
+            CH_TRACE("Internal forces");
+            for (int color = 0; color < ncolors; color++) {
+#pragma omp for schedule(dynamic, 4)
+                for (int k = color_start[color]; k < color_start[color + 1]; k++) {
+                    velements[color_elements[k]]->EleIntLoadResidual_F(R, c);
+                }
+            }
+        }
+    } else {
+        CH_TRACE("Internal forces");
+        for (unsigned int ie = 0; ie < velements.size(); ie++) {
+            velements[ie]->EleIntLoadResidual_F(R, c);
+        }
     }
     timer_internal_forces.stop();
     ncalls_internal_forces++;
@@ -291,6 +325,44 @@ void ChMesh::IntLoadResidual_F(const unsigned int off,
     }
 }
 
+void ChMesh::ColorElements() {
+    // Colors already used by the elements around each node
+    std::unordered_map<ChNodeFEAbase*, std::vector<int>> node_colors;
+    std::vector<int> element_color(velements.size());
+    std::vector<int> used;
+    int ncolors = 0;
+
+    for (unsigned int ie = 0; ie < velements.size(); ie++) {
+        used.clear();
+        int nnodes = velements[ie]->GetNnodes();
+        for (int in = 0; in < nnodes; in++) {
+            const std::vector<int>& colors = node_colors[velements[ie]->GetNodeN(in).get()];
+            used.insert(used.end(), colors.begin(), colors.end());
+        }
+        // Pick the first color not used by any of the nodes
+        int color = 0;
+        while (std::find(used.begin(), used.end(), color) != used.end())
+            color++;
+        for (int in = 0; in < nnodes; in++)
+            node_colors[velements[ie]->GetNodeN(in).get()].push_back(color);
+        element_color[ie] = color;
+        ncolors = std::max(ncolors, color + 1);
+    }
+
+    // Group the elements by color, keeping their order within each color
+    color_start.assign(ncolors + 1, 0);
+    for (unsigned int ie = 0; ie < velements.size(); ie++)
+        color_start[element_color[ie] + 1]++;
+    for (int color = 0; color < ncolors; color++)
+        color_start[color + 1] += color_start[color];
+    std::vector<int> next(color_start.begin(), color_start.end() - 1);
+    color_elements.resize(velements.size());
+    for (unsigned int ie = 0; ie < velements.size(); ie++)
+        color_elements[next[element_color[ie]]++] = ie;
+
+    colors_valid = true;
+}
+
 void ChMesh::ComputeMassProperties(double& mass,           // ChMesh object mass
                                    ChVector<>& com,        // ChMesh center of gravity
                                    ChMatrix33<>& inertia)  // ChMesh inertia tensor
@@ -369,9 +441,16 @@ void ChMesh::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
 
 void ChMesh::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
     timer_KRMload.start();
-#pragma omp parallel for
-    for (int ie = 0; ie < velements.size(); ie++)
-        velements[ie]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
+    // Each element writes only in its own K, R, M blocks: they are added to the system matrix later
+    // (see ChSystemDescriptor::SetUseParallelKblocks()).
+    int nthreads = GetSystem() ? GetSystem()->GetParallelThreadNumber() : 1;
+#pragma omp parallel num_threads(nthreads) if (nthreads > 1)
+    {
+        CH_TRACE("KRM matrices");
+#pragma omp for schedule(dynamic, 4)
+        for (int ie = 0; ie < (int)velements.size(); ie++)
+            velements[ie]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
+    }
     timer_KRMload.stop();
     ncalls_KRMload++;
 }
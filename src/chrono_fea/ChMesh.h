@@ -51,6 +51,11 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     bool automatic_gravity_load;
     int num_points_gravity;
 
+    bool use_parallel_internal_forces;  ///< evaluate the internal forces in parallel, color by color
+    bool colors_valid;                  ///< false if the element coloring must be recomputed
+    std::vector<int> color_start;       ///< start of each color in color_elements (plus the end of the last one)
+    std::vector<int> color_elements;    ///< indices of the elements, grouped by color
+
     ChTimer<> timer_internal_forces;
     ChTimer<> timer_KRMload;
     int ncalls_internal_forces;
@@ -62,6 +67,8 @@ class ChApiFea ChMesh : public ChIndexedNodes {
           n_dofs_w(0),
           automatic_gravity_load(true),
           num_points_gravity(1),
+          use_parallel_internal_forces(true),
+          colors_valid(false),
           ncalls_internal_forces(0),
           ncalls_KRMload(0) {}
     ChMesh(const ChMesh& other);
@@ -119,6 +126,21 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     /// Get cumulative time for Jacobian load calls.
     double GetTimeJacobianLoad() { return timer_KRMload(); }
 
+    /// Enable/disable the multithreaded evaluation of the internal forces of the elements (default: true).
+    /// Elements are partitioned in colors, such that elements of the same color do not share nodes; colors are
+    /// processed one after the other, and the elements of a color in parallel, so that no two threads add to the
+    /// same entries of the residual at the same time. The summation order depends only on the coloring, hence
+    /// results are bitwise identical for any number of threads (see ChSystem::SetParallelThreadNumber()).
+    /// If disabled, elements are processed sequentially, in the order in which they were added.
+    void SetUseParallelInternalForces(bool mpar) { use_parallel_internal_forces = mpar; }
+    /// Tell if the multithreaded evaluation of the internal forces is enabled.
+    bool GetUseParallelInternalForces() const { return use_parallel_internal_forces; }
+
+    /// Get the number of colors of the elements (elements of the same color do not share nodes).
+    /// The coloring is computed at the first parallel evaluation of the internal forces, and recomputed
+    /// after elements were added or removed.
+    int GetNumElementColors() const { return colors_valid ? (int)color_start.size() - 1 : 0; }
+
     /// Add a contact surface.
     void AddContactSurface(std::shared_ptr<ChContactSurface> m_surf);
 
@@ -277,6 +299,10 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     ///   - Precompute auxiliary data, such as (local) stiffness matrices Kl, if any, for each element.
     /// </pre>
     virtual void SetupInitial() override;
+
+    /// Partition the elements in colors, such that elements of the same color do not share nodes
+    /// (greedy coloring, in the order in which elements were added).
+    void ColorElements();
 };
 
 /// @} fea_module
@@ -214,6 +214,8 @@ void SCMDeformableTerrain::PrintStepStatistics(std::ostream& os) const {
     os << " Counters:" << std::endl;
     os << "   Number vertices:         " << m_ground->m_num_vertices << std::endl;
     os << "   Number ray-casts:        " << m_ground->m_num_ray_casts << std::endl;
+    if (m_ground->m_timer_ray_hits() > 0)
+        os << "   Ray-casts per second:    " << m_ground->m_num_ray_casts / m_ground->m_timer_ray_hits() << std::endl;
     os << "   Number faces:            " << m_ground->m_num_faces << std::endl;
     if (m_ground->do_refinement)
         os << "   Number faces refinement: " << m_ground->m_num_marked_faces << std::endl;
@@ -508,6 +510,7 @@ void SCMDeformableSoil::SetupAuxData() {
 void SCMDeformableSoil::ComputeInternalForces() {
     m_timer_calc_areas.reset();
     m_timer_ray_casting.reset();
+    m_timer_ray_hits.reset();
     m_timer_refinement.reset();
     m_timer_bulldozing.reset();
     m_timer_visualization.reset();
@@ -578,14 +581,10 @@ void SCMDeformableSoil::ComputeInternalForces() {
     // Loop through all vertices.
     // - set default SCM quantities (in case no ray-hit)
     // - skip vertices outside moving patch (if option enabled)
-    // - cast ray and record result in a map (key: vertex index)
-    // - initialize patch id to -1 (not set)
-    struct HitRecord {
-        ChContactable* contactable;  // pointer to hit object
-        ChVector<> abs_point;        // hit point, expressed in global frame
-        int patch_id;                // index of associated patch id
-    };
-    std::unordered_map<int, HitRecord> hits;
+    // - collect the ray from the vertex
+    m_ray_from.clear();
+    m_ray_to.clear();
+    m_ray_vertex.clear();
 
     for (int i = 0; i < vertices.size(); ++i) {
         // Initialize SCM quantities at current vertex
@@ -604,15 +603,37 @@ void SCMDeformableSoil::ComputeInternalForces() {
             }
         }
 
-        // Perform ray casting from current vertex
-        collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
+        // Ray from current vertex
         ChVector<> to = vertices[i] + N * test_high_offset;
         ChVector<> from = to - N * test_low_offset;
-        this->GetSystem()->GetCollisionSystem()->RayHit(from, to, mrayhit_result);
-        m_num_ray_casts++;
+        m_ray_from.push_back(from);
+        m_ray_to.push_back(to);
+        m_ray_vertex.push_back(i);
+    }
+
+    // Perform ray casting for all rays at once, and record the hits (in order of vertex index).
+    // - initialize patch id to -1 (not set)
+    m_timer_ray_hits.start();
+    this->GetSystem()->GetCollisionSystem()->RayHits(m_ray_from, m_ray_to, m_ray_results);
+    m_timer_ray_hits.stop();
+    m_num_ray_casts = m_ray_from.size();
+
+    struct HitRecord {
+        int vertex;                  // index of hit vertex
+        ChContactable* contactable;  // pointer to hit object
+        ChVector<> abs_point;        // hit point, expressed in global frame
+        int patch_id;                // index of associated patch id
+    };
+    std::vector<HitRecord> hits;
+    m_vertex_hit.assign(vertices.size(), -1);
+
+    for (size_t k = 0; k < m_ray_results.size(); ++k) {
+        const collision::ChCollisionSystem::ChRayhitResult& mrayhit_result = m_ray_results[k];
         if (mrayhit_result.hit) {
-            HitRecord record = { mrayhit_result.hitModel->GetContactable(), mrayhit_result.abs_hitPoint, -1 };
-            hits.insert(std::make_pair(i, record));
+            HitRecord record = {m_ray_vertex[k], mrayhit_result.hitModel->GetContactable(),
+                                mrayhit_result.abs_hitPoint, -1};
+            m_vertex_hit[m_ray_vertex[k]] = (int)hits.size();
+            hits.push_back(record);
         }
     }
 
@@ -622,24 +643,23 @@ void SCMDeformableSoil::ComputeInternalForces() {
     // Use a queue-based flood-filling algorithm.
     int num_patches = 0;
     for (auto& h : hits) {
-        int i = h.first;
-        if (h.second.patch_id != -1)                               // move on if vertex already assigned to a patch
+        int i = h.vertex;
+        if (h.patch_id != -1)                                      // move on if vertex already assigned to a patch
             continue;                                              //
         std::queue<int> todo;                                      //
-        h.second.patch_id = num_patches++;                         // assign this vertex to a new patch
+        h.patch_id = num_patches++;                                // assign this vertex to a new patch
         todo.push(i);                                              // add vertex to end of queue
         while (!todo.empty()) {                                    //
-            auto crt = hits.find(todo.front());                    // current vertex is first element in queue
+            int crt_i = todo.front();                              // current vertex is first element in queue
             todo.pop();                                            // remove first element of queue
-            auto crt_i = crt->first;                               //
-            auto crt_patch = crt->second.patch_id;                 //
+            int crt_patch = hits[m_vertex_hit[crt_i]].patch_id;    //
             for (const auto& nbr_i : connected_vertexes[crt_i]) {  // loop over all neighbors
-                auto nbr = hits.find(nbr_i);                       // look for neighbor in list of hit vertices
-                if (nbr == hits.end())                             // move on if neighbor is not a hit vertex
+                int nbr = m_vertex_hit[nbr_i];                     // look for neighbor in list of hit vertices
+                if (nbr == -1)                                     // move on if neighbor is not a hit vertex
                     continue;                                      //
-                if (nbr->second.patch_id != -1)                    // (COULD BE REMOVED, unless we update patch area)
+                if (hits[nbr].patch_id != -1)                      // (COULD BE REMOVED, unless we update patch area)
                     continue;                                      //
-                nbr->second.patch_id = crt_patch;                  // assign neighbor to same patch
+                hits[nbr].patch_id = crt_patch;                    // assign neighbor to same patch
                 todo.push(nbr_i);                                  // add neighbor to end of queue
             }
         }
@@ -654,8 +674,8 @@ void SCMDeformableSoil::ComputeInternalForces() {
     };
     std::vector<PatchRecord> patches(num_patches);
     for (auto& h : hits) {
-        ChVector<> v = plane.TransformParentToLocal(vertices[h.first]);
-        patches[h.second.patch_id].points.push_back(ChVector2<>(v.x(), v.z()));
+        ChVector<> v = plane.TransformParentToLocal(vertices[h.vertex]);
+        patches[h.patch_id].points.push_back(ChVector2<>(v.x(), v.z()));
     }
 
     // Calculate area and perimeter of each patch.
@@ -679,10 +699,10 @@ void SCMDeformableSoil::ComputeInternalForces() {
 
     // Process only hit vertices
     for (auto& h : hits) {
-        int i = h.first;
-        ChContactable* contactable = h.second.contactable;
-        const ChVector<>& abs_point = h.second.abs_point;
-        int patch_id = h.second.patch_id;
+        int i = h.vertex;
+        ChContactable* contactable = h.contactable;
+        const ChVector<>& abs_point = h.abs_point;
+        int patch_id = h.patch_id;
 
         double p_hit_offset = 1e9;
 
@@ -347,6 +347,7 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
     // Timers and counters
     ChTimer<double> m_timer_calc_areas;
     ChTimer<double> m_timer_ray_casting;
+    ChTimer<double> m_timer_ray_hits;
     ChTimer<double> m_timer_refinement;
     ChTimer<double> m_timer_bulldozing;
     ChTimer<double> m_timer_visualization;
@@ -355,6 +356,13 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
     size_t m_num_ray_casts;
     size_t m_num_marked_faces;
 
+    // Ray casting work data
+    std::vector<ChVector<>> m_ray_from;                                       ///< start points of the rays
+    std::vector<ChVector<>> m_ray_to;                                         ///< end points of the rays
+    std::vector<int> m_ray_vertex;                                            ///< mesh vertex of each ray
+    std::vector<collision::ChCollisionSystem::ChRayhitResult> m_ray_results;  ///< result of each ray
+    std::vector<int> m_vertex_hit;  ///< index of the hit record of each vertex (-1 if no hit)
+
     std::unordered_map<ChContactable*, TerrainForce> m_contact_forces;
 
     friend class SCMDeformableTerrain;
@@ -0,0 +1,108 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark for the multithreaded state gather and residual loading
+// in ChAssembly (see ChAssembly::SetUseParallelIntegrable).
+// Timings are reported versus the number of threads; the results obtained with
+// multiple threads are also checked against the sequential ones.
+//
+// =============================================================================
+
+#include <iostream>
+
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace std;
+
+#define TIME(X, Y)                                 \
+    timer.reset();                                 \
+    timer.start();                                 \
+    for (int i = 0; i < num_repeat; i++) {         \
+        X;                                         \
+    }                                              \
+    timer.stop();                                  \
+    cout << "  " << Y << timer() << endl;
+
+int main() {
+    ChTimer<double> timer;
+    const int num_bodies = 100000;
+    const int num_links = 10000;
+    const int num_repeat = 10;
+
+    ChSystemNSC system;
+
+    std::shared_ptr<ChBody> prev;
+    for (int i = 0; i < num_bodies; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetPos(ChVector<>(i * 0.01, rand() % 1000 / 1000.0, rand() % 1000 / 1000.0));
+        body->SetPos_dt(ChVector<>(rand() % 1000 / 1000.0, 0, 0));
+        system.AddBody(body);
+        if (i > 0 && i <= num_links) {
+            auto link = std::make_shared<ChLinkLockSpherical>();
+            link->Initialize(prev, body, ChCoordsys<>(body->GetPos()));
+            system.AddLink(link);
+        }
+        prev = body;
+    }
+
+    system.Setup();
+    system.Update();
+
+    int nx = system.GetNcoords_x();
+    int nv = system.GetNcoords_v();
+    int nc = system.GetNconstr();
+
+    ChState x_ref(nx, &system);
+    ChStateDelta v_ref(nv, &system);
+    ChVectorDynamic<> R_ref(nv);
+    ChVectorDynamic<> Qc_ref(nc);
+    ChVectorDynamic<> L(nc);
+    L.FillRandom(1, -1);
+    double T;
+
+    bool ok = true;
+
+    int max_threads = CHOMPfunctions::GetNumProcs();
+    for (int nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+        system.SetParallelThreadNumber(nthreads);
+        system.SetUseParallelIntegrable(nthreads > 1);
+
+        cout << "Threads: " << nthreads << endl;
+
+        ChState x(nx, &system);
+        ChStateDelta v(nv, &system);
+        ChVectorDynamic<> R(nv);
+        ChVectorDynamic<> Qc(nc);
+
+        TIME(system.StateGather(x, v, T), "StateGather ");
+        TIME(system.StateScatter(x, v, T), "StateScatter ");
+        TIME(system.LoadResidual_F(R, 1.0), "LoadResidual_F ");
+        TIME(system.LoadResidual_Mv(R, v, 1.0), "LoadResidual_Mv ");
+        TIME(system.LoadResidual_CqL(R, L, 1.0), "LoadResidual_CqL ");
+        TIME(system.LoadConstraint_C(Qc, 1.0), "LoadConstraint_C ");
+
+        if (nthreads == 1) {
+            x_ref = x;
+            v_ref = v;
+            R_ref = R;
+            Qc_ref = Qc;
+        } else {
+            bool same = x.Equals(x_ref, 0) && v.Equals(v_ref, 0) && R.Equals(R_ref, 0) && Qc.Equals(Qc_ref, 0);
+            cout << "  Results identical to sequential: " << (same ? "yes" : "NO") << endl;
+            ok = ok && same;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
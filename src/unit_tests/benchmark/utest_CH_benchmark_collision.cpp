@@ -0,0 +1,153 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark for the multithreaded collision detection of ChCollisionSystemBullet.
+// A pile of spheres (100000 by default, or N with N passed on the command line)
+// in a box container is processed by the default (sequential) Bullet collision
+// detection and by the multithreaded one with 1, 2, 4, ... threads; the spheres
+// are slightly moved before each collision detection, so that all bounding boxes
+// change as in a simulation. The time per collision detection is reported. The contacts found by the multithreaded
+// collision detection must be identical (also in order) for any number of
+// threads, and the same as those found by the sequential one.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include "../ChTestConfig.h"
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace std;
+
+int num_spheres = 100000;
+const int num_repeat = 5;
+const double radius = 0.05;
+
+// Contact data: identifiers of the two bodies, contact points.
+typedef std::tuple<int, int, double, double, double, double, double, double> Contact;
+
+class ContactCollector : public ChContactContainer::ReportContactCallback {
+  public:
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* contactobjA,
+                                 ChContactable* contactobjB) override {
+        int idA = static_cast<ChBody*>(contactobjA)->GetIdentifier();
+        int idB = static_cast<ChBody*>(contactobjB)->GetIdentifier();
+        contacts.push_back(Contact(idA, idB, pA.x(), pA.y(), pA.z(), pB.x(), pB.y(), pB.z()));
+        return true;
+    }
+
+    std::vector<Contact> contacts;
+};
+
+std::vector<Contact> Run(bool parallel, int nthreads) {
+    ChSystemNSC system;
+    system.SetParallelThreadNumber(nthreads);
+    auto collision_system = std::static_pointer_cast<ChCollisionSystemBullet>(system.GetCollisionSystem());
+    collision_system->SetUseParallelCollision(parallel);
+
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+
+    // Layers of nx x nx spheres, slightly interpenetrating and with a (deterministic) random offset.
+    int nx = 50;
+    int nz = (num_spheres + nx * nx - 1) / (nx * nx);
+    double spacing = 1.98 * radius;
+    double hdim = 0.5 * nx * spacing + radius;
+    utils::CreateBoxContainer(&system, -1, material, ChVector<>(hdim, hdim, nz * spacing), 0.1,
+                              ChVector<>(0, 0, 0), ChQuaternion<>(1, 0, 0, 0), true, false, true, false);
+
+    std::vector<std::shared_ptr<ChBody>> balls;
+    srand(0);
+    for (int i = 0; i < num_spheres; i++) {
+        int ix = i % nx;
+        int iy = (i / nx) % nx;
+        int iz = i / (nx * nx);
+        ChVector<> offset(rand() % 1000 / 1000.0, rand() % 1000 / 1000.0, rand() % 1000 / 1000.0);
+        auto ball = std::make_shared<ChBody>();
+        ball->SetIdentifier(i);
+        ball->SetPos(ChVector<>((ix - 0.5 * nx + 0.5) * spacing, (iy - 0.5 * nx + 0.5) * spacing,
+                                radius + iz * spacing) +
+                     0.01 * radius * offset);
+        ball->SetMaterialSurface(material);
+        ball->SetCollide(true);
+        ball->GetCollisionModel()->ClearModel();
+        ball->GetCollisionModel()->AddSphere(radius);
+        ball->GetCollisionModel()->BuildModel();
+        system.AddBody(ball);
+        balls.push_back(ball);
+    }
+    system.SetupInitial();
+
+    ChTimer<double> timer;
+    timer.reset();
+    system.ComputeCollisions();
+    for (int r = 0; r < num_repeat; r++) {
+        ChVector<> shift((r % 2 ? -1e-3 : 1e-3) * radius, 0, 0);
+        for (auto ball : balls)
+            ball->SetPos(ball->GetPos() + shift);
+        timer.start();
+        system.ComputeCollisions();
+        timer.stop();
+    }
+
+    ContactCollector collector;
+    system.GetContactContainer()->ReportAllContacts(&collector);
+
+    cout << (parallel ? "Multithreaded, threads: " : "Sequential, threads: ") << nthreads
+         << "  contacts: " << collector.contacts.size() << "  time: " << timer() / num_repeat << " s" << endl;
+
+    return collector.contacts;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1)
+        num_spheres = atoi(argv[1]);
+
+    int max_threads = std::max(CHOMPfunctions::GetNumProcs(), 4);
+
+    std::vector<Contact> ref = Run(false, 1);
+    std::sort(ref.begin(), ref.end());
+
+    bool ok = true;
+    std::vector<Contact> ref_parallel;
+    for (int nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+        std::vector<Contact> contacts = Run(true, nthreads);
+        if (nthreads == 1) {
+            ref_parallel = contacts;
+            std::sort(contacts.begin(), contacts.end());
+            bool same = contacts == ref;
+            cout << "  Contacts identical to sequential collision detection: " << (same ? "yes" : "NO") << endl;
+            ok = ok && same;
+        } else {
+            bool same = contacts == ref_parallel;
+            cout << "  Contacts identical to 1 thread: " << (same ? "yes" : "NO") << endl;
+            ok = ok && same;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark for the SOR-type solvers: ChSolverSOR, ChSolverSORmultithread and
+// the graph-colored ChSolverSORcolored.
+// A pile of spheres settling in a box is simulated with each solver; the total
+// time spent in the solver and the convergence history of the last step are
+// reported. The results of ChSolverSORcolored are also checked to be identical
+// for any number of threads.
+//
+// =============================================================================
+
+#include <iostream>
+#include <vector>
+
+#include "../ChTestConfig.h"
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChIterativeSolver.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+using namespace chrono;
+using namespace std;
+
+const double time_step = 1e-3;
+const int num_steps = 200;
+const int num_iterations = 100;
+const double radius = 0.05;
+
+struct Result {
+    double time;
+    std::vector<double> history;
+    std::vector<ChVector<>> positions;
+};
+
+Result Simulate(ChSolver::Type type, int nthreads) {
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetParallelThreadNumber(nthreads);
+    system.SetSolverType(type);
+    system.SetMaxItersSolverSpeed(num_iterations);
+    system.SetTolForce(0);
+
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.4f);
+
+    utils::CreateBoxContainer(&system, -1, material, ChVector<>(1, 1, 1), 0.1, ChVector<>(0, 0, 0),
+                              ChQuaternion<>(1, 0, 0, 0), true, false, true, false);
+
+    std::vector<std::shared_ptr<ChBody>> balls;
+    for (int iz = 0; iz < 10; iz++) {
+        for (int ix = -8; ix <= 8; ix++) {
+            for (int iy = -8; iy <= 8; iy++) {
+                auto ball = std::make_shared<ChBody>();
+                double offset = (iz % 2) * 0.3 * radius;
+                ball->SetPos(ChVector<>(ix * 2.1 * radius + offset, iy * 2.1 * radius, radius + iz * 2.05 * radius));
+                ball->SetMass(1);
+                ball->SetInertiaXX(0.4 * radius * radius * ChVector<>(1, 1, 1));
+                ball->SetMaterialSurface(material);
+                ball->SetCollide(true);
+                ball->GetCollisionModel()->ClearModel();
+                ball->GetCollisionModel()->AddSphere(radius);
+                ball->GetCollisionModel()->BuildModel();
+                system.AddBody(ball);
+                balls.push_back(ball);
+            }
+        }
+    }
+
+    auto solver = std::dynamic_pointer_cast<ChIterativeSolver>(system.GetSolver());
+    solver->SetRecordViolation(true);
+
+    Result result;
+    result.time = 0;
+    for (int step = 0; step < num_steps; step++) {
+        system.DoStepDynamics(time_step);
+        result.time += system.GetTimerSolver();
+    }
+
+    result.history = solver->GetViolationHistory();
+    for (auto ball : balls)
+        result.positions.push_back(ball->GetPos());
+
+    cout << "  contacts: " << system.GetNcontacts() << "  solver time: " << result.time << endl;
+    cout << "  max. violation after 10/25/50/100 iterations: " << result.history[9] << "  " << result.history[24]
+         << "  " << result.history[49] << "  " << result.history[99] << endl;
+
+    return result;
+}
+
+int main() {
+    int max_threads = CHOMPfunctions::GetNumProcs();
+
+    cout << "SOR" << endl;
+    Simulate(ChSolver::Type::SOR, 1);
+
+    for (int nthreads = 2; nthreads <= max_threads; nthreads *= 2) {
+        cout << "SOR_MULTITHREAD, threads: " << nthreads << endl;
+        Simulate(ChSolver::Type::SOR_MULTITHREAD, nthreads);
+    }
+
+    bool ok = true;
+    Result ref;
+    for (int nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+        cout << "SOR_COLORED, threads: " << nthreads << endl;
+        Result res = Simulate(ChSolver::Type::SOR_COLORED, nthreads);
+        if (nthreads == 1) {
+            ref = res;
+        } else {
+            bool same = res.history == ref.history && res.positions.size() == ref.positions.size();
+            for (size_t i = 0; same && i < res.positions.size(); i++)
+                same = res.positions[i].Equals(ref.positions[i], 0);
+            cout << "  Results identical to 1 thread: " << (same ? "yes" : "NO") << endl;
+            ok = ok && same;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -250,6 +250,71 @@ bool test_sparsity_lock()
 	return false;
 }
 
+// Check that two matrices have the same elements.
+bool same_elements(const ChCSMatrix& matA, const ChCSMatrix& matB) {
+    for (auto row_sel = 0; row_sel < matA.GetNumRows(); ++row_sel)
+        for (auto col_sel = 0; col_sel < matA.GetNumColumns(); ++col_sel)
+            if (matA.GetElement(row_sel, col_sel) != matB.GetElement(row_sel, col_sel))
+                return false;
+    return true;
+}
+
+// Assemble a matrix (with given scaling of the values and, optionally, an extra element).
+void assemble_scatter_test(ChCSMatrix& mat, double scale, bool extra) {
+    mat.Reset(4, 4);
+    mat.SetElement(0, 0, 10.0 * scale);
+    mat.SetElement(3, 0, 3.0 * scale);
+    mat.SetElement(1, 2, 1.2 * scale);
+    mat.SetElement(1, 1, 1.1 * scale);
+    mat.SetElement(1, 1, 1.0 * scale, false);
+    mat.SetElement(2, 1, 2.1 * scale);
+    mat.SetElement(2, 2, 2.2 * scale);
+    if (extra)
+        mat.SetElement(2, 3, 2.3 * scale);
+    mat.SetElement(0, 1, 0.1 * scale);
+}
+
+bool test_scatter_map()
+{
+	ChCSMatrix mat(4, 4, true, 15);
+	mat.SetSparsityPatternLock(true);
+
+	// first assembly: the matrix is not compressed, so nothing is recorded
+	mat.BeginScatterMap();
+	assemble_scatter_test(mat, 1.0, false);
+	if (mat.EndScatterMap() || mat.HasScatterMap())
+		return true;
+	mat.Compress();
+
+	// second assembly: same pattern, the scatter map is recorded
+	mat.BeginScatterMap();
+	assemble_scatter_test(mat, 2.0, false);
+	if (!mat.EndScatterMap() || !mat.HasScatterMap())
+		return true;
+
+	// third assembly: the scatter map is replayed
+	mat.BeginScatterMap();
+	assemble_scatter_test(mat, 3.0, false);
+	if (!mat.EndScatterMap() || !mat.HasScatterMap())
+		return true;
+
+	ChCSMatrix mat_ref(4, 4, true, 15);
+	assemble_scatter_test(mat_ref, 3.0, false);
+	if (!same_elements(mat, mat_ref))
+		return true;
+
+	// fourth assembly: a new element breaks the replay, the matrix must still be correct
+	mat.BeginScatterMap();
+	assemble_scatter_test(mat, 4.0, true);
+	if (mat.EndScatterMap() || mat.HasScatterMap())
+		return true;
+	mat.Compress();
+
+	ChCSMatrix mat_ref_extra(4, 4, true, 15);
+	assemble_scatter_test(mat_ref_extra, 4.0, true);
+	return !same_elements(mat, mat_ref_extra);
+}
+
 bool test_MatrMultriply(bool transposeA)
 {
     ChMatrixDynamic<double> matB(3, 2), mat_outR(3, 2), mat_outC(3, 2);
@@ -369,8 +434,9 @@ int main() {
 	auto test_MatrMultriply_errors = test_MatrMultriply(false);
 	auto test_MatrTMultriply_errors = test_MatrMultriply(true);
 	auto test_MatrMultriplyClipped_errors = test_MatrMultriplyClipped();
+	auto test_scatter_map_errors = test_scatter_map();
     
-    auto general_error = test_sparsity_lock_errors || test_Compress_errors || testColumnMajor_errors || test_MatrMultriply_errors || test_MatrTMultriply_errors || test_MatrMultriplyClipped_errors;
+    auto general_error = test_sparsity_lock_errors || test_Compress_errors || testColumnMajor_errors || test_MatrMultriply_errors || test_MatrTMultriply_errors || test_MatrMultriplyClipped_errors || test_scatter_map_errors;
 
     std::cout << (general_error ? "error on CSR matrix" : "test passed" )<< std::endl;
 
@@ -0,0 +1,151 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tests for the built-in sparse direct factorization (ChSparseLUEngine).
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include "chrono/core/ChCSMatrix.h"
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/solver/ChSparseLUEngine.h"
+
+using namespace chrono;
+
+using std::cout;
+using std::endl;
+
+double tolerance = 1e-10;
+
+// Return the infinity norm of the residual A*x-b.
+double Residual(const ChCSMatrix& A, const ChMatrixDynamic<>& x, const ChMatrixDynamic<>& b) {
+    ChMatrixDynamic<> Ax(b.GetRows(), 1);
+    A.MatrMultiply(x, Ax);
+    Ax -= b;
+    return Ax.NormInf();
+}
+
+// Factorize A, solve for a random right-hand side and check the residual.
+bool Check(ChSparseLUEngine& engine, ChCSMatrix& A, int num_primary) {
+    A.Compress();
+    if (engine.PatternChanged(A))
+        engine.Analyze(A, num_primary);
+    if (!engine.Factorize(A)) {
+        cout << "  zero pivot at " << engine.GetZeroPivot() << endl;
+        return false;
+    }
+
+    ChMatrixDynamic<> b(A.GetNumRows(), 1);
+    b.FillRandom(1, -1);
+    ChMatrixDynamic<> x;
+    engine.Solve(b, x);
+
+    double res = Residual(A, x, b);
+    cout << "  n = " << A.GetNumRows() << "  nnz = " << A.GetNNZ() << "  nnz(L) = " << engine.GetFactorNNZ()
+         << "  |Ax-b| = " << res << endl;
+    return res < tolerance;
+}
+
+// 2D Laplacian on a (m x m) grid, plus a diagonal shift (symmetric positive definite).
+void Laplacian(ChCSMatrix& A, int m, double shift) {
+    int n = m * m;
+    A.Reset(n, n);
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < m; j++) {
+            int k = i * m + j;
+            A.SetElement(k, k, 4 + shift);
+            if (i > 0)
+                A.SetElement(k, k - m, -1);
+            if (i < m - 1)
+                A.SetElement(k, k + m, -1);
+            if (j > 0)
+                A.SetElement(k, k - 1, -1);
+            if (j < m - 1)
+                A.SetElement(k, k + 1, -1);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    srand(1);
+
+    cout << "Symmetric positive definite matrix, LDL'" << endl;
+    {
+        ChCSMatrix A(1, 1);
+        Laplacian(A, 30, 0.1);
+        ChSparseLUEngine engine;
+        engine.SetSymmetric(true);
+        passed &= Check(engine, A, -1);
+    }
+
+    cout << "Unsymmetric matrix with unsymmetric pattern, LDU" << endl;
+    {
+        int n = 400;
+        ChCSMatrix A(n, n);
+        for (int i = 0; i < n; i++) {
+            A.SetElement(i, i, 10.0 + (rand() % 100) / 10.0);
+            for (int k = 0; k < 4; k++) {
+                int j = rand() % n;
+                if (j != i)
+                    A.SetElement(i, j, (rand() % 200) / 100.0 - 1.0);
+            }
+        }
+        ChSparseLUEngine engine;
+        passed &= Check(engine, A, -1);
+    }
+
+    cout << "Saddle-point matrix [M Cq'; Cq 0], LDL'" << endl;
+    {
+        int m = 20;
+        int nq = m * m;
+        int nc = 50;
+        ChCSMatrix A(1, 1);
+        Laplacian(A, m, 0.5);
+        ChCSMatrix Z(nq + nc, nq + nc);
+        for (int k = 0; k < nq; k++) {
+            for (int j = 0; j < nq; j++) {
+                double v = A.GetElement(k, j);
+                if (v != 0)
+                    Z.SetElement(k, j, v);
+            }
+        }
+        for (int c = 0; c < nc; c++) {
+            int q1 = (c * 7) % nq;
+            int q2 = (c * 13 + 5) % nq;
+            Z.SetElement(nq + c, q1, 1.0);
+            Z.SetElement(q1, nq + c, 1.0);
+            Z.SetElement(nq + c, q2, -1.0);
+            Z.SetElement(q2, nq + c, -1.0);
+            Z.SetElement(nq + c, nq + c, 0.0);
+        }
+        ChSparseLUEngine engine;
+        engine.SetSymmetric(true);
+        passed &= Check(engine, Z, nq);
+
+        cout << "Refactorization with the same pattern, LDU" << endl;
+        Z.ForEachExistentValue([](double* val) { *val *= 2; });
+        engine.SetSymmetric(false);
+        bool reanalyze = engine.PatternChanged(Z);
+        cout << "  pattern changed: " << (reanalyze ? "yes" : "no") << endl;
+        passed &= !reanalyze;
+        passed &= Check(engine, Z, nq);
+    }
+
+    cout << (passed ? "PASSED" : "FAILED") << endl;
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,157 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tests for the thread-aware trace profiler (ChTraceProfiler, CH_TRACE):
+// nested scopes, scopes in OpenMP parallel regions, ring buffer overflow and
+// export to Chrome trace JSON and CSV.
+//
+// =============================================================================
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/utils/ChTraceProfiler.h"
+
+using namespace chrono;
+using namespace chrono::utils;
+
+using std::cout;
+using std::endl;
+
+// Count the recorded events with the given name, over all threads.
+int CountEvents(const std::string& name) {
+    int n = 0;
+    for (int thread = 0; thread < ChTraceProfiler::GetNumThreads(); thread++) {
+        for (const auto& event : ChTraceProfiler::GetEvents(thread))
+            n += (name == event.name) ? 1 : 0;
+    }
+    return n;
+}
+
+void Work() {
+    volatile double sum = 0;
+    for (int i = 0; i < 10000; i++)
+        sum = sum + i * 0.5;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    cout << "Disabled profiler" << endl;
+    {
+        for (int i = 0; i < 100; i++) {
+            CH_TRACE("disabled");
+            Work();
+        }
+        passed &= (CountEvents("disabled") == 0);
+    }
+
+    cout << "Nested scopes and parallel regions" << endl;
+    int num_steps = 5;
+    int team_size = 0;
+    {
+        ChTraceProfiler::Enable(true);
+        ChTraceProfiler::Clear();
+        for (int step = 0; step < num_steps; step++) {
+            {
+                CH_TRACE("step");
+                {
+                    CH_TRACE("inner");
+                    Work();
+                }
+#pragma omp parallel num_threads(4)
+                {
+                    CH_TRACE("parallel");
+                    Work();
+#pragma omp master
+                    team_size = CHOMPfunctions::GetNumThreads();
+                }
+            }
+            ChTraceProfiler::NextStep();
+        }
+        ChTraceProfiler::Enable(false);
+
+        cout << "  threads: " << ChTraceProfiler::GetNumThreads() << "  team size: " << team_size << endl;
+        passed &= (CountEvents("step") == num_steps);
+        passed &= (CountEvents("inner") == num_steps);
+        passed &= (CountEvents("parallel") == num_steps * team_size);
+        passed &= (ChTraceProfiler::GetNumThreads() >= team_size);
+
+        // Check timestamps, nesting levels and steps.
+        for (int thread = 0; thread < ChTraceProfiler::GetNumThreads(); thread++) {
+            for (const auto& event : ChTraceProfiler::GetEvents(thread)) {
+                std::string name(event.name);
+                passed &= (event.end >= event.start);
+                passed &= (event.step >= 0 && event.step < num_steps);
+                if (name == "inner")
+                    passed &= (event.depth == 1);
+                if (name == "step")
+                    passed &= (event.depth == 0);
+            }
+        }
+    }
+
+    cout << "Export" << endl;
+    {
+        passed &= ChTraceProfiler::ExportChromeTrace("utest_trace.json");
+        passed &= ChTraceProfiler::ExportCSV("utest_trace.csv");
+
+        std::ifstream json("utest_trace.json");
+        std::stringstream json_text;
+        json_text << json.rdbuf();
+        passed &= (json_text.str().find("{\"traceEvents\":[") == 0);
+        passed &= (json_text.str().find("\"name\":\"parallel\"") != std::string::npos);
+
+        // One row for each scope at each step.
+        std::ifstream csv("utest_trace.csv");
+        std::string line;
+        std::getline(csv, line);
+        passed &= (line == "step,name,calls,total_ms,max_ms");
+        int rows = 0;
+        while (std::getline(csv, line))
+            rows++;
+        cout << "  CSV rows: " << rows << endl;
+        passed &= (rows == 3 * num_steps);
+    }
+
+    cout << "Ring buffer overflow" << endl;
+    {
+        ChTraceProfiler::SetBufferCapacity(8);
+        ChTraceProfiler::Enable(true);
+        static const char* names[] = {"e0", "e1", "e2", "e3", "e4", "e5", "e6", "e7", "e8", "e9"};
+        for (int i = 0; i < 20; i++) {
+            CH_TRACE(names[i % 10]);
+        }
+        ChTraceProfiler::Enable(false);
+
+        bool found = false;
+        for (int thread = 0; thread < ChTraceProfiler::GetNumThreads(); thread++) {
+            auto events = ChTraceProfiler::GetEvents(thread);
+            if (events.empty())
+                continue;
+            found = true;
+            // The 8 newest events are kept, in order.
+            passed &= (events.size() == 8);
+            passed &= (ChTraceProfiler::GetNumLostEvents(thread) == 12);
+            passed &= (std::string(events.front().name) == "e2" && std::string(events.back().name) == "e9");
+        }
+        passed &= found;
+    }
+
+    cout << (passed ? "PASSED" : "FAILED") << endl;
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
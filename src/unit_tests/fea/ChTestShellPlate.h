@@ -0,0 +1,97 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Helpers shared by the FEA unit tests and benchmarks that use a plate of ANCF
+// shell elements.
+//
+// =============================================================================
+
+#ifndef CHTESTSHELLPLATE_H
+#define CHTESTSHELLPLATE_H
+
+#include <cmath>
+
+#include "chrono/physics/ChSystem.h"
+
+#include "chrono_fea/ChElementShellANCF.h"
+#include "chrono_fea/ChMesh.h"
+
+namespace chrono {
+namespace fea {
+
+/// Create a square plate (side 1, thickness 0.01) of num_div x num_div ANCF shell elements, clamped along the
+/// edge x = 0, without gravity, and add it to the system.
+inline std::shared_ptr<ChMesh> CreateShellPlate(ChSystem& system, int num_div) {
+    auto mesh = std::make_shared<ChMesh>();
+
+    double dx = 1.0 / num_div;
+    int N = num_div + 1;
+    for (int j = 0; j < N; j++) {
+        for (int i = 0; i < N; i++) {
+            auto node = std::make_shared<ChNodeFEAxyzD>(ChVector<>(i * dx, j * dx, 0), ChVector<>(0, 0, 1));
+            node->SetMass(0);
+            node->SetFixed(i == 0);
+            mesh->AddNode(node);
+        }
+    }
+
+    auto mat = std::make_shared<ChMaterialShellANCF>(500, 2.1e8, 0.3);
+    for (int j = 0; j < num_div; j++) {
+        for (int i = 0; i < num_div; i++) {
+            auto element = std::make_shared<ChElementShellANCF>();
+            element->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(j * N + i)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(j * N + i + 1)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode((j + 1) * N + i + 1)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode((j + 1) * N + i)));
+            element->SetDimensions(dx, dx);
+            element->AddLayer(0.01, 0, mat);
+            element->SetAlphaDamp(0.08);
+            element->SetGravityOn(false);
+            mesh->AddElement(element);
+        }
+    }
+    mesh->SetAutomaticGravity(false);
+    system.Add(mesh);
+
+    return mesh;
+}
+
+/// Deform a plate created by CreateShellPlate (after the initial setup of the system), so that the internal forces
+/// and the Jacobians are not null and differ from element to element.
+inline void DeformShellPlate(ChSystem& system, std::shared_ptr<ChMesh> mesh, int num_div) {
+    double dx = 1.0 / num_div;
+    for (unsigned int in = 0; in < mesh->GetNnodes(); in++) {
+        auto node = std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(in));
+        ChVector<> pos = node->GetPos();
+        node->SetPos(pos + ChVector<>(0.01 * dx * std::sin(7 * pos.y()), 0, 0.1 * pos.x() * pos.x()));
+        node->SetD(ChVector<>(-0.2 * pos.x(), 0, 1).GetNormalized());
+    }
+    system.Setup();
+    system.Update();
+}
+
+/// Return the largest difference between the n values of a and of the reference b, relative to the largest
+/// absolute value of b (not finite if all the values of b are null).
+inline double MaxRelativeDifference(const double* a, const double* b, int n) {
+    double max_diff = 0;
+    double max_val = 0;
+    for (int i = 0; i < n; i++) {
+        max_diff = ChMax(max_diff, std::abs(a[i] - b[i]));
+        max_val = ChMax(max_val, std::abs(b[i]));
+    }
+    return max_diff / max_val;
+}
+
+}  // end namespace fea
+}  // end namespace chrono
+
+#endif
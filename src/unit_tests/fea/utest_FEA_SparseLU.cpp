@@ -0,0 +1,266 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Comparison of the built-in sparse direct solver (ChSolverSparseLU) with
+// MINRES on an ANCF shell plate (as in demo_FEA_ancfShell), integrated with HHT.
+// The nodes on one edge of the plate are pinned to ground with ChLinkPointFrame
+// constraints, so that the direct solver works on a saddle-point matrix.
+// The test checks that both solvers give the same tip displacement, that the
+// direct solver reuses its cached matrix layout and symbolic factorization
+// (the topology of the system never changes) and reports the time spent in
+// the solvers. This is repeated with both fill-reducing orderings (AMD and
+// RCM), and with a redundant constraint (solved with the static perturbation
+// of the pivots).
+// Finally, the fill-in of the two orderings is compared on the 3D Laplacian.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChSolverMINRES.h"
+#include "chrono/solver/ChSolverSparseLU.h"
+#include "chrono_fea/ChElementShellANCF.h"
+#include "chrono_fea/ChLinkPointFrame.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const int numDiv_x = 16;
+const int numDiv_y = 4;
+const int num_steps = 50;
+const double time_step = 1e-3;
+
+enum class SolverType { MINRES, SPARSE_LU };
+
+bool cache_ok = true;
+
+ChVector<> Simulate(SolverType solver_type,
+                    ChSparseLUEngine::Ordering ordering = ChSparseLUEngine::Ordering::AMD,
+                    bool redundant = false) {
+    ChSystemSMC my_system;
+    my_system.Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    auto my_mesh = std::make_shared<ChMesh>();
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    my_system.Add(ground);
+
+    // Geometry of the plate
+    double plate_lenght_x = 1;
+    double plate_lenght_y = 0.2;
+    double plate_lenght_z = 0.01;
+    int N_x = numDiv_x + 1;
+    int TotalNumElements = numDiv_x * numDiv_y;
+    int TotalNumNodes = (numDiv_x + 1) * (numDiv_y + 1);
+    double dx = plate_lenght_x / numDiv_x;
+    double dy = plate_lenght_y / numDiv_y;
+    double dz = plate_lenght_z;
+
+    // Create the nodes; pin the nodes along the axis X=0
+    for (int i = 0; i < TotalNumNodes; i++) {
+        double loc_x = (i % N_x) * dx;
+        double loc_y = (i / N_x) * dy;
+        auto node = std::make_shared<ChNodeFEAxyzD>(ChVector<>(loc_x, loc_y, 0), ChVector<>(0, 0, 1));
+        node->SetMass(0);
+        my_mesh->AddNode(node);
+
+        if (i % N_x == 0) {
+            auto constraint = std::make_shared<ChLinkPointFrame>();
+            constraint->Initialize(node, ground);
+            my_system.Add(constraint);
+        }
+
+        // Optionally pin the first node twice
+        if (i == 0 && redundant) {
+            auto constraint = std::make_shared<ChLinkPointFrame>();
+            constraint->Initialize(node, ground);
+            my_system.Add(constraint);
+        }
+    }
+
+    auto nodetip = std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(TotalNumNodes - 1));
+
+    double rho = 500;
+    ChVector<> E(2.1e7, 2.1e7, 2.1e7);
+    ChVector<> nu(0.3, 0.3, 0.3);
+    ChVector<> G(8.0769231e6, 8.0769231e6, 8.0769231e6);
+    auto mat = std::make_shared<ChMaterialShellANCF>(rho, E, nu, G);
+
+    for (int i = 0; i < TotalNumElements; i++) {
+        int node0 = (i / numDiv_x) * N_x + i % numDiv_x;
+        int node1 = node0 + 1;
+        int node2 = node0 + 1 + N_x;
+        int node3 = node0 + N_x;
+
+        auto element = std::make_shared<ChElementShellANCF>();
+        element->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(node0)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(node1)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(node2)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(node3)));
+        element->SetDimensions(dx, dy);
+        element->AddLayer(dz, 0 * CH_C_DEG_TO_RAD, mat);
+        element->SetAlphaDamp(0.0);
+        element->SetGravityOn(false);
+        my_mesh->AddElement(element);
+    }
+
+    my_system.Add(my_mesh);
+
+    // Set up solver
+    std::shared_ptr<ChSolver> solver;
+    if (solver_type == SolverType::MINRES) {
+        my_system.SetSolverType(ChSolver::Type::MINRES);
+        auto msolver = std::static_pointer_cast<ChSolverMINRES>(my_system.GetSolver());
+        msolver->SetDiagonalPreconditioning(true);
+        my_system.SetSolverWarmStarting(true);
+        my_system.SetMaxItersSolverSpeed(1000);
+        my_system.SetTolForce(1e-12);
+        solver = msolver;
+    } else {
+        auto lu_solver = std::make_shared<ChSolverSparseLU>();
+        lu_solver->GetEngine().SetOrdering(ordering);
+        if (redundant)
+            lu_solver->GetEngine().SetPivotPerturbation(1e-10);
+        my_system.SetSolver(lu_solver);
+        solver = lu_solver;
+    }
+
+    // Set up integrator
+    my_system.SetTimestepperType(ChTimestepper::Type::HHT);
+    auto mystepper = std::static_pointer_cast<ChTimestepperHHT>(my_system.GetTimestepper());
+    mystepper->SetAlpha(-0.2);
+    mystepper->SetMaxiters(100);
+    mystepper->SetAbsTolerances(1e-8);
+    mystepper->SetMode(ChTimestepperHHT::POSITION);
+    mystepper->SetScaling(true);
+
+    my_system.SetupInitial();
+
+    double time = 0;
+    int num_iterations = 0;
+    for (int it = 0; it < num_steps; it++) {
+        my_system.DoStepDynamics(time_step);
+        time += my_system.GetTimerSolver() + my_system.GetTimerSetup();
+        num_iterations += mystepper->GetNumIterations();
+    }
+
+    std::cout << "  tip position: " << nodetip->GetPos().z() << "  Newton iterations: " << num_iterations
+              << "  solver time: " << time << std::endl;
+
+    if (auto lu_solver = std::dynamic_pointer_cast<ChSolverSparseLU>(solver)) {
+        std::cout << "  setup calls: " << lu_solver->GetNumSetupCalls()
+                  << "  symbolic factorizations: " << lu_solver->GetNumAnalysisCalls()
+                  << "  nnz(L): " << lu_solver->GetEngine().GetFactorNNZ()
+                  << "  perturbed pivots: " << lu_solver->GetEngine().GetNumPerturbedPivots() << std::endl;
+        std::cout << "  cache hits: " << lu_solver->GetNumCacheHits()
+                  << "  cache misses: " << lu_solver->GetNumCacheMisses() << std::endl;
+        std::cout << "  assembly: " << lu_solver->GetTimeSetup_Assembly()
+                  << "  analysis: " << lu_solver->GetTimeSetup_Analysis()
+                  << "  factorization: " << lu_solver->GetTimeSetup_Factorization()
+                  << "  solve: " << lu_solver->GetTimeSolve_SolverCall() << std::endl;
+
+        cache_ok = lu_solver->GetNumAnalysisCalls() == 1 && lu_solver->GetNumCacheMisses() == 1 &&
+                   lu_solver->GetNumCacheHits() == lu_solver->GetNumSetupCalls() - 1;
+    }
+
+    return nodetip->GetPos();
+}
+
+// Factorize the 7-point finite difference Laplacian on a N x N x N grid (shifted, so that it is positive definite)
+// and return the number of nonzeros in L, or -1 if the solution is not accurate.
+int FactorizeLaplacian(ChSparseLUEngine::Ordering ordering) {
+    const int N = 12;
+    int n = N * N * N;
+
+    ChCSMatrix mat(n, n);
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            for (int k = 0; k < N; k++) {
+                int row = (i * N + j) * N + k;
+                mat.SetElement(row, row, 6.1);
+                if (i > 0)
+                    mat.SetElement(row, row - N * N, -1);
+                if (i < N - 1)
+                    mat.SetElement(row, row + N * N, -1);
+                if (j > 0)
+                    mat.SetElement(row, row - N, -1);
+                if (j < N - 1)
+                    mat.SetElement(row, row + N, -1);
+                if (k > 0)
+                    mat.SetElement(row, row - 1, -1);
+                if (k < N - 1)
+                    mat.SetElement(row, row + 1, -1);
+            }
+        }
+    }
+    mat.Compress();
+
+    ChSparseLUEngine engine;
+    engine.SetSymmetric(true);
+    engine.SetOrdering(ordering);
+    engine.Analyze(mat);
+    if (!engine.Factorize(mat))
+        return -1;
+
+    ChMatrixDynamic<double> b(n, 1);
+    ChMatrixDynamic<double> x(n, 1);
+    for (int i = 0; i < n; i++)
+        b(i) = std::sin(0.1 * i);
+    engine.Solve(b, x);
+
+    ChMatrixDynamic<double> r(n, 1);
+    mat.MatrMultiply(x, r);
+    r -= b;
+    double res = r.NormTwo() / b.NormTwo();
+
+    std::cout << "  nnz(L): " << engine.GetFactorNNZ() << "  residual: " << res << std::endl;
+    return res < 1e-12 ? engine.GetFactorNNZ() : -1;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    std::cout << "MINRES" << std::endl;
+    ChVector<> pos_minres = Simulate(SolverType::MINRES);
+    double displ = std::abs(pos_minres.z());
+
+    std::cout << "SparseLU (AMD)" << std::endl;
+    ChVector<> pos_lu = Simulate(SolverType::SPARSE_LU, ChSparseLUEngine::Ordering::AMD);
+    double diff = (pos_minres - pos_lu).Length();
+    std::cout << "Difference in tip position: " << diff << std::endl;
+    passed &= diff <= 1e-4 * displ && cache_ok;
+
+    std::cout << "SparseLU (RCM)" << std::endl;
+    pos_lu = Simulate(SolverType::SPARSE_LU, ChSparseLUEngine::Ordering::RCM);
+    diff = (pos_minres - pos_lu).Length();
+    std::cout << "Difference in tip position: " << diff << std::endl;
+    passed &= diff <= 1e-4 * displ && cache_ok;
+
+    std::cout << "SparseLU (redundant constraint)" << std::endl;
+    pos_lu = Simulate(SolverType::SPARSE_LU, ChSparseLUEngine::Ordering::AMD, true);
+    diff = (pos_minres - pos_lu).Length();
+    std::cout << "Difference in tip position: " << diff << std::endl;
+    passed &= diff <= 1e-4 * displ && cache_ok;
+
+    std::cout << "3D Laplacian (AMD)" << std::endl;
+    int nnz_amd = FactorizeLaplacian(ChSparseLUEngine::Ordering::AMD);
+    std::cout << "3D Laplacian (RCM)" << std::endl;
+    int nnz_rcm = FactorizeLaplacian(ChSparseLUEngine::Ordering::RCM);
+    passed &= nnz_amd > 0 && nnz_rcm > 0 && nnz_amd < nnz_rcm;
+
+    // Return 0 if the test passed.
+    return passed ? 0 : 1;
+}
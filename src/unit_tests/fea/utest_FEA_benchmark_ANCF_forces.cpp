@@ -0,0 +1,224 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark for the evaluation of the internal forces of the ANCF elements
+// integrated with Gauss quadrature (ChElementShellANCF, ChElementBrick_9 and
+// ChElementBeamANCF, for each of their strain formulations; the shell element
+// with and without precomputed reference configuration terms).
+// A single element of each type is deformed and given nodal velocities, then
+// ComputeInternalForces is called repeatedly (20000 times by default, or N
+// times with N passed on the command line). The time per call is reported, and
+// the internal forces must match reference values computed with the original
+// implementation of the elements, up to round-off.
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_fea/ChElementBeamANCF.h"
+#include "chrono_fea/ChElementBrick_9.h"
+#include "chrono_fea/ChElementShellANCF.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+using namespace std;
+
+int num_repeat = 20000;
+
+// Time the evaluation of the internal forces of the element, and compare them with the reference values
+// (norm and first entry of the internal force vector).
+bool TimeElement(const string& name, std::shared_ptr<ChElementBase> element, double ref_norm, double ref_first) {
+    ChMatrixDynamic<> Fi(element->GetNdofs(), 1);
+    element->ComputeInternalForces(Fi);
+    double norm = Fi.NormTwo();
+    double first = Fi(0, 0);
+
+    ChTimer<double> timer;
+    timer.start();
+    for (int r = 0; r < num_repeat; r++)
+        element->ComputeInternalForces(Fi);
+    timer.stop();
+
+    bool passed = std::abs(norm - ref_norm) <= 1e-10 * std::abs(ref_norm) &&
+                  std::abs(first - ref_first) <= 1e-10 * std::abs(ref_norm);
+    cout.precision(17);
+    cout << name << ": " << timer() * 1e6 / num_repeat << " us per call  |Fi|: " << norm << "  Fi(0): " << first
+         << (passed ? "" : "  MISMATCH") << endl;
+    return passed;
+}
+
+bool TestShell(ChSystem& system, bool precompute, const string& name) {
+    auto mesh = std::make_shared<ChMesh>();
+    double dx = 0.1;
+    ChVector<> pos[4] = {ChVector<>(0, 0, 0), ChVector<>(dx, 0, 0), ChVector<>(dx, dx, 0), ChVector<>(0, dx, 0)};
+    std::shared_ptr<ChNodeFEAxyzD> nodes[4];
+    for (int i = 0; i < 4; i++) {
+        nodes[i] = std::make_shared<ChNodeFEAxyzD>(pos[i], ChVector<>(0, 0, 1));
+        mesh->AddNode(nodes[i]);
+    }
+
+    auto mat = std::make_shared<ChMaterialShellANCF>(500, 2.1e8, 0.3);
+    auto element = std::make_shared<ChElementShellANCF>();
+    element->SetNodes(nodes[0], nodes[1], nodes[2], nodes[3]);
+    element->SetDimensions(dx, dx);
+    element->AddLayer(0.005, 0, mat);
+    element->AddLayer(0.005, 20 * CH_C_DEG_TO_RAD, mat);
+    element->SetAlphaDamp(0.08);
+    element->SetGravityOn(false);
+    element->SetPrecomputeReferenceData(precompute);
+    mesh->AddElement(element);
+    system.Add(mesh);
+    system.SetupInitial();
+
+    if (precompute)
+        cout << name << ": precomputed reference data " << element->GetReferenceDataSize() << " bytes per element"
+             << endl;
+
+    for (int i = 0; i < 4; i++) {
+        nodes[i]->SetPos(pos[i] + ChVector<>(0.002 * i, 0.001 * pos[i].x(), 0.3 * pos[i].x() * pos[i].x()));
+        nodes[i]->SetD(ChVector<>(-0.5 * pos[i].x(), 0.01 * i, 1).GetNormalized());
+        nodes[i]->SetPos_dt(ChVector<>(0.1 * i, 0, 0.2));
+        nodes[i]->SetD_dt(ChVector<>(0, 0.05 * i, 0));
+    }
+
+    return TimeElement(name, element, 24515.676953684768, 12877.270324439523);
+}
+
+bool TestBrick9(ChSystem& system,
+                ChElementBrick_9::StrainFormulation formulation,
+                const string& name,
+                double ref_norm,
+                double ref_first) {
+    auto mesh = std::make_shared<ChMesh>();
+    ChVector<> dims(0.1, 0.1, 0.02);
+    std::shared_ptr<ChNodeFEAxyz> nodes[8];
+    for (int i = 0; i < 8; i++) {
+        ChVector<> pos(((i + 1) / 2 % 2) * dims.x(), (i / 2 % 2) * dims.y(), (i / 4) * dims.z());
+        nodes[i] = std::make_shared<ChNodeFEAxyz>(pos);
+        mesh->AddNode(nodes[i]);
+    }
+    auto central = std::make_shared<ChNodeFEAcurv>(VNULL, VNULL, VNULL);
+    mesh->AddNode(central);
+
+    auto mat = std::make_shared<ChContinuumElastic>();
+    mat->Set_density(500);
+    mat->Set_E(2.1e8);
+    mat->Set_G(8.0769231e7);
+    mat->Set_v(0.3);
+    auto element = std::make_shared<ChElementBrick_9>();
+    element->SetNodes(nodes[0], nodes[1], nodes[2], nodes[3], nodes[4], nodes[5], nodes[6], nodes[7], central);
+    element->SetDimensions(dims);
+    element->SetMaterial(mat);
+    element->SetAlphaDamp(0.1);
+    element->SetGravityOn(false);
+    element->SetStrainFormulation(formulation);
+    element->SetPlasticity(false);
+    mesh->AddElement(element);
+    system.Add(mesh);
+    system.SetupInitial();
+
+    for (int i = 0; i < 8; i++) {
+        ChVector<> pos = nodes[i]->GetPos();
+        nodes[i]->SetPos(pos + ChVector<>(0.001 * i, -0.002 * pos.z(), 0.2 * pos.x() * pos.x()));
+        nodes[i]->SetPos_dt(ChVector<>(0.01 * i, 0, -0.02));
+    }
+    central->SetCurvatureXX(ChVector<>(0, 0, 0.4));
+    central->SetCurvatureYY(ChVector<>(0.01, 0, 0));
+    central->SetCurvatureXX_dt(ChVector<>(0, 0.1, 0));
+
+    return TimeElement(name, element, ref_norm, ref_first);
+}
+
+bool TestBeam(ChSystem& system,
+              ChElementBeamANCF::StrainFormulation formulation,
+              const string& name,
+              double ref_norm,
+              double ref_first) {
+    auto mesh = std::make_shared<ChMesh>();
+    double length = 0.5;
+    std::shared_ptr<ChNodeFEAxyzDD> nodes[3];
+    for (int i = 0; i < 3; i++) {
+        nodes[i] = std::make_shared<ChNodeFEAxyzDD>(ChVector<>(i * length / 2, 0, 0), ChVector<>(0, 1, 0),
+                                                    ChVector<>(0, 0, 1));
+        mesh->AddNode(nodes[i]);
+    }
+
+    double nu = 0.3;
+    double k = 10 * (1 + nu) / (12 + 11 * nu);
+    auto mat = std::make_shared<ChMaterialBeamANCF>(2000, 2.07e11, nu, k, k);
+    auto element = std::make_shared<ChElementBeamANCF>();
+    element->SetNodes(nodes[0], nodes[2], nodes[1]);
+    element->SetDimensions(length, 0.05, 0.02);
+    element->SetMaterial(mat);
+    element->SetAlphaDamp(0.0004);
+    element->SetGravityOn(false);
+    element->SetStrainFormulation(formulation);
+    mesh->AddElement(element);
+    system.Add(mesh);
+    system.SetupInitial();
+
+    for (int i = 0; i < 3; i++) {
+        ChVector<> pos = nodes[i]->GetPos();
+        nodes[i]->SetPos(pos + ChVector<>(0.001 * i, 0.05 * pos.x() * pos.x(), 0.01 * pos.x()));
+        nodes[i]->SetD(ChVector<>(-0.1 * pos.x(), 1, 0.02 * i).GetNormalized());
+        nodes[i]->SetDD(ChVector<>(0, -0.01 * i, 1).GetNormalized());
+        nodes[i]->SetPos_dt(ChVector<>(0, 0.1 * i, 0));
+        nodes[i]->SetD_dt(ChVector<>(0.02 * i, 0, 0));
+    }
+
+    return TimeElement(name, element, ref_norm, ref_first);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1)
+        num_repeat = atoi(argv[1]);
+
+    bool passed = true;
+    {
+        ChSystemNSC system;
+        passed &= TestShell(system, false, "ShellANCF");
+    }
+    {
+        ChSystemNSC system;
+        passed &= TestShell(system, true, "ShellANCF (precomputed)");
+    }
+    {
+        ChSystemNSC system;
+        passed &= TestBrick9(system, ChElementBrick_9::GreenLagrange, "Brick_9 (Green-Lagrange)",  //
+                             297592.84259176318, 103341.50213782067);
+    }
+    {
+        ChSystemNSC system;
+        passed &= TestBrick9(system, ChElementBrick_9::Hencky, "Brick_9 (Hencky)",  //
+                             246707.94029840812, 82577.969022957725);
+    }
+    {
+        ChSystemNSC system;
+        passed &= TestBeam(system, ChElementBeamANCF::CMPoisson, "BeamANCF (Poisson)",  //
+                           2103884.7770165061, 1136315.7853063527);
+    }
+    {
+        ChSystemNSC system;
+        passed &= TestBeam(system, ChElementBeamANCF::CMNoPoisson, "BeamANCF (no Poisson)",  //
+                           1701605.6200552555, 844345.26946233248);
+    }
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
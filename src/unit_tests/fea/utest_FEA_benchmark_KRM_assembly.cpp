@@ -0,0 +1,127 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark for the parallel evaluation of the element Jacobians and for the
+// parallel assembly of the K blocks in the system matrix
+// (see ChSystemDescriptor::SetUseParallelKblocks).
+// A deformed plate of ANCF shell elements (30x30 elements by default, or NxN
+// with N passed on the command line) is assembled in a CSR matrix with locked
+// sparsity pattern, as done by the direct solvers at each step. Timings of the
+// Jacobian evaluation (ChMesh::KRMmatricesLoad) and of the matrix assembly are
+// reported versus the number of threads; the matrices assembled in parallel must
+// be bitwise identical for any number of threads, and must match the sequential
+// assembly up to round-off.
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "chrono/core/ChCSMatrix.h"
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "ChTestShellPlate.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+using namespace std;
+
+// System exposing the setup of the system descriptor, as done by the timesteppers.
+class ChSystemKRM : public ChSystemNSC {
+  public:
+    using ChSystem::DescriptorPrepareInject;
+};
+
+int main(int argc, char* argv[]) {
+    int num_div = (argc > 1) ? atoi(argv[1]) : 30;
+    const int num_repeat = 5;
+
+    ChSystemKRM system;
+    auto mesh = CreateShellPlate(system, num_div);
+    system.SetupInitial();
+    DeformShellPlate(system, mesh, num_div);
+
+    // The ANCF shell elements compute their Jacobians from data set by the evaluation of the internal forces.
+    ChVectorDynamic<> R(system.GetNcoords_w());
+    mesh->IntLoadResidual_F(0, R, 1.0);
+
+    ChSystemDescriptor& sysd = *system.GetSystemDescriptor();
+    system.DescriptorPrepareInject(sysd);
+    system.KRMmatricesLoad(1.0, 0.1, 0.01);
+    int dim = sysd.CountActiveVariables() + sysd.CountActiveConstraints();
+    cout << "Elements: " << mesh->GetNelements() << "  matrix size: " << dim << endl;
+
+    // First assembly: learn the sparsity pattern.
+    ChCSMatrix Z(dim, dim);
+    Z.SetSparsityPatternLock(true);
+    sysd.SetUseParallelKblocks(false);
+    sysd.ConvertToMatrixForm(&Z, nullptr);
+    Z.Compress();
+    int nnz = Z.GetTrailingIndexLength();
+    cout << "Non-zeros: " << nnz << endl;
+
+    ChTimer<double> timer;
+
+    // Sequential assembly.
+    timer.start();
+    for (int r = 0; r < num_repeat; r++) {
+        Z.Reset(dim, dim);
+        sysd.ConvertToMatrixForm(&Z, nullptr);
+    }
+    timer.stop();
+    double time_serial = timer() / num_repeat;
+    std::vector<double> values_serial(Z.GetCS_ValueArray(), Z.GetCS_ValueArray() + nnz);
+    cout << "Sequential assembly: " << time_serial * 1e3 << " ms" << endl;
+
+    // Parallel assembly, color by color.
+    bool passed = true;
+    std::vector<double> values_ref;
+    sysd.SetUseParallelKblocks(true);
+    int max_threads = CHOMPfunctions::GetNumProcs();
+    for (int nthreads = 1; nthreads <= ChMax(max_threads, 2); nthreads *= 2) {
+        system.SetParallelThreadNumber(nthreads);
+
+        mesh->ResetTimers();
+        for (int r = 0; r < num_repeat; r++)
+            system.KRMmatricesLoad(1.0, 0.1, 0.01);
+        double time_jacobians = mesh->GetTimeJacobianLoad() / num_repeat;
+
+        timer.reset();
+        timer.start();
+        for (int r = 0; r < num_repeat; r++) {
+            Z.Reset(dim, dim);
+            sysd.ConvertToMatrixForm(&Z, nullptr);
+        }
+        timer.stop();
+        double time = timer() / num_repeat;
+        std::vector<double> values(Z.GetCS_ValueArray(), Z.GetCS_ValueArray() + nnz);
+
+        if (nthreads == 1) {
+            values_ref = values;
+            double diff = MaxRelativeDifference(values.data(), values_serial.data(), nnz);
+            cout << "K block colors: " << sysd.GetNumKblockColors()
+                 << "  max. difference from sequential: " << diff << " (relative)" << endl;
+            passed &= (sysd.GetNumKblockColors() > 0) && (diff <= 1e-12);
+        }
+        bool same = (values == values_ref) && (Z.GetTrailingIndexLength() == nnz);
+        passed &= same;
+        cout << "Threads: " << nthreads << "  Jacobians: " << time_jacobians * 1e3
+             << " ms  assembly: " << time * 1e3 << " ms  speedup: " << time_serial / time
+             << "  identical to 1 thread: " << (same ? "yes" : "NO") << endl;
+    }
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,95 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark for the parallel evaluation of the internal forces in ChMesh
+// (see ChMesh::SetUseParallelInternalForces).
+// A deformed plate of ANCF shell elements (100x100 elements by default, or NxN
+// with N passed on the command line) is assembled sequentially, then in parallel
+// with an increasing number of threads. Timings are reported; the parallel
+// results must be bitwise identical for any number of threads, and must match
+// the sequential results up to round-off.
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "ChTestShellPlate.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int num_div = (argc > 1) ? atoi(argv[1]) : 100;
+    const int num_repeat = 5;
+
+    ChSystemNSC system;
+    auto mesh = CreateShellPlate(system, num_div);
+    system.SetupInitial();
+    DeformShellPlate(system, mesh, num_div);
+
+    int nv = system.GetNcoords_w();
+    cout << "Elements: " << mesh->GetNelements() << "  DOFs: " << nv << endl;
+
+    ChTimer<double> timer;
+    ChVectorDynamic<> R_serial(nv);
+    ChVectorDynamic<> R_ref(nv);
+    ChVectorDynamic<> R(nv);
+
+    // Sequential evaluation.
+    mesh->SetUseParallelInternalForces(false);
+    timer.start();
+    for (int r = 0; r < num_repeat; r++) {
+        R_serial.Reset();
+        mesh->IntLoadResidual_F(0, R_serial, 1.0);
+    }
+    timer.stop();
+    double time_serial = timer() / num_repeat;
+    cout << "Sequential: " << time_serial * 1e3 << " ms" << endl;
+
+    // Parallel evaluation, color by color.
+    bool passed = true;
+    mesh->SetUseParallelInternalForces(true);
+    int max_threads = CHOMPfunctions::GetNumProcs();
+    for (int nthreads = 1; nthreads <= ChMax(max_threads, 2); nthreads *= 2) {
+        system.SetParallelThreadNumber(nthreads);
+
+        timer.reset();
+        timer.start();
+        for (int r = 0; r < num_repeat; r++) {
+            R.Reset();
+            mesh->IntLoadResidual_F(0, R, 1.0);
+        }
+        timer.stop();
+        double time = timer() / num_repeat;
+
+        if (nthreads == 1) {
+            R_ref = R;
+            double diff = MaxRelativeDifference(R.GetAddress(), R_serial.GetAddress(), nv);
+            cout << "Colors: " << mesh->GetNumElementColors()
+                 << "  max. difference from sequential: " << diff << " (relative)" << endl;
+            passed &= (diff <= 1e-12);
+        }
+        bool same = R.Equals(R_ref, 0);
+        passed &= same;
+        cout << "Threads: " << nthreads << "  parallel: " << time * 1e3 << " ms  speedup: " << time_serial / time
+             << "  identical to 1 thread: " << (same ? "yes" : "NO") << endl;
+    }
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,306 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the cached and lumped mass matrices of ChElementGeneric
+// (see ChElementGeneric::HasConstantMass and ChElementGeneric::SetLumpedMass).
+// - the M*w products of ANCF cable, ANCF shell and tetrahedron elements must match
+//   the products with the mass matrices computed by the elements;
+// - the lumped mass matrix of an ANCF cable must preserve the mass of the element;
+// - a swinging ANCF cable must follow about the same trajectory with the lumped
+//   and with the consistent mass matrices.
+// Timings of the products are reported.
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverMINRES.h"
+
+#include "chrono_fea/ChElementCableANCF.h"
+#include "chrono_fea/ChElementShellANCF.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChLinkPointFrame.h"
+#include "chrono_fea/ChMesh.h"
+
+#include "ChTestShellPlate.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+using namespace std;
+
+// Reference: add c*M*w through the mass matrix computed by the element (fixed nodes excluded).
+void ReferenceMv(ChElementBase& element, ChVectorDynamic<>& R, const ChVectorDynamic<>& w, double c) {
+    int n = element.GetNdofs();
+    ChMatrixDynamic<> M(n, n);
+    element.ComputeMmatrixGlobal(M);
+
+    ChMatrixDynamic<> wi(n, 1);
+    int stride = 0;
+    for (int in = 0; in < element.GetNnodes(); in++) {
+        int nodedofs = element.GetNodeNdofs(in);
+        if (!element.GetNodeN(in)->GetFixed())
+            wi.PasteClippedMatrix(w, element.GetNodeN(in)->NodeGetOffset_w(), 0, nodedofs, 1, stride, 0);
+        stride += nodedofs;
+    }
+
+    ChMatrixDynamic<> fi(n, 1);
+    fi.MatrMultiply(M, wi);
+    fi.MatrScale(c);
+
+    stride = 0;
+    for (int in = 0; in < element.GetNnodes(); in++) {
+        int nodedofs = element.GetNodeNdofs(in);
+        if (!element.GetNodeN(in)->GetFixed())
+            R.PasteSumClippedMatrix(fi, stride, 0, nodedofs, 1, element.GetNodeN(in)->NodeGetOffset_w(), 0);
+        stride += nodedofs;
+    }
+}
+
+// Compare the M*w products of all the elements of the mesh with the reference ones.
+bool TestProducts(const std::string& name, ChSystem& system, std::shared_ptr<ChMesh> mesh) {
+    system.SetupInitial();
+    system.Setup();
+    system.Update();
+
+    int nv = system.GetNcoords_w();
+    ChVectorDynamic<> w(nv);
+    for (int i = 0; i < nv; i++)
+        w(i) = std::rand() / (double)RAND_MAX - 0.5;
+
+    const int num_repeat = 20;
+    ChVectorDynamic<> R_ref(nv);
+    ChVectorDynamic<> R(nv);
+    ChTimer<double> timer_ref;
+    ChTimer<double> timer;
+
+    timer_ref.start();
+    for (int r = 0; r < num_repeat; r++) {
+        R_ref.Reset();
+        for (unsigned int ie = 0; ie < mesh->GetNelements(); ie++)
+            ReferenceMv(*mesh->GetElement(ie), R_ref, w, 0.5);
+    }
+    timer_ref.stop();
+
+    timer.start();
+    for (int r = 0; r < num_repeat; r++) {
+        R.Reset();
+        for (unsigned int ie = 0; ie < mesh->GetNelements(); ie++)
+            mesh->GetElement(ie)->EleIntLoadResidual_Mv(R, w, 0.5);
+    }
+    timer.stop();
+
+    double max_diff = 0;
+    double max_val = 0;
+    for (int i = 0; i < nv; i++) {
+        max_diff = ChMax(max_diff, std::abs(R(i) - R_ref(i)));
+        max_val = ChMax(max_val, std::abs(R_ref(i)));
+    }
+
+    cout << name << "  elements: " << mesh->GetNelements() << "  M*w reference: " << timer_ref() * 1e3 / num_repeat
+         << " ms  cached: " << timer() * 1e3 / num_repeat << " ms  max. difference: " << max_diff / max_val
+         << " (relative)" << endl;
+
+    return (max_val > 0) && (max_diff <= 1e-12 * max_val);
+}
+
+// ANCF cable, ANCF shell and tetrahedron meshes.
+bool TestCable() {
+    ChSystemNSC system;
+    auto mesh = std::make_shared<ChMesh>();
+
+    auto section = std::make_shared<ChBeamSectionCable>();
+    section->SetDiameter(0.02);
+    section->SetYoungModulus(1e9);
+    section->SetDensity(8000);
+
+    int num_elements = 50;
+    std::shared_ptr<ChNodeFEAxyzD> prev;
+    for (int i = 0; i <= num_elements; i++) {
+        auto node = std::make_shared<ChNodeFEAxyzD>(ChVector<>(i * 1.0 / num_elements, 0, 0), ChVector<>(1, 0, 0));
+        node->SetFixed(i == 0);
+        mesh->AddNode(node);
+        if (prev) {
+            auto element = std::make_shared<ChElementCableANCF>();
+            element->SetNodes(prev, node);
+            element->SetSection(section);
+            mesh->AddElement(element);
+        }
+        prev = node;
+    }
+    mesh->SetAutomaticGravity(false);
+    system.Add(mesh);
+
+    return TestProducts("ANCF cable", system, mesh);
+}
+
+bool TestShell() {
+    ChSystemNSC system;
+    auto mesh = CreateShellPlate(system, 20);
+
+    return TestProducts("ANCF shell", system, mesh);
+}
+
+bool TestTetra() {
+    ChSystemNSC system;
+    auto mesh = std::make_shared<ChMesh>();
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e7);
+    material->Set_v(0.3);
+    material->Set_density(1000);
+
+    // Grid of cubes, each split in 5 tetrahedrons.
+    int n = 8;
+    double h = 0.1;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int k = 0; k <= n; k++)
+        for (int j = 0; j <= n; j++)
+            for (int i = 0; i <= n; i++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(i * h, j * h, k * h));
+                node->SetFixed(k == 0);
+                mesh->AddNode(node);
+                nodes.push_back(node);
+            }
+    auto id = [n](int i, int j, int k) { return (k * (n + 1) + j) * (n + 1) + i; };
+    const int tets[5][4] = {{0, 1, 3, 5}, {0, 3, 2, 6}, {0, 5, 4, 6}, {3, 5, 6, 7}, {0, 3, 6, 5}};
+    for (int k = 0; k < n; k++)
+        for (int j = 0; j < n; j++)
+            for (int i = 0; i < n; i++) {
+                int c[8];
+                for (int v = 0; v < 8; v++)
+                    c[v] = id(i + (v & 1), j + ((v >> 1) & 1), k + ((v >> 2) & 1));
+                for (int t = 0; t < 5; t++) {
+                    auto element = std::make_shared<ChElementTetra_4>();
+                    element->SetNodes(nodes[c[tets[t][0]]], nodes[c[tets[t][1]]], nodes[c[tets[t][2]]],
+                                      nodes[c[tets[t][3]]]);
+                    element->SetMaterial(material);
+                    mesh->AddElement(element);
+                }
+            }
+    mesh->SetAutomaticGravity(false);
+    system.Add(mesh);
+
+    return TestProducts("Tetrahedrons", system, mesh);
+}
+
+// The lumped mass matrix of an ANCF cable element must preserve its mass.
+bool TestLumpedMass() {
+    auto section = std::make_shared<ChBeamSectionCable>();
+    section->SetDiameter(0.02);
+    section->SetDensity(8000);
+
+    auto node1 = std::make_shared<ChNodeFEAxyzD>(ChVector<>(0, 0, 0), ChVector<>(1, 0, 0));
+    auto node2 = std::make_shared<ChNodeFEAxyzD>(ChVector<>(0.5, 0, 0), ChVector<>(1, 0, 0));
+    auto element = std::make_shared<ChElementCableANCF>();
+    element->SetNodes(node1, node2);
+    element->SetSection(section);
+    element->SetupInitial(nullptr);
+
+    ChMatrixDynamic<> Md;
+    element->ComputeLumpedMmatrixGlobal(Md);
+
+    double mass = section->Area * section->density * 0.5;
+    bool passed = true;
+    for (int i = 0; i < 3; i++) {
+        double lumped_mass = Md(i) + Md(6 + i);
+        passed &= std::abs(lumped_mass - mass) < 1e-12 * mass;
+    }
+    for (int i = 0; i < 12; i++)
+        passed &= Md(i) > 0;
+
+    cout << "Lumped cable mass: " << Md(0) + Md(6) << "  element mass: " << mass << endl;
+    return passed;
+}
+
+// Swing an ANCF cable, hinged at one end, with the consistent or the lumped mass matrices.
+ChVector<> SwingCable(bool lumped) {
+    ChSystemNSC system;
+    auto mesh = std::make_shared<ChMesh>();
+
+    auto section = std::make_shared<ChBeamSectionCable>();
+    section->SetDiameter(0.01);
+    section->SetYoungModulus(1e8);
+    section->SetDensity(2000);
+    section->SetI(CH_C_PI / 4.0 * std::pow(0.005, 4));
+
+    int num_elements = 10;
+    std::shared_ptr<ChNodeFEAxyzD> first;
+    std::shared_ptr<ChNodeFEAxyzD> prev;
+    for (int i = 0; i <= num_elements; i++) {
+        auto node = std::make_shared<ChNodeFEAxyzD>(ChVector<>(i * 1.0 / num_elements, 0, 0), ChVector<>(1, 0, 0));
+        mesh->AddNode(node);
+        if (prev) {
+            auto element = std::make_shared<ChElementCableANCF>();
+            element->SetNodes(prev, node);
+            element->SetSection(section);
+            element->SetLumpedMass(lumped);
+            mesh->AddElement(element);
+        } else {
+            first = node;
+        }
+        prev = node;
+    }
+    system.Add(mesh);
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.Add(ground);
+    auto hinge = std::make_shared<ChLinkPointFrame>();
+    hinge->Initialize(first, ground);
+    system.Add(hinge);
+
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetSolverType(ChSolver::Type::MINRES);
+    system.SetSolverWarmStarting(true);
+    system.SetMaxItersSolverSpeed(200);
+    system.SetMaxItersSolverStab(200);
+    system.SetTolForce(1e-13);
+    std::static_pointer_cast<ChSolverMINRES>(system.GetSolver())->SetDiagonalPreconditioning(true);
+    system.SetTimestepperType(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED);
+
+    system.SetupInitial();
+    for (int step = 0; step < 200; step++)
+        system.DoStepDynamics(1e-3);
+
+    return prev->GetPos();
+}
+
+bool TestTrajectory() {
+    ChVector<> tip_consistent = SwingCable(false);
+    ChVector<> tip_lumped = SwingCable(true);
+    double diff = (tip_lumped - tip_consistent).Length();
+
+    cout << "Cable tip  consistent mass: " << tip_consistent.x() << " " << tip_consistent.z()
+         << "  lumped mass: " << tip_lumped.x() << " " << tip_lumped.z() << "  difference: " << diff << endl;
+
+    // The cable must have fallen by a similar amount.
+    return (tip_consistent.z() < -0.05) && (diff < 0.02 * std::abs(tip_consistent.z()));
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = TestCable();
+    passed &= TestShell();
+    passed &= TestTetra();
+    passed &= TestLumpedMass();
+    passed &= TestTrajectory();
+
+    cout << (passed ? "PASSED" : "FAILED") << endl;
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
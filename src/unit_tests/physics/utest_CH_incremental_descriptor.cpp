@@ -0,0 +1,161 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the incremental injection of the system descriptor
+// (ChSystem::SetUseIncrementalDescriptor).
+// A pile of spheres settling in a box, plus a pendulum connected to ground with
+// a revolute joint, is simulated twice: once with the default (full) injection
+// of the descriptor at each step and once in incremental mode. A sphere is
+// added and another one is removed during the simulation. Finally, a second
+// pendulum connected with a generic mate has its constrained coordinates swapped:
+// the mate reallocates its constraints, without changing their number.
+// The two simulations must give the same body positions at each step, and the
+// incremental system must perform a full injection only at the first step and
+// after each change of the assembly.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/physics/ChLinkMate.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+using namespace chrono;
+
+double time_step = 1e-3;
+int num_steps = 300;
+int step_add = 100;
+int step_remove = 200;
+int step_swap = 250;
+double radius = 0.1;
+double tolerance = 1e-10;
+
+std::shared_ptr<ChBody> CreateBall(ChSystem* system, std::shared_ptr<ChMaterialSurface> material, const ChVector<>& pos) {
+    auto ball = std::shared_ptr<ChBody>(system->NewBody());
+    ball->SetPos(pos);
+    ball->SetMass(1);
+    ball->SetInertiaXX(0.4 * radius * radius * ChVector<>(1, 1, 1));
+    ball->SetMaterialSurface(material);
+    ball->SetCollide(true);
+    ball->GetCollisionModel()->ClearModel();
+    ball->GetCollisionModel()->AddSphere(radius);
+    ball->GetCollisionModel()->BuildModel();
+    system->AddBody(ball);
+    return ball;
+}
+
+// Create the scene and return the list of moving bodies.
+std::vector<std::shared_ptr<ChBody>> CreateScene(ChSystem* system,
+                                                 std::shared_ptr<ChMaterialSurface> material,
+                                                 std::shared_ptr<ChLinkMateGeneric>& mate) {
+    system->Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    auto ground = utils::CreateBoxContainer(system, -1, material, ChVector<>(1, 1, 1), 0.1, ChVector<>(0, 0, 0),
+                                            ChQuaternion<>(1, 0, 0, 0), true, false, true, false);
+
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    for (int iz = 0; iz < 3; iz++) {
+        for (int ix = -2; ix <= 2; ix++) {
+            for (int iy = -2; iy <= 2; iy++) {
+                double offset = (iz % 2) * 0.3 * radius;
+                ChVector<> pos(ix * 2.2 * radius + offset, iy * 2.2 * radius, radius + iz * 2.1 * radius);
+                bodies.push_back(CreateBall(system, material, pos));
+            }
+        }
+    }
+
+    // Pendulum hanging from a revolute joint (outside of the box)
+    auto pend = std::shared_ptr<ChBody>(system->NewBody());
+    pend->SetPos(ChVector<>(2, 0, 1));
+    pend->SetMass(1);
+    pend->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+    system->AddBody(pend);
+    bodies.push_back(pend);
+
+    auto rev = std::make_shared<ChLinkLockRevolute>();
+    rev->Initialize(ground, pend, ChCoordsys<>(ChVector<>(2, 0.5, 1), Q_from_AngX(CH_C_PI_2)));
+    system->AddLink(rev);
+
+    // Pendulum hanging from a generic mate, free to rotate about X
+    auto pend2 = std::shared_ptr<ChBody>(system->NewBody());
+    pend2->SetPos(ChVector<>(3, 0, 1));
+    pend2->SetMass(1);
+    pend2->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+    system->AddBody(pend2);
+    bodies.push_back(pend2);
+
+    mate = std::make_shared<ChLinkMateGeneric>(true, true, true, false, true, true);
+    mate->Initialize(ground, pend2, ChFrame<>(ChVector<>(3, 0.5, 1)));
+    system->AddLink(mate);
+
+    return bodies;
+}
+
+int main(int argc, char* argv[]) {
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.4f);
+
+    ChSystemNSC sys_ref;
+    ChSystemNSC sys_inc;
+    sys_inc.SetUseIncrementalDescriptor(true);
+
+    std::shared_ptr<ChLinkMateGeneric> mate_ref;
+    std::shared_ptr<ChLinkMateGeneric> mate_inc;
+    auto bodies_ref = CreateScene(&sys_ref, material, mate_ref);
+    auto bodies_inc = CreateScene(&sys_inc, material, mate_inc);
+
+    bool passed = true;
+    for (int step = 0; step < num_steps && passed; step++) {
+        if (step == step_add) {
+            ChVector<> pos(0, 0, 1);
+            bodies_ref.push_back(CreateBall(&sys_ref, material, pos));
+            bodies_inc.push_back(CreateBall(&sys_inc, material, pos));
+        }
+        if (step == step_remove) {
+            sys_ref.RemoveBody(bodies_ref[0]);
+            sys_inc.RemoveBody(bodies_inc[0]);
+            bodies_ref.erase(bodies_ref.begin());
+            bodies_inc.erase(bodies_inc.begin());
+        }
+        if (step == step_swap) {
+            // Free the rotation about Y instead of X: same number of constraints, new constraint objects.
+            mate_ref->SetConstrainedCoords(true, true, true, true, false, true);
+            mate_inc->SetConstrainedCoords(true, true, true, true, false, true);
+        }
+
+        sys_ref.DoStepDynamics(time_step);
+        sys_inc.DoStepDynamics(time_step);
+
+        for (size_t i = 0; i < bodies_ref.size(); i++) {
+            double err = (bodies_ref[i]->GetPos() - bodies_inc[i]->GetPos()).Length();
+            if (err > tolerance) {
+                GetLog() << "step " << step << ": body " << (int)i << " position differs by " << err << "\n";
+                passed = false;
+                break;
+            }
+        }
+    }
+
+    GetLog() << "number of contacts: " << sys_inc.GetNcontacts() << "\n";
+    GetLog() << "full injections (default):     " << sys_ref.GetNumDescriptorRebuilds() << "\n";
+    GetLog() << "full injections (incremental): " << sys_inc.GetNumDescriptorRebuilds() << "\n";
+
+    // Full injections only at the first step, after adding and removing a body, and after changing the mate.
+    passed &= (sys_inc.GetNumDescriptorRebuilds() == 4);
+
+    GetLog() << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
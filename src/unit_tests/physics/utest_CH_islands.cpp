@@ -0,0 +1,304 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the simulation islands (sleeping and solving by islands).
+// Two separate stacks of boxes settle on a fixed ground. The SOR solver works
+// island by island: the two stacks must be found as two independent islands and
+// must stay standing. Once at rest, both stacks must fall asleep as two islands.
+// Then a box is thrown on the first stack: the whole first stack must wake up
+// at once, while the second stack must keep sleeping.
+// Finally, the island tags must survive the removal and re-insertion of bodies.
+// The other iterative solvers that support islands (symmetric SOR, Jacobi,
+// APGD and Barzilai-Borwein) must also find the two stacks as two islands and
+// keep them standing.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChIterativeSolver.h"
+#include "chrono/solver/ChSolverSOR.h"
+
+using namespace chrono;
+
+// Return the number of sleeping bodies in the list.
+int CountSleeping(const std::vector<std::shared_ptr<ChBody>>& bodies) {
+    int n = 0;
+    for (auto body : bodies)
+        n += body->GetSleeping() ? 1 : 0;
+    return n;
+}
+
+// A fixed body linked to ground: the link constraints have no active variables. They must not prevent solving
+// by islands (they form one more island), and a box resting on the ground must keep standing.
+bool TestFixedLink() {
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.5f);
+
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetSolverType(ChSolver::Type::SOR);
+    system.SetMaxItersSolverSpeed(100);
+    auto solver = std::static_pointer_cast<ChSolverSOR>(system.GetSolver());
+    solver->SetSolveByIslands(true);
+
+    double time_step = 1e-3;
+    double hsize = 0.1;
+    double density = 1 / std::pow(2 * hsize, 3);
+
+    auto ground = std::make_shared<ChBodyEasyBox>(6, 2, 2 * hsize, density, true, false);
+    ground->SetPos(ChVector<>(0, 0, -hsize));
+    ground->SetBodyFixed(true);
+    ground->SetMaterialSurface(material);
+    system.AddBody(ground);
+
+    auto post = std::make_shared<ChBodyEasyBox>(2 * hsize, 2 * hsize, 2 * hsize, density, false, false);
+    post->SetPos(ChVector<>(2, 0, hsize));
+    post->SetBodyFixed(true);
+    system.AddBody(post);
+
+    auto link = std::make_shared<ChLinkLockLock>();
+    link->Initialize(post, ground, ChCoordsys<>(ChVector<>(2, 0, 0)));
+    system.AddLink(link);
+
+    auto box = std::make_shared<ChBodyEasyBox>(2 * hsize, 2 * hsize, 2 * hsize, density, true, false);
+    box->SetPos(ChVector<>(0, 0, hsize));
+    box->SetMaterialSurface(material);
+    system.AddBody(box);
+
+    for (int step = 0; step < 200; step++)
+        system.DoStepDynamics(time_step);
+
+    int num_unknown = (int)system.GetSystemDescriptor()->GetUnknownConstraints().size();
+    GetLog() << "fixed link  islands: " << solver->GetNumIslands() << "  unknown constraints: " << num_unknown
+             << "  box height: " << box->GetPos().z() << "\n";
+
+    bool passed = (solver->GetNumIslands() == 2);
+    passed &= (num_unknown == 0);
+    passed &= std::abs(box->GetPos().z() - hsize) < 0.01;
+    return passed;
+}
+
+// Two stacks of boxes settle on the ground, solved island by island with the given solver. The stacks must be
+// found as two islands and must stay standing.
+bool TestSolver(ChSolver::Type type, const char* name) {
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.5f);
+
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetSolverType(type);
+    system.SetMaxItersSolverSpeed(200);
+    system.SetSolverWarmStarting(true);
+    auto solver = std::static_pointer_cast<ChIterativeSolver>(system.GetSolver());
+    solver->SetSolveByIslands(true);
+
+    double time_step = 1e-3;
+    double hsize = 0.1;
+    double density = 1 / std::pow(2 * hsize, 3);
+
+    auto ground = std::make_shared<ChBodyEasyBox>(6, 2, 2 * hsize, density, true, false);
+    ground->SetPos(ChVector<>(0, 0, -hsize));
+    ground->SetBodyFixed(true);
+    ground->SetMaterialSurface(material);
+    system.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> boxes;
+    for (int i = 0; i < 4; i++) {
+        auto box = std::make_shared<ChBodyEasyBox>(2 * hsize, 2 * hsize, 2 * hsize, density, true, false);
+        box->SetPos(ChVector<>(i % 2 ? 1 : -1, 0, hsize + (i / 2) * 2 * hsize));
+        box->SetMaterialSurface(material);
+        system.AddBody(box);
+        boxes.push_back(box);
+    }
+
+    for (int step = 0; step < 500; step++)
+        system.DoStepDynamics(time_step);
+
+    GetLog() << name << "  islands: " << solver->GetNumIslands() << "  iterations: " << solver->GetTotalIterations()
+             << "  top of stacks: " << boxes[2]->GetPos().z() << "  " << boxes[3]->GetPos().z() << "\n";
+
+    bool passed = (solver->GetNumIslands() == 2);
+    passed &= std::abs(boxes[2]->GetPos().z() - 3 * hsize) < 0.01;
+    passed &= std::abs(boxes[3]->GetPos().z() - 3 * hsize) < 0.01;
+    return passed;
+}
+
+// Three boxes fall asleep on the ground as three islands. A sleeping box is removed and added back: this shifts
+// the indices of the other bodies, and the box must not be merged with the island of another box. Waking up the
+// middle box must leave the other two asleep.
+bool TestRemoveBody() {
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.5f);
+
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetUseSleeping(true);
+    system.SetSolverType(ChSolver::Type::SOR);
+    system.SetMaxItersSolverSpeed(100);
+
+    double time_step = 1e-3;
+    double hsize = 0.1;
+    double density = 1 / std::pow(2 * hsize, 3);
+
+    auto ground = std::make_shared<ChBodyEasyBox>(6, 2, 2 * hsize, density, true, false);
+    ground->SetPos(ChVector<>(0, 0, -hsize));
+    ground->SetBodyFixed(true);
+    ground->SetMaterialSurface(material);
+    system.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> boxes;
+    for (int i = 0; i < 3; i++) {
+        auto box = std::make_shared<ChBodyEasyBox>(2 * hsize, 2 * hsize, 2 * hsize, density, true, false);
+        box->SetPos(ChVector<>(2.0 * (i - 1), 0, hsize));
+        box->SetMaterialSurface(material);
+        system.AddBody(box);
+        boxes.push_back(box);
+    }
+
+    for (int step = 0; step < 1000; step++)
+        system.DoStepDynamics(time_step);
+
+    bool passed = (system.GetNumSleepingIslands() == 3) && (CountSleeping(boxes) == 3);
+
+    // Remove the first box, let the other islands be tagged again, then add the box back.
+    system.RemoveBody(boxes[0]);
+    for (int step = 0; step < 10; step++)
+        system.DoStepDynamics(time_step);
+    system.AddBody(boxes[0]);
+    for (int step = 0; step < 10; step++)
+        system.DoStepDynamics(time_step);
+
+    passed &= (system.GetNumSleepingIslands() == 3) && (CountSleeping(boxes) == 3);
+
+    // Throw a box on the middle box.
+    auto falling = std::make_shared<ChBodyEasyBox>(2 * hsize, 2 * hsize, 2 * hsize, density, true, false);
+    falling->SetPos(ChVector<>(0, 0, 1));
+    falling->SetMaterialSurface(material);
+    system.AddBody(falling);
+    falling->SetPos_dt(ChVector<>(0, 0, -1));
+
+    bool woken = false;
+    for (int step = 0; step < 500; step++) {
+        system.DoStepDynamics(time_step);
+        woken |= !boxes[1]->GetSleeping();
+        if (!boxes[0]->GetSleeping() || !boxes[2]->GetSleeping()) {
+            GetLog() << "step " << step << ": untouched box woken up\n";
+            passed = false;
+            break;
+        }
+    }
+
+    GetLog() << "remove body  middle box woken up: " << (woken ? "yes" : "no") << "\n";
+    passed &= woken;
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.5f);
+
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetUseSleeping(true);
+    system.SetSolverType(ChSolver::Type::SOR);
+    system.SetMaxItersSolverSpeed(100);
+    auto solver = std::static_pointer_cast<ChSolverSOR>(system.GetSolver());
+    solver->SetSolveByIslands(true);
+
+    // Boxes of mass 1, half size hsize.
+    double time_step = 1e-3;
+    double hsize = 0.1;
+    double density = 1 / std::pow(2 * hsize, 3);
+
+    auto ground = std::make_shared<ChBodyEasyBox>(6, 2, 2 * hsize, density, true, false);
+    ground->SetPos(ChVector<>(0, 0, -hsize));
+    ground->SetBodyFixed(true);
+    ground->SetMaterialSurface(material);
+    system.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> stackA;
+    std::vector<std::shared_ptr<ChBody>> stackB;
+    for (int i = 0; i < 6; i++) {
+        auto box = std::make_shared<ChBodyEasyBox>(2 * hsize, 2 * hsize, 2 * hsize, density, true, false);
+        box->SetPos(ChVector<>(i % 2 ? 1 : -1, 0, hsize + (i / 2) * 2 * hsize));
+        box->SetMaterialSurface(material);
+        system.AddBody(box);
+        (i % 2 ? stackB : stackA).push_back(box);
+    }
+
+    bool passed = true;
+
+    // Settle and fall asleep.
+    int num_islands = 0;
+    for (int step = 0; step < 1500; step++) {
+        system.DoStepDynamics(time_step);
+        if (step == 100)
+            num_islands = solver->GetNumIslands();
+    }
+
+    GetLog() << "islands solved while settling: " << num_islands << "\n";
+    GetLog() << "sleeping islands: " << system.GetNumSleepingIslands() << "\n";
+    GetLog() << "top of stacks: " << stackA[2]->GetPos().z() << "  " << stackB[2]->GetPos().z() << "\n";
+
+    passed &= (num_islands == 2);
+    passed &= (system.GetNumSleepingIslands() == 2);
+    passed &= (CountSleeping(stackA) == 3 && CountSleeping(stackB) == 3);
+    passed &= std::abs(stackA[2]->GetPos().z() - 5 * hsize) < 0.01;
+    passed &= std::abs(stackB[2]->GetPos().z() - 5 * hsize) < 0.01;
+
+    // Throw a box on the first stack.
+    auto falling = std::make_shared<ChBodyEasyBox>(2 * hsize, 2 * hsize, 2 * hsize, density, true, false);
+    falling->SetPos(ChVector<>(-1, 0, 1));
+    falling->SetMaterialSurface(material);
+    system.AddBody(falling);
+    falling->SetPos_dt(ChVector<>(0, 0, -1));
+
+    bool woken = false;
+    for (int step = 0; step < 500; step++) {
+        system.DoStepDynamics(time_step);
+
+        // The first stack wakes up (and falls asleep again) as a whole.
+        int nA = CountSleeping(stackA);
+        if (nA != 0 && nA != 3) {
+            GetLog() << "step " << step << ": first stack partially asleep\n";
+            passed = false;
+        }
+        if (nA == 0)
+            woken = true;
+
+        // The second stack is not touched.
+        if (CountSleeping(stackB) != 3) {
+            GetLog() << "step " << step << ": second stack woken up\n";
+            passed = false;
+        }
+    }
+
+    GetLog() << "first stack woken up: " << (woken ? "yes" : "no") << "\n";
+    passed &= woken;
+
+    passed &= TestFixedLink();
+    passed &= TestRemoveBody();
+    passed &= TestSolver(ChSolver::Type::SYMMSOR, "symmetric SOR");
+    passed &= TestSolver(ChSolver::Type::JACOBI, "Jacobi");
+    passed &= TestSolver(ChSolver::Type::APGD, "APGD");
+    passed &= TestSolver(ChSolver::Type::BARZILAIBORWEIN, "Barzilai-Borwein");
+
+    GetLog() << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
@@ -0,0 +1,127 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the persistent contacts of ChContactContainerNSC.
+// A stack of boxes, a body made of two boxes (compound collision model) and
+// spheres with rolling friction settle on a fixed ground. The simulation is
+// run with and without persistent contacts: the trajectories must be the same,
+// and, once the bodies are at rest, all the contacts must be reused from one
+// step to the next. Persistent contacts are also switched on and off during
+// the simulation.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/physics/ChContactContainerNSC.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+
+double time_step = 1e-3;
+int num_steps = 800;
+
+std::shared_ptr<ChBody> CreateBody(ChSystem& system,
+                                   std::shared_ptr<ChMaterialSurface> material,
+                                   const ChVector<>& pos) {
+    auto body = std::make_shared<ChBody>();
+    body->SetPos(pos);
+    body->SetMass(1);
+    body->SetInertiaXX(ChVector<>(0.01, 0.01, 0.01));
+    body->SetMaterialSurface(material);
+    body->SetCollide(true);
+    body->GetCollisionModel()->ClearModel();
+    system.AddBody(body);
+    return body;
+}
+
+// Simulate the scene; persistent contacts are used in the steps for which persistent(step) is true.
+// Return the positions of the bodies at all steps, and the number of contacts and of reused contacts at the end.
+template <class F>
+std::vector<ChVector<>> Run(F persistent, int& num_contacts, int& num_persistent) {
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetMaxItersSolverSpeed(100);
+    system.SetSolverWarmStarting(true);
+    auto container = std::static_pointer_cast<ChContactContainerNSC>(system.GetContactContainer());
+
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.5f);
+    auto material_rolling = std::make_shared<ChMaterialSurfaceNSC>();
+    material_rolling->SetFriction(0.5f);
+    material_rolling->SetRollingFriction(0.01f);
+
+    auto ground = CreateBody(system, material_rolling, ChVector<>(0, 0, 0));
+    ground->SetBodyFixed(true);
+    ground->GetCollisionModel()->AddBox(3, 3, 0.1, ChVector<>(0, 0, -0.1));
+    ground->GetCollisionModel()->BuildModel();
+
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    for (int i = 0; i < 3; i++) {
+        auto box = CreateBody(system, material, ChVector<>(0, 0, 0.1 + 0.2 * i));
+        box->GetCollisionModel()->AddBox(0.1, 0.1, 0.1);
+        box->GetCollisionModel()->BuildModel();
+        bodies.push_back(box);
+    }
+
+    auto compound = CreateBody(system, material, ChVector<>(1, 0, 0.15));
+    compound->GetCollisionModel()->AddBox(0.2, 0.1, 0.05, ChVector<>(0, 0, -0.1));
+    compound->GetCollisionModel()->AddBox(0.05, 0.1, 0.1, ChVector<>(0.15, 0, 0.05));
+    compound->GetCollisionModel()->BuildModel();
+    bodies.push_back(compound);
+
+    for (int i = 0; i < 4; i++) {
+        auto ball = CreateBody(system, material_rolling, ChVector<>(-1, 0.3 * i - 0.45, 0.1 + 0.02 * i));
+        ball->GetCollisionModel()->AddSphere(0.1);
+        ball->GetCollisionModel()->BuildModel();
+        ball->SetPos_dt(ChVector<>(0.5, 0, 0));
+        bodies.push_back(ball);
+    }
+
+    std::vector<ChVector<>> positions;
+    for (int step = 0; step < num_steps; step++) {
+        container->SetPersistentContacts(persistent(step));
+        system.DoStepDynamics(time_step);
+        for (auto body : bodies)
+            positions.push_back(body->GetPos());
+    }
+
+    num_contacts = container->GetNcontacts();
+    num_persistent = container->GetNumPersistentContacts();
+    return positions;
+}
+
+int main(int argc, char* argv[]) {
+    int num_contacts;
+    int num_persistent;
+
+    auto ref = Run([](int step) { return false; }, num_contacts, num_persistent);
+    GetLog() << "default     contacts: " << num_contacts << "  reused: " << num_persistent << "\n";
+    bool passed = (num_persistent == 0);
+
+    auto pos1 = Run([](int step) { return true; }, num_contacts, num_persistent);
+    bool same1 = (pos1 == ref);
+    GetLog() << "persistent  contacts: " << num_contacts << "  reused: " << num_persistent
+             << "  same trajectories: " << (same1 ? "yes" : "NO") << "\n";
+    passed &= same1 && num_contacts > 0 && num_persistent == num_contacts;
+
+    auto pos2 = Run([](int step) { return (step / 100) % 2 == 1; }, num_contacts, num_persistent);
+    bool same2 = (pos2 == ref);
+    GetLog() << "switched    contacts: " << num_contacts << "  reused: " << num_persistent
+             << "  same trajectories: " << (same2 ? "yes" : "NO") << "\n";
+    passed &= same2 && num_persistent == num_contacts;
+
+    GetLog() << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
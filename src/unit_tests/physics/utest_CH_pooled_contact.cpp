@@ -0,0 +1,166 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the pooled contact containers (ChContactContainerPooledNSC and
+// ChContactContainerPooledSMC).
+// A pile of spheres settling in a box is simulated twice, once with the default
+// contact container and once with the pooled one. Since the pooled containers
+// store contacts in the same order, the two simulations must give the same
+// number of contacts and the same body positions at each step. The pooled
+// containers are also tested with the parallel ingestion of the contacts
+// (SetUseParallelAddContacts), which must not change the results.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/physics/ChContactContainerPooledNSC.h"
+#include "chrono/physics/ChContactContainerPooledSMC.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+using namespace chrono;
+
+double time_step = 1e-3;
+int num_steps = 500;
+double radius = 0.1;
+int num_layers = 4;
+double tolerance = 1e-10;
+
+// Create a pile of spheres in a box container and return the list of spheres.
+std::vector<std::shared_ptr<ChBody>> CreateScene(ChSystem* system, std::shared_ptr<ChMaterialSurface> material) {
+    system->Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    utils::CreateBoxContainer(system, -1, material, ChVector<>(1, 1, 1), 0.1, ChVector<>(0, 0, 0),
+                              ChQuaternion<>(1, 0, 0, 0), true, false, true, false);
+
+    std::vector<std::shared_ptr<ChBody>> balls;
+    for (int iz = 0; iz < num_layers; iz++) {
+        for (int ix = -3; ix <= 3; ix++) {
+            for (int iy = -3; iy <= 3; iy++) {
+                auto ball = std::shared_ptr<ChBody>(system->NewBody());
+                double offset = (iz % 2) * 0.3 * radius;
+                ball->SetPos(ChVector<>(ix * 2.2 * radius + offset, iy * 2.2 * radius, radius + iz * 2.1 * radius));
+                ball->SetMass(1);
+                ball->SetInertiaXX(0.4 * radius * radius * ChVector<>(1, 1, 1));
+                ball->SetMaterialSurface(material);
+                ball->SetCollide(true);
+                ball->GetCollisionModel()->ClearModel();
+                ball->GetCollisionModel()->AddSphere(radius);
+                ball->GetCollisionModel()->BuildModel();
+                system->AddBody(ball);
+                balls.push_back(ball);
+            }
+        }
+    }
+
+    return balls;
+}
+
+bool CompareContainers(ChSystem* sys_ref, ChSystem* sys_pool, std::shared_ptr<ChMaterialSurface> material) {
+    auto balls_ref = CreateScene(sys_ref, material);
+    auto balls_pool = CreateScene(sys_pool, material);
+
+    int max_contacts = 0;
+    for (int step = 0; step < num_steps; step++) {
+        sys_ref->DoStepDynamics(time_step);
+        sys_pool->DoStepDynamics(time_step);
+
+        int ncontacts = sys_ref->GetContactContainer()->GetNcontacts();
+        if (ncontacts != sys_pool->GetContactContainer()->GetNcontacts()) {
+            GetLog() << "  step " << step << ": different number of contacts (" << ncontacts << " vs "
+                     << sys_pool->GetContactContainer()->GetNcontacts() << ")\n";
+            return false;
+        }
+        max_contacts = std::max(max_contacts, ncontacts);
+
+        for (size_t i = 0; i < balls_ref.size(); i++) {
+            double err = (balls_ref[i]->GetPos() - balls_pool[i]->GetPos()).Length();
+            if (err > tolerance) {
+                GetLog() << "  step " << step << ": body " << (int)i << " position differs by " << err << "\n";
+                return false;
+            }
+        }
+    }
+
+    GetLog() << "  max. number of contacts: " << max_contacts << "\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    {
+        GetLog() << "NSC: ChContactContainerNSC vs. ChContactContainerPooledNSC\n";
+        auto material = std::make_shared<ChMaterialSurfaceNSC>();
+        material->SetFriction(0.4f);
+
+        ChSystemNSC sys_ref;
+        ChSystemNSC sys_pool;
+        sys_pool.SetContactContainer(std::make_shared<ChContactContainerPooledNSC>());
+        bool ok = CompareContainers(&sys_ref, &sys_pool, material);
+        GetLog() << "  " << (ok ? "PASSED" : "FAILED") << "\n";
+        passed &= ok;
+    }
+
+    {
+        GetLog() << "NSC: ChContactContainerNSC vs. ChContactContainerPooledNSC (parallel contact ingestion)\n";
+        auto material = std::make_shared<ChMaterialSurfaceNSC>();
+        material->SetFriction(0.4f);
+
+        ChSystemNSC sys_ref;
+        ChSystemNSC sys_pool;
+        sys_pool.SetParallelThreadNumber(4);
+        auto container = std::make_shared<ChContactContainerPooledNSC>();
+        container->SetUseParallelAddContacts(true);
+        sys_pool.SetContactContainer(container);
+        bool ok = CompareContainers(&sys_ref, &sys_pool, material);
+        GetLog() << "  " << (ok ? "PASSED" : "FAILED") << "\n";
+        passed &= ok;
+    }
+
+    {
+        GetLog() << "SMC: ChContactContainerSMC vs. ChContactContainerPooledSMC\n";
+        auto material = std::make_shared<ChMaterialSurfaceSMC>();
+        material->SetFriction(0.4f);
+        material->SetYoungModulus(1e6f);
+
+        ChSystemSMC sys_ref;
+        ChSystemSMC sys_pool;
+        sys_pool.SetContactContainer(std::make_shared<ChContactContainerPooledSMC>());
+        bool ok = CompareContainers(&sys_ref, &sys_pool, material);
+        GetLog() << "  " << (ok ? "PASSED" : "FAILED") << "\n";
+        passed &= ok;
+    }
+
+    {
+        GetLog() << "SMC: ChContactContainerSMC vs. ChContactContainerPooledSMC (parallel contact ingestion)\n";
+        auto material = std::make_shared<ChMaterialSurfaceSMC>();
+        material->SetFriction(0.4f);
+        material->SetYoungModulus(1e6f);
+
+        ChSystemSMC sys_ref;
+        ChSystemSMC sys_pool;
+        sys_pool.SetParallelThreadNumber(4);
+        auto container = std::make_shared<ChContactContainerPooledSMC>();
+        container->SetUseParallelAddContacts(true);
+        sys_pool.SetContactContainer(container);
+        bool ok = CompareContainers(&sys_ref, &sys_pool, material);
+        GetLog() << "  " << (ok ? "PASSED" : "FAILED") << "\n";
+        passed &= ok;
+    }
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,223 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the ray-hit tests with a specified collision model
+// (ChCollisionSystemBullet::RayHit and RayHits).
+// A grid of vertical rays is cast on collision models of different types (a
+// connected triangle mesh, a static and a non-static triangle mesh soup, a
+// compound of boxes), in a scene that also contains many other bodies. The
+// results must be the same as those obtained by a ray test with the whole
+// collision world, filtered by model, and the batched (multithreaded) ray test
+// must give the same results as the single ray tests. The batched ray test with
+// the whole collision world must also match the single ray tests.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/geometry/ChTriangleMeshSoup.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace chrono::geometry;
+
+typedef ChCollisionSystem::ChRayhitResult RayhitResult;
+
+int grid_size = 40;
+double tolerance = 1e-10;
+
+// Height of the terrain meshes.
+double Height(double x, double y) {
+    return 0.2 * std::sin(2 * x) * std::cos(3 * y);
+}
+
+// Add a body with the given collision model, at the given location.
+std::shared_ptr<ChBody> AddBody(ChSystem& system, const ChVector<>& pos) {
+    auto body = std::make_shared<ChBody>();
+    body->SetPos(pos);
+    body->SetRot(Q_from_AngZ(0.1));
+    body->SetBodyFixed(true);
+    body->SetCollide(true);
+    body->GetCollisionModel()->ClearModel();
+    system.AddBody(body);
+    return body;
+}
+
+// Ray test with the whole collision world, keeping the closest hit on the given model.
+bool RayHitWorld(ChCollisionSystemBullet* csys,
+                 const ChVector<>& from,
+                 const ChVector<>& to,
+                 ChCollisionModel* model,
+                 RayhitResult& result) {
+    btVector3 btfrom((btScalar)from.x(), (btScalar)from.y(), (btScalar)from.z());
+    btVector3 btto((btScalar)to.x(), (btScalar)to.y(), (btScalar)to.z());
+    btCollisionWorld::AllHitsRayResultCallback rayCallback(btfrom, btto);
+    csys->GetBulletCollisionWorld()->rayTest(btfrom, btto, rayCallback);
+
+    int hit = -1;
+    btScalar fraction = 1;
+    for (int i = 0; i < rayCallback.m_collisionObjects.size(); ++i) {
+        if (rayCallback.m_collisionObjects[i]->getUserPointer() == model && rayCallback.m_hitFractions[i] < fraction) {
+            hit = i;
+            fraction = rayCallback.m_hitFractions[i];
+        }
+    }
+    result.hit = (hit >= 0);
+    if (!result.hit)
+        return false;
+
+    result.abs_hitNormal.Set(rayCallback.m_hitNormalWorld[hit].x(), rayCallback.m_hitNormalWorld[hit].y(),
+                             rayCallback.m_hitNormalWorld[hit].z());
+    result.abs_hitNormal.Normalize();
+    result.abs_hitPoint.Set(rayCallback.m_hitPointWorld[hit].x(), rayCallback.m_hitPointWorld[hit].y(),
+                            rayCallback.m_hitPointWorld[hit].z());
+    result.abs_hitPoint -= result.abs_hitNormal * model->GetEnvelope();
+    result.dist_factor = fraction;
+    return true;
+}
+
+bool SameResult(const RayhitResult& r1, const RayhitResult& r2) {
+    if (r1.hit != r2.hit)
+        return false;
+    if (!r1.hit)
+        return true;
+    return (r1.abs_hitPoint - r2.abs_hitPoint).Length() < tolerance &&
+           (r1.abs_hitNormal - r2.abs_hitNormal).Length() < tolerance &&
+           std::abs(r1.dist_factor - r2.dist_factor) < tolerance;
+}
+
+int main(int argc, char* argv[]) {
+    ChSystemNSC system;
+    system.SetParallelThreadNumber(4);
+    auto csys = std::static_pointer_cast<ChCollisionSystemBullet>(system.GetCollisionSystem());
+    csys->SetUseParallelCollision(true);
+
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+
+    // Terrain meshes, as a connected mesh (compound of triangles) and as a triangle soup.
+    auto connected = std::make_shared<ChTriangleMeshConnected>();
+    auto soup = std::make_shared<ChTriangleMeshSoup>();
+    int n = 20;
+    double h = 0.1;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double x0 = (i - n / 2) * h, x1 = x0 + h;
+            double y0 = (j - n / 2) * h, y1 = y0 + h;
+            ChVector<> v00(x0, y0, Height(x0, y0)), v10(x1, y0, Height(x1, y0));
+            ChVector<> v01(x0, y1, Height(x0, y1)), v11(x1, y1, Height(x1, y1));
+            connected->addTriangle(v00, v10, v11);
+            connected->addTriangle(v00, v11, v01);
+            soup->addTriangle(v00, v10, v11);
+            soup->addTriangle(v00, v11, v01);
+        }
+    }
+    connected->RepairDuplicateVertexes(1e-9);
+
+    std::vector<std::shared_ptr<ChBody>> targets;
+
+    auto b1 = AddBody(system, ChVector<>(0, 0, 0));
+    b1->GetCollisionModel()->AddTriangleMesh(connected, true, false);
+    targets.push_back(b1);
+
+    auto b2 = AddBody(system, ChVector<>(0, 0, 0.5));
+    b2->GetCollisionModel()->AddTriangleMesh(soup, true, false);
+    targets.push_back(b2);
+
+    auto b3 = AddBody(system, ChVector<>(0, 0, 1.0));
+    b3->GetCollisionModel()->AddTriangleMesh(soup, false, false);
+    targets.push_back(b3);
+
+    auto b4 = AddBody(system, ChVector<>(0, 0, 1.5));
+    b4->GetCollisionModel()->AddBox(0.4, 0.3, 0.1, ChVector<>(-0.5, 0, 0));
+    b4->GetCollisionModel()->AddBox(0.3, 0.4, 0.2, ChVector<>(0.5, 0.2, 0.1), ChMatrix33<>(Q_from_AngX(0.3)));
+    b4->GetCollisionModel()->AddSphere(0.2, ChVector<>(0, -0.6, 0));
+    targets.push_back(b4);
+
+    for (auto body : targets) {
+        body->GetCollisionModel()->BuildModel();
+        body->SetMaterialSurface(material);
+    }
+
+    // Other bodies, overlapping the rays.
+    for (int i = 0; i < 200; i++) {
+        auto ball = AddBody(system, ChVector<>(-1 + 0.01 * i, 0.5 - 0.005 * i, 0.2 + 0.01 * i));
+        ball->GetCollisionModel()->AddSphere(0.05);
+        ball->GetCollisionModel()->BuildModel();
+        ball->SetMaterialSurface(material);
+    }
+
+    system.SetupInitial();
+    system.ComputeCollisions();
+
+    std::vector<ChVector<>> from;
+    std::vector<ChVector<>> to;
+    for (int i = 0; i < grid_size; i++) {
+        for (int j = 0; j < grid_size; j++) {
+            double x = -1.1 + 2.2 * (i + 0.37) / grid_size;
+            double y = -1.1 + 2.2 * (j + 0.61) / grid_size;
+            from.push_back(ChVector<>(x, y, 10));
+            to.push_back(ChVector<>(x, y, -10));
+        }
+    }
+
+    bool passed = true;
+    for (size_t ib = 0; ib < targets.size(); ib++) {
+        ChCollisionModel* model = targets[ib]->GetCollisionModel().get();
+        int num_hits = 0;
+        bool ok = true;
+
+        std::vector<RayhitResult> results;
+        csys->RayHits(from, to, model, results);
+
+        for (size_t k = 0; k < from.size(); k++) {
+            RayhitResult ref;
+            RayhitResult result;
+            RayHitWorld(csys.get(), from[k], to[k], model, ref);
+            csys->RayHit(from[k], to[k], model, result);
+            if (!SameResult(ref, result) || !SameResult(result, results[k]))
+                ok = false;
+            if (result.hit && result.hitModel != model)
+                ok = false;
+            num_hits += result.hit;
+        }
+
+        GetLog() << "Model " << (int)ib << ": " << num_hits << " hits  " << (ok ? "PASSED" : "FAILED")
+                 << "\n";
+        passed &= ok && num_hits > 0;
+    }
+
+    {
+        int num_hits = 0;
+        bool ok = true;
+
+        std::vector<RayhitResult> results;
+        csys->RayHits(from, to, results);
+
+        for (size_t k = 0; k < from.size(); k++) {
+            RayhitResult result;
+            csys->RayHit(from[k], to[k], result);
+            if (!SameResult(result, results[k]) || (result.hit && result.hitModel != results[k].hitModel))
+                ok = false;
+            num_hits += result.hit;
+        }
+
+        GetLog() << "All models: " << num_hits << " hits  " << (ok ? "PASSED" : "FAILED") << "\n";
+        passed &= ok && num_hits > 0;
+    }
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
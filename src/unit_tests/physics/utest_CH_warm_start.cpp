@@ -0,0 +1,205 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the persistent cache of contact reactions (warm starting).
+// First, the cache is checked alone: contacts stored in one order must be
+// found again, with their reactions, when reported in a different order and
+// after the bodies moved; contacts of different shapes must not be confused,
+// and a stored contact must be inherited at most once. Then a stack of boxes,
+// and a compound of spheres resting on the ground, are simulated with and without
+// warm starting, with both the list-based and the pooled NSC containers: with
+// warm starting, all the contacts of the resting stack must inherit the
+// reactions of the previous step, and the iterative solvers must take fewer
+// iterations to reach the tolerance.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChContactContainerNSC.h"
+#include "chrono/physics/ChContactContainerPooledNSC.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChIterativeSolver.h"
+
+using namespace chrono;
+
+// Check the matching of contacts reported in a different order, after a rigid motion of the bodies.
+bool TestCache() {
+    ChBody bodyA;
+    ChBody bodyB;
+    ChContactReactionCache cache;
+    cache.SetMatchingDistance(0.01);
+
+    std::vector<ChVector<>> points = {ChVector<>(0.1, 0, 0), ChVector<>(0, 0.1, 0), ChVector<>(0, 0, 0.1)};
+    ChVector<> force, torque;
+
+    // First step: no match. The first two contacts are on shape 0, the third on shape 1.
+    bool passed = true;
+    for (int i = 0; i < 3; i++)
+        passed &= !cache.Match(&bodyA, &bodyB, i / 2, 0, points[i], force, torque);
+    cache.BeginStore();
+    for (int i = 0; i < 3; i++)
+        cache.Store(&bodyA, &bodyB, i / 2, 0, ChVector<>(i + 1.0, 0, 0), ChVector<>(0, i + 1.0, 0));
+    cache.EndStore();
+    passed &= (cache.GetNumEntries() == 3);
+
+    // Second step: body A moved; contacts reported in reverse order, plus a new contact and a swapped pair.
+    ChFrame<> motion(ChVector<>(1, 2, 3), Q_from_AngZ(CH_C_PI_2));
+    bodyA.SetCoord(motion.GetCoord());
+    for (int i = 2; i >= 0; i--) {
+        ChVector<> p = motion.TransformPointLocalToParent(points[i] + ChVector<>(0.001, 0, 0));
+        bool found = cache.Match(&bodyA, &bodyB, i / 2, 0, p, force, torque);
+        passed &= found && force.x() == i + 1.0 && torque.y() == i + 1.0;
+    }
+    passed &= !cache.Match(&bodyA, &bodyB, 0, 0, motion.TransformPointLocalToParent(ChVector<>(0.2, 0, 0)), force,
+                           torque);
+    passed &= !cache.Match(&bodyB, &bodyA, 0, 0, motion.TransformPointLocalToParent(points[0]), force, torque);
+    // Same point as the third contact, but on another shape.
+    passed &= !cache.Match(&bodyA, &bodyB, 2, 0, motion.TransformPointLocalToParent(points[2]), force, torque);
+    // Same point and shape as the first contact, which was already inherited.
+    passed &= !cache.Match(&bodyA, &bodyB, 0, 0, motion.TransformPointLocalToParent(points[0]), force, torque);
+    passed &= (cache.GetNumMatched() == 3);
+
+    GetLog() << "cache matching: " << (passed ? "OK" : "FAILED") << "\n";
+    return passed;
+}
+
+// Simulate a resting stack of boxes; return the average number of solver iterations once settled.
+bool TestStack(ChSolver::Type type, bool pooled, bool warm, double& iterations) {
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.5f);
+
+    ChSystemNSC system;
+    if (pooled)
+        system.SetContactContainer(std::make_shared<ChContactContainerPooledNSC>());
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetSolverType(type);
+    system.SetMaxItersSolverSpeed(1000);
+    system.SetTolForce(1e-3);
+    system.SetSolverWarmStarting(warm);
+    auto solver = std::static_pointer_cast<ChIterativeSolver>(system.GetSolver());
+
+    // Boxes of mass 1, half size hsize.
+    double time_step = 1e-3;
+    double hsize = 0.1;
+    double density = 1 / std::pow(2 * hsize, 3);
+
+    auto ground = std::make_shared<ChBodyEasyBox>(6, 2, 2 * hsize, density, true, false);
+    ground->SetPos(ChVector<>(0, 0, -hsize));
+    ground->SetBodyFixed(true);
+    ground->SetMaterialSurface(material);
+    system.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> stack;
+    for (int i = 0; i < 5; i++) {
+        auto box = std::make_shared<ChBodyEasyBox>(2 * hsize, 2 * hsize, 2 * hsize, density, true, false);
+        box->SetPos(ChVector<>(0, 0, hsize + i * 2 * hsize));
+        box->SetMaterialSurface(material);
+        system.AddBody(box);
+        stack.push_back(box);
+    }
+
+    iterations = 0;
+    for (int step = 0; step < 600; step++) {
+        system.DoStepDynamics(time_step);
+        if (step >= 500)
+            iterations += solver->GetTotalIterations();
+    }
+    iterations /= 100;
+
+    ChContactReactionCache& cache =
+        pooled ? std::static_pointer_cast<ChContactContainerPooledNSC>(system.GetContactContainer())->GetReactionCache()
+               : std::static_pointer_cast<ChContactContainerNSC>(system.GetContactContainer())->GetReactionCache();
+    int num_contacts = system.GetContactContainer()->GetNcontacts();
+    int num_matched = cache.GetNumMatched();
+
+    GetLog() << "solver " << (int)type << (pooled ? "  pooled" : "  list  ") << (warm ? "  warm" : "  cold")
+             << "  contacts: " << num_contacts << "  matched: " << num_matched << "  iterations: " << iterations
+             << "\n";
+
+    bool passed = std::abs(stack.back()->GetPos().z() - 9 * hsize) < 0.01;
+    passed &= (num_contacts == 20);
+    passed &= warm ? (num_matched == num_contacts) : (num_matched == 0);
+    return passed;
+}
+
+// Simulate a compound of spheres resting on the ground: the contacts between the same two bodies are told apart
+// by their shapes, so all of them must inherit the reactions of the previous step.
+bool TestCompound(bool pooled) {
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.5f);
+
+    ChSystemNSC system;
+    if (pooled)
+        system.SetContactContainer(std::make_shared<ChContactContainerPooledNSC>());
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetSolverType(ChSolver::Type::SOR);
+    system.SetMaxItersSolverSpeed(100);
+    system.SetSolverWarmStarting(true);
+
+    auto ground = std::make_shared<ChBodyEasyBox>(2, 2, 0.2, 1000, true, false);
+    ground->SetPos(ChVector<>(0, 0, -0.1));
+    ground->SetBodyFixed(true);
+    ground->SetMaterialSurface(material);
+    system.AddBody(ground);
+
+    double radius = 0.05;
+    auto compound = std::make_shared<ChBody>();
+    compound->SetPos(ChVector<>(0, 0, radius));
+    compound->SetMass(9);
+    compound->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+    compound->SetMaterialSurface(material);
+    compound->SetCollide(true);
+    compound->GetCollisionModel()->ClearModel();
+    for (int i = -1; i <= 1; i++)
+        for (int j = -1; j <= 1; j++)
+            compound->GetCollisionModel()->AddSphere(radius, ChVector<>(0.2 * i, 0.2 * j, 0));
+    compound->GetCollisionModel()->BuildModel();
+    system.AddBody(compound);
+
+    for (int step = 0; step < 300; step++)
+        system.DoStepDynamics(1e-3);
+
+    ChContactReactionCache& cache =
+        pooled ? std::static_pointer_cast<ChContactContainerPooledNSC>(system.GetContactContainer())->GetReactionCache()
+               : std::static_pointer_cast<ChContactContainerNSC>(system.GetContactContainer())->GetReactionCache();
+    int num_contacts = system.GetContactContainer()->GetNcontacts();
+    int num_matched = cache.GetNumMatched();
+
+    GetLog() << "compound" << (pooled ? "  pooled" : "  list  ") << "  contacts: " << num_contacts
+             << "  matched: " << num_matched << "\n";
+
+    return num_contacts == 9 && num_matched == num_contacts;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = TestCache();
+
+    for (bool pooled : {false, true})
+        passed &= TestCompound(pooled);
+
+    for (auto type : {ChSolver::Type::SOR, ChSolver::Type::APGD}) {
+        for (bool pooled : {false, true}) {
+            double cold, warm;
+            passed &= TestStack(type, pooled, false, cold);
+            passed &= TestStack(type, pooled, true, warm);
+            passed &= (warm < cold);
+        }
+    }
+
+    GetLog() << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if all tests passed.
+    return !passed;
+}